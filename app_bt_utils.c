@@ -256,4 +256,43 @@ const char *get_bt_gatt_status_name(wiced_bt_gatt_status_t status)
 }
 
 
+/*******************************************************************************
+* Function Name: crc32_update
+********************************************************************************
+* Summary:
+* Updates a CRC-32 (IEEE 802.3, reflected, polynomial 0xEDB88320) with a block
+* of data. The value is finalized after every call, so a running CRC is
+* obtained by starting from 0 and passing the previous result back in, and
+* the result matches zlib's crc32().
+*
+* Parameters:
+*  uint32_t crc           : CRC of the preceding data, 0 for the first block
+*  const uint8_t *p_data  : Data to be added
+*  uint32_t len           : Length of the data
+*
+* Return:
+*  uint32_t: Updated CRC
+*
+*******************************************************************************/
+uint32_t crc32_update(uint32_t crc, const uint8_t *p_data, uint32_t len)
+{
+    /* Nibble-wise lookup table, trading a little speed for 64 bytes of flash */
+    static const uint32_t crc32_nibble_table[16] =
+    {
+        0x00000000u, 0x1DB71064u, 0x3B6E20C8u, 0x26D930ACu,
+        0x76DC4190u, 0x6B6B51F4u, 0x4DB26158u, 0x5005713Cu,
+        0xEDB88320u, 0xF00F9344u, 0xD6D6A3E8u, 0xCB61B38Cu,
+        0x9B64C2B0u, 0x86D3D2D4u, 0xA00AE278u, 0xBDBDF21Cu
+    };
+
+    crc = ~crc;
+    while (len--)
+    {
+        crc ^= *p_data++;
+        crc = (crc >> 4) ^ crc32_nibble_table[crc & 0x0Fu];
+        crc = (crc >> 4) ^ crc32_nibble_table[crc & 0x0Fu];
+    }
+    return ~crc;
+}
+
 /* [] END OF FILE */
@@ -47,21 +47,68 @@
 #include "cyhal.h"
 #include <FreeRTOS.h>
 #include <task.h>
+#include <semphr.h>
 #include "wiced_memory.h"
 #include "cycfg_gap.h"
 #include "app_bt_utils.h"
 #include "wiced_bt_stack.h"
 #include "ble_client.h"
 #include "wiced_bt_l2c.h"
+#include "tput_cwnd.h"
+#include "tput_blob.h"
+#include "tput_coalesce.h"
+#include "tput_rx_ring.h"
+#include "tput_result_log.h"
+#include "tput_telemetry.h"
+#include "tput_model.h"
+#include "tput_time.h"
+#include "tput_conn_evt.h"
+#include "tput_rx_jitter.h"
+#include "tput_load.h"
+#include "tput_trace.h"
+#include "tput_mem.h"
+#include "tput_eatt.h"
+#include "tput_relay.h"
+#include "tput_bridge.h"
+#include "tput_bench.h"
+#include "tput_evrec.h"
+#include "tput_ubench.h"
+#include "tput_bringup.h"
+#include "tput_reconnect.h"
+#include "tput_phy.h"
+#include "tput_security.h"
+#include "tput_adapt.h"
+#include "tput_stream.h"
 
 /*******************************************************************************
 *         Macros
 *******************************************************************************/
 #define GET_THROUGHPUT_TIMER_PERIOD (9999u)
 #define APP_MILLISEC_TIMER_PERIOD (9u)
-#define WRITE_DATA_SIZE (244)
+/* Pattern buffers of the writes, long enough for any packet size */
+#define WRITE_DATA_SIZE (GATT_WRITE_BYTES_MAX_LEN)
 #define TASK_NOTIFY_1MS_TIMER (1u)
 #define TASK_NOTIFY_NO_GATT_CONGESTION (2u)
+/* Size of the records generated in GATT_RECORDS_CTOS mode and number of
+ * records generated every millisecond */
+#define RECORD_DATA_SIZE (24u)
+#define RECORDS_PER_TICK (2u)
+/* Wait for the stopped writes to drain before writing the CCCD on a mode
+ * change */
+#define TPUT_CCCD_SETTLE_MS (2000u)
+
+#if TPUT_TELEMETRY_ENABLE
+/* The statistics are sent by telemetry_task instead of being printed. The
+ * arguments are still evaluated so the statistics code stays the same */
+#define STATS_PRINTF(...) do { if (0) { printf(__VA_ARGS__); } } while (0)
+#elif TPUT_BRIDGE_ENABLE && !TPUT_BRIDGE_SECOND_UART
+/* The statistics are not printed while the UART bridge streams on the debug
+ * UART */
+#define STATS_PRINTF(...) do { if (!tput_bridge_is_on_debug_uart()) { \
+                                   printf(__VA_ARGS__); } } while (0)
+#else
+#define STATS_PRINTF(...) printf(__VA_ARGS__)
+#endif
 
 /*******************************************************************************
 *        Variable Definitions
@@ -70,6 +117,14 @@
  * successfully*/
 static unsigned long gatt_notif_rx_bytes = 0;
 static unsigned long gatt_write_tx_bytes = 0;
+/* GATT Write commands completed with an error, for the result log */
+static uint16_t gatt_write_tx_failures = 0;
+/* Totals since connection, for the telemetry stream */
+static uint32_t gatt_notif_rx_total = 0;
+static uint32_t gatt_write_tx_total = 0;
+static uint16_t gatt_write_tx_failures_total = 0;
+/* Notifications received since connection, for the load sweep */
+static uint32_t gatt_notif_rx_pkts_total = 0;
 /*Variable that stores the data which will be sent as GATT write alternatively*/
 uint8_t write_data_seq1[WRITE_DATA_SIZE];
 uint8_t write_data_seq2[WRITE_DATA_SIZE];
@@ -88,16 +143,52 @@ static bool enable_cccd = true;
 static bool gatt_write_tx = false;
 /* Flag to used to Scan only for first button press */
 static bool scan_flag = true;
+/* Set when the service is discovered, to start TPUT_AUTO_START_MODE from
+ * ble_button_task */
+static volatile bool auto_start_pending = false;
+/* Set on link loss, to run the reconnection attempts from ble_button_task */
+static volatile bool reconnect_pending = false;
+/* Set on disconnection, to write the buffered results to flash from
+ * get_throughput_task */
+static volatile bool result_log_flush_pending = false;
+/* Time a record may wait for its packet to fill in GATT_RECORDS_CTOS mode */
+static uint16_t coalesce_deadline_ms = TPUT_COALESCE_DEADLINE_MS;
+/* Set while recorded events are replayed (TPUT_EVREC_ENABLE). The handlers
+ * then update the client state only: they make no calls to the stack, the
+ * timers or the flash, and skip the security and reconnection hooks */
+static bool replaying = false;
+/* Bytes transferred in the last second, both directions */
+static uint32_t last_second_bytes = 0;
+/* Coding requested for the Coded PHY, which the PHY update does not report */
+static wiced_bt_ble_lecoded_phy_preferences_t coded_phy_opts =
+                                                    BTM_BLE_PREFER_NO_LELR;
+/* PHY of a new connection, until the first PHY update */
+static tput_model_phy_t conn_phy = TPUT_MODEL_PHY_1M;
+#if TPUT_EXT_SCAN_ENABLE
+/* Scan and connect only on the LE Coded PHY, see tput_set_scan_phys() */
+static bool scan_coded_only = false;
+#endif
+/* Serializes the control functions called from ble_button_task,
+ * console_task and get_throughput_task. Recursive, as tput_connect() stops
+ * the scan with tput_scan_stop() */
+static SemaphoreHandle_t control_mutex = NULL;
+static StaticSemaphore_t control_mutex_buf;
 /* Variable to switch between different data transfer modes */
-static tput_mode_t mode_flag = GATT_NOTIFANDWRITE;
+static tput_mode_t mode_flag = TPUT_MODE_LAST;
 static const uint8_t tput_service_uuid[LEN_UUID_128] = TPUT_SERVICE_UUID;
 static uint16_t tput_service_handle = 0;
 static wiced_bt_gatt_status_t status;
 static wiced_bt_gatt_write_hdr_t tput_write_cmd = {0};
 /* variables for app buffer + handling */
-uint8_t *tput_buffer_ptr;
 uint8_t  data_flag = 0;
 uint8_t  value_initialize = 243;
+/* Sequence number carried by the records of GATT_RECORDS_CTOS mode */
+static uint32_t record_seq_num = 0;
+/* Notification bytes consumed by rx_sink_task */
+static unsigned long rx_sink_bytes = 0;
+/* Totals consumed by rx_sink_task since connection, for the load sweep */
+static uint32_t rx_sink_bytes_total = 0;
+static uint32_t rx_sink_pkts_total = 0;
 /* For 1 second timer*/
 static cyhal_timer_t get_throughput_timer_obj,app_millisec_timer_obj;
 const cyhal_timer_cfg_t get_throughput_timer_cfg =
@@ -124,11 +215,45 @@ const cyhal_timer_cfg_t app_millisec_timer_cfg =
 *        Function Prototypes
 *******************************************************************************/
 static void tput_scan_led_update            (void);
+static void tput_control_lock               (void);
+static void tput_control_unlock             (void);
 static void tput_ble_app_init               (void);
 static void tput_button_interrupt_handler   (void *handler_arg,
                                             cyhal_gpio_event_t event);
 static uint16_t tput_get_write_cmd_pkt_size (uint16_t att_mtu_size);
 static wiced_bt_gatt_status_t tput_enable_disable_gatt_notification(bool notify);
+static wiced_bt_gatt_status_t tput_start_mode(tput_mode_t mode,
+                                              uint32_t settle_ms);
+static void tput_on_first_byte(void);
+static wiced_bt_gatt_status_t tput_link_setup(void);
+static void tput_link_teardown(uint8_t reason, uint32_t lost_bytes);
+static wiced_bt_gatt_status_t tput_send_blob_chunk(void);
+static wiced_bt_gatt_status_t tput_send_coalesced_packet(void);
+static void tput_generate_records(void);
+static void tput_rx_sink_on_data(void *p_ctx);
+static void tput_log_result(uint32_t rx_kbps, uint32_t tx_kbps,
+                            uint32_t rx_overruns);
+static uint32_t tput_get_ceiling_kbps(bool rx);
+static bool tput_get_link_model(bool rx, tput_model_result_t *p_result);
+static tput_model_phy_t tput_get_model_phy(uint8_t hci_phy);
+#if TPUT_EXT_SCAN_ENABLE
+static void tput_ext_scan_configure(void);
+#endif
+static void tput_update_conn_evt_stats(void);
+static void tput_update_rx_jitter_stats(tput_rx_jitter_stats_t *p_stats);
+static void tput_update_adapt(uint32_t goodput_kbps);
+#if TPUT_EATT_ENABLE
+static void tput_update_eatt_stats(void);
+#endif
+static void tput_update_relay_stats(void);
+#if TPUT_BRIDGE_ENABLE
+static void tput_update_bridge_stats(void);
+#endif
+#if TPUT_STREAM_ENABLE
+static void tput_stream_wake(void);
+static wiced_bt_gatt_status_t tput_send_stream_msg(tput_stream_id_t stream);
+static void tput_update_stream_stats(uint32_t bulk_kbps);
+#endif
 static void tput_scan_result_cback  (wiced_bt_ble_scan_results_t *p_scan_result,
                                     uint8_t *p_adv_data);
 void tput_app_throughput_timer_callb        (void *callback_arg,
@@ -156,7 +281,8 @@ static cyhal_gpio_callback_data_t cyhal_gpio_callback_data =
 * Function Name: app_bt_free_buffer()
 ********************************************************************************
 * Summary:
-*   This function frees up the memory buffer
+*   This function frees up the memory buffer allocated with
+*   app_bt_alloc_buffer()
 *
 * Parameters:
 *   uint8_t *p_data: Pointer to the buffer to be free
@@ -167,7 +293,7 @@ static cyhal_gpio_callback_data_t cyhal_gpio_callback_data =
 *******************************************************************************/
 void app_bt_free_buffer(uint8_t *p_buf)
 {
-    vPortFree(p_buf);
+    tput_mem_free(p_buf);
 }
 
 
@@ -175,7 +301,8 @@ void app_bt_free_buffer(uint8_t *p_buf)
 * Function Name: app_bt_alloc_buffer()
 ********************************************************************************
 * Summary:
-*   This function allocates a memory buffer
+*   This function allocates a memory buffer, from the static buffer pool
+*   when TPUT_STATIC_ALLOC is set (see tput_mem.h)
 *
 * Parameters:
 *   int len : Length to allocate
@@ -186,7 +313,7 @@ void app_bt_free_buffer(uint8_t *p_buf)
 *******************************************************************************/
 void* app_bt_alloc_buffer(int len)
 {
-    return pvPortMalloc(len);
+    return tput_mem_alloc((uint32_t)len);
 }
 
 
@@ -213,6 +340,10 @@ wiced_result_t app_bt_management_callback(wiced_bt_management_evt_t event,
     wiced_bt_device_address_t bda = {0};
     wiced_bt_ble_scan_type_t p_scan_type ;
 
+    TPUT_TRACE_BEGIN(TPUT_TRACE_MGMT_CB, event);
+#if TPUT_EVREC_ENABLE
+    tput_evrec_on_mgmt_event(event, p_event_data);
+#endif
     switch (event)
     {
     case BTM_ENABLED_EVT:
@@ -261,13 +392,35 @@ wiced_result_t app_bt_management_callback(wiced_bt_management_evt_t event,
         break;
 
     case BTM_BLE_PHY_UPDATE_EVT:
+        tput_rx_jitter_link_event(TPUT_RX_LINK_PHY_UPDATE, tput_time_us());
         conn_state_info.rx_phy = p_event_data->ble_phy_update_event.rx_phy;
         conn_state_info.tx_phy = p_event_data->ble_phy_update_event.tx_phy;
-        printf("Selected RX PHY - %dM\nSelected TX PHY - %dM\nPeer address = ",
-                                conn_state_info.rx_phy,conn_state_info.tx_phy);
+        tput_bringup_mark(TPUT_BRINGUP_PHY);
+        printf("Selected RX PHY - %s\nSelected TX PHY - %s\nPeer address = ",
+               tput_phy_name(tput_get_model_phy(conn_state_info.rx_phy)),
+               tput_phy_name(tput_get_model_phy(conn_state_info.tx_phy)));
+        break;
+
+    case BTM_BLE_DATA_LENGTH_UPDATE_EVENT:
+        tput_rx_jitter_link_event(TPUT_RX_LINK_DATA_LENGTH_UPDATE,
+                                  tput_time_us());
+        conn_state_info.max_tx_octets =
+                    p_event_data->ble_data_length_update_event.max_tx_octets;
+        conn_state_info.max_rx_octets =
+                    p_event_data->ble_data_length_update_event.max_rx_octets;
+        conn_state_info.max_tx_time =
+                    p_event_data->ble_data_length_update_event.max_tx_time;
+        conn_state_info.max_rx_time =
+                    p_event_data->ble_data_length_update_event.max_rx_time;
+        tput_bringup_mark(TPUT_BRINGUP_DATA_LENGTH);
+        printf("Data length: TX %u bytes %u us, RX %u bytes %u us\n",
+               conn_state_info.max_tx_octets, conn_state_info.max_tx_time,
+               conn_state_info.max_rx_octets, conn_state_info.max_rx_time);
         break;
 
     case BTM_BLE_CONNECTION_PARAM_UPDATE:
+        tput_rx_jitter_link_event(TPUT_RX_LINK_CONN_PARAM_UPDATE,
+                                  tput_time_us());
         /* Connection parameters updated */
         if(WICED_BT_SUCCESS == p_event_data->ble_connection_param_update.status)
         {
@@ -286,11 +439,16 @@ wiced_result_t app_bt_management_callback(wiced_bt_management_evt_t event,
         break;
 
     default:
-        printf("Unhandled Bluetooth Management Event: 0x%x %s\n",
+        /* Pairing, encryption and key storage (tput_security.c) */
+        if (!tput_security_on_mgmt_event(event, p_event_data, &status))
+        {
+            printf("Unhandled Bluetooth Management Event: 0x%x %s\n",
                                             event, get_bt_event_name(event));
+        }
         break;
     }
 
+    TPUT_TRACE_END(TPUT_TRACE_MGMT_CB);
     return status;
 }
 
@@ -328,11 +486,11 @@ static void tput_ble_app_init(void)
 
     /*Initialize the data packet to be sent as GATT notification to the peer
       device */
-    for(uint8_t index = 0; index < WRITE_DATA_SIZE; index++)
+    for(uint16_t index = 0; index < WRITE_DATA_SIZE; index++)
     {
-        write_data_seq1[index] = index;
+        write_data_seq1[index] = (uint8_t)index;
     }
-    for(uint8_t index = 0; index < WRITE_DATA_SIZE; index++)
+    for(uint16_t index = 0; index < WRITE_DATA_SIZE; index++)
     {
         write_data_seq2[index] = value_initialize;
         value_initialize--;
@@ -384,6 +542,36 @@ static void tput_ble_app_init(void)
                             TIMER_INTERRUPT_PRIORITY,
                             true);
 
+    /* Microsecond timestamps of packets, for the connection event histogram */
+    tput_time_init();
+
+    /* Continue the result log after the records of previous boots */
+    tput_result_log_init();
+#if TPUT_RESULT_LOG_DUMP_AT_BOOT
+    tput_result_log_dump();
+#endif
+
+#if TPUT_RX_SINK_ENABLE
+    /* Hand received notification payloads to rx_sink_task */
+    {
+        static const tput_rx_sink_t rx_sink =
+        {
+            .on_data = tput_rx_sink_on_data,
+            .on_backpressure = NULL,
+            .p_ctx = NULL
+        };
+        tput_rx_ring_register_sink(&rx_sink);
+    }
+#if TPUT_BRIDGE_ENABLE
+    tput_bridge_init();
+#endif
+#endif
+
+#if TPUT_STREAM_ENABLE
+    /* Queued control and latency messages wake up send_gatt_write_task */
+    tput_stream_init(tput_stream_wake);
+#endif
+
     /* Initialize GPIO for button interrupt*/
     rslt = cyhal_gpio_init(CYBSP_USER_BTN,
                             CYHAL_GPIO_DIR_INPUT,
@@ -404,14 +592,21 @@ static void tput_ble_app_init(void)
                             GPIO_INTERRUPT_PRIORITY,
                             true);
 
-    /* Disable pairing for this application */
-    wiced_bt_set_pairable_mode(WICED_FALSE, 0);
+    /* Pairing is only allowed in the encrypted link mode */
+    tput_security_init();
 
     /* Register with BT stack to receive GATT callback */
     status = wiced_bt_gatt_register(ble_app_gatt_event_handler);
     printf("GATT event Handler registration status: %s \n",
                                 get_bt_gatt_status_name(status));
 
+#if TPUT_EATT_ENABLE
+    tput_eatt_init();
+#endif
+#if TPUT_EVREC_ENABLE
+    tput_evrec_init(ble_app_gatt_event_handler, app_bt_management_callback);
+#endif
+
     /* Initialize GATT Database */
     status = wiced_bt_gatt_db_init(gatt_database, gatt_database_len, NULL);
     printf("GATT database initialization status: %s \n",
@@ -439,6 +634,15 @@ static wiced_bt_gatt_status_t ble_app_gatt_event_handler(wiced_bt_gatt_evt_t eve
                                     wiced_bt_gatt_event_data_t *p_event_data)
 {
     wiced_bt_gatt_status_t status = WICED_BT_GATT_SUCCESS;
+    uint16_t blob_chunk_len = 0;
+    uint32_t timestamp_us;
+    pfn_free_buffer_t pfn_free;
+    tput_mode_t resume_mode;
+
+    TPUT_TRACE_BEGIN(TPUT_TRACE_GATT_CB, event);
+#if TPUT_EVREC_ENABLE
+    tput_evrec_on_gatt_event(event, p_event_data);
+#endif
     /* Call the appropriate callback function based on the GATT event type, and
      * pass the relevant event parameters to the callback function */
     switch (event)
@@ -464,6 +668,32 @@ static wiced_bt_gatt_status_t ble_app_gatt_event_handler(wiced_bt_gatt_evt_t eve
         if (tput_service_found)
         {
             printf("Custom throughput service found\n");
+            tput_bringup_mark(TPUT_BRINGUP_DISCOVERY);
+#if TPUT_STREAM_ENABLE
+            tput_stream_reset(tput_service_handle);
+#endif
+            if (replaying)
+            {
+                /* The recording holds the mode changes that followed */
+            }
+            else if (tput_reconnect_get_resume_mode(&resume_mode))
+            {
+                /* The link is new, so nothing is in flight */
+                tput_start_mode(resume_mode, 0u);
+            }
+#if (TPUT_AUTO_START_MODE > 0)
+            else
+            {
+#if TPUT_PIPELINED_BRINGUP
+                /* Nothing is in flight yet, so the CCCD is written right
+                 * away */
+                tput_start_mode((tput_mode_t)(TPUT_AUTO_START_MODE - 1), 0u);
+#else
+                auto_start_pending = true;
+                xTaskNotifyGive(ble_button_task_handle);
+#endif
+            }
+#endif
         }
         else
         {
@@ -475,14 +705,23 @@ static wiced_bt_gatt_status_t ble_app_gatt_event_handler(wiced_bt_gatt_evt_t eve
         switch (p_event_data->operation_complete.op)
         {
         case GATTC_OPTYPE_WRITE_WITH_RSP:
+#if TPUT_EATT_ENABLE
+            /* Write requests on EATT bearers */
+            if (tput_eatt_on_write_rsp(p_event_data->operation_complete.conn_id,
+                                    p_event_data->operation_complete.status))
+            {
+                break;
+            }
+#endif
         /*Check if GATT operation of enable/disable notification is success.*/
             if ((p_event_data->operation_complete.response_data.handle ==
                         (tput_service_handle + GATT_CCCD_HANDLE)) &&
             (WICED_BT_GATT_SUCCESS == p_event_data->operation_complete.status))
             {
                 printf("Notifications %s\n",(enable_cccd)?"enabled":"disabled");
+                tput_bringup_mark(TPUT_BRINGUP_MODE);
                 /* Start msec timer only for GATT writes */
-                if (gatt_write_tx)
+                if (gatt_write_tx && !replaying)
                 {
                     /* Clear GATT Tx packets */
                     gatt_notif_rx_bytes = 0;
@@ -503,23 +742,96 @@ static wiced_bt_gatt_status_t ble_app_gatt_event_handler(wiced_bt_gatt_evt_t eve
             break;
 
         case GATTC_OPTYPE_WRITE_NO_RSP:
-            if ((p_event_data->operation_complete.response_data.handle ==
-                    (tput_service_handle + GATT_WRITE_HANDLE)) &&
-            (WICED_BT_GATT_SUCCESS == p_event_data->operation_complete.status))
+            /* Relayed writes are accounted for when transmitted */
+            if (tput_relay_is_busy())
             {
-                gatt_write_tx_bytes += packet_size;
+                break;
+            }
+#if TPUT_STREAM_ENABLE
+            /* Control and latency messages are accounted for by their
+             * stream, and leave the in-flight window like the others */
+            if (TPUT_STREAM_BULK != tput_stream_on_complete(
+                                    WICED_BT_GATT_SUCCESS ==
+                                    p_event_data->operation_complete.status))
+            {
+                tput_cwnd_on_complete();
+                break;
+            }
+#endif
+            if (p_event_data->operation_complete.response_data.handle ==
+                    (tput_service_handle + GATT_WRITE_HANDLE))
+            {
+                /* Every completed write command leaves the in-flight window.
+                 * Blob chunks complete in order and may be shorter than
+                 * packet_size */
+                tput_cwnd_on_complete();
+                blob_chunk_len = tput_blob_on_chunk_complete(
+                                            WICED_BT_GATT_SUCCESS ==
+                                    p_event_data->operation_complete.status);
+                /* Coalesced packets are accounted for when sent, as their
+                 * length varies */
+                if ((WICED_BT_GATT_SUCCESS ==
+                                    p_event_data->operation_complete.status) &&
+                    (GATT_RECORDS_CTOS != mode_flag))
+                {
+                    blob_chunk_len = (blob_chunk_len) ? blob_chunk_len :
+                                                        packet_size;
+                    gatt_write_tx_bytes += blob_chunk_len;
+                    gatt_write_tx_total += blob_chunk_len;
+                }
+                if (WICED_BT_GATT_SUCCESS ==
+                                    p_event_data->operation_complete.status)
+                {
+                    tput_conn_evt_on_packet(tput_time_us());
+                    if (!tput_bringup_is_complete())
+                    {
+                        tput_on_first_byte();
+                    }
+                }
+                else
+                {
+                    gatt_write_tx_failures++;
+                    gatt_write_tx_failures_total++;
+                }
+                tput_adapt_on_write_complete(WICED_BT_GATT_SUCCESS ==
+                                    p_event_data->operation_complete.status);
             }
             break;
 
         case GATTC_OPTYPE_NOTIFICATION:
             /* Receive GATT Notifications from server */
             gatt_notif_rx_bytes += p_event_data->operation_complete.response_data.att_value.len;
+            gatt_notif_rx_total += p_event_data->operation_complete.response_data.att_value.len;
+            gatt_notif_rx_pkts_total++;
+            timestamp_us = tput_time_us();
+            tput_conn_evt_on_packet(timestamp_us);
+            tput_rx_jitter_on_notification(timestamp_us);
+            if (!tput_bringup_is_complete())
+            {
+                tput_on_first_byte();
+            }
+            /* The payload is only valid during this event. If a sink is
+             * registered, copy it once into the RX ring, from where the sink
+             * processes it in place */
+            if (tput_rx_ring_has_sink())
+            {
+                tput_rx_ring_put(p_event_data->operation_complete.conn_id,
+                    p_event_data->operation_complete.response_data.att_value.p_data,
+                    p_event_data->operation_complete.response_data.att_value.len);
+            }
+            /* Synthetic processing load, when run inline (tput_load.h) */
+            tput_load_run(TPUT_LOAD_INLINE);
             break;
 
         case GATTC_OPTYPE_CONFIG_MTU:
             conn_state_info.mtu = p_event_data->operation_complete.response_data.mtu;
             printf("Negotiated MTU Size: %d\n", conn_state_info.mtu);
+            tput_bringup_mark(TPUT_BRINGUP_MTU);
             packet_size = tput_get_write_cmd_pkt_size(conn_state_info.mtu);
+            if (replaying)
+            {
+                break;
+            }
 
             /* Send GATT service discovery request */
             wiced_bt_gatt_discovery_param_t gatt_discovery_setup = {0};
@@ -544,8 +856,15 @@ static wiced_bt_gatt_status_t ble_app_gatt_event_handler(wiced_bt_gatt_evt_t eve
     case GATT_CONGESTION_EVT:
         if(!p_event_data->congestion.congested)
         {
+            tput_cwnd_on_uncongested();
+            tput_rx_jitter_link_pending(TPUT_RX_LINK_TX_CONGESTED, false);
             xTaskNotifyGiveIndexed(send_gatt_write_task_handle,
                                     TASK_NOTIFY_NO_GATT_CONGESTION);
+            /* Resume relaying the payloads held back */
+            if (tput_relay_is_running())
+            {
+                xTaskNotifyGive(rx_sink_task_handle);
+            }
         }
         break;
     case GATT_GET_RESPONSE_BUFFER_EVT:
@@ -560,12 +879,20 @@ static wiced_bt_gatt_status_t ble_app_gatt_event_handler(wiced_bt_gatt_evt_t eve
         break;
     case GATT_APP_BUFFER_TRANSMITTED_EVT:
     {
+        /* Dynamically allocated buffers carry the function that frees them
+         * as context, static buffers carry NULL */
+        pfn_free = (pfn_free_buffer_t)p_event_data->buffer_xmitted.p_app_ctxt;
+        if (NULL != pfn_free)
+        {
+            pfn_free(p_event_data->buffer_xmitted.p_app_data);
+        }
         break;
     }
     default:
         status = WICED_BT_GATT_SUCCESS;
         break;
     }
+    TPUT_TRACE_END(TPUT_TRACE_GATT_CB);
     return status;
 }
 
@@ -608,555 +935,2892 @@ static void tput_button_interrupt_handler(void *handler_arg,
  ******************************************************************************/
 void ble_button_task(void *pvParam)
 {
-    wiced_result_t status = WICED_BT_SUCCESS;
-    wiced_bt_gatt_status_t gatt_status;
+    uint32_t wait_ms;
+
     while (1)
     {
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
-        if (!conn_state_info.conn_id)
+        /* Wakes up for the next reconnection step, if one is pending */
+        wait_ms = tput_reconnect_poll();
+        if (!ulTaskNotifyTake(pdTRUE, (wait_ms) ? pdMS_TO_TICKS(wait_ms) :
+                                                  portMAX_DELAY))
+        {
+            continue;
+        }
+        if (reconnect_pending)
+        {
+            /* The link was lost, start the reconnection attempts */
+            reconnect_pending = false;
+        }
+        else if (auto_start_pending)
+        {
+            /* Sequential bring-up: the service was discovered */
+            auto_start_pending = false;
+            if (conn_state_info.conn_id)
+            {
+                tput_set_mode((tput_mode_t)(TPUT_AUTO_START_MODE - 1));
+            }
+        }
+        else if (!conn_state_info.conn_id)
         {
+            /* The user takes over from a recovery in progress */
+            tput_reconnect_cancel();
             if (scan_flag)
             {
-                /* Start scan */
-                status = wiced_bt_ble_scan(BTM_BLE_SCAN_TYPE_HIGH_DUTY, true,
-                                           tput_scan_result_cback);
-                if ((WICED_BT_PENDING != status) && (WICED_BT_BUSY != status))
-                {
-                    printf("Error: Starting scan failed. Error code: %d\n",status);
-                    /* Switch off the scan LED */
-                    app_bt_scan_conn_state = APP_BT_SCAN_OFF_CONN_OFF;
-                    tput_scan_led_update();
-                }
+                tput_scan_start();
             }
         }
         else
         {
             /* After connection pressing the user button will change the
             * throughput modes as follows :
-            * GATT_Notif_StoC -> GATT_Write_CtoS -> GATT_NotifandWrite -> Roll
-            * back to GATT_Notif_StoC
-            */
-
-            /* Stop ongoing GATT writes when enabling/disabling server
-            * notification ,to prevent command failure due to GATT congestion
-            * that may occur .The timer will be enabled on GATT event callback
-            * based on the status of the GATT operation.
+            * GATT_Notif_StoC -> GATT_Write_CtoS -> GATT_NotifandWrite ->
+            * GATT_Blob_CtoS -> GATT_Records_CtoS -> Roll back to
+            * GATT_Notif_StoC
             */
-            if (CY_RSLT_SUCCESS != cyhal_timer_stop(&app_millisec_timer_obj))
-            {
-                 printf("Get millisec timer stop failed !\n");
-                 CY_ASSERT(0);
-            }
-            gatt_write_tx_bytes = 0;
+            tput_set_mode((mode_flag == TPUT_MODE_LAST) ?
+                          GATT_NOTIF_STOC :
+                          (tput_mode_t)(mode_flag + 1u));
+        }
+    }
+}
 
-            /* Change data transfer modes upon interrupt. Based on the current
-            * mode,set flags to enable/disable notifications and set/clear GATT
-            * write flag
-            */
-            mode_flag = (mode_flag == GATT_NOTIFANDWRITE) ?
-                        GATT_NOTIF_STOC :
-                        (tput_mode_t)(mode_flag + 1u);
-            switch (mode_flag)
-            {
-            case GATT_NOTIF_STOC:
-                enable_cccd = true;
-                gatt_write_tx = false;
-                break;
+/*******************************************************************************
+ * Function Name: tput_control_init
+ *******************************************************************************
+ * Summary:
+ *  Creates the lock of the control functions. Must be called before the
+ *  tasks that use them are created.
+ *
+ * Parameters:
+ *  None
+ *
+ * Return:
+ *  None
+ *
+ ******************************************************************************/
+void tput_control_init(void)
+{
+    control_mutex = xSemaphoreCreateRecursiveMutexStatic(&control_mutex_buf);
+}
 
-            case GATT_WRITE_CTOS:
-                enable_cccd = false;
-                gatt_write_tx = true;
-                break;
+/*******************************************************************************
+ * Function Name: tput_control_lock
+ *******************************************************************************
+ * Summary:
+ *  Takes the lock of the control functions, waiting for the task holding it.
+ *
+ * Parameters:
+ *  None
+ *
+ * Return:
+ *  None
+ *
+ ******************************************************************************/
+static void tput_control_lock(void)
+{
+    CY_ASSERT(NULL != control_mutex);
+    xSemaphoreTakeRecursive(control_mutex, portMAX_DELAY);
+}
 
-            case GATT_NOTIFANDWRITE:
-                enable_cccd = true;
-                gatt_write_tx = true;
-                break;
+/*******************************************************************************
+ * Function Name: tput_control_unlock
+ *******************************************************************************
+ * Summary:
+ *  Gives back the lock of the control functions.
+ *
+ * Parameters:
+ *  None
+ *
+ * Return:
+ *  None
+ *
+ ******************************************************************************/
+static void tput_control_unlock(void)
+{
+    xSemaphoreGiveRecursive(control_mutex);
+}
 
-            default:
-                printf("Invalid Data Transfer Mode\n");
-                break;
-            }
-            /*Delay added to avoid the failure of notification enable packet*/
-            vTaskDelay(2000);
-            gatt_status = tput_enable_disable_gatt_notification(enable_cccd);
-            if (WICED_BT_GATT_SUCCESS != gatt_status)
-            {
-                printf("Enable/Disable notification failed: %d\n\r",gatt_status);
-            }
-        }
+/*******************************************************************************
+ * Function Name: tput_scan_start
+ *******************************************************************************
+ * Summary:
+ *  Starts scanning for the throughput server. The first device advertising
+ *  the name "TPUT" is connected to.
+ *
+ * Parameters:
+ *  None
+ *
+ * Return:
+ *  wiced_result_t : WICED_BT_PENDING or WICED_BT_BUSY if the scan was started
+ *
+ ******************************************************************************/
+wiced_result_t tput_scan_start(void)
+{
+    wiced_result_t status;
+
+    tput_control_lock();
+#if TPUT_EXT_SCAN_ENABLE
+    tput_ext_scan_configure();
+#endif
+    status = wiced_bt_ble_scan(BTM_BLE_SCAN_TYPE_HIGH_DUTY, true,
+                               tput_scan_result_cback);
+    if ((WICED_BT_PENDING != status) && (WICED_BT_BUSY != status))
+    {
+        printf("Error: Starting scan failed. Error code: %d\n",status);
+        /* Switch off the scan LED */
+        app_bt_scan_conn_state = APP_BT_SCAN_OFF_CONN_OFF;
+        tput_scan_led_update();
     }
+    tput_control_unlock();
+    return status;
 }
 
 /*******************************************************************************
-* Function Name: tput_scan_result_cback()
-********************************************************************************
-* Summary:
-*   This function is registered as a callback to handle the scan results.
-*   When the desired device is found, it will try to establish connection with
-*   that device.
-*
-* Parameters:
-*   wiced_bt_ble_scan_results_t *p_scan_result: Details of the new device found.
-*   uint8_t                     *p_adv_data      : Advertisement data.
-*
-* Return:
-*   None
-*
-*******************************************************************************/
-static void tput_scan_result_cback(wiced_bt_ble_scan_results_t *p_scan_result,
-                                    uint8_t *p_adv_data)
+ * Function Name: tput_scan_stop
+ *******************************************************************************
+ * Summary:
+ *  Stops scanning.
+ *
+ * Parameters:
+ *  None
+ *
+ * Return:
+ *  wiced_result_t : Status from wiced_bt_ble_scan()
+ *
+ ******************************************************************************/
+wiced_result_t tput_scan_stop(void)
 {
-    wiced_result_t status = WICED_BT_SUCCESS;
-    uint8_t length = 0u;
-    uint8_t *p_data = NULL;
-    uint8_t server_device_name[5] = {'T', 'P', 'U', 'T', '\0'};
-
-    if (p_scan_result)
-    {
-        p_data = wiced_bt_ble_check_advertising_data(p_adv_data,
-                                            BTM_BLE_ADVERT_TYPE_NAME_COMPLETE,
-                                                    &length);
+    wiced_result_t status;
 
-        if (p_data != NULL)
-        {
-            /* Check if the peer device's name is "TPUT" */
-            if ((length = strlen((const char *)server_device_name)) &&
-                (memcmp(p_data, (uint8_t *)server_device_name, length) == 0))
-            {
-                printf("Scan completed\n Found peer device with BDA:\n");
-                print_bd_address(p_scan_result->remote_bd_addr);
-                scan_flag = false;
+    tput_control_lock();
+    status = wiced_bt_ble_scan(BTM_BLE_SCAN_TYPE_NONE, true,
+                               tput_scan_result_cback);
+    tput_control_unlock();
+    return status;
+}
 
-                /* Device found. Stop scan. */
-                if ((status = wiced_bt_ble_scan(BTM_BLE_SCAN_TYPE_NONE, true,
-                                                tput_scan_result_cback)) != 0)
-                {
-                    printf("Scan off status %d\n", status);
-                }
+/*******************************************************************************
+ * Function Name: tput_connect
+ *******************************************************************************
+ * Summary:
+ *  Connects to a server by address, without scanning for it first. A
+ *  running scan is stopped.
+ *
+ * Parameters:
+ *  wiced_bt_device_address_t bd_addr       : Address of the server
+ *  wiced_bt_ble_address_type_t addr_type   : BLE_ADDR_PUBLIC or
+ *                                            BLE_ADDR_RANDOM
+ *
+ * Return:
+ *  bool : true if the connection request was sent
+ *
+ ******************************************************************************/
+bool tput_connect(wiced_bt_device_address_t bd_addr,
+                  wiced_bt_ble_address_type_t addr_type)
+{
+    bool sent = false;
 
-                /* Initiate the connection */
-                if (wiced_bt_gatt_le_connect(p_scan_result->remote_bd_addr,
-                                             p_scan_result->ble_addr_type,
-                                             BLE_CONN_MODE_HIGH_DUTY,
-                                             WICED_TRUE) != WICED_TRUE)
-                {
-                    printf("wiced_bt_gatt_connect failed\n");
-                }
-                else
-                {
-                    printf("gatt connect request sent\n");
-                }
-            }
+    tput_control_lock();
+    if (conn_state_info.conn_id)
+    {
+        printf("Already connected\n");
+    }
+    else
+    {
+        if (APP_BT_SCAN_ON_CONN_OFF == app_bt_scan_conn_state)
+        {
+            tput_scan_stop();
+        }
+        scan_flag = false;
+
+#if TPUT_EXT_SCAN_ENABLE
+        tput_ext_scan_configure();
+#endif
+        if (wiced_bt_gatt_le_connect(bd_addr, addr_type,
+                                     BLE_CONN_MODE_HIGH_DUTY,
+                                     WICED_TRUE) != WICED_TRUE)
+        {
+            printf("wiced_bt_gatt_connect failed\n");
+        }
+        else
+        {
+            printf("gatt connect request sent\n");
+            sent = true;
         }
     }
+    tput_control_unlock();
+    return sent;
 }
 
 /*******************************************************************************
-* Function Name: ble_app_connect_callback()
-********************************************************************************
-* Summary:
-*   This callback function handles connection status changes.
-*
-* Parameters:
-*   wiced_bt_gatt_connection_status_t *p_conn_status  : Pointer to data that has
-*                                                       connection details
-*
-* Return:
-*  wiced_bt_gatt_status_t: See possible status codes in wiced_bt_gatt_status_e
-*                          in wiced_bt_gatt.h
-*
-*******************************************************************************/
-static wiced_bt_gatt_status_t ble_app_connect_callback(
-                            wiced_bt_gatt_connection_status_t *p_conn_status)
+ * Function Name: tput_connect_abandon
+ *******************************************************************************
+ * Summary:
+ *  Gives up on the connection attempts made with tput_connect(). The user
+ *  button starts scanning again.
+ *
+ * Parameters:
+ *  None
+ *
+ * Return:
+ *  None
+ *
+ ******************************************************************************/
+void tput_connect_abandon(void)
 {
-    wiced_bt_gatt_status_t status = WICED_BT_GATT_ERROR;
-
-    if (NULL != p_conn_status)
+    if (!conn_state_info.conn_id)
     {
-        if (p_conn_status->connected)
-        {
-            /* Device has connected */
-            printf("Connected : BDA ");
+        scan_flag = true;
+    }
+}
+
+/*******************************************************************************
+ * Function Name: tput_disconnect
+ *******************************************************************************
+ * Summary:
+ *  Disconnects from the server.
+ *
+ * Parameters:
+ *  None
+ *
+ * Return:
+ *  wiced_bt_gatt_status_t : Status from wiced_bt_gatt_disconnect()
+ *
+ ******************************************************************************/
+wiced_bt_gatt_status_t tput_disconnect(void)
+{
+    wiced_bt_gatt_status_t status = WICED_BT_GATT_ERROR;
+
+    tput_control_lock();
+    if (conn_state_info.conn_id)
+    {
+        status = wiced_bt_gatt_disconnect(conn_state_info.conn_id);
+    }
+    tput_control_unlock();
+    return status;
+}
+
+/*******************************************************************************
+ * Function Name: tput_set_mode
+ *******************************************************************************
+ * Summary:
+ *  Selects the data transfer mode. Based on the mode, notifications are
+ *  enabled or disabled on the server and GATT writes are started or
+ *  stopped. Blocks for 2 seconds, so it must be called from a task.
+ *
+ * Parameters:
+ *  tput_mode_t mode : Data transfer mode
+ *
+ * Return:
+ *  wiced_bt_gatt_status_t : Status of the notification enable/disable
+ *
+ ******************************************************************************/
+wiced_bt_gatt_status_t tput_set_mode(tput_mode_t mode)
+{
+    wiced_bt_gatt_status_t status;
+
+    /* The lock is held through the settle delay so that no other task
+     * changes the mode between the flags and the CCCD write */
+    tput_control_lock();
+    /*Delay added to avoid the failure of notification enable packet*/
+    status = tput_start_mode(mode, TPUT_CCCD_SETTLE_MS);
+    tput_control_unlock();
+    return status;
+}
+
+/*******************************************************************************
+ * Function Name: tput_start_mode
+ *******************************************************************************
+ * Summary:
+ *  Selects the data transfer mode, see tput_set_mode(). Waits settle_ms
+ *  after stopping the writes before writing the CCCD. With 0, does not
+ *  block and may be called from the GATT callback.
+ *
+ * Parameters:
+ *  tput_mode_t mode   : Data transfer mode
+ *  uint32_t settle_ms : Time for the stopped writes to drain
+ *
+ * Return:
+ *  wiced_bt_gatt_status_t : Status of the notification enable/disable
+ *
+ ******************************************************************************/
+static wiced_bt_gatt_status_t tput_start_mode(tput_mode_t mode,
+                                              uint32_t settle_ms)
+{
+    wiced_bt_gatt_status_t gatt_status;
+    bool keep_writes = false;
+#if TPUT_STREAM_ENABLE
+    uint8_t cccd_value[CCCD_LENGTH] = {0};
+#endif
+
+    if ((!conn_state_info.conn_id) || (mode > TPUT_MODE_LAST))
+    {
+        return WICED_BT_GATT_ERROR;
+    }
+
+#if TPUT_STREAM_ENABLE
+    /* Between the modes writing packets of packet_size, the writes keep
+     * flowing and the CCCD write goes out ahead of them on the control
+     * stream. Blob chunks and records are matched with their completions,
+     * so the writes still drain before and after those modes */
+    keep_writes = gatt_write_tx &&
+                  ((GATT_WRITE_CTOS == mode_flag) ||
+                   (GATT_NOTIFANDWRITE == mode_flag)) &&
+                  ((GATT_WRITE_CTOS == mode) || (GATT_NOTIFANDWRITE == mode));
+#endif
+
+    /* Stop ongoing GATT writes when enabling/disabling server
+    * notification ,to prevent command failure due to GATT congestion
+    * that may occur .The timer will be enabled on GATT event callback
+    * based on the status of the GATT operation.
+    */
+    if (!keep_writes)
+    {
+        if (CY_RSLT_SUCCESS != cyhal_timer_stop(&app_millisec_timer_obj))
+        {
+             printf("Get millisec timer stop failed !\n");
+             CY_ASSERT(0);
+        }
+        gatt_write_tx_bytes = 0;
+    }
+
+    /* Relayed writes share the write handle with the other modes */
+    if (GATT_NOTIF_STOC != mode)
+    {
+        tput_relay_stop();
+    }
+
+    /* Set flags to enable/disable notifications and set/clear GATT
+    * write flag based on the mode
+    */
+    mode_flag = mode;
+    switch (mode_flag)
+    {
+    case GATT_NOTIF_STOC:
+        enable_cccd = true;
+        gatt_write_tx = false;
+        break;
+
+    case GATT_WRITE_CTOS:
+        enable_cccd = false;
+        gatt_write_tx = true;
+        break;
+
+    case GATT_NOTIFANDWRITE:
+        enable_cccd = true;
+        gatt_write_tx = true;
+        break;
+
+    case GATT_BLOB_CTOS:
+        enable_cccd = false;
+        gatt_write_tx = true;
+        /* Resumes the previous transfer if the link was lost */
+        tput_blob_start();
+        break;
+
+    case GATT_RECORDS_CTOS:
+        enable_cccd = false;
+        gatt_write_tx = true;
+        tput_coalesce_init(packet_size, coalesce_deadline_ms);
+        break;
+
+    default:
+        printf("Invalid Data Transfer Mode\n");
+        break;
+    }
+    if (settle_ms && !keep_writes)
+    {
+        vTaskDelay(pdMS_TO_TICKS(settle_ms));
+    }
+#if TPUT_STREAM_ENABLE
+    if (keep_writes)
+    {
+        cccd_value[0] = enable_cccd;
+        gatt_status = tput_stream_enqueue(TPUT_STREAM_CONTROL,
+                                    tput_service_handle + GATT_CCCD_HANDLE,
+                                    true, cccd_value, CCCD_LENGTH) ?
+                      WICED_BT_GATT_SUCCESS : WICED_BT_GATT_ERROR;
+    }
+    else
+#endif
+    {
+        gatt_status = tput_enable_disable_gatt_notification(enable_cccd);
+    }
+    if (WICED_BT_GATT_SUCCESS != gatt_status)
+    {
+        printf("Enable/Disable notification failed: %d\n\r",gatt_status);
+    }
+    else
+    {
+        /* Resumed if the link is lost */
+        tput_reconnect_save_mode(mode_flag);
+    }
+    return gatt_status;
+}
+
+/*******************************************************************************
+ * Function Name: tput_on_first_byte
+ *******************************************************************************
+ * Summary:
+ *  Called for the first notification received or write sent on a
+ *  connection. Ends the bring-up timing and the link loss recovery.
+ *
+ * Parameters:
+ *  None
+ *
+ * Return:
+ *  None
+ *
+ ******************************************************************************/
+static void tput_on_first_byte(void)
+{
+    tput_bringup_mark(TPUT_BRINGUP_FIRST_BYTE);
+    if (!replaying)
+    {
+        tput_reconnect_on_first_byte();
+    }
+}
+
+/*******************************************************************************
+ * Function Name: tput_set_packet_size
+ *******************************************************************************
+ * Summary:
+ *  Overrides the GATT write packet size derived from the MTU. The size is
+ *  used by the next write; in GATT_RECORDS_CTOS mode, records are packed to
+ *  the size that was set when the mode was selected.
+ *
+ * Parameters:
+ *  uint16_t size : Packet size in bytes, at most MTU - 3 and
+ *                  GATT_WRITE_BYTES_MAX_LEN
+ *
+ * Return:
+ *  bool : true if the size was accepted
+ *
+ ******************************************************************************/
+bool tput_set_packet_size(uint16_t size)
+{
+    bool accepted = false;
+
+    tput_control_lock();
+    if ((conn_state_info.conn_id) && (0 != size) &&
+        (size <= conn_state_info.mtu - ATT_HEADER) &&
+        (size <= GATT_WRITE_BYTES_MAX_LEN))
+    {
+        packet_size = size;
+        accepted = true;
+    }
+    tput_control_unlock();
+    return accepted;
+}
+
+/*******************************************************************************
+ * Function Name: tput_set_coalesce_deadline
+ *******************************************************************************
+ * Summary:
+ *  Sets the longest time a record waits for its packet to fill in
+ *  GATT_RECORDS_CTOS mode. The deadline is used from the next time the mode
+ *  is selected.
+ *
+ * Parameters:
+ *  uint16_t deadline_ms : Deadline in milliseconds, 0 to send every
+ *                         millisecond
+ *
+ * Return:
+ *  None
+ *
+ ******************************************************************************/
+void tput_set_coalesce_deadline(uint16_t deadline_ms)
+{
+    coalesce_deadline_ms = deadline_ms;
+}
+
+/*******************************************************************************
+ * Function Name: tput_set_phy
+ *******************************************************************************
+ * Summary:
+ *  Requests a PHY change. The selected PHY is reported in
+ *  BTM_BLE_PHY_UPDATE_EVT. The event does not report the coding of the
+ *  Coded PHY, so the coding requested is assumed: S2 for
+ *  BTM_BLE_PREFER_LELR_512K, S8 otherwise.
+ *
+ * Parameters:
+ *  wiced_bt_ble_host_phy_preferences_t phys : BTM_BLE_PREFER_1M_PHY,
+ *                                             BTM_BLE_PREFER_2M_PHY or
+ *                                             BTM_BLE_PREFER_LELR_PHY
+ *  wiced_bt_ble_lecoded_phy_preferences_t phy_opts : Coding of the Coded
+ *                                             PHY, BTM_BLE_PREFER_NO_LELR,
+ *                                             BTM_BLE_PREFER_LELR_512K (S2)
+ *                                             or BTM_BLE_PREFER_LELR_125K (S8)
+ *
+ * Return:
+ *  wiced_bt_dev_status_t : Status from wiced_bt_ble_set_phy()
+ *
+ ******************************************************************************/
+wiced_bt_dev_status_t tput_set_phy(wiced_bt_ble_host_phy_preferences_t phys,
+                            wiced_bt_ble_lecoded_phy_preferences_t phy_opts)
+{
+    wiced_bt_ble_phy_preferences_t phy_preferences = {0};
+    wiced_bt_dev_status_t result;
+
+    if (!conn_state_info.conn_id)
+    {
+        return WICED_BT_ERROR;
+    }
+    memcpy(phy_preferences.remote_bd_addr, conn_state_info.remote_addr,
+           BD_ADDR_LEN);
+    phy_preferences.tx_phys = phys;
+    phy_preferences.rx_phys = phys;
+    phy_preferences.phy_opts = phy_opts;
+    result = wiced_bt_ble_set_phy(&phy_preferences);
+    if (WICED_BT_SUCCESS == result)
+    {
+        tput_rx_jitter_link_pending(TPUT_RX_LINK_PHY_UPDATE, true);
+        if (BTM_BLE_PREFER_LELR_PHY & phys)
+        {
+            coded_phy_opts = phy_opts;
+        }
+    }
+    return result;
+}
+
+#if TPUT_EXT_SCAN_ENABLE
+/*******************************************************************************
+ * Function Name: tput_set_scan_phys
+ *******************************************************************************
+ * Summary:
+ *  Selects the primary PHYs of the next scans and connections: the 1M and
+ *  LE Coded PHYs, or only the LE Coded PHY to reach a server out of 1M
+ *  range. A connection made on the Coded PHY stays on it until a PHY
+ *  update.
+ *
+ * Parameters:
+ *  bool coded_only : true to scan and connect only on the LE Coded PHY
+ *
+ * Return:
+ *  None
+ *
+ ******************************************************************************/
+void tput_set_scan_phys(bool coded_only)
+{
+    scan_coded_only = coded_only;
+}
+#endif
+
+/*******************************************************************************
+ * Function Name: tput_set_conn_interval
+ *******************************************************************************
+ * Summary:
+ *  Requests new connection interval limits. The interval chosen by the
+ *  server is reported in BTM_BLE_CONNECTION_PARAM_UPDATE.
+ *
+ * Parameters:
+ *  uint16_t min_interval : Minimum interval in units of 1.25 ms
+ *  uint16_t max_interval : Maximum interval in units of 1.25 ms
+ *
+ * Return:
+ *  bool : true if the request was sent
+ *
+ ******************************************************************************/
+bool tput_set_conn_interval(uint16_t min_interval, uint16_t max_interval)
+{
+    bool sent = false;
+
+    tput_control_lock();
+    if ((conn_state_info.conn_id) && (min_interval <= max_interval) &&
+        (WICED_TRUE ==
+            wiced_bt_l2cap_update_ble_conn_params(conn_state_info.remote_addr,
+                                                  min_interval, max_interval,
+                                                  TPUT_CONN_LATENCY,
+                                                  TPUT_SUPERVISION_TIMEOUT)))
+    {
+        tput_rx_jitter_link_pending(TPUT_RX_LINK_CONN_PARAM_UPDATE, true);
+        sent = true;
+    }
+    tput_control_unlock();
+    return sent;
+}
+
+/*******************************************************************************
+ * Function Name: tput_clear_stats
+ *******************************************************************************
+ * Summary:
+ *  Clears the throughput counters and the statistics of the RX ring and the
+ *  coalescing layer.
+ *
+ * Parameters:
+ *  None
+ *
+ * Return:
+ *  None
+ *
+ ******************************************************************************/
+void tput_clear_stats(void)
+{
+    gatt_notif_rx_bytes = 0;
+    gatt_write_tx_bytes = 0;
+    gatt_write_tx_failures = 0;
+    gatt_notif_rx_total = 0;
+    gatt_write_tx_total = 0;
+    gatt_write_tx_failures_total = 0;
+    gatt_notif_rx_pkts_total = 0;
+    rx_sink_bytes = 0;
+    rx_sink_bytes_total = 0;
+    rx_sink_pkts_total = 0;
+    tput_rx_ring_clear_stats();
+    tput_coalesce_clear_stats();
+    tput_phy_clear_stats();
+    tput_security_clear_stats();
+    tput_adapt_clear_stats();
+#if TPUT_STREAM_ENABLE
+    tput_stream_clear_stats();
+#endif
+}
+
+/*******************************************************************************
+ * Function Name: tput_print_status
+ *******************************************************************************
+ * Summary:
+ *  Prints the connection state and the link parameters.
+ *
+ * Parameters:
+ *  None
+ *
+ * Return:
+ *  None
+ *
+ ******************************************************************************/
+void tput_print_status(void)
+{
+    if (!conn_state_info.conn_id)
+    {
+        printf("Not connected, %s\n",
+               (APP_BT_SCAN_ON_CONN_OFF == app_bt_scan_conn_state) ?
+               "scanning" : "not scanning");
+        return;
+    }
+    printf("Connected to ");
+    print_bd_address(conn_state_info.remote_addr);
+    printf("Connection ID %u, MTU %u, interval %.2f ms, TX PHY %s, "
+           "RX PHY %s\n",
+           conn_state_info.conn_id, conn_state_info.mtu,
+           conn_state_info.conn_interval,
+           tput_phy_name(tput_get_model_phy(conn_state_info.tx_phy)),
+           tput_phy_name(tput_get_model_phy(conn_state_info.rx_phy)));
+    printf("Mode %u, packet size %u, notifications %s, writes %s\n",
+           mode_flag + 1u, packet_size, enable_cccd ? "on" : "off",
+           gatt_write_tx ? "on" : "off");
+    tput_bringup_print();
+}
+
+/*******************************************************************************
+ * Function Name: tput_get_rx_totals
+ *******************************************************************************
+ * Summary:
+ *  Reads the notification bytes and packets received, and consumed by
+ *  rx_sink_task, since the connection was established. Used to measure the
+ *  effect of the synthetic load (tput_load.c).
+ *
+ * Parameters:
+ *  tput_rx_totals_t *p_totals : Totals read
+ *
+ * Return:
+ *  bool : false if not connected or notifications are off
+ *
+ ******************************************************************************/
+bool tput_get_rx_totals(tput_rx_totals_t *p_totals)
+{
+    if (!conn_state_info.conn_id || !enable_cccd)
+    {
+        return false;
+    }
+    taskENTER_CRITICAL();
+    p_totals->rx_bytes = gatt_notif_rx_total;
+    p_totals->rx_pkts = gatt_notif_rx_pkts_total;
+    p_totals->consumed_bytes = rx_sink_bytes_total;
+    p_totals->consumed_pkts = rx_sink_pkts_total;
+    taskEXIT_CRITICAL();
+    return true;
+}
+
+/*******************************************************************************
+ * Function Name: tput_set_relay
+ *******************************************************************************
+ * Summary:
+ *  Starts or stops relaying every notification received as a GATT write
+ *  command (see tput_relay.c). Only in data transfer mode 1, where the
+ *  write handle is otherwise unused.
+ *
+ * Parameters:
+ *  bool on          : true to start relaying
+ *  uint16_t conn_id : Connection the writes are sent on, 0 for the
+ *                     connection the notifications are received on
+ *
+ * Return:
+ *  bool : false if not connected, not in mode 1, or the RX ring is disabled
+ *
+ ******************************************************************************/
+bool tput_set_relay(bool on, uint16_t conn_id)
+{
+    if (!on)
+    {
+        tput_relay_stop();
+        return true;
+    }
+    if (!conn_state_info.conn_id || !tput_service_handle ||
+        (GATT_NOTIF_STOC != mode_flag) || !tput_rx_ring_has_sink())
+    {
+        return false;
+    }
+    tput_relay_clear_stats();
+    tput_relay_start(conn_id ? conn_id : conn_state_info.conn_id,
+                     tput_service_handle + GATT_WRITE_HANDLE);
+    return true;
+}
+
+#if TPUT_EVREC_ENABLE
+/*******************************************************************************
+ * Function Name: tput_record_events
+ *******************************************************************************
+ * Summary:
+ *  Starts or stops recording the GATT and management events (see
+ *  tput_evrec.c). Recording starts while disconnected, so that the
+ *  recording includes the connection.
+ *
+ * Parameters:
+ *  bool on : true to start a new recording
+ *
+ * Return:
+ *  bool : false if connected
+ *
+ ******************************************************************************/
+bool tput_record_events(bool on)
+{
+    if (!on)
+    {
+        tput_evrec_stop();
+        return true;
+    }
+    if (conn_state_info.conn_id)
+    {
+        return false;
+    }
+    tput_evrec_start();
+    return true;
+}
+
+/*******************************************************************************
+ * Function Name: tput_replay_events
+ *******************************************************************************
+ * Summary:
+ *  Replays the recorded events to the event handlers (see tput_evrec.c).
+ *  If the recording ends connected, the connection is then closed locally,
+ *  so that the client is left idle as before the replay.
+ *
+ * Parameters:
+ *  None
+ *
+ * Return:
+ *  bool : false if not idle, or if the replay failed a check
+ *
+ ******************************************************************************/
+bool tput_replay_events(void)
+{
+    wiced_bt_gatt_connection_status_t conn_status = {0};
+    bool passed;
+
+    if ((APP_BT_SCAN_OFF_CONN_OFF != app_bt_scan_conn_state) ||
+        tput_evrec_is_recording())
+    {
+        return false;
+    }
+    /* The handlers must neither reach the recorded server nor disturb the
+     * timers, the flash or the bonds */
+    replaying = true;
+    passed = tput_evrec_replay();
+
+    if (conn_state_info.conn_id)
+    {
+        conn_status.bd_addr = conn_state_info.remote_addr;
+        conn_status.conn_id = conn_state_info.conn_id;
+        conn_status.connected = WICED_FALSE;
+        conn_status.reason = GATT_CONN_TERMINATE_LOCAL_HOST;
+        ble_app_connect_callback(&conn_status);
+    }
+    replaying = false;
+    app_bt_scan_conn_state = APP_BT_SCAN_OFF_CONN_OFF;
+    tput_scan_led_update();
+    return passed;
+}
+#endif
+
+#if TPUT_UBENCH_BUILD
+/* State of the microbenchmarks of the client hot paths */
+static wiced_bt_gatt_event_data_t ubench_evt;
+static uint16_t ubench_mtu = 0;
+
+/*******************************************************************************
+ * Function Name: tput_ubench_notif_prepare
+ *******************************************************************************
+ * Summary:
+ *  Builds a notification event of DATA_PACKET_SIZE_1 bytes, after waiting
+ *  for rx_sink_task to drain the RX ring, so that every call stores its
+ *  payload in the ring.
+ *
+ ******************************************************************************/
+static void tput_ubench_notif_prepare(void)
+{
+    tput_rx_ring_stats_t rx_ring_stats;
+
+    tput_rx_ring_get_stats(&rx_ring_stats);
+    while (rx_ring_stats.lag)
+    {
+        vTaskDelay(1);
+        tput_rx_ring_get_stats(&rx_ring_stats);
+    }
+    memset(&ubench_evt, 0, sizeof(ubench_evt));
+    ubench_evt.operation_complete.op = GATTC_OPTYPE_NOTIFICATION;
+    ubench_evt.operation_complete.status = WICED_BT_GATT_SUCCESS;
+    ubench_evt.operation_complete.response_data.att_value.len =
+                                                        DATA_PACKET_SIZE_1;
+    ubench_evt.operation_complete.response_data.att_value.p_data =
+                                                        write_data_seq1;
+}
+
+/*******************************************************************************
+ * Function Name: tput_ubench_write_cmplt_prepare
+ *******************************************************************************
+ * Summary:
+ *  Builds the completion event of a write command, and accounts the write
+ *  as sent so that the completion opens the window.
+ *
+ ******************************************************************************/
+static void tput_ubench_write_cmplt_prepare(void)
+{
+    memset(&ubench_evt, 0, sizeof(ubench_evt));
+    ubench_evt.operation_complete.op = GATTC_OPTYPE_WRITE_NO_RSP;
+    ubench_evt.operation_complete.status = WICED_BT_GATT_SUCCESS;
+    ubench_evt.operation_complete.response_data.handle =
+                                    tput_service_handle + GATT_WRITE_HANDLE;
+    tput_cwnd_on_sent();
+}
+
+/*******************************************************************************
+ * Function Name: tput_ubench_gatt_event
+ *******************************************************************************
+ * Summary:
+ *  Benchmark: ble_app_gatt_event_handler() on the prepared event.
+ *
+ ******************************************************************************/
+static void tput_ubench_gatt_event(void)
+{
+    ble_app_gatt_event_handler(GATT_OPERATION_CPLT_EVT, &ubench_evt);
+}
+
+/*******************************************************************************
+ * Function Name: tput_ubench_write_submit
+ *******************************************************************************
+ * Summary:
+ *  Benchmark: the application part of sending a write command in
+ *  send_gatt_write_task, that is the window check, the command header and
+ *  the accounting, without the call to the stack.
+ *
+ ******************************************************************************/
+static void tput_ubench_write_submit(void)
+{
+    if (tput_cwnd_can_send())
+    {
+        tput_write_cmd.auth_req = GATT_AUTH_REQ_NONE;
+        tput_write_cmd.handle = (tput_service_handle) + GATT_WRITE_HANDLE;
+        tput_write_cmd.len = packet_size;
+        tput_write_cmd.offset = 0;
+        tput_cwnd_on_sent();
+        data_flag = data_flag == 0 ? 1 : 0 ;
+    }
+}
+
+/*******************************************************************************
+ * Function Name: tput_ubench_counters
+ *******************************************************************************
+ * Summary:
+ *  Benchmark: the counter updates of a received notification.
+ *
+ ******************************************************************************/
+static void tput_ubench_counters(void)
+{
+    gatt_notif_rx_bytes += DATA_PACKET_SIZE_1;
+    gatt_notif_rx_total += DATA_PACKET_SIZE_1;
+    gatt_notif_rx_pkts_total++;
+}
+
+/*******************************************************************************
+ * Function Name: tput_ubench_pkt_size_prepare
+ *******************************************************************************
+ * Summary:
+ *  Selects the next MTU, so that every branch of
+ *  tput_get_write_cmd_pkt_size() is measured.
+ *
+ ******************************************************************************/
+static void tput_ubench_pkt_size_prepare(void)
+{
+    static const uint16_t mtus[] = {23u, 247u, CY_BT_MTU_SIZE};
+    static uint32_t mtu_idx = 0;
+
+    mtu_idx = (mtu_idx + 1u) % (sizeof(mtus) / sizeof(mtus[0]));
+    ubench_mtu = mtus[mtu_idx];
+}
+
+/*******************************************************************************
+ * Function Name: tput_ubench_pkt_size
+ *******************************************************************************
+ * Summary:
+ *  Benchmark: tput_get_write_cmd_pkt_size().
+ *
+ ******************************************************************************/
+static void tput_ubench_pkt_size(void)
+{
+    (void)tput_get_write_cmd_pkt_size(ubench_mtu);
+}
+
+/*******************************************************************************
+ * Function Name: tput_run_ubench
+ *******************************************************************************
+ * Summary:
+ *  Runs the microbenchmarks of the client hot paths (see tput_ubench.c)
+ *  while disconnected, and then clears the state they changed as a
+ *  disconnection does.
+ *
+ * Parameters:
+ *  uint32_t calls : Calls measured per benchmark
+ *
+ * Return:
+ *  bool : false if connected
+ *
+ ******************************************************************************/
+bool tput_run_ubench(uint32_t calls)
+{
+    static const tput_ubench_case_t cases[] =
+    {
+        {"notification_handler", tput_ubench_gatt_event,
+                                 tput_ubench_notif_prepare},
+        {"write_submit",         tput_ubench_write_submit, tput_cwnd_reset},
+        {"write_complete",       tput_ubench_gatt_event,
+                                 tput_ubench_write_cmplt_prepare},
+        {"counter_update",       tput_ubench_counters, NULL},
+        {"write_cmd_pkt_size",   tput_ubench_pkt_size,
+                                 tput_ubench_pkt_size_prepare},
+    };
+    tput_mode_t saved_mode = mode_flag;
+    uint16_t saved_packet_size = packet_size;
+
+    if (conn_state_info.conn_id)
+    {
+        return false;
+    }
+    /* Write completions are only accounted in the plain write modes */
+    mode_flag = GATT_WRITE_CTOS;
+    packet_size = DATA_PACKET_SIZE_1;
+    tput_ubench_run_cases(cases, sizeof(cases) / sizeof(cases[0]), calls);
+
+    mode_flag = saved_mode;
+    packet_size = saved_packet_size;
+    gatt_notif_rx_bytes = 0;
+    gatt_write_tx_bytes = 0;
+    gatt_notif_rx_total = 0;
+    gatt_write_tx_total = 0;
+    gatt_notif_rx_pkts_total = 0;
+    rx_sink_bytes = 0;
+    rx_sink_bytes_total = 0;
+    rx_sink_pkts_total = 0;
+    tput_cwnd_reset();
+#if TPUT_STREAM_ENABLE
+    tput_stream_reset(tput_service_handle);
+#endif
+    tput_conn_evt_reset();
+    tput_rx_jitter_reset();
+    tput_rx_ring_clear_stats();
+    return true;
+}
+#endif
+
+#if TPUT_BRIDGE_ENABLE
+/*******************************************************************************
+ * Function Name: tput_set_bridge
+ *******************************************************************************
+ * Summary:
+ *  Starts or stops streaming the notification payloads consumed by
+ *  rx_sink_task to the bridge UART (see tput_bridge.c).
+ *
+ * Parameters:
+ *  bool on : true to start streaming
+ *
+ * Return:
+ *  bool : false if the RX ring is disabled or the UART is not available
+ *
+ ******************************************************************************/
+bool tput_set_bridge(bool on)
+{
+    if (!on)
+    {
+        tput_bridge_stop();
+        return true;
+    }
+    if (!tput_rx_ring_has_sink())
+    {
+        return false;
+    }
+    tput_bridge_clear_stats();
+    return tput_bridge_start();
+}
+#endif
+
+#if TPUT_EATT_ENABLE
+/*******************************************************************************
+ * Function Name: tput_open_eatt_bearers
+ *******************************************************************************
+ * Summary:
+ *  Opens the EATT bearers on the current connection (see tput_eatt.h).
+ *
+ * Parameters:
+ *  None
+ *
+ * Return:
+ *  wiced_bt_gatt_status_t : Status of the request
+ *
+ ******************************************************************************/
+wiced_bt_gatt_status_t tput_open_eatt_bearers(void)
+{
+    if (!conn_state_info.conn_id)
+    {
+        return WICED_BT_GATT_ERROR;
+    }
+    return tput_eatt_open(conn_state_info.remote_addr);
+}
+
+/*******************************************************************************
+ * Function Name: tput_set_eatt_writes
+ *******************************************************************************
+ * Summary:
+ *  Starts or stops the write requests on the EATT bearers. They are sent by
+ *  send_gatt_write_task, so a data transfer mode with GATT writes must be
+ *  selected.
+ *
+ * Parameters:
+ *  bool on : true to start the writes
+ *
+ * Return:
+ *  bool : false if the service was not discovered
+ *
+ ******************************************************************************/
+bool tput_set_eatt_writes(bool on)
+{
+    if (!on)
+    {
+        tput_eatt_stop();
+        return true;
+    }
+    if (!conn_state_info.conn_id || !tput_service_handle)
+    {
+        return false;
+    }
+    tput_eatt_clear_stats();
+    tput_eatt_start(tput_service_handle + GATT_WRITE_HANDLE, write_data_seq1,
+                    WRITE_DATA_SIZE);
+    return true;
+}
+#endif
+
+/*******************************************************************************
+* Function Name: tput_scan_result_cback()
+********************************************************************************
+* Summary:
+*   This function is registered as a callback to handle the scan results.
+*   When the desired device is found, it will try to establish connection with
+*   that device.
+*
+* Parameters:
+*   wiced_bt_ble_scan_results_t *p_scan_result: Details of the new device found.
+*   uint8_t                     *p_adv_data      : Advertisement data.
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+static void tput_scan_result_cback(wiced_bt_ble_scan_results_t *p_scan_result,
+                                    uint8_t *p_adv_data)
+{
+    wiced_result_t status = WICED_BT_SUCCESS;
+    uint8_t length = 0u;
+    uint8_t *p_data = NULL;
+    uint8_t server_device_name[5] = {'T', 'P', 'U', 'T', '\0'};
+
+    if (p_scan_result)
+    {
+        p_data = wiced_bt_ble_check_advertising_data(p_adv_data,
+                                            BTM_BLE_ADVERT_TYPE_NAME_COMPLETE,
+                                                    &length);
+
+        if (p_data != NULL)
+        {
+            /* Check if the peer device's name is "TPUT" */
+            if ((length = strlen((const char *)server_device_name)) &&
+                (memcmp(p_data, (uint8_t *)server_device_name, length) == 0))
+            {
+                printf("Scan completed\n Found peer device with BDA:\n");
+                print_bd_address(p_scan_result->remote_bd_addr);
+                scan_flag = false;
+
+                /* Device found. Stop scan. */
+                if ((status = wiced_bt_ble_scan(BTM_BLE_SCAN_TYPE_NONE, true,
+                                                tput_scan_result_cback)) != 0)
+                {
+                    printf("Scan off status %d\n", status);
+                }
+
+                /* Initiate the connection */
+                if (wiced_bt_gatt_le_connect(p_scan_result->remote_bd_addr,
+                                             p_scan_result->ble_addr_type,
+                                             BLE_CONN_MODE_HIGH_DUTY,
+                                             WICED_TRUE) != WICED_TRUE)
+                {
+                    printf("wiced_bt_gatt_connect failed\n");
+                }
+                else
+                {
+                    printf("gatt connect request sent\n");
+                }
+            }
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: ble_app_connect_callback()
+********************************************************************************
+* Summary:
+*   This callback function handles connection status changes.
+*
+* Parameters:
+*   wiced_bt_gatt_connection_status_t *p_conn_status  : Pointer to data that has
+*                                                       connection details
+*
+* Return:
+*  wiced_bt_gatt_status_t: See possible status codes in wiced_bt_gatt_status_e
+*                          in wiced_bt_gatt.h
+*
+*******************************************************************************/
+static wiced_bt_gatt_status_t ble_app_connect_callback(
+                            wiced_bt_gatt_connection_status_t *p_conn_status)
+{
+    wiced_bt_gatt_status_t status = WICED_BT_GATT_ERROR;
+    tput_cwnd_stats_t cwnd_stats;
+    uint32_t lost_bytes = 0;
+
+#if TPUT_EATT_ENABLE
+    /* EATT bearers share the connection of the ATT bearer */
+    if ((NULL != p_conn_status) && conn_state_info.conn_id &&
+        (p_conn_status->conn_id != conn_state_info.conn_id))
+    {
+        if (!p_conn_status->connected)
+        {
+            tput_eatt_on_bearer_down(p_conn_status->conn_id);
+        }
+        return WICED_BT_GATT_SUCCESS;
+    }
+#endif
+
+    if (NULL != p_conn_status)
+    {
+        if (p_conn_status->connected)
+        {
+            /* Device has connected */
+            printf("Connected : BDA ");
             print_bd_address(p_conn_status->bd_addr);
             printf("Connection ID '%d'\n", p_conn_status->conn_id);
 
-            /* Store the connection ID and remote BDA*/
-            conn_state_info.conn_id = p_conn_status->conn_id;
-            printf("connection_id = %d\n", conn_state_info.conn_id);
-            memcpy(conn_state_info.remote_addr,
-                        p_conn_status->bd_addr,
-                        BD_ADDR_LEN);
+            /* Store the connection ID and remote BDA*/
+            conn_state_info.conn_id = p_conn_status->conn_id;
+            printf("connection_id = %d\n", conn_state_info.conn_id);
+            memcpy(conn_state_info.remote_addr,
+                        p_conn_status->bd_addr,
+                        BD_ADDR_LEN);
+            if (!replaying)
+            {
+                tput_reconnect_on_connected(p_conn_status->bd_addr,
+                                            p_conn_status->addr_type);
+                /* Pairs or re-encrypts alongside the ATT bring-up */
+                tput_security_on_connected(p_conn_status->bd_addr,
+                                           p_conn_status->addr_type);
+            }
+            tput_adapt_reset();
+#if TPUT_STREAM_ENABLE
+            tput_stream_reset(0u);
+#endif
+#if TPUT_EXT_SCAN_ENABLE
+            /* Initiated on the Coded PHY only, with the coding the
+             * controller chooses, assumed to be S8 */
+            conn_phy = scan_coded_only ? TPUT_MODEL_PHY_CODED_S8 :
+                                         TPUT_MODEL_PHY_1M;
+#endif
+
+            /* Update the scan/conn state */
+            app_bt_scan_conn_state = APP_BT_SCAN_OFF_CONN_ON;
+
+            /* The data path must not use the heap from now on */
+            tput_mem_heap_lock(true);
+
+            tput_bringup_mark(TPUT_BRINGUP_CONNECTED);
+            auto_start_pending = false;
+
+            status = replaying ? WICED_BT_GATT_SUCCESS : tput_link_setup();
+        }
+        else
+        {
+            /* Device has disconnected. Writes in flight are dropped with
+             * the link */
+            if (gatt_write_tx)
+            {
+                tput_cwnd_get_stats(&cwnd_stats);
+                lost_bytes = (uint32_t)cwnd_stats.in_flight * packet_size;
+            }
+            tput_mem_heap_lock(false);
+            if (!replaying)
+            {
+                tput_security_on_disconnected();
+            }
+            tput_relay_on_link_down();
+#if TPUT_EATT_ENABLE
+            tput_eatt_on_link_down();
+#endif
+            printf("Disconnected : BDA ");
+            print_bd_address(p_conn_status->bd_addr);
+            printf("Connection ID '%d', Reason '%s'\n",
+                        p_conn_status->conn_id,
+                        get_bt_gatt_disconn_reason_name(p_conn_status->reason));
+
+            /* Fill the structure containing connection info with zero */
+            memset(&conn_state_info, 0, sizeof(conn_state_info));
+            /* Reset the flags */
+            tput_service_found = false;
+            coded_phy_opts = BTM_BLE_PREFER_NO_LELR;
+            conn_phy = TPUT_MODEL_PHY_1M;
+            mode_flag = TPUT_MODE_LAST;
+            enable_cccd = true;
+            gatt_write_tx = false;
+            scan_flag = true;
+            /* Clear tx and rx packet count */
+            gatt_notif_rx_bytes = 0;
+            gatt_write_tx_bytes = 0;
+            gatt_write_tx_failures = 0;
+            gatt_notif_rx_total = 0;
+            gatt_write_tx_total = 0;
+            gatt_write_tx_failures_total = 0;
+            gatt_notif_rx_pkts_total = 0;
+            rx_sink_bytes_total = 0;
+            rx_sink_pkts_total = 0;
+            /* Writes in flight are dropped with the link */
+            tput_cwnd_reset();
+            /* A writer waiting for the congestion to clear would never be
+             * woken up */
+            xTaskNotifyGiveIndexed(send_gatt_write_task_handle,
+                                   TASK_NOTIFY_NO_GATT_CONGESTION);
+#if TPUT_STREAM_ENABLE
+            tput_stream_reset(0u);
+#endif
+            tput_blob_suspend();
+            tput_conn_evt_reset();
+            tput_rx_jitter_reset();
+            /* Update the scan/conn state */
+            app_bt_scan_conn_state = APP_BT_SCAN_OFF_CONN_OFF;
+            if (!replaying)
+            {
+                tput_link_teardown(p_conn_status->reason, lost_bytes);
+            }
+            last_second_bytes = 0;
+        }
+
+        /* Update Scan LED to reflect the updated state */
+        tput_scan_led_update();
+    }
+
+    return status;
+}
+
+/*******************************************************************************
+ * Function Name: tput_link_setup
+ *******************************************************************************
+ * Summary:
+ *  Starts the bring-up of a new connection: MTU exchange and, with
+ *  TPUT_PIPELINED_BRINGUP, the PHY and data length updates. Starts the one
+ *  second timer.
+ *
+ * Parameters:
+ *  None
+ *
+ * Return:
+ *  wiced_bt_gatt_status_t : Status of the MTU exchange request
+ *
+ ******************************************************************************/
+static wiced_bt_gatt_status_t tput_link_setup(void)
+{
+    wiced_bt_gatt_status_t status;
+
+    wiced_bt_l2cap_enable_update_ble_conn_params(conn_state_info.remote_addr,
+                                                true);
+
+    /* Send MTU exchange request */
+    status = wiced_bt_gatt_client_configure_mtu(conn_state_info.conn_id,
+                                                CY_BT_MTU_SIZE);
+    if (status != WICED_BT_GATT_SUCCESS)
+    {
+        printf("GATT MTU configure failed %d\n", status);
+    }
+#if TPUT_PIPELINED_BRINGUP
+    /* The PHY and data length updates are link layer procedures,
+     * which run alongside the MTU exchange. Discovery and the CCCD
+     * write still wait for the previous ATT response. A link on
+     * the Coded PHY is kept for its range */
+    if ((TPUT_MODEL_PHY_1M == conn_phy) &&
+        (WICED_BT_SUCCESS != tput_set_phy(BTM_BLE_PREFER_2M_PHY,
+                                          BTM_BLE_PREFER_NO_LELR)))
+    {
+        printf("PHY update request failed\n");
+    }
+    if (WICED_BT_SUCCESS !=
+        wiced_bt_ble_set_data_packet_length(conn_state_info.remote_addr,
+                                            TPUT_BRINGUP_TX_OCTETS,
+                                            TPUT_BRINGUP_TX_TIME_US))
+    {
+        printf("Data length update request failed\n");
+    }
+#endif
+
+    if (CY_RSLT_SUCCESS != cyhal_timer_start(&get_throughput_timer_obj))
+    {
+        printf("Get throughput timer start failed !\n");
+        CY_ASSERT(0);
+    }
+    return status;
+}
+
+/*******************************************************************************
+ * Function Name: tput_link_teardown
+ *******************************************************************************
+ * Summary:
+ *  Completes a disconnection: stores the results, stops the timers and
+ *  starts a recovery if the link was lost.
+ *
+ * Parameters:
+ *  uint8_t reason      : Disconnection reason
+ *  uint32_t lost_bytes : Bytes written but not transmitted
+ *
+ * Return:
+ *  None
+ *
+ ******************************************************************************/
+static void tput_link_teardown(uint8_t reason, uint32_t lost_bytes)
+{
+    /* Keep the results of this connection across a reset. The
+     * flash write is left to get_throughput_task, as the log may be
+     * held for a while by a dump */
+    result_log_flush_pending = true;
+    xTaskNotifyGive(get_throughput_task_handle);
+    /* Stop the timers */
+    if (CY_RSLT_SUCCESS != cyhal_timer_stop(&get_throughput_timer_obj))
+    {
+        printf("Get throughput timer stop failed !\n");
+        CY_ASSERT(0);
+    }
+
+    if (CY_RSLT_SUCCESS != cyhal_timer_stop(&app_millisec_timer_obj))
+    {
+        printf("Get millisec timer stop failed !\n");
+        CY_ASSERT(0);
+    }
+    if (tput_reconnect_on_disconnected(reason, lost_bytes,
+                                       last_second_bytes))
+    {
+        reconnect_pending = true;
+        xTaskNotifyGive(ble_button_task_handle);
+    }
+    else
+    {
+        printf("Press user button on your kit to start scanning.....\n");
+    }
+}
+
+/*******************************************************************************
+* Function Name: tput_app_throughput_timer_callb()
+********************************************************************************
+*
+* Summary:
+*   One second timer callback.
+*
+* Parameters:
+*   void *callback_arg  : The argument parameter is not used in this callback.
+*   cyhal_timer_event_t event : The argument parameter is not used in this
+*                               callback.
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void tput_app_throughput_timer_callb(void *callback_arg,cyhal_timer_event_t event)
+{
+    BaseType_t xHigherPriorityTaskWoken;
+    xHigherPriorityTaskWoken = pdFALSE;
+    TPUT_TRACE_BEGIN(TPUT_TRACE_THROUGHPUT_ISR, 0);
+    vTaskNotifyGiveFromISR(get_throughput_task_handle,&xHigherPriorityTaskWoken);
+    TPUT_TRACE_END(TPUT_TRACE_THROUGHPUT_ISR);
+    portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+}
+
+/*******************************************************************************
+* Function Name: get_throughput_task()
+********************************************************************************
+* Summary:
+*   Send Throughput Values every second .
+*
+* Parameters:
+*   void *pvParam : The argument parameter is not used.
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void get_throughput_task(void *pvParam)
+{
+    unsigned long rx_kbps;
+    unsigned long tx_kbps;
+    unsigned long ceiling_kbps;
+    uint32_t rx_overruns;
+    tput_rx_jitter_stats_t jitter_stats;
+
+    while (true)
+    {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        if (result_log_flush_pending)
+        {
+            result_log_flush_pending = false;
+            tput_result_log_flush();
+        }
+        TPUT_TRACE_BEGIN(TPUT_TRACE_STATS, 0);
+        rx_kbps = 0;
+        tx_kbps = 0;
+        rx_overruns = 0;
+        if (conn_state_info.conn_id && gatt_notif_rx_bytes)
+        {
+            rx_kbps = (gatt_notif_rx_bytes * 8) / 1000;
+            ceiling_kbps = tput_get_ceiling_kbps(true);
+            STATS_PRINTF("GATT NOTIFICATION : Client Throughput (RX) = %lu kbps"
+                         " (%lu%% of %lu kbps)\n", rx_kbps,
+                         ceiling_kbps ? (rx_kbps * 100u) / ceiling_kbps : 0u,
+                         ceiling_kbps);
+            gatt_notif_rx_bytes = 0; //Reset the byte counter
+        }
+
+        if ((conn_state_info.conn_id) && gatt_write_tx_bytes)
+        {
+            tx_kbps = (gatt_write_tx_bytes * 8) / 1000;
+            ceiling_kbps = tput_get_ceiling_kbps(false);
+            STATS_PRINTF("GATT WRITE        : Client Throughput (TX) = %lu kbps"
+                         " (%lu%% of %lu kbps)\n", tx_kbps,
+                         ceiling_kbps ? (tx_kbps * 100u) / ceiling_kbps : 0u,
+                         ceiling_kbps);
+            gatt_write_tx_bytes = 0; //Reset the byte counter
+        }
+        if (conn_state_info.conn_id)
+        {
+            /* Estimates the data not transferred if the link is lost */
+            last_second_bytes = (uint32_t)(rx_kbps + tx_kbps) * 125u;
+            tput_phy_sample(tput_get_model_phy(conn_state_info.rx_phy), rx_kbps,
+                            tput_get_model_phy(conn_state_info.tx_phy), tx_kbps);
+        }
+
+        if (conn_state_info.conn_id && tput_relay_is_busy())
+        {
+            tput_update_relay_stats();
+        }
+
+#if TPUT_BRIDGE_ENABLE
+        if (tput_bridge_is_running())
+        {
+            tput_update_bridge_stats();
+        }
+#endif
+
+        if ((conn_state_info.conn_id) && tput_rx_ring_has_sink() &&
+            enable_cccd)
+        {
+            tput_rx_ring_stats_t rx_ring_stats;
+            tput_rx_ring_get_stats(&rx_ring_stats);
+            rx_sink_bytes = (rx_sink_bytes * 8) / 1000;
+            STATS_PRINTF("RX SINK           : Consumed = %lu kbps, lag %u pkts "
+                         "(max %u, oldest %lu ms), overruns %lu, backpressure %lu\n",
+                         rx_sink_bytes, rx_ring_stats.lag, rx_ring_stats.max_lag,
+                         (unsigned long)rx_ring_stats.oldest_age_ms,
+                         (unsigned long)rx_ring_stats.overruns,
+                         (unsigned long)rx_ring_stats.backpressure_events);
+            rx_overruns = rx_ring_stats.overruns;
+            rx_sink_bytes = 0;
+            tput_rx_ring_clear_stats();
+        }
+
+        if ((conn_state_info.conn_id) && gatt_write_tx)
+        {
+            tput_cwnd_stats_t cwnd_stats;
+            tput_cwnd_get_stats(&cwnd_stats);
+            STATS_PRINTF("GATT WRITE WINDOW : %u pkts (in flight %u), congestion "
+                         "episodes %lu, congested %lu ms\n",
+                         cwnd_stats.cwnd, cwnd_stats.in_flight,
+                         (unsigned long)cwnd_stats.congestion_episodes,
+                         (unsigned long)cwnd_stats.congested_time_ms);
+        }
+
+        if ((conn_state_info.conn_id) && (GATT_RECORDS_CTOS == mode_flag))
+        {
+            tput_coalesce_stats_t coalesce_stats;
+            tput_coalesce_get_stats(&coalesce_stats);
+            if (coalesce_stats.packets)
+            {
+                STATS_PRINTF("GATT RECORDS      : %lu records in %lu pkts, packing "
+                             "efficiency %lu%%, added latency avg %lu ms max %lu ms, "
+                             "deadline flushes %lu, rejected %lu\n",
+                             (unsigned long)coalesce_stats.messages,
+                             (unsigned long)coalesce_stats.packets,
+                             (unsigned long)((coalesce_stats.message_bytes * 100u) /
+                                              coalesce_stats.packet_capacity),
+                             (unsigned long)(coalesce_stats.latency_sum_ms /
+                                              coalesce_stats.messages),
+                             (unsigned long)coalesce_stats.latency_max_ms,
+                             (unsigned long)coalesce_stats.deadline_flushes,
+                             (unsigned long)coalesce_stats.rejected);
+            }
+            tput_coalesce_clear_stats();
+        }
+
+        if (conn_state_info.conn_id)
+        {
+            tput_update_conn_evt_stats();
+            tput_update_rx_jitter_stats(&jitter_stats);
+            tput_security_sample(rx_kbps, tx_kbps,
+                                 jitter_stats.count ?
+                                 jitter_stats.sum_us / jitter_stats.count : 0u,
+                                 jitter_stats.jitter_us);
+            tput_update_adapt(rx_kbps + tx_kbps);
+#if TPUT_STREAM_ENABLE
+            tput_update_stream_stats(tx_kbps);
+#endif
+#if TPUT_EATT_ENABLE
+            tput_update_eatt_stats();
+#endif
+            tput_log_result(rx_kbps, tx_kbps, rx_overruns);
+            tput_bench_sample(rx_kbps, tx_kbps);
+        }
+        TPUT_TRACE_END(TPUT_TRACE_STATS);
+    }
+}
+
+/*******************************************************************************
+* Function Name: tput_app_millisec_timer_cb()
+********************************************************************************
+*
+* Summary:
+*   One millisecond timer callback.
+*
+* Parameters:
+*   void *callback_arg  : The argument parameter is not used in this callback.
+*   cyhal_timer_event_t event : The argument parameter is not used in this
+*                               callback.
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void tput_app_millisec_timer_callb(void *callback_arg,cyhal_timer_event_t event)
+{
+    BaseType_t xHigherPriorityTaskWoken;
+    xHigherPriorityTaskWoken = pdFALSE;
+    TPUT_TRACE_BEGIN(TPUT_TRACE_MILLISEC_ISR, 0);
+    vTaskNotifyGiveIndexedFromISR(send_gatt_write_task_handle,
+                                TASK_NOTIFY_1MS_TIMER,
+                                &xHigherPriorityTaskWoken);
+    TPUT_TRACE_END(TPUT_TRACE_MILLISEC_ISR);
+    portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+}
+
+/*******************************************************************************
+* Function Name: send_gatt_write_task()
+********************************************************************************
+*
+* Summary:
+*   Send GATT Write if enabled by the GATT Client.
+*
+* Parameters:
+*   void *pvParam : The argument parameter is not used.
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void send_gatt_write_task(void *pvParam)
+{
+#if TPUT_STREAM_ENABLE
+    tput_stream_id_t stream;
+    bool bulk_ready;
+#endif
+
+    while(true)
+    {
+    ulTaskNotifyTakeIndexed(TASK_NOTIFY_1MS_TIMER,pdTRUE, portMAX_DELAY);
+    TPUT_TRACE_BEGIN(TPUT_TRACE_WRITE_BURST, 0);
+#if TPUT_STREAM_ENABLE
+    tput_stream_tick();
+    bulk_ready = gatt_write_tx;
+#endif
+
+    /* In GATT_RECORDS_CTOS mode, small records are produced every tick and
+     * packed into full packets, which are sent when full or when the oldest
+     * record reaches the coalescing deadline */
+    if ((conn_state_info.conn_id) && (gatt_write_tx == true) &&
+        (GATT_RECORDS_CTOS == mode_flag))
+    {
+        tput_generate_records();
+        tput_coalesce_tick();
+    }
+
+#if TPUT_EATT_ENABLE
+    /* Write requests on the EATT bearers run next to the write commands on
+     * the ATT bearer, each bearer restarts as soon as it is answered */
+    if (tput_eatt_is_running())
+    {
+        tput_eatt_tick();
+    }
+#endif
+
+    /* Send GATT write(with no response) commands to the server only
+     * when there is no GATT congestion and no GATT notifications are being
+     * received. In data transfer mode 3(Both TX and RX), the GATT write
+     * commands will be sent irrespective of GATT notifications being received
+     * or not and when it is connected .
+     * Every tick, as many writes are sent as the AIMD window allows. The
+     * window grows by one packet per window of completed writes and is halved
+     * when the stack reports congestion, so the stack buffer pool is not
+     * driven to exhaustion and the write rate does not saw-tooth.
+     */
+    while ((conn_state_info.conn_id) && tput_cwnd_can_send())
+    {
+#if TPUT_STREAM_ENABLE
+            /* Control and latency messages go out ahead of, or interleaved
+             * with, the writes of the mode (tput_stream.h). Relayed writes
+             * complete apart, so nothing else is sent meanwhile */
+            stream = tput_relay_is_busy() ? TPUT_STREAM_COUNT :
+                     tput_stream_select(bulk_ready, packet_size);
+            if (TPUT_STREAM_COUNT == stream)
+            {
+            break;
+            }
+            if (TPUT_STREAM_BULK == stream)
+            {
+            /* Recorded ahead of the call, as the completion may come first */
+            tput_stream_on_sending(TPUT_STREAM_BULK, packet_size);
+            }
+            if (TPUT_STREAM_BULK != stream)
+            {
+            status = tput_send_stream_msg(stream);
+            }
+            else if (GATT_BLOB_CTOS == mode_flag)
+#else
+            if (gatt_write_tx == false)
+            {
+            break;
+            }
+            if (GATT_BLOB_CTOS == mode_flag)
+#endif
+            {
+            status = tput_send_blob_chunk();
+            }
+            else if (GATT_RECORDS_CTOS == mode_flag)
+            {
+            status = tput_send_coalesced_packet();
+            }
+            else
+            {
+            tput_write_cmd.auth_req = GATT_AUTH_REQ_NONE;
+            tput_write_cmd.handle = (tput_service_handle) + GATT_WRITE_HANDLE;
+            tput_write_cmd.len = packet_size;
+            tput_write_cmd.offset = 0;
+            /* Counted ahead of the call, as the completion may come first */
+            tput_cwnd_on_sent();
+            /*Packets are sending alternatively. The data sequences are static,
+             * so no free function is passed as context */
+            if(data_flag == 0)
+            {
+            status = wiced_bt_gatt_client_send_write(conn_state_info.conn_id,
+                                                                GATT_CMD_WRITE,
+                                                                &tput_write_cmd,
+                                                                write_data_seq1,
+                                                                NULL);
+            }
+            else
+            {
+            status = wiced_bt_gatt_client_send_write(conn_state_info.conn_id,
+                                                                GATT_CMD_WRITE,
+                                                                &tput_write_cmd,
+                                                                write_data_seq2,
+                                                                NULL);
+            }
+            if (WICED_BT_GATT_SUCCESS != status)
+            {
+            tput_cwnd_cancel_sent();
+            }
+            }
+
+#if TPUT_STREAM_ENABLE
+            if ((TPUT_STREAM_BULK == stream) &&
+                (WICED_BT_GATT_SUCCESS != status))
+            {
+            tput_stream_cancel_sending();
+            }
+#endif
+            if(WICED_BT_GATT_CONGESTED == status)
+            {
+            tput_cwnd_on_congested();
+            tput_rx_jitter_link_pending(TPUT_RX_LINK_TX_CONGESTED, true);
+            TPUT_TRACE_INSTANT(TPUT_TRACE_WRITE_CONGESTED, 0);
+            ulTaskNotifyTakeIndexed(TASK_NOTIFY_NO_GATT_CONGESTION,
+                                                            pdTRUE,
+                                                            portMAX_DELAY);
+            break;
+            }
+            else if (WICED_BT_GATT_SUCCESS == status)
+            {
+#if TPUT_STREAM_ENABLE
+             /* Stream messages are accounted for when sent */
+             if (TPUT_STREAM_BULK != stream)
+             {
+             continue;
+             }
+             tput_stream_on_sent(TPUT_STREAM_BULK, packet_size);
+#endif
+             data_flag = data_flag == 0 ? 1 : 0 ;
+            }
+#if TPUT_STREAM_ENABLE
+            else if (TPUT_STREAM_BULK == stream)
+            {
+            /* Nothing to send in the mode, the other streams may have */
+            bulk_ready = false;
+            }
+#endif
+            else
+            {
+            break;
+            }
+    }
+    TPUT_TRACE_END(TPUT_TRACE_WRITE_BURST);
+    }
+}
+
+/*******************************************************************************
+* Function Name: tput_rx_sink_on_data()
+********************************************************************************
+* Summary:
+*   RX ring callback, run in the GATT callback when a notification payload
+*   has been added to the ring. Wakes up rx_sink_task.
+*
+* Parameters:
+*   void *p_ctx : Unused
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+static void tput_rx_sink_on_data(void *p_ctx)
+{
+    xTaskNotifyGive(rx_sink_task_handle);
+}
+
+/*******************************************************************************
+* Function Name: rx_sink_task()
+********************************************************************************
+* Summary:
+*   Consumes notification payloads from the RX ring. Payloads are processed
+*   in place and released in the order they were acquired.
+*
+* Parameters:
+*   void *pvParam : The argument parameter is not used.
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void rx_sink_task(void *pvParam)
+{
+    const tput_rx_pkt_t *p_pkt;
+
+    while (true)
+    {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        TPUT_TRACE_BEGIN(TPUT_TRACE_RX_SINK, 0);
+        /* While relaying, payloads are written out from their slots, which
+         * are released once transmitted */
+        if (tput_relay_is_busy())
+        {
+            tput_relay_forward();
+        }
+        else
+        {
+            while (NULL != (p_pkt = tput_rx_ring_acquire()))
+            {
+                rx_sink_bytes += p_pkt->len;
+                /* Synthetic processing load, when deferred (tput_load.h) */
+                tput_load_run(TPUT_LOAD_DEFERRED);
+#if TPUT_BRIDGE_ENABLE
+                if (tput_bridge_is_running())
+                {
+                    tput_bridge_write(p_pkt->p_data, p_pkt->len);
+                }
+#endif
+                rx_sink_bytes_total += p_pkt->len;
+                rx_sink_pkts_total++;
+                tput_rx_ring_release();
+            }
+#if TPUT_BRIDGE_ENABLE
+            /* Send what arrived meanwhile if the UART is idle */
+            tput_bridge_flush();
+#endif
+        }
+        TPUT_TRACE_END(TPUT_TRACE_RX_SINK);
+    }
+}
+
+/*******************************************************************************
+* Function Name: telemetry_task()
+********************************************************************************
+* Summary:
+*   Sends a telemetry sample every TPUT_TELEMETRY_PERIOD_MS. Only created
+*   when TPUT_TELEMETRY_ENABLE is set.
+*
+* Parameters:
+*   void *pvParam : The argument parameter is not used.
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void telemetry_task(void *pvParam)
+{
+    TickType_t last_wake = xTaskGetTickCount();
+    tput_telemetry_sample_t sample;
+    tput_cwnd_stats_t cwnd_stats;
+    tput_rx_ring_stats_t rx_ring_stats;
+    uint16_t seq = 0;
+
+    while (true)
+    {
+        vTaskDelayUntil(&last_wake, pdMS_TO_TICKS(TPUT_TELEMETRY_PERIOD_MS));
+
+        tput_cwnd_get_stats(&cwnd_stats);
+        tput_rx_ring_get_stats(&rx_ring_stats);
+        memset(&sample, 0, sizeof(sample));
+
+        sample.seq = seq++;
+        sample.timestamp_ms = (uint32_t)(last_wake * portTICK_PERIOD_MS);
+        if (conn_state_info.conn_id)
+        {
+            sample.flags |= TPUT_TELEMETRY_FLAG_CONNECTED;
+        }
+        if (cwnd_stats.congested)
+        {
+            sample.flags |= TPUT_TELEMETRY_FLAG_CONGESTED;
+        }
+        if (enable_cccd)
+        {
+            sample.flags |= TPUT_TELEMETRY_FLAG_NOTIFY;
+        }
+        if (gatt_write_tx)
+        {
+            sample.flags |= TPUT_TELEMETRY_FLAG_WRITE;
+        }
+        sample.rx_bytes = gatt_notif_rx_total;
+        sample.tx_bytes = gatt_write_tx_total;
+        sample.cwnd = cwnd_stats.cwnd;
+        sample.in_flight = cwnd_stats.in_flight;
+        sample.congestion_episodes = cwnd_stats.congestion_episodes;
+        sample.congested_ms = cwnd_stats.congested_time_ms;
+        sample.tx_failures = gatt_write_tx_failures_total;
+        sample.rx_lag = rx_ring_stats.lag;
+        sample.mode = (uint8_t)mode_flag;
+        sample.phy = (uint8_t)((conn_state_info.tx_phy << 4) |
+                               (conn_state_info.rx_phy & 0x0Fu));
+        sample.mtu = conn_state_info.mtu;
+        sample.conn_interval =
+                    (uint16_t)(conn_state_info.conn_interval / 1.25 + 0.5);
+        sample.packet_size = packet_size;
+        sample.rx_ceiling_kbps = (uint16_t)tput_get_ceiling_kbps(true);
+        sample.tx_ceiling_kbps = (uint16_t)tput_get_ceiling_kbps(false);
+
+        tput_telemetry_send(&sample);
+    }
+}
+
+/*******************************************************************************
+* Function Name: tput_scan_led_update()
+********************************************************************************
+*
+* Summary:
+*   This function updates the scan LED state based on BLE scanning/
+*   connection state
+*
+* Parameters:
+*   None
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+static void tput_scan_led_update(void)
+{
+    cy_rslt_t rslt = CY_RSLT_SUCCESS;
+    /* Stop the scan led pwm */
+    rslt = cyhal_pwm_stop(&scan_led_pwm);
+    if (CY_RSLT_SUCCESS != rslt)
+    {
+        printf("Failed to stop PWM !!\n");
+        CY_ASSERT(0);
+    }
+
+    /* Update LED state based on BLE scan/connection state.
+     * LED OFF for no scan/connection, LED blinking for scan state,
+     * LED ON for connected state  */
+    switch (app_bt_scan_conn_state)
+    {
+    case APP_BT_SCAN_OFF_CONN_OFF:
+        rslt = cyhal_pwm_set_duty_cycle(&scan_led_pwm,
+                                        LED_OFF_DUTY_CYCLE,
+                                        SCAN_LED_PWM_FREQUENCY);
+        break;
+
+    case APP_BT_SCAN_ON_CONN_OFF:
+        rslt = cyhal_pwm_set_duty_cycle(&scan_led_pwm,
+                                        LED_BLINKING_DUTY_CYCLE,
+                                        SCAN_LED_PWM_FREQUENCY);
+        break;
+
+    case APP_BT_SCAN_OFF_CONN_ON:
+        rslt = cyhal_pwm_set_duty_cycle(&scan_led_pwm,
+                                        LED_ON_DUTY_CYCLE,
+                                        SCAN_LED_PWM_FREQUENCY);
+        break;
+
+    default:
+        /* LED OFF for unexpected states */
+        rslt = cyhal_pwm_set_duty_cycle(&scan_led_pwm,
+                                        LED_OFF_DUTY_CYCLE,
+                                        SCAN_LED_PWM_FREQUENCY);
+        break;
+    }
+    /* Check if update to PWM parameters is successful*/
+    if (CY_RSLT_SUCCESS != rslt)
+    {
+        printf("Failed to set duty cycle parameters!!\n");
+    }
+
+    /* Start the scan led pwm */
+    rslt = cyhal_pwm_start(&scan_led_pwm);
+
+    /* Check if PWM started successfully */
+    if (CY_RSLT_SUCCESS != rslt)
+    {
+        printf("Failed to start PWM !!\n");
+        CY_ASSERT(0);
+    }
+}
+
+/*******************************************************************************
+* Function Name: tput_enable_disable_gatt_notification()
+********************************************************************************
+* Summary:
+*   Enable or disable  GATT notification from the server.
+*
+* Parameters:
+*   bool notify : Boolean variable to enable/disable notification.
+*
+* Return:
+*   wiced_bt_gatt_status_t  : Status code from wiced_bt_gatt_status_e.
+*
+*******************************************************************************/
+static wiced_bt_gatt_status_t tput_enable_disable_gatt_notification(bool notify)
+{
+    wiced_bt_gatt_write_hdr_t tput_write_notif = {0};
+    wiced_bt_gatt_status_t status = WICED_BT_GATT_SUCCESS;
+    uint8_t local_notif_enable[CCCD_LENGTH] = {0};
+    uint8_t *notif_val = NULL;
+    /*Allocate memory for data to be written on server DB and pass it to stack*/
+    notif_val = app_bt_alloc_buffer(sizeof(uint16_t)); //CCCD is two bytes
+    if (notif_val)
+    {
+        local_notif_enable[0] = notify;
+        memcpy(notif_val, local_notif_enable, sizeof(uint16_t));
+        tput_write_notif.auth_req = GATT_AUTH_REQ_NONE;
+        tput_write_notif.handle = tput_service_handle + GATT_CCCD_HANDLE;
+        tput_write_notif.len = CCCD_LENGTH;
+        tput_write_notif.offset = 0;
+        status = wiced_bt_gatt_client_send_write(conn_state_info.conn_id,
+                                                GATT_REQ_WRITE,
+                                                &tput_write_notif,
+                                        notif_val,(void *)app_bt_free_buffer);
+    }
+    else
+    {
+        printf("malloc failed! write request not sent\n");
+        status = WICED_BT_GATT_ERROR;
+    }
+    return status;
+}
 
-            /* Update the scan/conn state */
-            app_bt_scan_conn_state = APP_BT_SCAN_OFF_CONN_ON;
+/*******************************************************************************
+* Function Name: tput_send_blob_chunk()
+********************************************************************************
+* Summary:
+*   Sends the next chunk of the blob transfer as a GATT write command. The
+*   chunk buffer is freed on GATT_APP_BUFFER_TRANSMITTED_EVT, or right away
+*   if the stack does not accept it.
+*
+* Parameters:
+*   None
+*
+* Return:
+*   wiced_bt_gatt_status_t  : Status code from wiced_bt_gatt_status_e.
+*                             WICED_BT_GATT_ERROR if nothing is left to send.
+*
+*******************************************************************************/
+static wiced_bt_gatt_status_t tput_send_blob_chunk(void)
+{
+    wiced_bt_gatt_write_hdr_t blob_write_cmd = {0};
+    wiced_bt_gatt_status_t status = WICED_BT_GATT_ERROR;
+    uint8_t *p_chunk = NULL;
+    uint16_t chunk_len = 0;
+
+    if (!tput_blob_has_data())
+    {
+        return WICED_BT_GATT_ERROR;
+    }
 
-            wiced_bt_l2cap_enable_update_ble_conn_params(conn_state_info.remote_addr,
-                                                        true);
+    p_chunk = app_bt_alloc_buffer(packet_size);
+    if (NULL == p_chunk)
+    {
+        return WICED_BT_GATT_INSUF_RESOURCE;
+    }
 
-            /* Send MTU exchange request */
-            status = wiced_bt_gatt_client_configure_mtu(conn_state_info.conn_id,
-                                                        CY_BT_MTU_SIZE);
-            if (status != WICED_BT_GATT_SUCCESS)
-            {
-                printf("GATT MTU configure failed %d\n", status);
-            }
+    chunk_len = tput_blob_build_chunk(p_chunk, packet_size);
+    if (0u == chunk_len)
+    {
+        app_bt_free_buffer(p_chunk);
+        return WICED_BT_GATT_ERROR;
+    }
 
-            if (CY_RSLT_SUCCESS != cyhal_timer_start(&get_throughput_timer_obj))
-            {
-                printf("Get throughput timer start failed !\n");
-                CY_ASSERT(0);
-            }
-        }
-        else
-        {
-            /* Device has disconnected */
-            printf("Disconnected : BDA ");
-            print_bd_address(p_conn_status->bd_addr);
-            printf("Connection ID '%d', Reason '%s'\n",
-                        p_conn_status->conn_id,
-                        get_bt_gatt_disconn_reason_name(p_conn_status->reason));
+    blob_write_cmd.auth_req = GATT_AUTH_REQ_NONE;
+    blob_write_cmd.handle = tput_service_handle + GATT_WRITE_HANDLE;
+    blob_write_cmd.len = chunk_len;
+    blob_write_cmd.offset = 0;
+    /* Counted ahead of the call, as the completion may come first */
+    tput_cwnd_on_sent();
+    status = wiced_bt_gatt_client_send_write(conn_state_info.conn_id,
+                                             GATT_CMD_WRITE,
+                                             &blob_write_cmd,
+                                             p_chunk,
+                                             (void *)app_bt_free_buffer);
+    if (WICED_BT_GATT_SUCCESS != status)
+    {
+        tput_cwnd_cancel_sent();
+        /* The chunk will be built again on the next attempt */
+        tput_blob_cancel_chunk();
+        app_bt_free_buffer(p_chunk);
+    }
+    return status;
+}
 
-            /* Fill the structure containing connection info with zero */
-            memset(&conn_state_info, 0, sizeof(conn_state_info));
-            /* Reset the flags */
-            tput_service_found = false;
-            mode_flag = GATT_NOTIFANDWRITE;
-            enable_cccd = true;
-            gatt_write_tx = false;
-            scan_flag = true;
-            /* Clear tx and rx packet count */
-            gatt_notif_rx_bytes = 0;
-            gatt_write_tx_bytes = 0;
-            /* Stop the timers */
-            if (CY_RSLT_SUCCESS != cyhal_timer_stop(&get_throughput_timer_obj))
-            {
-                printf("Get throughput timer stop failed !\n");
-                CY_ASSERT(0);
-            }
+/*******************************************************************************
+* Function Name: tput_generate_records()
+********************************************************************************
+* Summary:
+*   Produces the small records of GATT_RECORDS_CTOS mode, standing in for an
+*   application that emits many short messages. Each record starts with a
+*   sequence number, so the receiver can detect loss.
+*
+* Parameters:
+*   None
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+static void tput_generate_records(void)
+{
+    uint8_t record[RECORD_DATA_SIZE];
 
-            if (CY_RSLT_SUCCESS != cyhal_timer_stop(&app_millisec_timer_obj))
-            {
-                printf("Get millisec timer stop failed !\n");
-                CY_ASSERT(0);
-            }
-            /* Update the scan/conn state */
-            app_bt_scan_conn_state = APP_BT_SCAN_OFF_CONN_OFF;
-            printf("Press user button on your kit to start scanning.....\n");
+    for (uint8_t count = 0; count < RECORDS_PER_TICK; count++)
+    {
+        memcpy(record, &write_data_seq1[count], RECORD_DATA_SIZE);
+        record[0] = (uint8_t)(record_seq_num);
+        record[1] = (uint8_t)(record_seq_num >> 8);
+        record[2] = (uint8_t)(record_seq_num >> 16);
+        record[3] = (uint8_t)(record_seq_num >> 24);
+        if (!tput_coalesce_submit(record, RECORD_DATA_SIZE))
+        {
+            /* All packet buffers are busy. Try again next tick */
+            break;
         }
+        record_seq_num++;
+    }
+}
 
-        /* Update Scan LED to reflect the updated state */
-        tput_scan_led_update();
+/*******************************************************************************
+* Function Name: tput_send_coalesced_packet()
+********************************************************************************
+* Summary:
+*   Sends the oldest packet of coalesced records as a GATT write command. The
+*   packet buffer belongs to the coalescing layer and is returned to it on
+*   GATT_APP_BUFFER_TRANSMITTED_EVT.
+*
+* Parameters:
+*   None
+*
+* Return:
+*   wiced_bt_gatt_status_t  : Status code from wiced_bt_gatt_status_e.
+*                             WICED_BT_GATT_ERROR if no packet is ready.
+*
+*******************************************************************************/
+static wiced_bt_gatt_status_t tput_send_coalesced_packet(void)
+{
+    wiced_bt_gatt_write_hdr_t records_write_cmd = {0};
+    wiced_bt_gatt_status_t status = WICED_BT_GATT_ERROR;
+    uint8_t *p_packet = NULL;
+    uint16_t packet_len = 0;
+
+    p_packet = tput_coalesce_get_ready(&packet_len);
+    if (NULL == p_packet)
+    {
+        return WICED_BT_GATT_ERROR;
     }
 
+    records_write_cmd.auth_req = GATT_AUTH_REQ_NONE;
+    records_write_cmd.handle = tput_service_handle + GATT_WRITE_HANDLE;
+    records_write_cmd.len = packet_len;
+    records_write_cmd.offset = 0;
+    /* Accounted for ahead of the call, as the completion and the release of
+     * the buffer may come first */
+    tput_cwnd_on_sent();
+    tput_coalesce_on_sent();
+    status = wiced_bt_gatt_client_send_write(conn_state_info.conn_id,
+                                             GATT_CMD_WRITE,
+                                             &records_write_cmd,
+                                             p_packet,
+                                             (void *)tput_coalesce_release);
+    if (WICED_BT_GATT_SUCCESS == status)
+    {
+        gatt_write_tx_bytes += packet_len;
+        gatt_write_tx_total += packet_len;
+    }
+    else
+    {
+        tput_coalesce_cancel_sent();
+        tput_cwnd_cancel_sent();
+    }
     return status;
 }
 
 /*******************************************************************************
-* Function Name: tput_app_throughput_timer_callb()
+* Function Name: tput_get_write_cmd_pkt_size()
 ********************************************************************************
+* Summary: This function decides size of notification packet based on the
+*   attribute MTU exchanged. This is done to utilize the LL payload space
+*   effectively.
+*
+* Parameters:
+*   uint16_t att_mtu_size: MTU value exchaged after connection.
+*
+* Return:
+*   uint16_t: Size of notification packet derived based on MTU.
 *
+*******************************************************************************/
+static uint16_t tput_get_write_cmd_pkt_size(uint16_t att_mtu_size)
+{
+    if (att_mtu_size < DATA_PACKET_SIZE_1 + ATT_HEADER)
+    {
+        /* Packet Length = ATT_MTU_SIZE - ATT_HANDLE(2 bytes)-ATT_OPCODE(1 byte)
+        * Reason: With DLE enabled, LL payload is 251 bytes. So if an MTU less
+        * than 247 is exchanged, the data can be accommodated in a single LL
+        * packet */
+        packet_size = att_mtu_size - ATT_HEADER;
+    }
+    else if ((att_mtu_size >= DATA_PACKET_SIZE_1 + ATT_HEADER) &&
+                    (att_mtu_size < DATA_PACKET_SIZE_2 + ATT_HEADER))
+    {
+        /* If MTU is between 247 and 498, if a packet size other than 244 bytes
+         * is used, the data will be split and the LL payload space is not
+         * utilized effectively. Refer README for details */
+        packet_size = DATA_PACKET_SIZE_1;
+    }
+    else
+    {
+        /*For MTU value greater than 498, if a packet size other than 495(or244)
+         * is used, the LL payload space is not utilized effectively.
+         * 495 bytes will go as two LL packets: 244 bytes + 251 bytes */
+        packet_size = DATA_PACKET_SIZE_2;
+    }
+    return packet_size;
+}
+
+/*******************************************************************************
+* Function Name: tput_log_result()
+********************************************************************************
 * Summary:
-*   One second timer callback.
+*   Adds the throughput of the last second and the link parameters to the
+*   persistent result log.
 *
 * Parameters:
-*   void *callback_arg  : The argument parameter is not used in this callback.
-*   cyhal_timer_event_t event : The argument parameter is not used in this
-*                               callback.
+*   uint32_t rx_kbps     : Notification throughput of the last second
+*   uint32_t tx_kbps     : GATT write throughput of the last second
+*   uint32_t rx_overruns : Notifications dropped by the RX ring
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+static void tput_log_result(uint32_t rx_kbps, uint32_t tx_kbps,
+                            uint32_t rx_overruns)
+{
+    /* The congested time is cumulative, only its increase is logged */
+    static uint32_t prev_congested_ms = 0;
+    tput_result_record_t record = {0};
+    tput_cwnd_stats_t cwnd_stats;
+
+    tput_cwnd_get_stats(&cwnd_stats);
+    if (cwnd_stats.congested_time_ms < prev_congested_ms)
+    {
+        /* Window was reset by a new connection */
+        prev_congested_ms = 0;
+    }
+
+    record.timestamp_ms = (uint32_t)(xTaskGetTickCount() * portTICK_PERIOD_MS);
+    record.mode = (uint8_t)mode_flag;
+    record.phy = (uint8_t)((conn_state_info.tx_phy << 4) |
+                           (conn_state_info.rx_phy & 0x0Fu));
+    record.mtu = conn_state_info.mtu;
+    record.conn_interval = (uint16_t)(conn_state_info.conn_interval / 1.25 + 0.5);
+    record.packet_size = packet_size;
+    record.rx_kbps = (uint16_t)rx_kbps;
+    record.tx_kbps = (uint16_t)tx_kbps;
+    record.cwnd = cwnd_stats.cwnd;
+    record.congestion_episodes = cwnd_stats.congestion_episodes;
+    record.congested_ms = (uint16_t)(cwnd_stats.congested_time_ms -
+                                     prev_congested_ms);
+    record.rx_overruns = (uint16_t)rx_overruns;
+    record.tx_failures = gatt_write_tx_failures;
+    gatt_write_tx_failures = 0;
+    prev_congested_ms = cwnd_stats.congested_time_ms;
+
+    tput_result_log_append(&record);
+}
+
+/*******************************************************************************
+* Function Name: tput_get_ceiling_kbps()
+********************************************************************************
+* Summary:
+*   Computes the theoretical maximum throughput of the current link in one
+*   direction, for the current data transfer mode (see tput_model.c).
+*
+* Parameters:
+*   bool rx : true for notifications, false for GATT writes
+*
+* Return:
+*   uint32_t : Maximum throughput in kbps, 0 if the mode does not transfer
+*              data in this direction or the link parameters are not known
+*
+*******************************************************************************/
+static uint32_t tput_get_ceiling_kbps(bool rx)
+{
+    tput_model_result_t result;
+
+    tput_get_link_model(rx, &result);
+    return result.ceiling_kbps;
+}
+
+/*******************************************************************************
+* Function Name: tput_get_link_model()
+********************************************************************************
+* Summary:
+*   Runs the throughput model (see tput_model.c) for the current link and
+*   data transfer mode in one direction.
+*
+* Parameters:
+*   bool rx                        : true for notifications, false for GATT
+*                                    writes
+*   tput_model_result_t *p_result  : Result of the model
+*
+* Return:
+*   bool : false if the mode does not transfer data in this direction or
+*          the link parameters are not known, p_result is zeroed then
+*
+*******************************************************************************/
+static bool tput_get_link_model(bool rx, tput_model_result_t *p_result)
+{
+    tput_model_link_t link;
+    tput_model_dir_t dir;
+
+    if ((!conn_state_info.conn_id) || (rx && !enable_cccd) ||
+        (!rx && !gatt_write_tx))
+    {
+        memset(p_result, 0, sizeof(*p_result));
+        return false;
+    }
+    dir = (enable_cccd && gatt_write_tx) ? TPUT_MODEL_DIR_BOTH :
+          (rx ? TPUT_MODEL_DIR_RX : TPUT_MODEL_DIR_TX);
+
+    link.conn_interval_us = (uint32_t)(conn_state_info.conn_interval * 1000.0);
+    link.tx_phy = tput_get_model_phy(conn_state_info.tx_phy);
+    link.rx_phy = tput_get_model_phy(conn_state_info.rx_phy);
+    link.max_tx_octets = conn_state_info.max_tx_octets;
+    link.max_rx_octets = conn_state_info.max_rx_octets;
+    link.max_tx_time_us = conn_state_info.max_tx_time;
+    link.max_rx_time_us = conn_state_info.max_rx_time;
+    link.mtu = conn_state_info.mtu;
+    link.packet_size = packet_size;
+    link.encrypted = tput_security_is_encrypted();
+
+    return tput_model_compute(&link, dir, p_result);
+}
+
+/*******************************************************************************
+* Function Name: tput_update_conn_evt_stats()
+********************************************************************************
+* Summary:
+*   Prints the histogram of packets per connection event of the last second
+*   and updates the connection interval and packet budget it is based on.
+*   When data flows in both directions, each exchange of a connection event
+*   can carry one packet each way, so the budget is doubled.
+*
+* Parameters:
+*   None
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+static void tput_update_conn_evt_stats(void)
+{
+    tput_conn_evt_stats_t evt_stats;
+    tput_model_result_t result;
+    uint16_t budget;
+
+    tput_conn_evt_get_stats(&evt_stats);
+    tput_conn_evt_clear_stats();
+    if (evt_stats.events)
+    {
+        STATS_PRINTF("CONN EVENTS       : %lu events, %lu.%02lu pkts/event, "
+                     "budget %u, %lu%% at budget, pkts:events",
+                     (unsigned long)evt_stats.events,
+                     (unsigned long)(evt_stats.packets / evt_stats.events),
+                     (unsigned long)(((evt_stats.packets % evt_stats.events) *
+                                      100u) / evt_stats.events),
+                     evt_stats.budget,
+                     (unsigned long)((evt_stats.events_at_budget * 100u) /
+                                      evt_stats.events));
+        for (uint32_t bin = 0; bin < TPUT_CONN_EVT_HIST_BINS; bin++)
+        {
+            if (evt_stats.hist[bin])
+            {
+                STATS_PRINTF(" %lu%s:%lu", (unsigned long)bin,
+                             (TPUT_CONN_EVT_HIST_BINS - 1u == bin) ? "+" : "",
+                             (unsigned long)evt_stats.hist[bin]);
+            }
+        }
+        STATS_PRINTF("\n");
+    }
+
+    if (!tput_get_link_model(enable_cccd, &result))
+    {
+        tput_get_link_model(false, &result);
+    }
+    budget = result.pkts_per_event;
+    if (enable_cccd && gatt_write_tx)
+    {
+        budget *= 2u;
+    }
+    tput_conn_evt_configure((uint32_t)(conn_state_info.conn_interval * 1000.0),
+                            budget);
+}
+
+/*******************************************************************************
+* Function Name: tput_update_rx_jitter_stats()
+********************************************************************************
+* Summary:
+*   Prints the notification inter-arrival statistics of the last second and
+*   the gaps logged since, and updates the connection interval gaps are
+*   measured against.
+*
+* Parameters:
+*   tput_rx_jitter_stats_t *p_stats: Returns the statistics of the last second
 *
 * Return:
 *   None
 *
 *******************************************************************************/
-void tput_app_throughput_timer_callb(void *callback_arg,cyhal_timer_event_t event)
+static void tput_update_rx_jitter_stats(tput_rx_jitter_stats_t *p_stats)
 {
-    BaseType_t xHigherPriorityTaskWoken;
-    xHigherPriorityTaskWoken = pdFALSE;
-    vTaskNotifyGiveFromISR(get_throughput_task_handle,&xHigherPriorityTaskWoken);
-    portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+    tput_rx_jitter_stats_t jitter_stats;
+    tput_rx_gap_t gap;
+
+    tput_rx_jitter_get_stats(&jitter_stats);
+    tput_rx_jitter_clear_stats();
+    *p_stats = jitter_stats;
+    if (jitter_stats.count)
+    {
+        STATS_PRINTF("RX TIMING         : inter-arrival avg %lu us, min %lu us, "
+                     "max %lu us, jitter %lu us, gaps %lu, us:count",
+                     (unsigned long)(jitter_stats.sum_us / jitter_stats.count),
+                     (unsigned long)jitter_stats.min_us,
+                     (unsigned long)jitter_stats.max_us,
+                     (unsigned long)jitter_stats.jitter_us,
+                     (unsigned long)jitter_stats.gaps);
+        for (uint32_t bin = 0; bin < TPUT_RX_JITTER_HIST_BINS; bin++)
+        {
+            if (jitter_stats.hist[bin])
+            {
+                /* Bins are labelled with their lower bound */
+                STATS_PRINTF(" %lu:%lu",
+                             bin ? (unsigned long)(TPUT_RX_JITTER_BIN0_US << bin) :
+                                   0ul,
+                             (unsigned long)jitter_stats.hist[bin]);
+            }
+        }
+        STATS_PRINTF("\n");
+    }
+
+    while (tput_rx_jitter_get_gap(&gap))
+    {
+        STATS_PRINTF("RX GAP            : %lu.%03lu ms (%lu intervals)%s%s%s%s\n",
+                     (unsigned long)(gap.gap_us / 1000u),
+                     (unsigned long)(gap.gap_us % 1000u),
+                     (unsigned long)(gap.gap_us / gap.conn_interval_us),
+                     (gap.link_state & TPUT_RX_LINK_PHY_UPDATE) ?
+                                                " PHY update" : "",
+                     (gap.link_state & TPUT_RX_LINK_CONN_PARAM_UPDATE) ?
+                                                " connection update" : "",
+                     (gap.link_state & TPUT_RX_LINK_DATA_LENGTH_UPDATE) ?
+                                                " data length update" : "",
+                     (gap.link_state & TPUT_RX_LINK_TX_CONGESTED) ?
+                                                " TX congested" : "");
+    }
+
+    tput_rx_jitter_configure((uint32_t)(conn_state_info.conn_interval * 1000.0));
 }
 
 /*******************************************************************************
-* Function Name: get_throughput_task()
+* Function Name: tput_update_adapt()
 ********************************************************************************
 * Summary:
-*   Send Throughput Values every second .
+*   Runs the adaptive PHY and packet size controller on the last second,
+*   applies its decision, and requests the RSSI for the next second. The
+*   packet size is only adapted for GATT writes; in GATT_RECORDS_CTOS mode
+*   records are packed to the size set when the mode was selected.
 *
 * Parameters:
-*   void *pvParam : The argument parameter is not used.
+*   uint32_t goodput_kbps : Throughput of the last second, both directions
 *
 * Return:
 *   None
 *
 *******************************************************************************/
-void get_throughput_task(void *pvParam)
+static void tput_update_adapt(uint32_t goodput_kbps)
 {
-    while (true)
+    tput_adapt_action_t action;
+    uint16_t max_packet_size;
+
+    if (!tput_adapt_is_enabled())
     {
-        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
-        if (conn_state_info.conn_id && gatt_notif_rx_bytes)
+        return;
+    }
+    max_packet_size = (gatt_write_tx && (GATT_RECORDS_CTOS != mode_flag)) ?
+                      conn_state_info.mtu - ATT_HEADER : 0u;
+    if (max_packet_size > GATT_WRITE_BYTES_MAX_LEN)
+    {
+        max_packet_size = GATT_WRITE_BYTES_MAX_LEN;
+    }
+    if (tput_adapt_sample(tput_get_model_phy(conn_state_info.tx_phy),
+                          packet_size, max_packet_size, goodput_kbps, &action))
+    {
+        switch (action.phy)
         {
-            gatt_notif_rx_bytes = (gatt_notif_rx_bytes * 8) / 1000;
-            printf("GATT NOTIFICATION : Client Throughput (RX) = %lu kbps\n",
-                                                         gatt_notif_rx_bytes);
-            gatt_notif_rx_bytes = 0; //Reset the byte counter
+        case TPUT_MODEL_PHY_1M:
+            tput_set_phy(BTM_BLE_PREFER_1M_PHY, BTM_BLE_PREFER_NO_LELR);
+            break;
+        case TPUT_MODEL_PHY_2M:
+            tput_set_phy(BTM_BLE_PREFER_2M_PHY, BTM_BLE_PREFER_NO_LELR);
+            break;
+        case TPUT_MODEL_PHY_CODED_S2:
+            tput_set_phy(BTM_BLE_PREFER_LELR_PHY, BTM_BLE_PREFER_LELR_512K);
+            break;
+        case TPUT_MODEL_PHY_CODED_S8:
+            tput_set_phy(BTM_BLE_PREFER_LELR_PHY, BTM_BLE_PREFER_LELR_125K);
+            break;
+        default:
+            break;
         }
-
-        if ((conn_state_info.conn_id) && gatt_write_tx_bytes)
+        if (action.packet_size)
         {
-            gatt_write_tx_bytes = (gatt_write_tx_bytes * 8) / 1000;
-            printf("GATT WRITE        : Client Throughput (TX) = %lu kbps\n",
-                                                        gatt_write_tx_bytes);
-            gatt_write_tx_bytes = 0; //Reset the byte counter
+            tput_set_packet_size(action.packet_size);
         }
     }
+    tput_adapt_request_rssi(conn_state_info.remote_addr);
 }
 
+#if TPUT_STREAM_ENABLE
 /*******************************************************************************
-* Function Name: tput_app_millisec_timer_cb()
+* Function Name: tput_stream_wake()
 ********************************************************************************
-*
 * Summary:
-*   One millisecond timer callback.
+*   Wakes up send_gatt_write_task when a message is queued on a stream, also
+*   while the 1 ms timer is stopped.
 *
 * Parameters:
-*   void *callback_arg  : The argument parameter is not used in this callback.
-*   cyhal_timer_event_t event : The argument parameter is not used in this
-*                               callback.
+*   None
 *
 * Return:
 *   None
 *
 *******************************************************************************/
-void tput_app_millisec_timer_callb(void *callback_arg,cyhal_timer_event_t event)
+static void tput_stream_wake(void)
 {
-    BaseType_t xHigherPriorityTaskWoken;
-    xHigherPriorityTaskWoken = pdFALSE;
-    vTaskNotifyGiveIndexedFromISR(send_gatt_write_task_handle,
-                                TASK_NOTIFY_1MS_TIMER,
-                                &xHigherPriorityTaskWoken);
-    portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+    xTaskNotifyGiveIndexed(send_gatt_write_task_handle, TASK_NOTIFY_1MS_TIMER);
 }
 
 /*******************************************************************************
-* Function Name: send_gatt_write_task()
+* Function Name: tput_send_stream_msg()
 ********************************************************************************
-*
 * Summary:
-*   Send GATT Write if enabled by the GATT Client.
+*   Sends the next message of the control or latency stream. The message is
+*   copied to a buffer freed on GATT_APP_BUFFER_TRANSMITTED_EVT, or right
+*   away if the stack does not accept it.
 *
 * Parameters:
-*   void *pvParam : The argument parameter is not used.
+*   tput_stream_id_t stream : TPUT_STREAM_CONTROL or TPUT_STREAM_LATENCY
 *
 * Return:
-*   None
+*   wiced_bt_gatt_status_t  : Status code from wiced_bt_gatt_status_e.
+*                             WICED_BT_GATT_ERROR if no buffer is free.
 *
 *******************************************************************************/
-void send_gatt_write_task(void *pvParam)
+static wiced_bt_gatt_status_t tput_send_stream_msg(tput_stream_id_t stream)
 {
-    while(true)
+    wiced_bt_gatt_write_hdr_t stream_write = {0};
+    wiced_bt_gatt_status_t status;
+    const tput_stream_msg_t *p_msg;
+    uint8_t *p_buffer;
+    bool request;
+
+    p_msg = tput_stream_peek(stream);
+    if (NULL == p_msg)
     {
-    ulTaskNotifyTakeIndexed(TASK_NOTIFY_1MS_TIMER,pdTRUE, portMAX_DELAY);
-
-    /* Send GATT write(with no response) commands to the server only
-     * when there is no GATT congestion and no GATT notifications are being
-     * received. In data transfer mode 3(Both TX and RX), the GATT write
-     * commands will be sent irrespective of GATT notifications being received
-     * or not and when it is connected .
-     */
-    if ((conn_state_info.conn_id) && (gatt_write_tx == true))
+        return WICED_BT_GATT_ERROR;
+    }
+    p_buffer = app_bt_alloc_buffer(p_msg->len);
+    if (NULL == p_buffer)
     {
-            tput_write_cmd.auth_req = GATT_AUTH_REQ_NONE;
-            tput_write_cmd.handle = (tput_service_handle) + GATT_WRITE_HANDLE;
-            tput_write_cmd.len = packet_size;
-            tput_write_cmd.offset = 0;
-            /*Packets are sending alternatively*/
-            if(data_flag == 0)
-            {
-            status = wiced_bt_gatt_client_send_write(conn_state_info.conn_id,
-                                                                GATT_CMD_WRITE,
-                                                                &tput_write_cmd,
-                                                                write_data_seq1,
-                                                                (void *)app_bt_free_buffer);
-            }
-            else
-            {
-            status = wiced_bt_gatt_client_send_write(conn_state_info.conn_id,
-                                                                GATT_CMD_WRITE,
-                                                                &tput_write_cmd,
-                                                                write_data_seq2,
-                                                                (void *)app_bt_free_buffer);
-            }
-
-            if(WICED_BT_GATT_CONGESTED == status)
-            {
-            app_bt_free_buffer((wiced_bt_buffer_t *)tput_buffer_ptr);
-            ulTaskNotifyTakeIndexed(TASK_NOTIFY_NO_GATT_CONGESTION,
-                                                            pdTRUE,
-                                                            portMAX_DELAY);
-            }
-            else if (WICED_BT_GATT_SUCCESS == status)
-            {
-             data_flag = data_flag == 0 ? 1 : 0 ;
-            }
+        return WICED_BT_GATT_ERROR;
+    }
+    memcpy(p_buffer, p_msg->data, p_msg->len);
+    request = p_msg->request;
+
+    stream_write.auth_req = GATT_AUTH_REQ_NONE;
+    stream_write.handle = p_msg->handle;
+    stream_write.len = p_msg->len;
+    stream_write.offset = 0;
+    /* Counted ahead of the call, as the completion may come first. Write
+     * requests are answered apart from the window */
+    if (!request)
+    {
+        tput_cwnd_on_sent();
+        tput_stream_on_sending(stream, p_msg->len);
     }
+    status = wiced_bt_gatt_client_send_write(conn_state_info.conn_id,
+                                    request ? GATT_REQ_WRITE : GATT_CMD_WRITE,
+                                    &stream_write, p_buffer,
+                                    (void *)app_bt_free_buffer);
+    if (WICED_BT_GATT_SUCCESS != status)
+    {
+        if (!request)
+        {
+            tput_cwnd_cancel_sent();
+            tput_stream_cancel_sending();
+        }
+        app_bt_free_buffer(p_buffer);
+        return status;
     }
+    tput_stream_on_sent(stream, 0u);
+    return status;
 }
 
 /*******************************************************************************
-* Function Name: tput_scan_led_update()
+* Function Name: tput_update_stream_stats()
 ********************************************************************************
-*
 * Summary:
-*   This function updates the scan LED state based on BLE scanning/
-*   connection state
+*   Prints the throughput and the queueing delay of the control and latency
+*   streams over the last second, next to the throughput of the writes of
+*   the data transfer mode, if any message was queued.
 *
 * Parameters:
-*   None
+*   uint32_t bulk_kbps : Throughput of the writes of the data transfer mode
 *
 * Return:
 *   None
 *
 *******************************************************************************/
-static void tput_scan_led_update(void)
+static void tput_update_stream_stats(uint32_t bulk_kbps)
 {
-    cy_rslt_t rslt = CY_RSLT_SUCCESS;
-    /* Stop the scan led pwm */
-    rslt = cyhal_pwm_stop(&scan_led_pwm);
-    if (CY_RSLT_SUCCESS != rslt)
+    tput_stream_stats_t stream_stats[TPUT_STREAM_BULK];
+    bool active = false;
+    uint32_t stream;
+
+    for (stream = 0; stream < TPUT_STREAM_BULK; stream++)
     {
-        printf("Failed to stop PWM !!\n");
-        CY_ASSERT(0);
+        tput_stream_get_stats((tput_stream_id_t)stream, &stream_stats[stream]);
+        active |= (stream_stats[stream].msgs || stream_stats[stream].dropped);
+    }
+    tput_stream_clear_stats();
+    if (!active)
+    {
+        return;
     }
 
-    /* Update LED state based on BLE scan/connection state.
-     * LED OFF for no scan/connection, LED blinking for scan state,
-     * LED ON for connected state  */
-    switch (app_bt_scan_conn_state)
+    for (stream = 0; stream < TPUT_STREAM_BULK; stream++)
     {
-    case APP_BT_SCAN_OFF_CONN_OFF:
-        rslt = cyhal_pwm_set_duty_cycle(&scan_led_pwm,
-                                        LED_OFF_DUTY_CYCLE,
-                                        SCAN_LED_PWM_FREQUENCY);
-        break;
+        STATS_PRINTF("STREAM %-11s: %lu kbps, %lu msgs, queueing delay avg "
+                     "%lu us max %lu us, queue max %u, dropped %lu\n",
+                     tput_stream_name((tput_stream_id_t)stream),
+                     (unsigned long)((stream_stats[stream].bytes * 8u) / 1000u),
+                     (unsigned long)stream_stats[stream].msgs,
+                     stream_stats[stream].msgs ?
+                     (unsigned long)(stream_stats[stream].delay_sum_us /
+                                     stream_stats[stream].msgs) : 0ul,
+                     (unsigned long)stream_stats[stream].delay_max_us,
+                     stream_stats[stream].max_depth,
+                     (unsigned long)stream_stats[stream].dropped);
+    }
+    STATS_PRINTF("STREAM %-11s: %lu kbps\n", tput_stream_name(TPUT_STREAM_BULK),
+                 (unsigned long)bulk_kbps);
+}
+#endif
 
-    case APP_BT_SCAN_ON_CONN_OFF:
-        rslt = cyhal_pwm_set_duty_cycle(&scan_led_pwm,
-                                        LED_BLINKING_DUTY_CYCLE,
-                                        SCAN_LED_PWM_FREQUENCY);
-        break;
+#if TPUT_BRIDGE_ENABLE
+/*******************************************************************************
+* Function Name: tput_update_bridge_stats()
+********************************************************************************
+* Summary:
+*   Prints the throughput of the UART bridge over the last second, the
+*   payloads that waited for a free buffer, and the bytes dropped.
+*
+* Parameters:
+*   None
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+static void tput_update_bridge_stats(void)
+{
+    tput_bridge_stats_t bridge_stats;
+
+    tput_bridge_get_stats(&bridge_stats);
+    tput_bridge_clear_stats();
+    STATS_PRINTF("UART BRIDGE       : %lu kbps, %lu transfers, backpressure %lu, "
+                 "dropped %lu bytes (%lu pkts), errors %lu\n",
+                 (unsigned long)((bridge_stats.bytes * 8u) / 1000u),
+                 (unsigned long)bridge_stats.transfers,
+                 (unsigned long)bridge_stats.backpressure_events,
+                 (unsigned long)bridge_stats.dropped_bytes,
+                 (unsigned long)bridge_stats.dropped_pkts,
+                 (unsigned long)bridge_stats.tx_errors);
+}
+#endif
 
-    case APP_BT_SCAN_OFF_CONN_ON:
-        rslt = cyhal_pwm_set_duty_cycle(&scan_led_pwm,
-                                        LED_ON_DUTY_CYCLE,
-                                        SCAN_LED_PWM_FREQUENCY);
-        break;
+/*******************************************************************************
+* Function Name: tput_update_relay_stats()
+********************************************************************************
+* Summary:
+*   Prints the relay throughput, the writes in flight, the payloads queued
+*   in the RX ring, and the latency added by the relay over the last second.
+*
+* Parameters:
+*   None
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+static void tput_update_relay_stats(void)
+{
+    tput_relay_stats_t relay_stats;
+    tput_rx_ring_stats_t rx_ring_stats;
+
+    tput_relay_get_stats(&relay_stats);
+    tput_relay_clear_stats();
+    tput_rx_ring_get_stats(&rx_ring_stats);
+    STATS_PRINTF("RELAY             : %lu kbps, %lu pkts, queued %u (max %u), "
+                 "in flight %u (max %u), latency avg %lu us, min %lu us, "
+                 "max %lu us, failed %lu, congested %lu\n",
+                 (unsigned long)((relay_stats.bytes * 8u) / 1000u),
+                 (unsigned long)relay_stats.pkts,
+                 rx_ring_stats.lag, rx_ring_stats.max_lag,
+                 relay_stats.in_flight, relay_stats.max_in_flight,
+                 relay_stats.pkts ?
+                    (unsigned long)(relay_stats.latency_sum_us / relay_stats.pkts) :
+                    0ul,
+                 relay_stats.pkts ? (unsigned long)relay_stats.latency_min_us : 0ul,
+                 (unsigned long)relay_stats.latency_max_us,
+                 (unsigned long)relay_stats.failures,
+                 (unsigned long)relay_stats.congested);
+}
 
-    default:
-        /* LED OFF for unexpected states */
-        rslt = cyhal_pwm_set_duty_cycle(&scan_led_pwm,
-                                        LED_OFF_DUTY_CYCLE,
-                                        SCAN_LED_PWM_FREQUENCY);
-        break;
-    }
-    /* Check if update to PWM parameters is successful*/
-    if (CY_RSLT_SUCCESS != rslt)
+#if TPUT_EATT_ENABLE
+/*******************************************************************************
+* Function Name: tput_update_eatt_stats()
+********************************************************************************
+* Summary:
+*   Prints the throughput and write request latency of every EATT bearer
+*   over the last second, and their total.
+*
+* Parameters:
+*   None
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+static void tput_update_eatt_stats(void)
+{
+    tput_eatt_bearer_stats_t eatt_stats[TPUT_EATT_NUM_BEARERS];
+    uint32_t num_bearers;
+    unsigned long total_bytes = 0;
+    unsigned long total_writes = 0;
+
+    num_bearers = tput_eatt_get_stats(eatt_stats, TPUT_EATT_NUM_BEARERS);
+    tput_eatt_clear_stats();
+    if (!tput_eatt_is_running())
     {
-        printf("Failed to set duty cycle parameters!!\n");
+        return;
     }
-
-    /* Start the scan led pwm */
-    rslt = cyhal_pwm_start(&scan_led_pwm);
-
-    /* Check if PWM started successfully */
-    if (CY_RSLT_SUCCESS != rslt)
+    for (uint32_t bearer = 0; bearer < num_bearers; bearer++)
     {
-        printf("Failed to start PWM !!\n");
-        CY_ASSERT(0);
+        tput_eatt_bearer_stats_t *p_stats = &eatt_stats[bearer];
+
+        STATS_PRINTF("EATT BEARER %lu     : conn %u, MTU %u, %lu kbps, %lu writes,"
+                     " %lu failed, latency avg %lu us, min %lu us, max %lu us\n",
+                     (unsigned long)bearer, p_stats->conn_id, p_stats->mtu,
+                     (unsigned long)((p_stats->bytes * 8u) / 1000u),
+                     (unsigned long)p_stats->writes,
+                     (unsigned long)p_stats->failures,
+                     p_stats->writes ?
+                        (unsigned long)(p_stats->latency_sum_us / p_stats->writes) :
+                        0ul,
+                     p_stats->writes ? (unsigned long)p_stats->latency_min_us : 0ul,
+                     (unsigned long)p_stats->latency_max_us);
+        total_bytes += p_stats->bytes;
+        total_writes += p_stats->writes;
     }
+    STATS_PRINTF("EATT TOTAL        : %lu kbps, %lu writes over %lu bearers\n",
+                 (total_bytes * 8u) / 1000u, total_writes,
+                 (unsigned long)num_bearers);
 }
+#endif
 
 /*******************************************************************************
-* Function Name: tput_enable_disable_gatt_notification()
+* Function Name: tput_get_model_phy()
 ********************************************************************************
 * Summary:
-*   Enable or disable  GATT notification from the server.
+*   Converts a PHY reported by the stack to the PHY of the throughput model,
+*   with the coding requested for the Coded PHY (see tput_set_phy()).
 *
 * Parameters:
-*   bool notify : Boolean variable to enable/disable notification.
+*   uint8_t hci_phy : 1 (1M), 2 (2M) or 3 (Coded), 0 before the first PHY
+*                     update
 *
 * Return:
-*   wiced_bt_gatt_status_t  : Status code from wiced_bt_gatt_status_e.
+*   tput_model_phy_t : PHY
 *
 *******************************************************************************/
-static wiced_bt_gatt_status_t tput_enable_disable_gatt_notification(bool notify)
+static tput_model_phy_t tput_get_model_phy(uint8_t hci_phy)
 {
-    wiced_bt_gatt_write_hdr_t tput_write_notif = {0};
-    wiced_bt_gatt_status_t status = WICED_BT_GATT_SUCCESS;
-    uint8_t local_notif_enable[CCCD_LENGTH] = {0};
-    uint8_t *notif_val = NULL;
-    /*Allocate memory for data to be written on server DB and pass it to stack*/
-    notif_val = app_bt_alloc_buffer(sizeof(uint16_t)); //CCCD is two bytes
-    if (notif_val)
-    {
-        local_notif_enable[0] = notify;
-        memcpy(notif_val, local_notif_enable, sizeof(uint16_t));
-        tput_write_notif.auth_req = GATT_AUTH_REQ_NONE;
-        tput_write_notif.handle = tput_service_handle + GATT_CCCD_HANDLE;
-        tput_write_notif.len = CCCD_LENGTH;
-        tput_write_notif.offset = 0;
-        status = wiced_bt_gatt_client_send_write(conn_state_info.conn_id,
-                                                GATT_REQ_WRITE,
-                                                &tput_write_notif,
-                                        notif_val,(void *)app_bt_free_buffer);
-    }
-    else
+    switch (hci_phy)
     {
-        printf("malloc failed! write request not sent\n");
-        status = WICED_BT_GATT_ERROR;
+    case 0:
+        return conn_phy;
+    case TPUT_MODEL_PHY_2M:
+        return TPUT_MODEL_PHY_2M;
+    case TPUT_MODEL_PHY_CODED_S8:
+        return (BTM_BLE_PREFER_LELR_512K == coded_phy_opts) ?
+               TPUT_MODEL_PHY_CODED_S2 : TPUT_MODEL_PHY_CODED_S8;
+    default:
+        return TPUT_MODEL_PHY_1M;
     }
-    return status;
 }
 
+#if TPUT_EXT_SCAN_ENABLE
 /*******************************************************************************
-* Function Name: tput_get_write_cmd_pkt_size()
+* Function Name: tput_ext_scan_configure()
 ********************************************************************************
-* Summary: This function decides size of notification packet based on the
-*   attribute MTU exchanged. This is done to utilize the LL payload space
-*   effectively.
+* Summary:
+*   Configures the extended scan and the connection initiation, used by the
+*   next wiced_bt_ble_scan() and wiced_bt_gatt_le_connect(), on the PHYs
+*   selected with tput_set_scan_phys(). The same parameters are used on
+*   each PHY.
 *
 * Parameters:
-*   uint16_t att_mtu_size: MTU value exchaged after connection.
+*   None
 *
 * Return:
-*   uint16_t: Size of notification packet derived based on MTU.
+*   None
 *
 *******************************************************************************/
-static uint16_t tput_get_write_cmd_pkt_size(uint16_t att_mtu_size)
+static void tput_ext_scan_configure(void)
 {
-    if (att_mtu_size < DATA_PACKET_SIZE_1 + ATT_HEADER)
+    wiced_bt_ble_ext_scan_config_t scan_cfg = {0};
+    wiced_bt_ble_ext_conn_cfg_t conn_cfg = {0};
+    wiced_bt_ble_ext_adv_phy_mask_t phys;
+    uint32_t i;
+
+    phys = scan_coded_only ? WICED_BLE_EXT_ADV_PHY_LE_CODED_BIT :
+           (WICED_BLE_EXT_ADV_PHY_1M_BIT | WICED_BLE_EXT_ADV_PHY_LE_CODED_BIT);
+
+    scan_cfg.scanning_phys = phys;
+    scan_cfg.enc_phy_scan_type = BTM_BLE_SCAN_MODE_ACTIVE;
+    scan_cfg.enc_phy_scan_int = TPUT_EXT_SCAN_INTERVAL;
+    scan_cfg.enc_phy_scan_win = TPUT_EXT_SCAN_WINDOW;
+    scan_cfg.dec_phy_scan_type = BTM_BLE_SCAN_MODE_ACTIVE;
+    scan_cfg.dec_phy_scan_int = TPUT_EXT_SCAN_INTERVAL;
+    scan_cfg.dec_phy_scan_win = TPUT_EXT_SCAN_WINDOW;
+    if (WICED_BT_SUCCESS != wiced_bt_ble_cache_ext_scan_config(&scan_cfg))
     {
-        /* Packet Length = ATT_MTU_SIZE - ATT_HANDLE(2 bytes)-ATT_OPCODE(1 byte)
-        * Reason: With DLE enabled, LL payload is 251 bytes. So if an MTU less
-        * than 247 is exchanged, the data can be accommodated in a single LL
-        * packet */
-        packet_size = att_mtu_size - ATT_HEADER;
+        printf("Extended scan configuration failed\n");
     }
-    else if ((att_mtu_size >= DATA_PACKET_SIZE_1 + ATT_HEADER) &&
-                    (att_mtu_size < DATA_PACKET_SIZE_2 + ATT_HEADER))
+
+    /* The arrays hold the parameters of the 1M, 2M and Coded PHYs */
+    conn_cfg.initiating_phys = phys;
+    for (i = 0; i < 3u; i++)
     {
-        /* If MTU is between 247 and 498, if a packet size other than 244 bytes
-         * is used, the data will be split and the LL payload space is not
-         * utilized effectively. Refer README for details */
-        packet_size = DATA_PACKET_SIZE_1;
+        conn_cfg.scan_int[i] = TPUT_EXT_SCAN_INTERVAL;
+        conn_cfg.scan_window[i] = TPUT_EXT_SCAN_WINDOW;
+        conn_cfg.min_conn_int[i] = TPUT_EXT_CONN_MIN_INTERVAL;
+        conn_cfg.max_conn_int[i] = TPUT_EXT_CONN_MAX_INTERVAL;
+        conn_cfg.conn_latency[i] = TPUT_CONN_LATENCY;
+        conn_cfg.supervision_to[i] = TPUT_SUPERVISION_TIMEOUT;
     }
-    else
+    if (WICED_BT_SUCCESS != wiced_bt_ble_cache_ext_conn_config(&conn_cfg))
     {
-        /*For MTU value greater than 498, if a packet size other than 495(or244)
-         * is used, the LL payload space is not utilized effectively.
-         * 495 bytes will go as two LL packets: 244 bytes + 251 bytes */
-        packet_size = DATA_PACKET_SIZE_2;
+        printf("Extended connection configuration failed\n");
     }
-    return packet_size;
 }
+#endif
+
 /* [] END OF FILE */
@@ -83,9 +83,101 @@
 #define DATA_PACKET_SIZE_2               (495u)
 #define ATT_HEADER                       (3u)
 
+/* Peripheral latency and supervision timeout (in units of 10 ms) requested
+ * along with a new connection interval */
+#define TPUT_CONN_LATENCY                (0u)
+#define TPUT_SUPERVISION_TIMEOUT         (500u)
+
 /* Handle to write field in GATT DB */
 #define GATT_WRITE_HANDLE               (5)
 
+/* Set to 1 to hand GATT notification payloads to rx_sink_task through the
+ * RX ring (tput_rx_ring.h). Set to 0 to only count received bytes */
+#ifndef TPUT_RX_SINK_ENABLE
+#define TPUT_RX_SINK_ENABLE             (1)
+#endif
+
+/* Set to 1 to print the persistent result log (tput_result_log.h) as CSV
+ * at startup. The console command "log dump" prints it at any time */
+#ifndef TPUT_RESULT_LOG_DUMP_AT_BOOT
+#define TPUT_RESULT_LOG_DUMP_AT_BOOT    (0)
+#endif
+
+/* Set to 1 to send the statistics as binary telemetry frames
+ * (tput_telemetry.h) instead of printing them every second. Decode the
+ * frames with scripts/tput_telemetry.py */
+#ifndef TPUT_TELEMETRY_ENABLE
+#define TPUT_TELEMETRY_ENABLE           (0)
+#endif
+
+/* Set by the microbenchmark build, "make build UBENCH=1", which adds the
+ * console command "ubench" (tput_ubench.h) */
+#ifndef TPUT_UBENCH_BUILD
+#define TPUT_UBENCH_BUILD               (0)
+#endif
+
+/* Set to 1 to support recording the GATT and management events and
+ * replaying them to the handlers (tput_evrec.h), controlled with the
+ * console command "evrec" */
+#ifndef TPUT_EVREC_ENABLE
+#define TPUT_EVREC_ENABLE               (0)
+#endif
+
+/* Set to 1 to support streaming the notification payloads to a UART
+ * (tput_bridge.h), controlled with the console command "bridge" */
+#ifndef TPUT_BRIDGE_ENABLE
+#define TPUT_BRIDGE_ENABLE              (0)
+#endif
+
+/* Set to 1 to support writes over several Enhanced ATT bearers in parallel
+ * (tput_eatt.h), controlled with the console command "eatt". Requires a
+ * stack with EATT support and an encrypted link to a server supporting it */
+#ifndef TPUT_EATT_ENABLE
+#define TPUT_EATT_ENABLE                (0)
+#endif
+
+/* Set to 1 to request the 2M PHY and the maximum data length together with
+ * the MTU exchange on connection, and to start the data transfer mode
+ * selected by TPUT_AUTO_START_MODE as soon as the service is discovered.
+ * Set to 0 for the sequential bring-up, which waits 2 seconds before
+ * writing the CCCD (tput_bringup.h reports the time to first byte) */
+#ifndef TPUT_PIPELINED_BRINGUP
+#define TPUT_PIPELINED_BRINGUP          (1)
+#endif
+
+/* Data transfer mode (1 to 5) started once the throughput service is
+ * discovered, without pressing the user button. 0 waits for the button */
+#ifndef TPUT_AUTO_START_MODE
+#define TPUT_AUTO_START_MODE            (0)
+#endif
+
+/* Set to 1 to send the writes through the prioritized TX arbiter
+ * (tput_stream.h), which sends control and latency sensitive messages ahead
+ * of, or interleaved with, the writes of the data transfer mode, without
+ * stopping them, controlled with the console command "stream" */
+#ifndef TPUT_STREAM_ENABLE
+#define TPUT_STREAM_ENABLE              (0)
+#endif
+
+/* Set to 1 to scan and connect with the extended advertising procedures,
+ * on the 1M and LE Coded PHYs, or only on the LE Coded PHY (console command
+ * "scan on coded"). Requires a stack and controller built with extended
+ * advertising support */
+#ifndef TPUT_EXT_SCAN_ENABLE
+#define TPUT_EXT_SCAN_ENABLE            (0)
+#endif
+
+/* Extended scan interval and window, in units of 0.625 ms, and connection
+ * interval limits, in units of 1.25 ms, used on every PHY */
+#define TPUT_EXT_SCAN_INTERVAL          (96u)
+#define TPUT_EXT_SCAN_WINDOW            (96u)
+#define TPUT_EXT_CONN_MIN_INTERVAL      (6u)
+#define TPUT_EXT_CONN_MAX_INTERVAL      (40u)
+
+/* Data length requested on connection by the pipelined bring-up */
+#define TPUT_BRINGUP_TX_OCTETS          (251u)
+#define TPUT_BRINGUP_TX_TIME_US         (2120u)
+
 /*******************************************************************************
 *        Structures and Enumerations
 *******************************************************************************/
@@ -97,6 +189,10 @@ typedef struct
     double                     conn_interval; // connection interval negotiated
     wiced_bt_ble_host_phy_preferences_t   rx_phy; // RX PHY selected
     wiced_bt_ble_host_phy_preferences_t   tx_phy; // TX PHY selected
+    uint16_t                   max_tx_octets; // LL payload length (DLE), TX
+    uint16_t                   max_rx_octets; // LL payload length (DLE), RX
+    uint16_t                   max_tx_time;   // LL PDU time (DLE) in us, TX
+    uint16_t                   max_rx_time;   // LL PDU time (DLE) in us, RX
 
 } conn_state_info_t;
 
@@ -104,9 +200,18 @@ typedef enum
 {
     GATT_NOTIF_STOC,         /* Server to Client Notifications */
     GATT_WRITE_CTOS,         /* Client to Server GATT writes   */
-    GATT_NOTIFANDWRITE       /* Both Notifications and GATT writes */
+    GATT_NOTIFANDWRITE,      /* Both Notifications and GATT writes */
+    GATT_BLOB_CTOS,          /* Client to Server blob transfer */
+    GATT_RECORDS_CTOS        /* Client to Server small records, coalesced */
 }tput_mode_t;
 
+/* Mode after which the user button rolls back to GATT_NOTIF_STOC */
+#define TPUT_MODE_LAST                  (GATT_RECORDS_CTOS)
+
+/* Function called on GATT_APP_BUFFER_TRANSMITTED_EVT to release a buffer
+ * passed to the stack */
+typedef void (*pfn_free_buffer_t)(uint8_t *p_buf);
+
 /* PWM Duty Cycle of LED's for different states */
 typedef enum
 {
@@ -124,9 +229,20 @@ typedef enum
     APP_BT_SCAN_OFF_CONN_ON
 } app_bt_scan_conn_mode_t;
 
+/* Notification totals since connection, see tput_get_rx_totals() */
+typedef struct
+{
+    uint32_t rx_bytes;          // received in the GATT callback
+    uint32_t rx_pkts;
+    uint32_t consumed_bytes;    // processed by rx_sink_task
+    uint32_t consumed_pkts;
+} tput_rx_totals_t;
+
 extern TaskHandle_t ble_button_task_handle;
 extern TaskHandle_t get_throughput_task_handle;
 extern TaskHandle_t send_gatt_write_task_handle;
+extern TaskHandle_t rx_sink_task_handle;
+extern TaskHandle_t telemetry_task_handle;
 /****************************************************************************
  *                              FUNCTION DECLARATIONS
  ***************************************************************************/
@@ -136,6 +252,48 @@ wiced_bt_dev_status_t  app_bt_management_callback(wiced_bt_management_evt_t even
 void ble_button_task(void *pvParam);
 void get_throughput_task(void *pvParam);
 void send_gatt_write_task(void *pvParam);
+void rx_sink_task(void *pvParam);
+void telemetry_task(void *pvParam);
+
+/* Control functions used by the user button and the command console. Except
+ * for tput_scan_start() and tput_set_coalesce_deadline(), they must be called
+ * while connected. The scan, connection, mode, packet size and connection
+ * interval functions take a lock, so they may be called from several tasks
+ * but not from the stack callbacks; tput_control_init() creates the lock */
+void tput_control_init(void);
+wiced_result_t tput_scan_start(void);
+wiced_result_t tput_scan_stop(void);
+bool tput_connect(wiced_bt_device_address_t bd_addr,
+                  wiced_bt_ble_address_type_t addr_type);
+void tput_connect_abandon(void);
+wiced_bt_gatt_status_t tput_disconnect(void);
+wiced_bt_gatt_status_t tput_set_mode(tput_mode_t mode);
+bool tput_set_packet_size(uint16_t size);
+void tput_set_coalesce_deadline(uint16_t deadline_ms);
+wiced_bt_dev_status_t tput_set_phy(wiced_bt_ble_host_phy_preferences_t phys,
+                            wiced_bt_ble_lecoded_phy_preferences_t phy_opts);
+bool tput_set_conn_interval(uint16_t min_interval, uint16_t max_interval);
+void tput_clear_stats(void);
+void tput_print_status(void);
+bool tput_get_rx_totals(tput_rx_totals_t *p_totals);
+bool tput_set_relay(bool on, uint16_t conn_id);
+#if TPUT_EXT_SCAN_ENABLE
+void tput_set_scan_phys(bool coded_only);
+#endif
+#if TPUT_BRIDGE_ENABLE
+bool tput_set_bridge(bool on);
+#endif
+#if TPUT_EVREC_ENABLE
+bool tput_record_events(bool on);
+bool tput_replay_events(void);
+#endif
+#if TPUT_UBENCH_BUILD
+bool tput_run_ubench(uint32_t calls);
+#endif
+#if TPUT_EATT_ENABLE
+wiced_bt_gatt_status_t tput_open_eatt_bearers(void);
+bool tput_set_eatt_writes(bool on);
+#endif
 
 #endif      /*__BLE_CLIENT_H__ */
 /* [] END OF FILE */
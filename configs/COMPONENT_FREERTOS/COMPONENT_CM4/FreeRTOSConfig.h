@@ -236,4 +236,19 @@ extern void vApplicationSleep( uint32_t xExpectedIdleTime );
  */
 #define configUSE_NEWLIB_REENTRANT              1
 
+/* Record the context switches in the trace of the application when it is
+ * built with DEFINES+=TPUT_TRACE_ENABLE=1 (see tput_trace.h) */
+#if defined(TPUT_TRACE_ENABLE) && (TPUT_TRACE_ENABLE)
+extern void tput_trace_task_switched_in(uint32_t task_number);
+#define traceTASK_SWITCHED_IN() \
+            tput_trace_task_switched_in((uint32_t)pxCurrentTCB->uxTCBNumber)
+#endif
+
+/* Check that no heap allocation is made while connected when the application
+ * is built with DEFINES+=TPUT_STATIC_ALLOC=1 (see tput_mem.h) */
+#if defined(TPUT_STATIC_ALLOC) && (TPUT_STATIC_ALLOC)
+extern void tput_mem_on_heap_alloc(size_t size);
+#define traceMALLOC( pvAddress, uiSize )    tput_mem_on_heap_alloc( uiSize )
+#endif
+
 #endif /* FREERTOS_CONFIG_H */
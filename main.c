@@ -43,6 +43,8 @@
 *        Header Files
 *******************************************************************************/
 #include "ble_client.h"
+#include "tput_console.h"
+#include "tput_mem.h"
 #include "wiced_bt_stack.h"
 #include "cy_retarget_io.h"
 #include <FreeRTOS.h>
@@ -55,18 +57,76 @@
 *******************************************************************************/
 #define TASK_PRIORITY                   ( configMAX_PRIORITIES - 4 )
 #define TASK_STACK_SIZE                 ( configMINIMAL_STACK_SIZE * 4 )
+/* The console only runs when the data path tasks are idle */
+#define CONSOLE_TASK_PRIORITY           ( tskIDLE_PRIORITY + 1 )
 #define BUTTON_TASK_STRING                     "BLE button Task"
 #define THROUGHPUT_TASK_STRING                 "Throughput Task"
 #define MILLISEC_TASK_STRING                   "Millisec Task"
+#define RX_SINK_TASK_STRING                    "RX Sink Task"
+#define CONSOLE_TASK_STRING                    "Console Task"
+#define TELEMETRY_TASK_STRING                  "Telemetry Task"
+/* Tasks created by main(), for the static task memory */
+#define NUM_APP_TASKS                   ( 5u + TPUT_TELEMETRY_ENABLE )
 
 /*Handle for the task*/
 TaskHandle_t ble_button_task_handle;
 TaskHandle_t get_throughput_task_handle;
 TaskHandle_t send_gatt_write_task_handle;
+TaskHandle_t rx_sink_task_handle;
+TaskHandle_t console_task_handle;
+TaskHandle_t telemetry_task_handle;
+
+#if TPUT_STATIC_ALLOC
+/* Stacks and control blocks of the tasks, allocated statically in the
+ * zero-heap mode */
+static StackType_t app_task_stacks[NUM_APP_TASKS][TASK_STACK_SIZE];
+static StaticTask_t app_task_tcbs[NUM_APP_TASKS];
+static uint32_t num_app_tasks = 0;
+#endif
 
 /******************************************************************************
  *                          Function Definitions
  ******************************************************************************/
+
+/*******************************************************************************
+* Function Name: app_task_create()
+********************************************************************************
+* Summary:
+*   Creates an application task. With TPUT_STATIC_ALLOC, its stack and
+*   control block are taken from static memory instead of the heap.
+*
+* Parameters:
+*   TaskFunction_t task_fn : Task function
+*   const char *name       : Task name
+*   UBaseType_t priority   : Task priority
+*   TaskHandle_t *p_handle : Handle of the task created
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+static void app_task_create(TaskFunction_t task_fn, const char *name,
+                            UBaseType_t priority, TaskHandle_t *p_handle)
+{
+#if TPUT_STATIC_ALLOC
+    CY_ASSERT(num_app_tasks < NUM_APP_TASKS);
+    *p_handle = xTaskCreateStatic(task_fn, name, TASK_STACK_SIZE, NULL,
+                                  priority, app_task_stacks[num_app_tasks],
+                                  &app_task_tcbs[num_app_tasks]);
+    num_app_tasks++;
+    if (NULL == *p_handle)
+    {
+        CY_ASSERT(0) ;
+    }
+#else
+    if (pdPASS != xTaskCreate(task_fn, name, TASK_STACK_SIZE, NULL, priority,
+                              p_handle))
+    {
+        CY_ASSERT(0) ;
+    }
+#endif
+}
+
 /*
  *  Entry point to the application. Set device configuration and start BT
  *  stack initialization.  The actual application initialization will happen
@@ -76,7 +136,6 @@ int main()
 {
     cy_rslt_t rslt;
     wiced_result_t result;
-    BaseType_t rtos_result;
 
     /* Initialize the board support package */
     rslt = cybsp_init();
@@ -107,32 +166,23 @@ int main()
         CY_ASSERT(0);
     }
 
-    rtos_result = xTaskCreate(ble_button_task,BUTTON_TASK_STRING,
-                                TASK_STACK_SIZE,
-                                NULL, TASK_PRIORITY,
-                                &ble_button_task_handle);
-    if(pdPASS != rtos_result)
-    {
-        CY_ASSERT(0) ;
-    }
+    /* The control functions are called from several tasks */
+    tput_control_init();
 
-    rtos_result = xTaskCreate(get_throughput_task,THROUGHPUT_TASK_STRING,
-                                TASK_STACK_SIZE,
-                                NULL, TASK_PRIORITY,
-                                &get_throughput_task_handle);
-    if(pdPASS != rtos_result)
-    {
-        CY_ASSERT(0) ;
-    }
-
-    rtos_result = xTaskCreate(send_gatt_write_task,MILLISEC_TASK_STRING,
-                                TASK_STACK_SIZE,
-                                NULL,TASK_PRIORITY,
-                                &send_gatt_write_task_handle);
-    if(pdPASS != rtos_result)
-    {
-        CY_ASSERT(0) ;
-    }
+    app_task_create(ble_button_task, BUTTON_TASK_STRING, TASK_PRIORITY,
+                    &ble_button_task_handle);
+    app_task_create(get_throughput_task, THROUGHPUT_TASK_STRING,
+                    TASK_PRIORITY, &get_throughput_task_handle);
+    app_task_create(send_gatt_write_task, MILLISEC_TASK_STRING, TASK_PRIORITY,
+                    &send_gatt_write_task_handle);
+    app_task_create(rx_sink_task, RX_SINK_TASK_STRING, TASK_PRIORITY,
+                    &rx_sink_task_handle);
+    app_task_create(console_task, CONSOLE_TASK_STRING, CONSOLE_TASK_PRIORITY,
+                    &console_task_handle);
+#if TPUT_TELEMETRY_ENABLE
+    app_task_create(telemetry_task, TELEMETRY_TASK_STRING, TASK_PRIORITY,
+                    &telemetry_task_handle);
+#endif
 
     /* Start the FreeRTOS scheduler */
     vTaskStartScheduler() ;
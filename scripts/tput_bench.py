@@ -0,0 +1,119 @@
+#!/usr/bin/env python3
+#
+# Extracts the results of the "bench" console command (tput_bench.c) from
+# captured console logs, and compares two firmware builds: the mean
+# throughput of each mode is compared with Welch's t-test on the trial
+# means, and the difference is reported with its 95% confidence interval.
+#
+# Usage:
+#   tput_bench.py console.log                    summarize the benchmarks
+#   tput_bench.py baseline.log candidate.log     compare two builds
+#
+# A mode benchmarked several times in a log is summarized from all of its
+# steady trials.
+#
+# Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+# an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+# See the LICENSE file of this repository for the terms of use.
+
+import argparse
+import math
+import statistics
+import sys
+
+PREFIX = 'bench,'
+
+# Two-sided 95% quantiles of Student's t distribution, by degrees of
+# freedom from 1 to 30, as in tput_bench.c
+T95 = [12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262,
+       2.228, 2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101,
+       2.093, 2.086, 2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052,
+       2.048, 2.045, 2.042]
+
+
+def t95(df):
+    """Quantile for fractional degrees of freedom, rounded down."""
+    df = int(df)
+    if df < 1:
+        return float('inf')
+    return T95[df - 1] if df <= len(T95) else 1.96
+
+
+def read_trials(path):
+    """Returns the means of the steady trials in the log, by mode."""
+    header = None
+    trials = {}
+    with open(path, errors='replace') as stream:
+        for line in stream:
+            line = line.strip()
+            if not line.startswith(PREFIX):
+                continue
+            fields = line[len(PREFIX):].split(',')
+            if fields[0] == 'mode':
+                header = fields
+            elif header is not None and len(fields) == len(header):
+                row = dict(zip(header, fields))
+                if row['steady'] == '1':
+                    trials.setdefault(int(row['mode']), []).append(
+                        float(row['mean_kbps']))
+    return trials
+
+
+def summary(values):
+    """Returns the mean, standard deviation and 95% CI half-width."""
+    mean = statistics.mean(values)
+    if len(values) < 2:
+        return mean, 0.0, float('nan')
+    sd = statistics.stdev(values)
+    return mean, sd, t95(len(values) - 1) * sd / math.sqrt(len(values))
+
+
+def compare(base, cand):
+    """Returns the difference of the means, its 95% CI half-width and the
+    Welch degrees of freedom."""
+    var_b = statistics.variance(base) / len(base)
+    var_c = statistics.variance(cand) / len(cand)
+    diff = statistics.mean(cand) - statistics.mean(base)
+    if var_b + var_c == 0:
+        return diff, 0.0, float('inf')
+    df = (var_b + var_c) ** 2 / (var_b ** 2 / (len(base) - 1) +
+                                 var_c ** 2 / (len(cand) - 1))
+    return diff, t95(df) * math.sqrt(var_b + var_c), df
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description='Summarize or compare throughput client benchmarks')
+    parser.add_argument('log', help='captured console log')
+    parser.add_argument('candidate', nargs='?',
+                        help='console log of the build compared with log')
+    args = parser.parse_args()
+
+    base = read_trials(args.log)
+    if not base:
+        sys.exit('no steady benchmark trials found in ' + args.log)
+
+    if args.candidate is None:
+        print('mode  trials  mean kbps    sd kbps  95% CI kbps')
+        for mode in sorted(base):
+            mean, sd, half = summary(base[mode])
+            print('%4d  %6d  %9.2f  %9.2f  %.2f .. %.2f' %
+                  (mode, len(base[mode]), mean, sd, mean - half, mean + half))
+        return
+
+    cand = read_trials(args.candidate)
+    print('mode  baseline kbps  candidate kbps  difference (95% CI)')
+    for mode in sorted(set(base) & set(cand)):
+        if len(base[mode]) < 2 or len(cand[mode]) < 2:
+            print('%4d  needs at least 2 steady trials in each log' % mode)
+            continue
+        diff, half, _ = compare(base[mode], cand[mode])
+        verdict = ('no significant change' if abs(diff) <= half else
+                   'faster' if diff > 0 else 'slower')
+        print('%4d  %13.2f  %14.2f  %+.2f (%+.2f .. %+.2f) %s' %
+              (mode, statistics.mean(base[mode]), statistics.mean(cand[mode]),
+               diff, diff - half, diff + half, verdict))
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,123 @@
+#!/usr/bin/env python3
+#
+# Handles the event recordings of the throughput client (tput_evrec.c):
+# extracts a recording printed by the "evrec dump" console command into a
+# binary file, lists the records of a file, and converts a file into the
+# console commands that load it back for "evrec replay".
+#
+# Usage:
+#   tput_evrec.py extract console.log rec.bin   save the last dump in the log
+#   tput_evrec.py info rec.bin                  list the records
+#   tput_evrec.py load rec.bin > commands.txt   console commands loading it
+#
+# The commands written by "load" are sent to the console one line at a
+# time, waiting for "OK" after each.
+#
+# Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+# an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+# See the LICENSE file of this repository for the terms of use.
+
+import argparse
+import collections
+import struct
+import sys
+
+VERSION = 1
+FILE_HDR = struct.Struct('<3sBHH')
+REC_HDR = struct.Struct('<BBHI')
+CHECK = struct.Struct('<II')
+SOURCES = ('gatt', 'mgmt', 'check')
+GATT_EVENTS = ('CONNECTION_STATUS', 'OPERATION_CPLT', 'DISCOVERY_RESULT',
+               'DISCOVERY_CPLT', 'ATTRIBUTE_REQUEST', 'CONGESTION',
+               'GET_RESPONSE_BUFFER', 'APP_BUFFER_TRANSMITTED')
+# Bytes per "evrec load" command, to fit the 64 character console line
+LOAD_BYTES = 26
+
+
+def extract(stream):
+    """Returns the last recording dumped in the log."""
+    data = None
+    for line in stream:
+        line = line.strip()
+        if line.startswith('evrec_start,'):
+            data = bytearray()
+        elif line.startswith('evrec,') and data is not None:
+            data += bytes.fromhex(line[len('evrec,'):])
+    return data
+
+
+def records(data):
+    """Yields the header of every record and its data."""
+    magic, version, _, _ = FILE_HDR.unpack_from(data)
+    if magic != b'TEV' or version != VERSION:
+        sys.exit('not an event recording, or of another version')
+    offset = FILE_HDR.size
+    while offset + REC_HDR.size <= len(data):
+        src, event, length, delta_us = REC_HDR.unpack_from(data, offset)
+        offset += REC_HDR.size
+        if offset + length > len(data):
+            sys.exit('truncated record at %d' % offset)
+        yield src, event, delta_us, data[offset:offset + length]
+        offset += length
+
+
+def event_name(src, event):
+    if src == 0 and event < len(GATT_EVENTS):
+        return GATT_EVENTS[event]
+    return '%s %d' % (SOURCES[src] if src < len(SOURCES) else src, event)
+
+
+def info(data):
+    counts = collections.Counter()
+    time_us = 0
+    for src, event, delta_us, payload in records(data):
+        time_us += delta_us
+        if src == 2:
+            rx_bytes, rx_pkts = CHECK.unpack_from(payload)
+            print('%12.6f  check: rx %d bytes, %d pkts' %
+                  (time_us / 1e6, rx_bytes, rx_pkts))
+        else:
+            counts[event_name(src, event)] += 1
+    print('%d bytes, %.3f s' % (len(data), time_us / 1e6))
+    for name, count in counts.most_common():
+        print('%8d  %s' % (count, name))
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description='Extract, list or load throughput client event recordings')
+    sub = parser.add_subparsers(dest='command', required=True)
+    p_extract = sub.add_parser('extract', help='save a dump from a console log')
+    p_extract.add_argument('log', help='captured console log, or - for stdin')
+    p_extract.add_argument('out', help='recording file written')
+    p_info = sub.add_parser('info', help='list the records of a recording')
+    p_info.add_argument('file')
+    p_load = sub.add_parser('load', help='write the console commands loading '
+                            'a recording')
+    p_load.add_argument('file')
+    args = parser.parse_args()
+
+    if args.command == 'extract':
+        if args.log == '-':
+            data = extract(sys.stdin)
+        else:
+            with open(args.log, errors='replace') as stream:
+                data = extract(stream)
+        if data is None:
+            sys.exit('no recording found in ' + args.log)
+        with open(args.out, 'wb') as out:
+            out.write(data)
+        return
+
+    with open(args.file, 'rb') as stream:
+        data = stream.read()
+    if args.command == 'info':
+        info(data)
+    else:
+        print('evrec clear')
+        for offset in range(0, len(data), LOAD_BYTES):
+            print('evrec load ' + data[offset:offset + LOAD_BYTES].hex())
+
+
+if __name__ == '__main__':
+    main()
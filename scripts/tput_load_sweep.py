@@ -0,0 +1,93 @@
+#!/usr/bin/env python3
+#
+# Extracts the result of the "sweep" console command (tput_load.c) from a
+# captured console log, and plots the receive throughput against the
+# per-packet processing cost, with one curve per placement of the load
+# (inline in the GATT callback, or deferred to rx_sink_task).
+#
+# Usage:
+#   tput_load_sweep.py console.log               plot the sweep
+#   tput_load_sweep.py --csv console.log > s.csv extract the rows as CSV
+#
+# --csv writes the header of the last sweep in the log followed by its rows.
+# Plotting requires matplotlib.
+#
+# Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+# an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+# See the LICENSE file of this repository for the terms of use.
+
+import argparse
+import csv
+import sys
+
+PREFIX = 'sweep,'
+
+
+def read_sweep(stream):
+    """Returns the rows of the last sweep in the log, as dictionaries."""
+    header = None
+    rows = []
+    for line in stream:
+        line = line.strip()
+        if not line.startswith(PREFIX):
+            continue
+        fields = line[len(PREFIX):].split(',')
+        if fields[0] == 'placement':
+            header = fields
+            rows = []
+        elif header is not None and len(fields) == len(header):
+            rows.append(dict(zip(header, fields)))
+    return header, rows
+
+
+def write_csv(header, rows, out):
+    writer = csv.DictWriter(out, fieldnames=header, lineterminator='\n')
+    writer.writeheader()
+    writer.writerows(rows)
+
+
+def plot(rows, consumed):
+    import matplotlib.pyplot as plt
+
+    key = 'consumed_kbps' if consumed else 'rx_kbps'
+    fig, ax = plt.subplots()
+    for placement in ('inline', 'deferred'):
+        points = [r for r in rows if r['placement'] == placement]
+        if points:
+            ax.plot([float(r['cost_us']) for r in points],
+                    [float(r[key]) for r in points],
+                    marker='o', label=placement)
+    ax.set_xlabel('processing cost per notification (us)')
+    ax.set_ylabel('consumed throughput (kbps)' if consumed
+                  else 'received throughput (kbps)')
+    ax.grid(True)
+    ax.legend()
+    plt.show()
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description='Plot the throughput client load sweep')
+    parser.add_argument('log', help='captured console log, or - for stdin')
+    parser.add_argument('--csv', action='store_true',
+                        help='write the sweep as CSV instead of plotting')
+    parser.add_argument('--consumed', action='store_true',
+                        help='plot the throughput consumed by rx_sink_task')
+    args = parser.parse_args()
+
+    if args.log == '-':
+        header, rows = read_sweep(sys.stdin)
+    else:
+        with open(args.log, errors='replace') as stream:
+            header, rows = read_sweep(stream)
+    if not rows:
+        sys.exit('no sweep found in ' + args.log)
+
+    if args.csv:
+        write_csv(header, rows, sys.stdout)
+    else:
+        plot(rows, args.consumed)
+
+
+if __name__ == '__main__':
+    main()
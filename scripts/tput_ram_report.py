@@ -0,0 +1,88 @@
+#!/usr/bin/env python3
+#
+# Reports the RAM footprint of a build of the throughput client: the size of
+# every writable section of the ELF file (data, bss, heap, stack, ...) and
+# the largest variables. Use it to size configTOTAL_HEAP_SIZE and the
+# buffer pool of the zero-heap mode (TPUT_STATIC_ALLOC in tput_mem.h).
+#
+# Usage:
+#   tput_ram_report.py build/<TARGET>/Debug/<APPNAME>.elf
+#   tput_ram_report.py --top 50 --tools ~/ModusToolbox/tools_3.2/gcc/bin app.elf
+#
+# Requires the readelf and nm tools of the GNU Arm toolchain, found in PATH
+# or in the directory given with --tools.
+#
+# Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+# an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+# See the LICENSE file of this repository for the terms of use.
+
+import argparse
+import os
+import subprocess
+import sys
+
+TOOL_PREFIX = 'arm-none-eabi-'
+RAM_SYMBOL_TYPES = 'bBdDsS'
+
+
+def run_tool(tools, name, args):
+    tool = os.path.join(tools, TOOL_PREFIX + name) if tools \
+        else TOOL_PREFIX + name
+    try:
+        return subprocess.run([tool] + args, check=True, text=True,
+                              stdout=subprocess.PIPE).stdout
+    except FileNotFoundError:
+        sys.exit('%s not found, use --tools' % tool)
+
+
+def ram_sections(tools, elf):
+    """Returns (name, size) of the allocated, writable sections."""
+    sections = []
+    for line in run_tool(tools, 'readelf', ['-S', '-W', elf]).splitlines():
+        # [Nr] Name Type Address Off Size ES Flg Lk Inf Al
+        if not line.lstrip().startswith('[') or ']' not in line:
+            continue
+        fields = line.split(']', 1)[1].split()
+        if len(fields) < 7 or fields[0] == 'Name':
+            continue
+        name, size, flags = fields[0], int(fields[4], 16), fields[6]
+        if 'A' in flags and 'W' in flags and size:
+            sections.append((name, size))
+    return sections
+
+
+def ram_symbols(tools, elf):
+    """Returns (size, name) of the variables, largest first."""
+    symbols = []
+    output = run_tool(tools, 'nm', ['-S', '--size-sort', '-t', 'd', elf])
+    for line in output.splitlines():
+        fields = line.split()
+        if len(fields) == 4 and fields[2] in RAM_SYMBOL_TYPES:
+            symbols.append((int(fields[1]), fields[3]))
+    return sorted(symbols, reverse=True)
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description='Report the RAM footprint of a throughput client build')
+    parser.add_argument('elf', help='ELF file of the build')
+    parser.add_argument('--top', type=int, default=25,
+                        help='number of variables listed')
+    parser.add_argument('--tools', default='',
+                        help='directory of the GNU Arm toolchain binaries')
+    args = parser.parse_args()
+
+    sections = ram_sections(args.tools, args.elf)
+    print('%-24s %10s' % ('section', 'bytes'))
+    for name, size in sections:
+        print('%-24s %10d' % (name, size))
+    print('%-24s %10d' % ('total', sum(size for _, size in sections)))
+
+    print()
+    print('%-40s %10s' % ('variable', 'bytes'))
+    for size, name in ram_symbols(args.tools, args.elf)[:args.top]:
+        print('%-40s %10d' % (name, size))
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,240 @@
+#!/usr/bin/env python3
+#
+# Decodes the binary telemetry stream of the throughput client
+# (TPUT_TELEMETRY_ENABLE in ble_client.h) into CSV, or plots it live.
+#
+# Frames are COBS encoded, terminated by 0x00, and hold one
+# tput_telemetry_sample_t followed by its CRC-32. Frames that fail the CRC,
+# for example when console text was interleaved, are skipped.
+#
+# Usage:
+#   tput_telemetry.py /dev/ttyACM0 > run.csv      decode a serial port
+#   tput_telemetry.py capture.bin > run.csv       decode a captured stream
+#   tput_telemetry.py --plot /dev/ttyACM0         plot throughput live
+#
+# Reading a serial port requires pyserial, --plot requires matplotlib.
+#
+# Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+# an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+# See the LICENSE file of this repository for the terms of use.
+
+import argparse
+import collections
+import csv
+import os
+import struct
+import sys
+import zlib
+
+# Must match tput_telemetry_sample_t and TPUT_TELEMETRY_VERSION
+SAMPLE_VERSION = 2
+SAMPLE_FORMAT = struct.Struct('<BBHIIIHHIIHHBBHHHHH')
+SAMPLE_FIELDS = ('version', 'flags', 'seq', 'timestamp_ms', 'rx_bytes',
+                 'tx_bytes', 'cwnd', 'in_flight', 'congestion_episodes',
+                 'congested_ms', 'tx_failures', 'rx_lag', 'mode', 'phy', 'mtu',
+                 'conn_interval', 'packet_size', 'rx_ceiling_kbps',
+                 'tx_ceiling_kbps')
+
+FLAG_CONNECTED = 0x01
+FLAG_CONGESTED = 0x02
+FLAG_NOTIFY = 0x04
+FLAG_WRITE = 0x08
+
+CSV_FIELDS = ('timestamp_ms', 'seq', 'connected', 'congested', 'mode',
+              'rx_kbps', 'tx_kbps', 'rx_ceiling_kbps', 'tx_ceiling_kbps',
+              'rx_pct', 'tx_pct', 'rx_bytes', 'tx_bytes', 'cwnd',
+              'in_flight', 'congestion_episodes', 'congested_ms',
+              'tx_failures', 'rx_lag', 'tx_phy', 'rx_phy', 'mtu',
+              'conn_interval_ms', 'packet_size', 'lost_samples')
+
+
+def cobs_decode(data):
+    """Decodes one COBS frame without its delimiter, None if malformed."""
+    out = bytearray()
+    idx = 0
+    while idx < len(data):
+        code = data[idx]
+        if code == 0 or idx + code > len(data):
+            return None
+        out += data[idx + 1:idx + code]
+        idx += code
+        if code != 0xFF and idx < len(data):
+            out.append(0)
+    return bytes(out)
+
+
+def parse_frame(frame):
+    """Returns the sample in a frame as a dict, None if it is invalid."""
+    raw = cobs_decode(frame)
+    if raw is None or len(raw) != SAMPLE_FORMAT.size + 4:
+        return None
+    payload, crc = raw[:-4], struct.unpack('<I', raw[-4:])[0]
+    if zlib.crc32(payload) != crc:
+        return None
+    sample = dict(zip(SAMPLE_FIELDS, SAMPLE_FORMAT.unpack(payload)))
+    if sample['version'] != SAMPLE_VERSION:
+        return None
+    return sample
+
+
+def read_frames(stream):
+    """Yields the 0x00 delimited frames of a byte stream."""
+    # A serial port returns no data on timeout, a file at its end
+    follow = hasattr(stream, 'in_waiting')
+    buf = bytearray()
+    while True:
+        chunk = stream.read(256)
+        if not chunk:
+            if follow:
+                continue
+            return
+        buf += chunk
+        while True:
+            end = buf.find(b'\x00')
+            if end < 0:
+                break
+            if end:
+                yield bytes(buf[:end])
+            del buf[:end + 1]
+
+
+class RateTracker:
+    """Derives kbps from the cumulative byte counters of two samples."""
+
+    def __init__(self):
+        self.prev = None
+
+    def update(self, sample):
+        row = {
+            'timestamp_ms': sample['timestamp_ms'],
+            'seq': sample['seq'],
+            'connected': int(bool(sample['flags'] & FLAG_CONNECTED)),
+            'congested': int(bool(sample['flags'] & FLAG_CONGESTED)),
+            'mode': sample['mode'] + 1,
+            'tx_phy': sample['phy'] >> 4,
+            'rx_phy': sample['phy'] & 0x0F,
+            'conn_interval_ms': sample['conn_interval'] * 1.25,
+            'rx_kbps': 0.0,
+            'tx_kbps': 0.0,
+            'lost_samples': 0,
+        }
+        for key in ('rx_bytes', 'tx_bytes', 'cwnd', 'in_flight',
+                    'congestion_episodes', 'congested_ms', 'tx_failures',
+                    'rx_lag', 'mtu', 'packet_size', 'rx_ceiling_kbps',
+                    'tx_ceiling_kbps'):
+            row[key] = sample[key]
+
+        prev = self.prev
+        if prev is not None:
+            row['lost_samples'] = (sample['seq'] - prev['seq'] - 1) & 0xFFFF
+            dt_ms = sample['timestamp_ms'] - prev['timestamp_ms']
+            # Counters restart from zero on a new connection
+            if (dt_ms > 0 and sample['rx_bytes'] >= prev['rx_bytes'] and
+                    sample['tx_bytes'] >= prev['tx_bytes']):
+                row['rx_kbps'] = round(
+                    (sample['rx_bytes'] - prev['rx_bytes']) * 8 / dt_ms, 1)
+                row['tx_kbps'] = round(
+                    (sample['tx_bytes'] - prev['tx_bytes']) * 8 / dt_ms, 1)
+        for way in ('rx', 'tx'):
+            ceiling = sample[way + '_ceiling_kbps']
+            row[way + '_pct'] = (round(row[way + '_kbps'] * 100 / ceiling, 1)
+                                 if ceiling else '')
+        self.prev = sample
+        return row
+
+
+def open_input(path, baudrate):
+    if os.path.isfile(path) or path == '-':
+        return sys.stdin.buffer if path == '-' else open(path, 'rb')
+    import serial
+    return serial.Serial(path, baudrate, timeout=0.1)
+
+
+def decode_csv(stream, out):
+    writer = csv.DictWriter(out, fieldnames=CSV_FIELDS)
+    writer.writeheader()
+    tracker = RateTracker()
+    bad = 0
+    for frame in read_frames(stream):
+        sample = parse_frame(frame)
+        if sample is None:
+            bad += 1
+            continue
+        writer.writerow(tracker.update(sample))
+        out.flush()
+    if bad:
+        print('%d invalid frames skipped' % bad, file=sys.stderr)
+
+
+def plot_live(stream, window_s):
+    import threading
+    import matplotlib.pyplot as plt
+    from matplotlib.animation import FuncAnimation
+
+    rows = collections.deque()
+    lock = threading.Lock()
+
+    def reader():
+        tracker = RateTracker()
+        for frame in read_frames(stream):
+            sample = parse_frame(frame)
+            if sample is not None:
+                with lock:
+                    rows.append(tracker.update(sample))
+
+    threading.Thread(target=reader, daemon=True).start()
+
+    fig, (ax_rate, ax_win) = plt.subplots(2, 1, sharex=True)
+    rx_line, = ax_rate.plot([], [], label='RX kbps')
+    tx_line, = ax_rate.plot([], [], label='TX kbps')
+    cwnd_line, = ax_win.plot([], [], label='cwnd')
+    flight_line, = ax_win.plot([], [], label='in flight')
+    ax_rate.legend(loc='upper left')
+    ax_win.legend(loc='upper left')
+    ax_win.set_xlabel('time (s)')
+
+    def update(_):
+        with lock:
+            while rows and (rows[-1]['timestamp_ms'] -
+                            rows[0]['timestamp_ms']) > window_s * 1000:
+                rows.popleft()
+            data = list(rows)
+        if not data:
+            return
+        t = [r['timestamp_ms'] / 1000 for r in data]
+        rx_line.set_data(t, [r['rx_kbps'] for r in data])
+        tx_line.set_data(t, [r['tx_kbps'] for r in data])
+        cwnd_line.set_data(t, [r['cwnd'] for r in data])
+        flight_line.set_data(t, [r['in_flight'] for r in data])
+        for ax in (ax_rate, ax_win):
+            ax.relim()
+            ax.autoscale_view()
+
+    _anim = FuncAnimation(fig, update, interval=200, cache_frame_data=False)
+    plt.show()
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description='Decode the throughput client telemetry stream')
+    parser.add_argument('input',
+                        help='serial port, capture file, or - for stdin')
+    parser.add_argument('--baudrate', type=int, default=115200)
+    parser.add_argument('--plot', action='store_true',
+                        help='plot throughput and write window live')
+    parser.add_argument('--window', type=float, default=30.0,
+                        help='seconds shown by --plot')
+    args = parser.parse_args()
+
+    stream = open_input(args.input, args.baudrate)
+    try:
+        if args.plot:
+            plot_live(stream, args.window)
+        else:
+            decode_csv(stream, sys.stdout)
+    except KeyboardInterrupt:
+        pass
+
+
+if __name__ == '__main__':
+    main()
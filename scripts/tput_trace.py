@@ -0,0 +1,148 @@
+#!/usr/bin/env python3
+#
+# Converts the event trace of the throughput client (the "trace dump"
+# console command, TPUT_TRACE_ENABLE in tput_trace.h) from a captured
+# console log into the Chrome trace event JSON format. Open the result in
+# https://ui.perfetto.dev or chrome://tracing.
+#
+# The trace shows one track per task, holding the traced callbacks and task
+# activity, one track for the traced interrupts, and a "CPU" track showing
+# which task was running. Idle time appears as the IDLE task.
+#
+# Usage:
+#   tput_trace.py console.log > trace.json
+#
+# Timestamps come from the 32-bit cycle counter, which wraps within a
+# minute. Consecutive events are assumed to be less than one wrap period
+# apart.
+#
+# Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+# an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+# See the LICENSE file of this repository for the terms of use.
+
+import argparse
+import json
+import sys
+
+PID = 1
+ISR_TID = 0
+CPU_TID = 100000
+PHASES = {'B': 'B', 'E': 'E', 'I': 'i'}
+
+
+def read_dump(stream):
+    """Returns the last trace dump in the log, None if there is none."""
+    dump = None
+    for line in stream:
+        fields = line.strip().split(',')
+        tag = fields[0]
+        if tag == 'trace_start':
+            dump = {'cycles_per_us': int(fields[1]), 'lost': int(fields[3]),
+                    'ids': {}, 'tasks': {}, 'events': [], 'complete': False}
+        elif dump is None or dump['complete']:
+            continue
+        elif tag == 'trace_id':
+            dump['ids'][int(fields[1])] = (fields[2], fields[3] == 'isr')
+        elif tag == 'trace_task':
+            dump['tasks'][int(fields[1])] = ','.join(fields[2:])
+        elif tag == 'trace' and len(fields) == 5:
+            dump['events'].append((int(fields[1]), fields[2], int(fields[3]),
+                                   int(fields[4])))
+        elif tag == 'trace_end':
+            dump['complete'] = True
+    return dump
+
+
+def cpu_slice(dump, task, start, end):
+    """Returns the slice of the CPU track during which a task ran."""
+    return {'ph': 'X', 'pid': PID, 'tid': CPU_TID, 'ts': start,
+            'dur': end - start, 'name': dump['tasks'].get(task, str(task))}
+
+
+def convert(dump):
+    """Converts a trace dump to a list of Chrome trace events."""
+    cycles_per_us = float(dump['cycles_per_us'])
+    out = [
+        {'ph': 'M', 'pid': PID, 'name': 'process_name',
+         'args': {'name': 'throughput client'}},
+        {'ph': 'M', 'pid': PID, 'tid': ISR_TID, 'name': 'thread_name',
+         'args': {'name': 'interrupts'}},
+        {'ph': 'M', 'pid': PID, 'tid': CPU_TID, 'name': 'thread_name',
+         'args': {'name': 'CPU'}},
+    ]
+    for number, name in dump['tasks'].items():
+        out.append({'ph': 'M', 'pid': PID, 'tid': number,
+                    'name': 'thread_name', 'args': {'name': name}})
+
+    # Unwrap the cycle counter
+    cycles = 0
+    prev = None
+    current_task = None
+    running_since = None
+    open_spans = {}
+    for raw, kind, evt_id, arg in dump['events']:
+        if prev is not None:
+            cycles += (raw - prev) & 0xFFFFFFFF
+        prev = raw
+        ts = cycles / cycles_per_us
+
+        if kind == 'S':
+            if current_task is not None:
+                out.append(cpu_slice(dump, current_task, running_since, ts))
+            current_task = arg
+            running_since = ts
+            continue
+
+        name, isr = dump['ids'].get(evt_id, (str(evt_id), False))
+        if isr:
+            tid = ISR_TID
+        elif kind == 'E' and open_spans.get(evt_id):
+            # A callback preempted by a context switch ends on the track
+            # where it began
+            tid = open_spans[evt_id].pop()
+        else:
+            tid = current_task
+        if tid is None:
+            continue
+        if kind == 'B' and not isr:
+            open_spans.setdefault(evt_id, []).append(tid)
+        event = {'ph': PHASES[kind], 'pid': PID, 'tid': tid, 'ts': ts,
+                 'name': name}
+        if kind == 'B':
+            event['args'] = {'arg': arg}
+        elif kind == 'I':
+            event['s'] = 't'
+            event['args'] = {'arg': arg}
+        out.append(event)
+
+    if current_task is not None:
+        out.append(cpu_slice(dump, current_task, running_since, ts))
+    return out
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description='Convert a throughput client trace dump to Chrome JSON')
+    parser.add_argument('log', help='captured console log, or - for stdin')
+    args = parser.parse_args()
+
+    if args.log == '-':
+        dump = read_dump(sys.stdin)
+    else:
+        with open(args.log, errors='replace') as stream:
+            dump = read_dump(stream)
+    if dump is None or not dump['events']:
+        sys.exit('no trace dump found in ' + args.log)
+    if not dump['complete']:
+        print('warning: trace dump is truncated', file=sys.stderr)
+    if dump['lost']:
+        print('warning: %d older events were overwritten' % dump['lost'],
+              file=sys.stderr)
+
+    json.dump({'traceEvents': convert(dump), 'displayTimeUnit': 'ns'},
+              sys.stdout)
+    sys.stdout.write('\n')
+
+
+if __name__ == '__main__':
+    main()
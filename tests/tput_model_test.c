@@ -0,0 +1,196 @@
+/*******************************************************************************
+ * File Name: tput_model_test.c
+ *
+ * Description: Host unit test of the throughput model (tput_model.c). Build and run it
+ *              from the root of the repository with:
+ *                gcc -Wall -Wextra -I. tests/tput_model_test.c tput_model.c -o tput_model_test && ./tput_model_test
+ *
+ * Related Document: See README.md
+ *
+ *
+ *******************************************************************************
+ * Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ ******************************************************************************/
+
+/******************************************************************************
+ *                                INCLUDES
+ ******************************************************************************/
+#include <stdio.h>
+#include "tput_model.h"
+
+/*******************************************************************************
+*         Macros
+*******************************************************************************/
+/* Largest values of a 2M or 1M link with Data Length Extension */
+#define TEST_MTU                        (247u)
+#define TEST_PACKET_SIZE                (244u)
+#define TEST_OCTETS                     (251u)
+/* PDU time the stack requests with the data length, that of 251 bytes on
+ * 1M. On the Coded PHY the controller uses at least 2704 us */
+#define TEST_TIME_US                    (2120u)
+/* Longest PDU time, that of 251 bytes at S=8 */
+#define TEST_MAX_TIME_US                (17040u)
+#define TEST_CONN_INTERVAL_US           (7500u)
+
+/*******************************************************************************
+*        Variable Definitions
+*******************************************************************************/
+static unsigned int failures = 0;
+
+/******************************************************************************
+ * Function Definitions
+ ******************************************************************************/
+
+/*******************************************************************************
+* Function Name: test_link()
+********************************************************************************
+* Summary:
+*   Returns a link with both directions on the same PHY, at the largest data
+*   length and packet size, and the PDU time the stack requests.
+*
+* Parameters:
+*   tput_model_phy_t phy      : PHY of both directions
+*   uint32_t conn_interval_us : Connection interval
+*
+* Return:
+*   tput_model_link_t : Link parameters
+*
+*******************************************************************************/
+static tput_model_link_t test_link(tput_model_phy_t phy,
+                                   uint32_t conn_interval_us)
+{
+    tput_model_link_t link =
+    {
+        .conn_interval_us = conn_interval_us,
+        .tx_phy = phy,
+        .rx_phy = phy,
+        .max_tx_octets = TEST_OCTETS,
+        .max_rx_octets = TEST_OCTETS,
+        .max_tx_time_us = TEST_TIME_US,
+        .max_rx_time_us = TEST_TIME_US,
+        .mtu = TEST_MTU,
+        .packet_size = TEST_PACKET_SIZE,
+        .encrypted = false
+    };
+
+    return link;
+}
+
+/*******************************************************************************
+* Function Name: test_ceiling()
+********************************************************************************
+* Summary:
+*   Checks the ceiling computed for a link and a direction.
+*
+* Parameters:
+*   const char *name                : Name of the case
+*   const tput_model_link_t *p_link : Link parameters
+*   tput_model_dir_t dir            : Direction of the traffic
+*   uint32_t expected_kbps          : Expected ceiling
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+static void test_ceiling(const char *name, const tput_model_link_t *p_link,
+                         tput_model_dir_t dir, uint32_t expected_kbps)
+{
+    tput_model_result_t result;
+
+    if (!tput_model_compute(p_link, dir, &result))
+    {
+        printf("FAIL %s: link rejected\n", name);
+        failures++;
+    }
+    else if (result.ceiling_kbps != expected_kbps)
+    {
+        printf("FAIL %s: %lu kbps, expected %lu kbps\n", name,
+               (unsigned long)result.ceiling_kbps,
+               (unsigned long)expected_kbps);
+        failures++;
+    }
+    else
+    {
+        printf("ok   %s: %lu kbps\n", name, (unsigned long)expected_kbps);
+    }
+}
+
+int main(void)
+{
+    tput_model_link_t link;
+    tput_model_result_t result;
+
+    /* 1 PDU of 251 bytes and an empty PDU back fit 5 times in 7.5 ms */
+    link = test_link(TPUT_MODEL_PHY_2M, TEST_CONN_INTERVAL_US);
+    test_ceiling("2M TX", &link, TPUT_MODEL_DIR_TX, 1301u);
+    test_ceiling("2M RX", &link, TPUT_MODEL_DIR_RX, 1301u);
+    /* Data both ways leaves room for 3 exchanges */
+    test_ceiling("2M both", &link, TPUT_MODEL_DIR_BOTH, 780u);
+
+    link = test_link(TPUT_MODEL_PHY_1M, TEST_CONN_INTERVAL_US);
+    test_ceiling("1M TX", &link, TPUT_MODEL_DIR_TX, 780u);
+    test_ceiling("1M both", &link, TPUT_MODEL_DIR_BOTH, 260u);
+
+    link = test_link(TPUT_MODEL_PHY_CODED_S2, TEST_CONN_INTERVAL_US);
+    test_ceiling("Coded S2 TX", &link, TPUT_MODEL_DIR_TX, 260u);
+
+    /* At S8 the 2704 us PDU time limits PDUs to 31 bytes, 2 of the 9
+     * exchanges of a packet fit in 7.5 ms */
+    link = test_link(TPUT_MODEL_PHY_CODED_S8, TEST_CONN_INTERVAL_US);
+    test_ceiling("Coded S8 TX 7.5 ms", &link, TPUT_MODEL_DIR_TX, 57u);
+    link = test_link(TPUT_MODEL_PHY_CODED_S8, 100000u);
+    test_ceiling("Coded S8 TX 100 ms", &link, TPUT_MODEL_DIR_TX, 60u);
+    /* With the longest PDU time, one packet takes a single 251 byte PDU */
+    link.max_tx_time_us = TEST_MAX_TIME_US;
+    link.max_rx_time_us = TEST_MAX_TIME_US;
+    test_ceiling("Coded S8 TX 100 ms 17040 us", &link, TPUT_MODEL_DIR_TX, 97u);
+    /* The 328 us default PDU time limits 1M PDUs to 31 bytes */
+    link = test_link(TPUT_MODEL_PHY_1M, TEST_CONN_INTERVAL_US);
+    link.max_tx_time_us = 0u;
+    link.max_rx_time_us = 0u;
+    test_ceiling("1M TX default time", &link, TPUT_MODEL_DIR_TX, 289u);
+
+    /* Packets that do not fit the MTU are rejected */
+    link = test_link(TPUT_MODEL_PHY_2M, TEST_CONN_INTERVAL_US);
+    link.packet_size = TEST_MTU;
+    if (tput_model_compute(&link, TPUT_MODEL_DIR_TX, &result) ||
+        (0u != result.ceiling_kbps))
+    {
+        printf("FAIL packet larger than the MTU accepted\n");
+        failures++;
+    }
+
+    printf("%u failures\n", failures);
+    return (0u == failures) ? 0 : 1;
+}
+
+/* [] END OF FILE */
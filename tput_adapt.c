@@ -0,0 +1,689 @@
+/*******************************************************************************
+ * File Name: tput_adapt.c
+ *
+ * Description: This file implements the adaptive PHY and packet size
+ *              controller. It samples the RSSI, the GATT write failures and the
+ *              goodput every second, steps the PHY and the GATT write packet
+ *              size with hysteresis, and logs each decision with the goodput
+ *              before and after.
+ *
+ * Related Document: See README.md
+ *
+ *
+ *******************************************************************************
+ * Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ ******************************************************************************/
+
+/******************************************************************************
+ *                                INCLUDES
+ ******************************************************************************/
+#include <stdio.h>
+#include <string.h>
+#include <FreeRTOS.h>
+#include <task.h>
+#include "wiced_bt_dev.h"
+#include "tput_phy.h"
+#include "tput_adapt.h"
+
+/*******************************************************************************
+*        Macros
+*******************************************************************************/
+/* The RSSI is smoothed over about 1 << TPUT_ADAPT_RSSI_SHIFT readings */
+#define TPUT_ADAPT_RSSI_SHIFT           (2u)
+/* 2M, 1M, Coded S2 and Coded S8 */
+#define TPUT_ADAPT_PHY_COUNT            (4u)
+
+/*******************************************************************************
+*        Function Prototypes
+*******************************************************************************/
+static void tput_adapt_rssi_cb(void *p_data);
+static int32_t tput_adapt_phy_index(tput_model_phy_t phy);
+static bool tput_adapt_decide(tput_adapt_change_t change,
+                              tput_model_phy_t from_phy,
+                              tput_model_phy_t to_phy,
+                              uint16_t from_packet_size,
+                              uint16_t to_packet_size,
+                              uint32_t fail_pct,
+                              tput_adapt_action_t *p_action);
+static void tput_adapt_measured(uint32_t after_kbps);
+static void tput_adapt_decision_print(const tput_adapt_decision_t *p_decision);
+
+/*******************************************************************************
+*        Variable Definitions
+*******************************************************************************/
+/* PHYs from the fastest to the most robust */
+static const tput_model_phy_t phy_ladder[TPUT_ADAPT_PHY_COUNT] =
+{
+    TPUT_MODEL_PHY_2M,
+    TPUT_MODEL_PHY_1M,
+    TPUT_MODEL_PHY_CODED_S2,
+    TPUT_MODEL_PHY_CODED_S8
+};
+static const char *change_names[] =
+{
+    "PHY down",
+    "PHY up",
+    "shrink",
+    "grow",
+    "revert"
+};
+static volatile bool enabled = false;
+static wiced_bt_device_address_t rssi_addr;
+/* Smoothed RSSI, in dBm << TPUT_ADAPT_RSSI_SHIFT */
+static volatile int16_t rssi_smoothed = 0;
+static volatile bool rssi_valid = false;
+/* GATT writes completed in the current second */
+static volatile uint32_t write_completions = 0;
+static volatile uint32_t write_failures = 0;
+/* Consecutive seconds the link was degraded or healthy */
+static uint32_t down_seconds = 0;
+static uint32_t up_seconds = 0;
+/* Seconds left to measure the last change, and to try no faster setting */
+static uint32_t hold_seconds = 0;
+static uint32_t block_seconds = 0;
+/* Goodput since the last change, or since its measurement */
+static uint32_t goodput_sum_kbps = 0;
+static uint32_t goodput_seconds = 0;
+/* Packet size before the first shrink, that growing returns to */
+static uint16_t home_packet_size = 0;
+/* Last change, while it is measured, and its index in the log */
+static tput_adapt_decision_t pending;
+static uint32_t pending_index = 0;
+/* Last TPUT_ADAPT_LOG_SIZE decisions, log_count in total */
+static tput_adapt_decision_t decision_log[TPUT_ADAPT_LOG_SIZE];
+static uint32_t log_count = 0;
+static tput_adapt_stats_t stats = {0};
+
+/******************************************************************************
+ * Function Definitions
+ ******************************************************************************/
+
+/*******************************************************************************
+* Function Name: tput_adapt_enable()
+********************************************************************************
+* Summary:
+*   Enables or disables the controller. The PHY and the packet size it
+*   selected are kept when it is disabled.
+*
+* Parameters:
+*   bool on : true to adapt the PHY and the packet size to the link
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void tput_adapt_enable(bool on)
+{
+    enabled = on;
+    tput_adapt_reset();
+}
+
+/*******************************************************************************
+* Function Name: tput_adapt_is_enabled()
+********************************************************************************
+* Summary:
+*   Tells if the controller is enabled.
+*
+* Parameters:
+*   None
+*
+* Return:
+*   bool : true if enabled
+*
+*******************************************************************************/
+bool tput_adapt_is_enabled(void)
+{
+    return enabled;
+}
+
+/*******************************************************************************
+* Function Name: tput_adapt_reset()
+********************************************************************************
+* Summary:
+*   Forgets the measurements of the previous link. Called on connection.
+*
+* Parameters:
+*   None
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void tput_adapt_reset(void)
+{
+    taskENTER_CRITICAL();
+    rssi_valid = false;
+    write_completions = 0;
+    write_failures = 0;
+    taskEXIT_CRITICAL();
+    down_seconds = 0;
+    up_seconds = 0;
+    hold_seconds = 0;
+    block_seconds = 0;
+    goodput_sum_kbps = 0;
+    goodput_seconds = 0;
+    home_packet_size = 0;
+}
+
+/*******************************************************************************
+* Function Name: tput_adapt_request_rssi()
+********************************************************************************
+* Summary:
+*   Requests the RSSI of the link from the controller. The reading is used
+*   by the next call to tput_adapt_sample().
+*
+* Parameters:
+*   const uint8_t *p_bd_addr : Address of the server
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void tput_adapt_request_rssi(const uint8_t *p_bd_addr)
+{
+    if (!enabled)
+    {
+        return;
+    }
+    memcpy(rssi_addr, p_bd_addr, BD_ADDR_LEN);
+    wiced_bt_dev_read_rssi(rssi_addr, BT_TRANSPORT_LE, tput_adapt_rssi_cb);
+}
+
+/*******************************************************************************
+* Function Name: tput_adapt_on_write_complete()
+********************************************************************************
+* Summary:
+*   Counts a completed GATT write. Called from the GATT callback.
+*
+* Parameters:
+*   bool success : false if the write completed with an error
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void tput_adapt_on_write_complete(bool success)
+{
+    write_completions++;
+    if (!success)
+    {
+        write_failures++;
+    }
+}
+
+/*******************************************************************************
+* Function Name: tput_adapt_sample()
+********************************************************************************
+* Summary:
+*   Called every second while connected. Finishes the measurement of the
+*   last change, reverting a faster setting that lowered the goodput, or
+*   else decides the next change:
+*   - on a degraded link (weak RSSI or many write failures) for
+*     TPUT_ADAPT_DOWN_SECONDS, shrinks the packet size if the writes fail on
+*     a good signal, or else steps to a more robust PHY.
+*   - on a healthy link for TPUT_ADAPT_UP_SECONDS, grows the packet size
+*     back, or else steps to a faster PHY if the RSSI is strong.
+*   Nothing is decided while no data is transferred.
+*
+* Parameters:
+*   tput_model_phy_t phy     : Current PHY
+*   uint16_t packet_size     : Current GATT write packet size
+*   uint16_t max_packet_size : Largest packet size, 0 if the packet size is
+*                              not adapted
+*   uint32_t goodput_kbps    : Throughput of the last second, both directions
+*   tput_adapt_action_t *p_action : Returns the change to apply
+*
+* Return:
+*   bool : true if p_action holds a change
+*
+*******************************************************************************/
+bool tput_adapt_sample(tput_model_phy_t phy, uint16_t packet_size,
+                       uint16_t max_packet_size, uint32_t goodput_kbps,
+                       tput_adapt_action_t *p_action)
+{
+    uint32_t completions;
+    uint32_t failures;
+    uint32_t fail_pct;
+    uint32_t after_kbps;
+    uint16_t size;
+    int32_t index;
+    int32_t rssi;
+    bool weak;
+    bool strong;
+    bool failing;
+
+    taskENTER_CRITICAL();
+    completions = write_completions;
+    failures = write_failures;
+    write_completions = 0;
+    write_failures = 0;
+    taskEXIT_CRITICAL();
+
+    p_action->phy = (tput_model_phy_t)0;
+    p_action->packet_size = 0;
+    if ((!enabled) || ((0 == goodput_kbps) && (0 == completions)))
+    {
+        down_seconds = 0;
+        up_seconds = 0;
+        return false;
+    }
+    fail_pct = completions ? (failures * 100u) / completions : 0u;
+    goodput_sum_kbps += goodput_kbps;
+    goodput_seconds++;
+    if (block_seconds)
+    {
+        block_seconds--;
+    }
+
+    if (hold_seconds)
+    {
+        if (--hold_seconds)
+        {
+            return false;
+        }
+        after_kbps = goodput_sum_kbps / goodput_seconds;
+        tput_adapt_measured(after_kbps);
+        goodput_sum_kbps = 0;
+        goodput_seconds = 0;
+        if (((TPUT_ADAPT_PHY_UP == pending.change) ||
+             (TPUT_ADAPT_PACKET_GROW == pending.change)) &&
+            ((after_kbps * 100u) <
+             (pending.before_kbps * (100u - TPUT_ADAPT_REVERT_PCT))))
+        {
+            block_seconds = TPUT_ADAPT_BLOCK_SECONDS;
+            goodput_sum_kbps = after_kbps;
+            goodput_seconds = 1;
+            return tput_adapt_decide(TPUT_ADAPT_REVERT, phy, pending.from_phy,
+                                     packet_size, pending.from_packet_size,
+                                     fail_pct, p_action);
+        }
+        return false;
+    }
+
+    rssi = rssi_smoothed / (1 << TPUT_ADAPT_RSSI_SHIFT);
+    weak = rssi_valid && (rssi < TPUT_ADAPT_RSSI_DOWN_DBM);
+    strong = rssi_valid && (rssi > TPUT_ADAPT_RSSI_UP_DBM);
+    failing = (fail_pct >= TPUT_ADAPT_FAIL_HIGH_PCT);
+    down_seconds = (weak || failing) ? down_seconds + 1u : 0u;
+    up_seconds = (!weak && (fail_pct <= TPUT_ADAPT_FAIL_LOW_PCT)) ?
+                 up_seconds + 1u : 0u;
+    index = tput_adapt_phy_index(phy);
+
+    if (down_seconds >= TPUT_ADAPT_DOWN_SECONDS)
+    {
+        size = (packet_size / 2u > TPUT_ADAPT_MIN_PACKET_SIZE) ?
+               packet_size / 2u : TPUT_ADAPT_MIN_PACKET_SIZE;
+        /* Writes failing on a good signal: smaller packets first */
+        if ((failing && !weak) || (index < 0) ||
+            ((uint32_t)index + 1u >= TPUT_ADAPT_PHY_COUNT))
+        {
+            if (max_packet_size && (packet_size > size))
+            {
+                if (!home_packet_size)
+                {
+                    home_packet_size = packet_size;
+                }
+                return tput_adapt_decide(TPUT_ADAPT_PACKET_SHRINK, phy, phy,
+                                         packet_size, size, fail_pct,
+                                         p_action);
+            }
+        }
+        if ((index >= 0) && ((uint32_t)index + 1u < TPUT_ADAPT_PHY_COUNT))
+        {
+            return tput_adapt_decide(TPUT_ADAPT_PHY_DOWN, phy,
+                                     phy_ladder[index + 1], packet_size,
+                                     packet_size, fail_pct, p_action);
+        }
+        /* Most robust setting already */
+        down_seconds = 0;
+        return false;
+    }
+
+    if ((up_seconds >= TPUT_ADAPT_UP_SECONDS) && (!block_seconds))
+    {
+        if (max_packet_size && (packet_size < home_packet_size))
+        {
+            size = packet_size * 2u;
+            size = (size < home_packet_size) ? size : home_packet_size;
+            size = (size < max_packet_size) ? size : max_packet_size;
+            return tput_adapt_decide(TPUT_ADAPT_PACKET_GROW, phy, phy,
+                                     packet_size, size, fail_pct, p_action);
+        }
+        if (strong && (index > 0))
+        {
+            return tput_adapt_decide(TPUT_ADAPT_PHY_UP, phy,
+                                     phy_ladder[index - 1], packet_size,
+                                     packet_size, fail_pct, p_action);
+        }
+    }
+    return false;
+}
+
+/*******************************************************************************
+* Function Name: tput_adapt_get_stats()
+********************************************************************************
+* Summary:
+*   Returns the number of changes decided.
+*
+* Parameters:
+*   tput_adapt_stats_t *p_stats : Returns the statistics
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void tput_adapt_get_stats(tput_adapt_stats_t *p_stats)
+{
+    taskENTER_CRITICAL();
+    *p_stats = stats;
+    taskEXIT_CRITICAL();
+}
+
+/*******************************************************************************
+* Function Name: tput_adapt_clear_stats()
+********************************************************************************
+* Summary:
+*   Clears the statistics and the decision log.
+*
+* Parameters:
+*   None
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void tput_adapt_clear_stats(void)
+{
+    taskENTER_CRITICAL();
+    memset(&stats, 0, sizeof(stats));
+    log_count = 0;
+    taskEXIT_CRITICAL();
+}
+
+/*******************************************************************************
+* Function Name: tput_adapt_print()
+********************************************************************************
+* Summary:
+*   Prints the state of the controller and the last decisions, oldest first.
+*
+* Parameters:
+*   None
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void tput_adapt_print(void)
+{
+    tput_adapt_stats_t adapt_stats;
+    tput_adapt_decision_t decision;
+    uint32_t count;
+    uint32_t i;
+
+    tput_adapt_get_stats(&adapt_stats);
+    printf("Adapt %s: %lu decisions, %lu PHY changes, %lu packet size changes, "
+           "%lu reverted\n", enabled ? "on" : "off",
+           (unsigned long)adapt_stats.decisions,
+           (unsigned long)adapt_stats.phy_changes,
+           (unsigned long)adapt_stats.packet_changes,
+           (unsigned long)adapt_stats.reverts);
+    if (rssi_valid)
+    {
+        printf("RSSI %d dBm\n",
+               (int)(rssi_smoothed / (1 << TPUT_ADAPT_RSSI_SHIFT)));
+    }
+
+    count = (log_count < TPUT_ADAPT_LOG_SIZE) ? log_count : TPUT_ADAPT_LOG_SIZE;
+    for (i = log_count - count; i < log_count; i++)
+    {
+        taskENTER_CRITICAL();
+        decision = decision_log[i % TPUT_ADAPT_LOG_SIZE];
+        taskEXIT_CRITICAL();
+        tput_adapt_decision_print(&decision);
+    }
+}
+
+/*******************************************************************************
+* Function Name: tput_adapt_rssi_cb()
+********************************************************************************
+* Summary:
+*   Smooths the RSSI read from the controller. Called by the stack.
+*
+* Parameters:
+*   void *p_data : wiced_bt_dev_rssi_result_t of the reading
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+static void tput_adapt_rssi_cb(void *p_data)
+{
+    wiced_bt_dev_rssi_result_t *p_result = (wiced_bt_dev_rssi_result_t *)p_data;
+    int16_t reading;
+
+    if (WICED_BT_SUCCESS != p_result->status)
+    {
+        return;
+    }
+    reading = (int16_t)(p_result->rssi * (1 << TPUT_ADAPT_RSSI_SHIFT));
+    if (!rssi_valid)
+    {
+        rssi_smoothed = reading;
+        rssi_valid = true;
+    }
+    else
+    {
+        rssi_smoothed += (reading - rssi_smoothed) /
+                         (1 << TPUT_ADAPT_RSSI_SHIFT);
+    }
+}
+
+/*******************************************************************************
+* Function Name: tput_adapt_phy_index()
+********************************************************************************
+* Summary:
+*   Finds a PHY in the ladder.
+*
+* Parameters:
+*   tput_model_phy_t phy : PHY
+*
+* Return:
+*   int32_t : Index in phy_ladder, -1 if not found
+*
+*******************************************************************************/
+static int32_t tput_adapt_phy_index(tput_model_phy_t phy)
+{
+    uint32_t index;
+
+    for (index = 0; index < TPUT_ADAPT_PHY_COUNT; index++)
+    {
+        if (phy_ladder[index] == phy)
+        {
+            return (int32_t)index;
+        }
+    }
+    return -1;
+}
+
+/*******************************************************************************
+* Function Name: tput_adapt_decide()
+********************************************************************************
+* Summary:
+*   Logs a change with the goodput since the previous one, returns it to
+*   apply, and starts its measurement.
+*
+* Parameters:
+*   tput_adapt_change_t change : Kind of change
+*   tput_model_phy_t from_phy  : Current PHY
+*   tput_model_phy_t to_phy    : PHY to request
+*   uint16_t from_packet_size  : Current packet size
+*   uint16_t to_packet_size    : Packet size to set
+*   uint32_t fail_pct          : GATT write failures in the last second
+*   tput_adapt_action_t *p_action : Returns the change to apply
+*
+* Return:
+*   bool : false if nothing changes
+*
+*******************************************************************************/
+static bool tput_adapt_decide(tput_adapt_change_t change,
+                              tput_model_phy_t from_phy,
+                              tput_model_phy_t to_phy,
+                              uint16_t from_packet_size,
+                              uint16_t to_packet_size,
+                              uint32_t fail_pct,
+                              tput_adapt_action_t *p_action)
+{
+    if ((from_phy == to_phy) && (from_packet_size == to_packet_size))
+    {
+        return false;
+    }
+
+    memset(&pending, 0, sizeof(pending));
+    pending.timestamp_ms = (uint32_t)(xTaskGetTickCount() * portTICK_PERIOD_MS);
+    pending.change = change;
+    pending.from_phy = from_phy;
+    pending.to_phy = to_phy;
+    pending.from_packet_size = from_packet_size;
+    pending.to_packet_size = to_packet_size;
+    pending.rssi = (int8_t)(rssi_smoothed / (1 << TPUT_ADAPT_RSSI_SHIFT));
+    pending.rssi_valid = rssi_valid;
+    pending.fail_pct = (uint8_t)fail_pct;
+    pending.before_kbps = goodput_seconds ? goodput_sum_kbps / goodput_seconds :
+                                            0u;
+
+    taskENTER_CRITICAL();
+    pending_index = log_count;
+    decision_log[log_count % TPUT_ADAPT_LOG_SIZE] = pending;
+    log_count++;
+    stats.decisions++;
+    if (from_phy != to_phy)
+    {
+        stats.phy_changes++;
+    }
+    if (from_packet_size != to_packet_size)
+    {
+        stats.packet_changes++;
+    }
+    if (TPUT_ADAPT_REVERT == change)
+    {
+        stats.reverts++;
+    }
+    taskEXIT_CRITICAL();
+    tput_adapt_decision_print(&pending);
+
+    if (from_phy != to_phy)
+    {
+        p_action->phy = to_phy;
+    }
+    if (from_packet_size != to_packet_size)
+    {
+        p_action->packet_size = to_packet_size;
+    }
+    hold_seconds = TPUT_ADAPT_HOLD_SECONDS;
+    down_seconds = 0;
+    up_seconds = 0;
+    goodput_sum_kbps = 0;
+    goodput_seconds = 0;
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: tput_adapt_measured()
+********************************************************************************
+* Summary:
+*   Records and prints the goodput after the last change.
+*
+* Parameters:
+*   uint32_t after_kbps : Average goodput over TPUT_ADAPT_HOLD_SECONDS
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+static void tput_adapt_measured(uint32_t after_kbps)
+{
+    pending.after_kbps = after_kbps;
+    pending.measured = true;
+
+    taskENTER_CRITICAL();
+    /* The log may have been cleared meanwhile */
+    if (log_count == pending_index + 1u)
+    {
+        decision_log[pending_index % TPUT_ADAPT_LOG_SIZE] = pending;
+    }
+    taskEXIT_CRITICAL();
+    tput_adapt_decision_print(&pending);
+}
+
+/*******************************************************************************
+* Function Name: tput_adapt_decision_print()
+********************************************************************************
+* Summary:
+*   Prints a decision on one line.
+*
+* Parameters:
+*   const tput_adapt_decision_t *p_decision : Decision
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+static void tput_adapt_decision_print(const tput_adapt_decision_t *p_decision)
+{
+    printf("ADAPT %lu.%03lu s: %s,",
+           (unsigned long)(p_decision->timestamp_ms / 1000u),
+           (unsigned long)(p_decision->timestamp_ms % 1000u),
+           change_names[p_decision->change]);
+    if (p_decision->from_phy != p_decision->to_phy)
+    {
+        printf(" PHY %s -> %s,", tput_phy_name(p_decision->from_phy),
+               tput_phy_name(p_decision->to_phy));
+    }
+    if (p_decision->from_packet_size != p_decision->to_packet_size)
+    {
+        printf(" packet %u -> %u bytes,", p_decision->from_packet_size,
+               p_decision->to_packet_size);
+    }
+    if (p_decision->rssi_valid)
+    {
+        printf(" RSSI %d dBm,", (int)p_decision->rssi);
+    }
+    printf(" write failures %u%%, %lu kbps before", p_decision->fail_pct,
+           (unsigned long)p_decision->before_kbps);
+    if (p_decision->measured)
+    {
+        printf(", %lu kbps after", (unsigned long)p_decision->after_kbps);
+    }
+    printf("\n");
+}
+
+/* [] END OF FILE */
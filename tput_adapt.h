@@ -0,0 +1,137 @@
+/*******************************************************************************
+ * File Name: tput_adapt.h
+ *
+ * Description: This file contains the declarations of the adaptive PHY and
+ *              packet size controller.
+ *
+ * Related Document: See README.md
+ *
+ *
+ *******************************************************************************
+ * Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ ******************************************************************************/
+
+#ifndef __TPUT_ADAPT_H__
+#define __TPUT_ADAPT_H__
+
+/******************************************************************************
+ *                                INCLUDES
+ ******************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include "tput_model.h"
+
+/*******************************************************************************
+*        Macros
+*******************************************************************************/
+/* RSSI below which a more robust PHY is selected, and above which a faster
+ * one is. The gap between the two is the hysteresis */
+#define TPUT_ADAPT_RSSI_DOWN_DBM        (-80)
+#define TPUT_ADAPT_RSSI_UP_DBM          (-70)
+/* Share of the GATT writes completed with an error above which the link is
+ * degraded, and below which it is healthy */
+#define TPUT_ADAPT_FAIL_HIGH_PCT        (10u)
+#define TPUT_ADAPT_FAIL_LOW_PCT         (2u)
+/* Consecutive seconds a degraded or healthy link must last before a change */
+#define TPUT_ADAPT_DOWN_SECONDS         (2u)
+#define TPUT_ADAPT_UP_SECONDS           (5u)
+/* Seconds after a change over which its goodput is measured, with no other
+ * change meanwhile */
+#define TPUT_ADAPT_HOLD_SECONDS         (3u)
+/* A faster setting that loses this share of the goodput is reverted, and
+ * no faster setting is tried for TPUT_ADAPT_BLOCK_SECONDS */
+#define TPUT_ADAPT_REVERT_PCT           (10u)
+#define TPUT_ADAPT_BLOCK_SECONDS        (30u)
+/* Smallest GATT write packet size the controller shrinks to */
+#define TPUT_ADAPT_MIN_PACKET_SIZE      (60u)
+/* Decisions kept for the console */
+#define TPUT_ADAPT_LOG_SIZE             (8u)
+
+/*******************************************************************************
+*        Structures and Enumerations
+*******************************************************************************/
+typedef enum
+{
+    TPUT_ADAPT_PHY_DOWN,        // to a more robust PHY
+    TPUT_ADAPT_PHY_UP,          // to a faster PHY
+    TPUT_ADAPT_PACKET_SHRINK,
+    TPUT_ADAPT_PACKET_GROW,
+    TPUT_ADAPT_REVERT           // back from a faster setting that did worse
+} tput_adapt_change_t;
+
+typedef struct
+{
+    uint32_t timestamp_ms;
+    tput_adapt_change_t change;
+    tput_model_phy_t from_phy;
+    tput_model_phy_t to_phy;
+    uint16_t from_packet_size;
+    uint16_t to_packet_size;
+    int8_t rssi;                // smoothed, when the decision was made
+    bool rssi_valid;
+    uint8_t fail_pct;           // GATT write failures in the last second
+    uint32_t before_kbps;       // average goodput since the previous change
+    uint32_t after_kbps;        // over TPUT_ADAPT_HOLD_SECONDS after it
+    bool measured;              // after_kbps is valid
+} tput_adapt_decision_t;
+
+typedef struct
+{
+    tput_model_phy_t phy;       // PHY to request, 0 to keep the current one
+    uint16_t packet_size;       // packet size to set, 0 to keep it
+} tput_adapt_action_t;
+
+typedef struct
+{
+    uint32_t decisions;
+    uint32_t phy_changes;
+    uint32_t packet_changes;
+    uint32_t reverts;
+} tput_adapt_stats_t;
+
+/****************************************************************************
+ *                              FUNCTION DECLARATIONS
+ ***************************************************************************/
+void tput_adapt_enable(bool on);
+bool tput_adapt_is_enabled(void);
+void tput_adapt_reset(void);
+void tput_adapt_request_rssi(const uint8_t *p_bd_addr);
+void tput_adapt_on_write_complete(bool success);
+bool tput_adapt_sample(tput_model_phy_t phy, uint16_t packet_size,
+                       uint16_t max_packet_size, uint32_t goodput_kbps,
+                       tput_adapt_action_t *p_action);
+void tput_adapt_get_stats(tput_adapt_stats_t *p_stats);
+void tput_adapt_clear_stats(void);
+void tput_adapt_print(void);
+
+#endif      /*__TPUT_ADAPT_H__ */
+/* [] END OF FILE */
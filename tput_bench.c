@@ -0,0 +1,386 @@
+/*******************************************************************************
+ * File Name: tput_bench.c
+ *
+ * Description: This file contains the benchmark runner, which measures the throughput
+ *              of a mode over repeated trials. Each trial discards the warm-up, waits for
+ *              steady state and is then measured; the trials are summarized with their
+ *              mean, standard deviation and 95% confidence interval.
+ *
+ * Related Document: See README.md
+ *
+ *
+ *******************************************************************************
+ * Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ ******************************************************************************/
+
+/******************************************************************************
+ *                                INCLUDES
+ ******************************************************************************/
+#include <stdio.h>
+#include <FreeRTOS.h>
+#include <task.h>
+#include "ble_client.h"
+#include "tput_bench.h"
+
+/******************************************************************************
+ *                                Macros
+ ******************************************************************************/
+/* Longest wait for the next one-second sample */
+#define TPUT_BENCH_SAMPLE_TIMEOUT_MS    (2000u)
+
+/*******************************************************************************
+*        Structures and Enumerations
+*******************************************************************************/
+/* Running mean and variance (Welford) */
+typedef struct
+{
+    uint32_t count;
+    double   mean;
+    double   m2;                // sum of squared differences from the mean
+} tput_bench_acc_t;
+
+/*******************************************************************************
+*        Variable Definitions
+*******************************************************************************/
+/* Two-sided 95% quantiles of Student's t distribution, by degrees of
+ * freedom from 1 to 30. 1.96 is used above */
+static const double t95[] =
+{
+    12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+    2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+    2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042
+};
+
+static TaskHandle_t bench_task = NULL;
+static volatile uint32_t sample_kbps = 0;
+static tput_mode_t bench_mode = GATT_NOTIF_STOC;
+
+/******************************************************************************
+ * Function Definitions
+ ******************************************************************************/
+
+/*******************************************************************************
+* Function Name: tput_bench_acc_add()
+********************************************************************************
+* Summary:
+*   Adds a value to a running mean and variance.
+*
+* Parameters:
+*   tput_bench_acc_t *p_acc : Accumulator
+*   double value            : Value added
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+static void tput_bench_acc_add(tput_bench_acc_t *p_acc, double value)
+{
+    double delta = value - p_acc->mean;
+
+    p_acc->count++;
+    p_acc->mean += delta / p_acc->count;
+    p_acc->m2 += delta * (value - p_acc->mean);
+}
+
+/*******************************************************************************
+* Function Name: tput_bench_sqrt()
+********************************************************************************
+* Summary:
+*   Square root by Newton's method, to avoid linking the math library.
+*
+* Parameters:
+*   double value : Non-negative value
+*
+* Return:
+*   double : Square root of value
+*
+*******************************************************************************/
+static double tput_bench_sqrt(double value)
+{
+    double root = (value > 1.0) ? value : 1.0;
+
+    if (value <= 0.0)
+    {
+        return 0.0;
+    }
+    for (uint32_t iter = 0; iter < 64u; iter++)
+    {
+        double next = 0.5 * (root + (value / root));
+        if (next >= root)
+        {
+            break;
+        }
+        root = next;
+    }
+    return root;
+}
+
+/*******************************************************************************
+* Function Name: tput_bench_acc_sd()
+********************************************************************************
+* Summary:
+*   Sample standard deviation of the values added to an accumulator.
+*
+* Parameters:
+*   const tput_bench_acc_t *p_acc : Accumulator
+*
+* Return:
+*   double : Standard deviation, 0 with less than two values
+*
+*******************************************************************************/
+static double tput_bench_acc_sd(const tput_bench_acc_t *p_acc)
+{
+    if (p_acc->count < 2u)
+    {
+        return 0.0;
+    }
+    return tput_bench_sqrt(p_acc->m2 / (p_acc->count - 1u));
+}
+
+/*******************************************************************************
+* Function Name: tput_bench_sample()
+********************************************************************************
+* Summary:
+*   Hands the throughput measured over the last second to a running
+*   benchmark. Called from get_throughput_task every second while connected.
+*   The sample is the throughput in the direction(s) the mode transfers.
+*
+* Parameters:
+*   uint32_t rx_kbps : Notification throughput
+*   uint32_t tx_kbps : GATT write throughput
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void tput_bench_sample(uint32_t rx_kbps, uint32_t tx_kbps)
+{
+    TaskHandle_t task = bench_task;
+
+    if (NULL == task)
+    {
+        return;
+    }
+    switch (bench_mode)
+    {
+    case GATT_NOTIF_STOC:
+        sample_kbps = rx_kbps;
+        break;
+    case GATT_NOTIFANDWRITE:
+        sample_kbps = rx_kbps + tx_kbps;
+        break;
+    default:
+        sample_kbps = tx_kbps;
+        break;
+    }
+    xTaskNotifyGive(task);
+}
+
+/*******************************************************************************
+* Function Name: tput_bench_wait_sample()
+********************************************************************************
+* Summary:
+*   Waits for the next one-second sample.
+*
+* Parameters:
+*   uint32_t *p_kbps : Sample
+*
+* Return:
+*   bool : false if no sample came, the link is down
+*
+*******************************************************************************/
+static bool tput_bench_wait_sample(uint32_t *p_kbps)
+{
+    if (0u == ulTaskNotifyTake(pdTRUE,
+                               pdMS_TO_TICKS(TPUT_BENCH_SAMPLE_TIMEOUT_MS)))
+    {
+        return false;
+    }
+    *p_kbps = sample_kbps;
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: tput_bench_trial()
+********************************************************************************
+* Summary:
+*   Runs one trial: sets the mode, discards TPUT_BENCH_WARMUP_S samples,
+*   waits for steady state, and measures measure_s samples.
+*
+* Parameters:
+*   uint32_t measure_s        : Number of samples measured
+*   uint32_t *p_settle_s      : Samples discarded before the measurement
+*   tput_bench_acc_t *p_acc   : Measured samples
+*
+* Return:
+*   bool : false if the link went down or the mode could not be set.
+*          p_acc->count is 0 if steady state was not reached
+*
+*******************************************************************************/
+static bool tput_bench_trial(uint32_t measure_s, uint32_t *p_settle_s,
+                             tput_bench_acc_t *p_acc)
+{
+    uint32_t window[TPUT_BENCH_WINDOW];
+    uint32_t kbps;
+    bool steady = false;
+
+    *p_settle_s = 0;
+    *p_acc = (tput_bench_acc_t){0};
+
+    /* Setting the mode again restarts the transfer, so that each trial
+     * includes the transient */
+    if (WICED_BT_GATT_SUCCESS != tput_set_mode(bench_mode))
+    {
+        return false;
+    }
+    ulTaskNotifyTake(pdTRUE, 0);
+
+    for (uint32_t sample = 0; sample < TPUT_BENCH_WARMUP_S; sample++)
+    {
+        if (!tput_bench_wait_sample(&kbps))
+        {
+            return false;
+        }
+        (*p_settle_s)++;
+    }
+
+    while (!steady && (*p_settle_s < TPUT_BENCH_STEADY_TIMEOUT_S))
+    {
+        tput_bench_acc_t win_acc = {0};
+
+        if (!tput_bench_wait_sample(&kbps))
+        {
+            return false;
+        }
+        window[*p_settle_s % TPUT_BENCH_WINDOW] = kbps;
+        (*p_settle_s)++;
+        if (*p_settle_s < (TPUT_BENCH_WARMUP_S + TPUT_BENCH_WINDOW))
+        {
+            continue;
+        }
+        for (uint32_t idx = 0; idx < TPUT_BENCH_WINDOW; idx++)
+        {
+            tput_bench_acc_add(&win_acc, window[idx]);
+        }
+        steady = (win_acc.mean > 0.0) &&
+                 ((tput_bench_acc_sd(&win_acc) * 100.0) <=
+                  (win_acc.mean * TPUT_BENCH_STEADY_CV_PCT));
+    }
+    if (!steady)
+    {
+        return true;
+    }
+
+    for (uint32_t sample = 0; sample < measure_s; sample++)
+    {
+        if (!tput_bench_wait_sample(&kbps))
+        {
+            return false;
+        }
+        tput_bench_acc_add(p_acc, kbps);
+    }
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: tput_bench_run()
+********************************************************************************
+* Summary:
+*   Measures the throughput of a mode over repeated trials. One CSV line,
+*   prefixed with "bench,", is printed per trial, followed by a line
+*   prefixed with "bench_summary," giving the mean, standard deviation and
+*   95% confidence interval of the trial means (see scripts/tput_bench.py).
+*   Trials that did not reach steady state are left out of the summary.
+*   Blocks until done, so it must be called from a task. The mode is left
+*   set at the end.
+*
+* Parameters:
+*   tput_mode_t mode   : Data transfer mode measured
+*   uint32_t trials    : Number of trials, up to TPUT_BENCH_MAX_TRIALS
+*   uint32_t measure_s : Measurement time of each trial, in seconds
+*
+* Return:
+*   bool : false if the arguments are invalid or the link went down
+*
+*******************************************************************************/
+bool tput_bench_run(tput_mode_t mode, uint32_t trials, uint32_t measure_s)
+{
+    tput_bench_acc_t trial_acc;
+    tput_bench_acc_t summary_acc = {0};
+    uint32_t settle_s;
+    double sd;
+    double half_width;
+    bool ok = true;
+
+    if ((0u == trials) || (trials > TPUT_BENCH_MAX_TRIALS) ||
+        (0u == measure_s) || (mode > TPUT_MODE_LAST))
+    {
+        return false;
+    }
+    bench_mode = mode;
+    bench_task = xTaskGetCurrentTaskHandle();
+
+    printf("bench,mode,trial,settle_s,steady,mean_kbps,sd_kbps\n");
+    for (uint32_t trial = 0; ok && (trial < trials); trial++)
+    {
+        ok = tput_bench_trial(measure_s, &settle_s, &trial_acc);
+        if (ok)
+        {
+            printf("bench,%u,%lu,%lu,%u,%.2f,%.2f\n", (unsigned)mode + 1u,
+                   (unsigned long)trial + 1u, (unsigned long)settle_s,
+                   (trial_acc.count ? 1u : 0u), trial_acc.mean,
+                   tput_bench_acc_sd(&trial_acc));
+            if (trial_acc.count)
+            {
+                tput_bench_acc_add(&summary_acc, trial_acc.mean);
+            }
+        }
+    }
+    bench_task = NULL;
+
+    sd = tput_bench_acc_sd(&summary_acc);
+    half_width = 0.0;
+    if (summary_acc.count >= 2u)
+    {
+        uint32_t df = summary_acc.count - 1u;
+        half_width = ((df <= (sizeof(t95) / sizeof(t95[0]))) ? t95[df - 1u] : 1.96) *
+                     sd / tput_bench_sqrt(summary_acc.count);
+    }
+    printf("bench_summary,mode,trials,mean_kbps,sd_kbps,ci95_low_kbps,"
+           "ci95_high_kbps\n");
+    printf("bench_summary,%u,%lu,%.2f,%.2f,%.2f,%.2f\n", (unsigned)mode + 1u,
+           (unsigned long)summary_acc.count, summary_acc.mean, sd,
+           summary_acc.mean - half_width, summary_acc.mean + half_width);
+    return ok;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,77 @@
+/*******************************************************************************
+ * File Name: tput_bench.h
+ *
+ * Description: This file contains the declarations of the statistical benchmark runner.
+ *
+ * Related Document: See README.md
+ *
+ *
+ *******************************************************************************
+ * Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ ******************************************************************************/
+
+#ifndef __TPUT_BENCH_H__
+#define __TPUT_BENCH_H__
+
+/******************************************************************************
+ *                                INCLUDES
+ ******************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include "ble_client.h"
+
+/******************************************************************************
+ *                                Macros
+ ******************************************************************************/
+/* One-second samples discarded after the mode is set, before steady state
+ * is looked for */
+#define TPUT_BENCH_WARMUP_S             (3u)
+/* Steady state is reached when the coefficient of variation of the last
+ * TPUT_BENCH_WINDOW samples is at most TPUT_BENCH_STEADY_CV_PCT percent */
+#define TPUT_BENCH_WINDOW               (5u)
+#define TPUT_BENCH_STEADY_CV_PCT        (5u)
+/* A trial that has not reached steady state after this long is reported
+ * and left out of the summary */
+#define TPUT_BENCH_STEADY_TIMEOUT_S     (30u)
+
+#define TPUT_BENCH_DEFAULT_TRIALS       (5u)
+#define TPUT_BENCH_MAX_TRIALS           (30u)
+#define TPUT_BENCH_DEFAULT_MEASURE_S    (10u)
+
+/****************************************************************************
+ *                              FUNCTION DECLARATIONS
+ ***************************************************************************/
+void tput_bench_sample(uint32_t rx_kbps, uint32_t tx_kbps);
+bool tput_bench_run(tput_mode_t mode, uint32_t trials, uint32_t measure_s);
+
+#endif      /*__TPUT_BENCH_H__ */
+/* [] END OF FILE */
@@ -0,0 +1,449 @@
+/*******************************************************************************
+ * File Name: tput_blob.c
+ *
+ * Description: This file implements the bulk blob transfer mode. The blob
+ *              is streamed as GATT write commands, each carrying the offset
+ *              of its payload, and is verified end to end with a CRC-32.
+ *
+ * Related Document: See README.md
+ *
+ *
+ *******************************************************************************
+ * Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ ******************************************************************************/
+
+/******************************************************************************
+ *                                INCLUDES
+ ******************************************************************************/
+#include <FreeRTOS.h>
+#include <task.h>
+#include <stdio.h>
+#include "app_bt_utils.h"
+#include "tput_blob.h"
+#include "tput_cwnd.h"
+
+/*******************************************************************************
+*         Macros
+*******************************************************************************/
+/* One entry per chunk that can be in flight, plus one to tell full from
+ * empty */
+#define BLOB_INFLIGHT_FIFO_SIZE         (TPUT_CWND_MAX_PKTS + 1u)
+
+/*******************************************************************************
+*        Structures and Enumerations
+*******************************************************************************/
+typedef enum
+{
+    BLOB_STATE_IDLE,        /* No transfer started yet */
+    BLOB_STATE_ACTIVE,      /* Chunks are being sent */
+    BLOB_STATE_SUSPENDED,   /* Link lost, waiting to resume */
+    BLOB_STATE_DONE         /* Trailer acknowledged */
+} blob_state_t;
+
+/* Bookkeeping for a chunk handed to the stack and not yet completed */
+typedef struct
+{
+    uint16_t chunk_len;     /* Length of the whole chunk, header included */
+    uint16_t payload_len;   /* Blob bytes carried, 0 for the trailer */
+    uint32_t crc_before;    /* Running CRC before this chunk */
+    uint32_t crc_after;     /* Running CRC including this chunk */
+    uint8_t epoch;          /* Rewind count when the chunk was built */
+} blob_chunk_info_t;
+
+/*******************************************************************************
+*        Function Prototypes
+*******************************************************************************/
+static bool tput_blob_default_read(uint32_t offset, uint8_t *p_buf,
+                                   uint16_t len);
+
+/*******************************************************************************
+*        Variable Definitions
+*******************************************************************************/
+static uint32_t blob_size = TPUT_BLOB_DEFAULT_SIZE;
+static tput_blob_read_t blob_read = tput_blob_default_read;
+static blob_state_t blob_state = BLOB_STATE_IDLE;
+/* Next offset to be sent and offset up to which all chunks have completed */
+static uint32_t next_offset = 0;
+static uint32_t acked_offset = 0;
+/* Running CRC of the sent and of the completed bytes */
+static uint32_t crc_sent = 0;
+static uint32_t crc_acked = 0;
+static bool trailer_queued = false;
+/* Set when a chunk failed: sending restarts from acked_offset. Chunks built
+ * before the rewind carry an older epoch and are not accounted for */
+static volatile bool rewind_pending = false;
+static uint8_t epoch = 0;
+static uint16_t resume_count = 0;
+static TickType_t start_tick = 0;
+/* Chunks in flight, pushed by the write task and popped by the GATT callback */
+static blob_chunk_info_t inflight_fifo[BLOB_INFLIGHT_FIFO_SIZE];
+static volatile uint8_t fifo_head = 0;
+static volatile uint8_t fifo_tail = 0;
+
+/******************************************************************************
+ * Function Definitions
+ ******************************************************************************/
+
+/*******************************************************************************
+* Function Name: tput_blob_default_read()
+********************************************************************************
+* Summary:
+*   Source of the built-in test blob. The content is a function of the offset
+*   only, so any range can be regenerated when a transfer is resumed.
+*
+* Parameters:
+*   uint32_t offset : Offset of the first byte
+*   uint8_t *p_buf  : Destination buffer
+*   uint16_t len    : Number of bytes to read
+*
+* Return:
+*   bool : Always true
+*
+*******************************************************************************/
+static bool tput_blob_default_read(uint32_t offset, uint8_t *p_buf,
+                                   uint16_t len)
+{
+    for (uint16_t index = 0; index < len; index++)
+    {
+        p_buf[index] = (uint8_t)(((offset + index) * 2654435761u) >> 24);
+    }
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: tput_blob_set_source()
+********************************************************************************
+* Summary:
+*   Registers the blob to be transferred, for example a firmware image or a
+*   log file. Passing NULL restores the built-in test blob.
+*
+* Parameters:
+*   uint32_t size            : Size of the blob in bytes
+*   tput_blob_read_t read_cb : Function that reads a range of the blob
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void tput_blob_set_source(uint32_t size, tput_blob_read_t read_cb)
+{
+    if (NULL == read_cb)
+    {
+        blob_size = TPUT_BLOB_DEFAULT_SIZE;
+        blob_read = tput_blob_default_read;
+    }
+    else
+    {
+        blob_size = size;
+        blob_read = read_cb;
+    }
+    blob_state = BLOB_STATE_IDLE;
+}
+
+/*******************************************************************************
+* Function Name: tput_blob_start()
+********************************************************************************
+* Summary:
+*   Starts a new transfer, or resumes the interrupted one from the last
+*   completed offset.
+*
+* Parameters:
+*   None
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void tput_blob_start(void)
+{
+    fifo_head = 0;
+    fifo_tail = 0;
+    trailer_queued = false;
+    rewind_pending = false;
+
+    if (BLOB_STATE_SUSPENDED == blob_state)
+    {
+        resume_count++;
+        printf("Resuming blob transfer at offset %lu of %lu\n",
+                (unsigned long)acked_offset, (unsigned long)blob_size);
+    }
+    else
+    {
+        acked_offset = 0;
+        crc_acked = 0;
+        resume_count = 0;
+        start_tick = xTaskGetTickCount();
+        printf("Starting blob transfer of %lu bytes\n",
+                (unsigned long)blob_size);
+    }
+    next_offset = acked_offset;
+    crc_sent = crc_acked;
+    blob_state = BLOB_STATE_ACTIVE;
+}
+
+/*******************************************************************************
+* Function Name: tput_blob_suspend()
+********************************************************************************
+* Summary:
+*   Called when the link is lost. Chunks still in flight are considered lost
+*   and will be sent again when the transfer is resumed.
+*
+* Parameters:
+*   None
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void tput_blob_suspend(void)
+{
+    if (BLOB_STATE_ACTIVE == blob_state)
+    {
+        blob_state = BLOB_STATE_SUSPENDED;
+        fifo_head = 0;
+        fifo_tail = 0;
+        printf("Blob transfer suspended at offset %lu\n",
+                (unsigned long)acked_offset);
+    }
+}
+
+/*******************************************************************************
+* Function Name: tput_blob_has_data()
+********************************************************************************
+* Summary:
+*   Checks whether a chunk or the trailer remains to be sent.
+*
+* Parameters:
+*   None
+*
+* Return:
+*   bool : true if tput_blob_build_chunk() will produce a chunk
+*
+*******************************************************************************/
+bool tput_blob_has_data(void)
+{
+    return ((BLOB_STATE_ACTIVE == blob_state) &&
+            ((!trailer_queued) || rewind_pending) &&
+            (((fifo_tail + 1u) % BLOB_INFLIGHT_FIFO_SIZE) != fifo_head));
+}
+
+/*******************************************************************************
+* Function Name: tput_blob_build_chunk()
+********************************************************************************
+* Summary:
+*   Fills p_buf with the next chunk: the payload offset followed by up to
+*   max_len - TPUT_BLOB_CHUNK_HDR_LEN bytes of the blob. Once the whole blob
+*   has been sent, the trailer is produced instead.
+*
+* Parameters:
+*   uint8_t *p_buf   : Buffer that will be passed to the stack
+*   uint16_t max_len : Size of p_buf, normally the write packet size
+*
+* Return:
+*   uint16_t : Length of the chunk, 0 if nothing is left to send
+*
+*******************************************************************************/
+uint16_t tput_blob_build_chunk(uint8_t *p_buf, uint16_t max_len)
+{
+    blob_chunk_info_t *p_info;
+    uint32_t offset;
+    uint16_t payload_len = 0;
+
+    if ((!tput_blob_has_data()) || (max_len < TPUT_BLOB_TRAILER_LEN))
+    {
+        return 0;
+    }
+
+    if (rewind_pending)
+    {
+        /* Send again from the chunk that failed */
+        taskENTER_CRITICAL();
+        next_offset = acked_offset;
+        crc_sent = crc_acked;
+        trailer_queued = false;
+        epoch++;
+        rewind_pending = false;
+        taskEXIT_CRITICAL();
+    }
+
+    p_info = &inflight_fifo[fifo_tail];
+    p_info->crc_before = crc_sent;
+    p_info->epoch = epoch;
+
+    if (next_offset < blob_size)
+    {
+        offset = next_offset;
+        payload_len = max_len - TPUT_BLOB_CHUNK_HDR_LEN;
+        if (payload_len > (blob_size - next_offset))
+        {
+            payload_len = (uint16_t)(blob_size - next_offset);
+        }
+        if (!blob_read(offset, &p_buf[TPUT_BLOB_CHUNK_HDR_LEN], payload_len))
+        {
+            printf("Blob read failed at offset %lu\n", (unsigned long)offset);
+            return 0;
+        }
+        crc_sent = crc32_update(crc_sent, &p_buf[TPUT_BLOB_CHUNK_HDR_LEN],
+                                payload_len);
+        next_offset += payload_len;
+        p_info->chunk_len = TPUT_BLOB_CHUNK_HDR_LEN + payload_len;
+    }
+    else
+    {
+        offset = TPUT_BLOB_TRAILER_OFFSET;
+        p_buf[4] = (uint8_t)(blob_size);
+        p_buf[5] = (uint8_t)(blob_size >> 8);
+        p_buf[6] = (uint8_t)(blob_size >> 16);
+        p_buf[7] = (uint8_t)(blob_size >> 24);
+        p_buf[8] = (uint8_t)(crc_sent);
+        p_buf[9] = (uint8_t)(crc_sent >> 8);
+        p_buf[10] = (uint8_t)(crc_sent >> 16);
+        p_buf[11] = (uint8_t)(crc_sent >> 24);
+        trailer_queued = true;
+        p_info->chunk_len = TPUT_BLOB_TRAILER_LEN;
+    }
+
+    p_buf[0] = (uint8_t)(offset);
+    p_buf[1] = (uint8_t)(offset >> 8);
+    p_buf[2] = (uint8_t)(offset >> 16);
+    p_buf[3] = (uint8_t)(offset >> 24);
+
+    p_info->payload_len = payload_len;
+    p_info->crc_after = crc_sent;
+    fifo_tail = (fifo_tail + 1u) % BLOB_INFLIGHT_FIFO_SIZE;
+
+    return p_info->chunk_len;
+}
+
+/*******************************************************************************
+* Function Name: tput_blob_cancel_chunk()
+********************************************************************************
+* Summary:
+*   Takes back the chunk built last, when the stack did not accept it.
+*
+* Parameters:
+*   None
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void tput_blob_cancel_chunk(void)
+{
+    blob_chunk_info_t *p_info;
+
+    if (fifo_tail == fifo_head)
+    {
+        return;
+    }
+
+    taskENTER_CRITICAL();
+    fifo_tail = (fifo_tail + BLOB_INFLIGHT_FIFO_SIZE - 1u) %
+                                                    BLOB_INFLIGHT_FIFO_SIZE;
+    p_info = &inflight_fifo[fifo_tail];
+    if (0u == p_info->payload_len)
+    {
+        trailer_queued = false;
+    }
+    next_offset -= p_info->payload_len;
+    crc_sent = p_info->crc_before;
+    taskEXIT_CRITICAL();
+}
+
+/*******************************************************************************
+* Function Name: tput_blob_on_chunk_complete()
+********************************************************************************
+* Summary:
+*   Accounts for a completed write command. Chunks complete in the order they
+*   were sent, so the oldest chunk in flight is the one that completed. When
+*   the trailer completes, the transfer time and rate are reported. If the
+*   chunk failed, the chunks sent after it are discarded and the transfer
+*   continues from the failed chunk.
+*
+* Parameters:
+*   bool success : true if the write command was sent
+*
+* Return:
+*   uint16_t : Length of the completed chunk, 0 if no chunk was in flight
+*
+*******************************************************************************/
+uint16_t tput_blob_on_chunk_complete(bool success)
+{
+    blob_chunk_info_t info;
+    uint32_t elapsed_ms;
+
+    taskENTER_CRITICAL();
+    if (fifo_head == fifo_tail)
+    {
+        taskEXIT_CRITICAL();
+        return 0;
+    }
+    info = inflight_fifo[fifo_head];
+    fifo_head = (fifo_head + 1u) % BLOB_INFLIGHT_FIFO_SIZE;
+    if (rewind_pending || (info.epoch != epoch))
+    {
+        /* Sent after a failed chunk, will be sent again */
+        taskEXIT_CRITICAL();
+        return info.chunk_len;
+    }
+    if (!success)
+    {
+        rewind_pending = true;
+    }
+    taskEXIT_CRITICAL();
+
+    if (!success)
+    {
+        printf("Blob chunk failed, resending from offset %lu\n",
+                (unsigned long)acked_offset);
+    }
+    else if (0u != info.payload_len)
+    {
+        acked_offset += info.payload_len;
+        crc_acked = info.crc_after;
+    }
+    else
+    {
+        blob_state = BLOB_STATE_DONE;
+        elapsed_ms = (uint32_t)(xTaskGetTickCount() - start_tick) *
+                                                        portTICK_PERIOD_MS;
+        printf("Blob transfer complete: %lu bytes in %lu ms (%.3f MB/s), "
+               "CRC-32 0x%08lX, resumed %u times\n",
+               (unsigned long)blob_size, (unsigned long)elapsed_ms,
+               (elapsed_ms) ? ((double)blob_size / 1000.0 / elapsed_ms) : 0.0,
+               (unsigned long)crc_acked, resume_count);
+    }
+
+    return info.chunk_len;
+}
+
+/* [] END OF FILE */
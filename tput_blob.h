@@ -0,0 +1,82 @@
+/*******************************************************************************
+ * File Name: tput_blob.h
+ *
+ * Description: This file contains the declarations of the bulk blob
+ *              transfer mode.
+ *
+ * Related Document: See README.md
+ *
+ *
+ *******************************************************************************
+ * Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ ******************************************************************************/
+
+#ifndef __TPUT_BLOB_H__
+#define __TPUT_BLOB_H__
+
+/******************************************************************************
+ *                                INCLUDES
+ ******************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+
+/******************************************************************************
+ *                                Macros
+ ******************************************************************************/
+/* Size of the built-in test blob used when no source is registered */
+#define TPUT_BLOB_DEFAULT_SIZE          (256u * 1024u)
+/* Every chunk starts with the little-endian offset of its payload */
+#define TPUT_BLOB_CHUNK_HDR_LEN         (4u)
+/* Offset value that marks the trailer chunk. The trailer carries the total
+ * blob length and the CRC-32 of the whole blob, both little-endian */
+#define TPUT_BLOB_TRAILER_OFFSET        (0xFFFFFFFFu)
+#define TPUT_BLOB_TRAILER_LEN           (TPUT_BLOB_CHUNK_HDR_LEN + 8u)
+
+/*******************************************************************************
+*        Structures and Enumerations
+*******************************************************************************/
+/* Reads len bytes of the blob at offset into p_buf. Returns false on error */
+typedef bool (*tput_blob_read_t)(uint32_t offset, uint8_t *p_buf, uint16_t len);
+
+/****************************************************************************
+ *                              FUNCTION DECLARATIONS
+ ***************************************************************************/
+void     tput_blob_set_source(uint32_t size, tput_blob_read_t read_cb);
+void     tput_blob_start(void);
+void     tput_blob_suspend(void);
+bool     tput_blob_has_data(void);
+uint16_t tput_blob_build_chunk(uint8_t *p_buf, uint16_t max_len);
+void     tput_blob_cancel_chunk(void);
+uint16_t tput_blob_on_chunk_complete(bool success);
+
+#endif      /*__TPUT_BLOB_H__ */
+/* [] END OF FILE */
@@ -0,0 +1,499 @@
+/*******************************************************************************
+ * File Name: tput_bridge.c
+ *
+ * Description: This file contains the BLE-to-UART bridge, which streams the received
+ *              notification payloads to a UART through two DMA buffers used in turn.
+ *
+ * Related Document: See README.md
+ *
+ *
+ *******************************************************************************
+ * Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ ******************************************************************************/
+
+/******************************************************************************
+ *                                INCLUDES
+ ******************************************************************************/
+#include <stdio.h>
+#include <string.h>
+#include <FreeRTOS.h>
+#include <task.h>
+#include "cyhal.h"
+#include "cy_retarget_io.h"
+#include "ble_client.h"
+#include "tput_bridge.h"
+
+#if TPUT_BRIDGE_ENABLE
+
+/*******************************************************************************
+*        Function Prototypes
+*******************************************************************************/
+static void tput_bridge_uart_cb(void *callback_arg, cyhal_uart_event_t event);
+
+/*******************************************************************************
+*        Variable Definitions
+*******************************************************************************/
+#if TPUT_BRIDGE_SECOND_UART
+static cyhal_uart_t bridge_uart;
+#endif
+static cyhal_uart_t *p_uart = NULL;
+static bool uart_dma = false;
+
+/* The task fills buffers[fill_idx] while the other buffer is transmitted.
+ * fill_idx, fill_len and tx_busy are changed by the task in critical
+ * sections and by the UART interrupt. While filling is set, the task copies
+ * into the fill buffer and the interrupt does not swap the buffers */
+static uint8_t buffers[2][TPUT_BRIDGE_BUF_SIZE];
+static uint32_t fill_idx = 0;
+static uint32_t fill_len = 0;
+static bool filling = false;
+static volatile bool tx_busy = false;
+static uint32_t tx_len = 0;
+
+static volatile bool running = false;
+static TaskHandle_t writer_task = NULL;
+static tput_bridge_stats_t stats;
+
+/******************************************************************************
+ * Function Definitions
+ ******************************************************************************/
+
+/*******************************************************************************
+* Function Name: tput_bridge_init()
+********************************************************************************
+* Summary:
+*   Sets up the bridge UART for asynchronous transfers, by DMA when a DMA
+*   channel is available and by interrupt otherwise.
+*
+* Parameters:
+*   None
+*
+* Return:
+*   cy_rslt_t : CY_RSLT_SUCCESS, or the error of the UART driver
+*
+*******************************************************************************/
+cy_rslt_t tput_bridge_init(void)
+{
+    cy_rslt_t rslt;
+
+#if TPUT_BRIDGE_SECOND_UART
+    const cyhal_uart_cfg_t uart_cfg =
+    {
+        .data_bits = 8u,
+        .stop_bits = 1u,
+        .parity = CYHAL_UART_PARITY_NONE,
+        .rx_buffer = NULL,
+        .rx_buffer_size = 0u
+    };
+    uint32_t actual_baud;
+
+    rslt = cyhal_uart_init(&bridge_uart, TPUT_BRIDGE_UART_TX,
+                           TPUT_BRIDGE_UART_RX, NC, NC, NULL, &uart_cfg);
+    if (CY_RSLT_SUCCESS == rslt)
+    {
+        rslt = cyhal_uart_set_baud(&bridge_uart, TPUT_BRIDGE_BAUD_RATE,
+                                   &actual_baud);
+    }
+    if (CY_RSLT_SUCCESS != rslt)
+    {
+        printf("UART bridge: UART init failed: 0x%lx\n", (unsigned long)rslt);
+        return rslt;
+    }
+    p_uart = &bridge_uart;
+#else
+    p_uart = &cy_retarget_io_uart_obj;
+#endif
+
+    uart_dma = (CY_RSLT_SUCCESS ==
+                cyhal_uart_set_async_mode(p_uart, CYHAL_ASYNC_DMA,
+                                          CYHAL_DMA_PRIORITY_DEFAULT));
+    if (!uart_dma)
+    {
+        rslt = cyhal_uart_set_async_mode(p_uart, CYHAL_ASYNC_SW,
+                                         CYHAL_DMA_PRIORITY_DEFAULT);
+        if (CY_RSLT_SUCCESS != rslt)
+        {
+            p_uart = NULL;
+            return rslt;
+        }
+    }
+    cyhal_uart_register_callback(p_uart, tput_bridge_uart_cb, NULL);
+    cyhal_uart_enable_event(p_uart, (cyhal_uart_event_t)(CYHAL_UART_IRQ_TX_DONE |
+                                                         CYHAL_UART_IRQ_TX_ERROR),
+                            TPUT_BRIDGE_UART_INTR_PRIORITY, true);
+    printf("UART bridge: %s UART, %s transfers\n",
+           (p_uart == &cy_retarget_io_uart_obj) ? "debug" : "second",
+           uart_dma ? "DMA" : "interrupt");
+    return CY_RSLT_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: tput_bridge_start()
+********************************************************************************
+* Summary:
+*   Starts accepting payloads with empty buffers.
+*
+* Parameters:
+*   None
+*
+* Return:
+*   bool : false if the UART could not be set up
+*
+*******************************************************************************/
+bool tput_bridge_start(void)
+{
+    if (NULL == p_uart)
+    {
+        return false;
+    }
+    taskENTER_CRITICAL();
+    fill_len = 0;
+    running = true;
+    taskEXIT_CRITICAL();
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: tput_bridge_stop()
+********************************************************************************
+* Summary:
+*   Stops accepting payloads. A transfer in progress completes; the bytes
+*   not yet transferred are discarded.
+*
+* Parameters:
+*   None
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void tput_bridge_stop(void)
+{
+    taskENTER_CRITICAL();
+    running = false;
+    fill_len = 0;
+    taskEXIT_CRITICAL();
+}
+
+/*******************************************************************************
+* Function Name: tput_bridge_is_running()
+********************************************************************************
+* Summary:
+*   Tells whether payloads are streamed to the UART.
+*
+* Parameters:
+*   None
+*
+* Return:
+*   bool : true between tput_bridge_start() and tput_bridge_stop()
+*
+*******************************************************************************/
+bool tput_bridge_is_running(void)
+{
+    return running;
+}
+
+/*******************************************************************************
+* Function Name: tput_bridge_is_on_debug_uart()
+********************************************************************************
+* Summary:
+*   Tells whether payloads are streamed to the debug UART, which printf()
+*   also writes to. The application holds back its text output meanwhile.
+*
+* Parameters:
+*   None
+*
+* Return:
+*   bool : true while running on the debug UART
+*
+*******************************************************************************/
+bool tput_bridge_is_on_debug_uart(void)
+{
+    return running && (p_uart == &cy_retarget_io_uart_obj);
+}
+
+/*******************************************************************************
+* Function Name: tput_bridge_swap()
+********************************************************************************
+* Summary:
+*   Hands the fill buffer to the UART and starts filling the other one, if
+*   the UART is idle and the fill buffer holds data. Called in a critical
+*   section or from the UART interrupt.
+*
+* Parameters:
+*   None
+*
+* Return:
+*   uint8_t * : Buffer to be transferred, tx_len bytes, or NULL
+*
+*******************************************************************************/
+static uint8_t *tput_bridge_swap(void)
+{
+    uint8_t *p_tx;
+
+    if (tx_busy || filling || (0u == fill_len))
+    {
+        return NULL;
+    }
+    p_tx = buffers[fill_idx];
+    tx_len = fill_len;
+    tx_busy = true;
+    fill_idx ^= 1u;
+    fill_len = 0;
+    return p_tx;
+}
+
+/*******************************************************************************
+* Function Name: tput_bridge_transfer()
+********************************************************************************
+* Summary:
+*   Starts the transfer of a buffer returned by tput_bridge_swap().
+*
+* Parameters:
+*   uint8_t *p_tx : Buffer to be transferred
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+static void tput_bridge_transfer(uint8_t *p_tx)
+{
+    if (CY_RSLT_SUCCESS != cyhal_uart_write_async(p_uart, p_tx, tx_len))
+    {
+        stats.tx_errors++;
+        stats.dropped_bytes += tx_len;
+        tx_busy = false;
+    }
+}
+
+/*******************************************************************************
+* Function Name: tput_bridge_flush()
+********************************************************************************
+* Summary:
+*   Starts transferring the payloads written so far if the UART is idle.
+*   Called once the sink has no more payloads to write, so that the UART
+*   carries as many payloads per transfer as have arrived meanwhile.
+*
+* Parameters:
+*   None
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void tput_bridge_flush(void)
+{
+    uint8_t *p_tx;
+
+    taskENTER_CRITICAL();
+    p_tx = tput_bridge_swap();
+    taskEXIT_CRITICAL();
+    if (NULL != p_tx)
+    {
+        tput_bridge_transfer(p_tx);
+    }
+}
+
+/*******************************************************************************
+* Function Name: tput_bridge_write()
+********************************************************************************
+* Summary:
+*   Copies a payload into the fill buffer. If it does not fit, the payload
+*   waits for the transfer in progress to complete, at most
+*   TPUT_BRIDGE_WAIT_MS, and is dropped after that. Called from a task.
+*
+* Parameters:
+*   const uint8_t *p_data : Payload
+*   uint16_t len          : Length of the payload
+*
+* Return:
+*   bool : false if the payload was dropped
+*
+*******************************************************************************/
+bool tput_bridge_write(const uint8_t *p_data, uint16_t len)
+{
+    TickType_t start_tick = xTaskGetTickCount();
+    TickType_t wait_ticks = pdMS_TO_TICKS(TPUT_BRIDGE_WAIT_MS);
+    uint8_t *p_dst = NULL;
+    bool waited = false;
+
+    if (!running)
+    {
+        return false;
+    }
+    writer_task = xTaskGetCurrentTaskHandle();
+
+    while (len <= TPUT_BRIDGE_BUF_SIZE)
+    {
+        taskENTER_CRITICAL();
+        if ((fill_len + len) <= TPUT_BRIDGE_BUF_SIZE)
+        {
+            p_dst = &buffers[fill_idx][fill_len];
+            filling = true;
+        }
+        taskEXIT_CRITICAL();
+        if (NULL != p_dst)
+        {
+            break;
+        }
+
+        /* Full: send it if the UART is idle, otherwise wait for the
+         * interrupt to take it */
+        tput_bridge_flush();
+        if (tx_busy)
+        {
+            if (!waited)
+            {
+                waited = true;
+                stats.backpressure_events++;
+            }
+            if ((xTaskGetTickCount() - start_tick) >= wait_ticks)
+            {
+                break;
+            }
+            ulTaskNotifyTakeIndexed(TPUT_BRIDGE_NOTIFY_INDEX, pdTRUE,
+                                    wait_ticks);
+        }
+    }
+
+    if (NULL == p_dst)
+    {
+        taskENTER_CRITICAL();
+        stats.dropped_bytes += len;
+        stats.dropped_pkts++;
+        taskEXIT_CRITICAL();
+        return false;
+    }
+
+    memcpy(p_dst, p_data, len);
+    taskENTER_CRITICAL();
+    fill_len += len;
+    filling = false;
+    taskEXIT_CRITICAL();
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: tput_bridge_uart_cb()
+********************************************************************************
+* Summary:
+*   UART interrupt callback. Counts the completed transfer and, if payloads
+*   were written meanwhile, starts transferring them at once.
+*
+* Parameters:
+*   void *callback_arg       : Unused
+*   cyhal_uart_event_t event : CYHAL_UART_IRQ_TX_DONE or CYHAL_UART_IRQ_TX_ERROR
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+static void tput_bridge_uart_cb(void *callback_arg, cyhal_uart_event_t event)
+{
+    BaseType_t higher_priority_task_woken = pdFALSE;
+    uint8_t *p_tx;
+
+    if (!tx_busy)
+    {
+        return;
+    }
+    if (0u != (event & CYHAL_UART_IRQ_TX_ERROR))
+    {
+        stats.tx_errors++;
+        stats.dropped_bytes += tx_len;
+    }
+    else if (0u != (event & CYHAL_UART_IRQ_TX_DONE))
+    {
+        stats.bytes += tx_len;
+        stats.transfers++;
+    }
+    else
+    {
+        return;
+    }
+    tx_busy = false;
+
+    if (running && (NULL != (p_tx = tput_bridge_swap())))
+    {
+        tput_bridge_transfer(p_tx);
+    }
+    if (NULL != writer_task)
+    {
+        vTaskNotifyGiveIndexedFromISR(writer_task, TPUT_BRIDGE_NOTIFY_INDEX,
+                                      &higher_priority_task_woken);
+    }
+    portYIELD_FROM_ISR(higher_priority_task_woken);
+}
+
+/*******************************************************************************
+* Function Name: tput_bridge_get_stats()
+********************************************************************************
+* Summary:
+*   Reads the statistics since the last call of tput_bridge_clear_stats().
+*
+* Parameters:
+*   tput_bridge_stats_t *p_stats : Statistics read
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void tput_bridge_get_stats(tput_bridge_stats_t *p_stats)
+{
+    taskENTER_CRITICAL();
+    *p_stats = stats;
+    taskEXIT_CRITICAL();
+}
+
+/*******************************************************************************
+* Function Name: tput_bridge_clear_stats()
+********************************************************************************
+* Summary:
+*   Clears the statistics.
+*
+* Parameters:
+*   None
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void tput_bridge_clear_stats(void)
+{
+    taskENTER_CRITICAL();
+    memset(&stats, 0, sizeof(stats));
+    taskEXIT_CRITICAL();
+}
+
+#endif /* TPUT_BRIDGE_ENABLE */
+
+/* [] END OF FILE */
@@ -0,0 +1,117 @@
+/*******************************************************************************
+ * File Name: tput_bridge.h
+ *
+ * Description: This file contains the declarations of the BLE-to-UART bridge.
+ *
+ * Related Document: See README.md
+ *
+ *
+ *******************************************************************************
+ * Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ ******************************************************************************/
+
+#ifndef __TPUT_BRIDGE_H__
+#define __TPUT_BRIDGE_H__
+
+/******************************************************************************
+ *                                INCLUDES
+ ******************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include "cyhal.h"
+
+/******************************************************************************
+ *                                Macros
+ ******************************************************************************/
+/* Set to 1 to stream the payloads to a second UART on the pins below. With
+ * 0, the debug UART is used at the baud rate set by cy_retarget_io, and the
+ * statistics and the console replies are not printed while streaming */
+#ifndef TPUT_BRIDGE_SECOND_UART
+#define TPUT_BRIDGE_SECOND_UART         (0)
+#endif
+#ifndef TPUT_BRIDGE_UART_TX
+#define TPUT_BRIDGE_UART_TX             (CYBSP_D1)
+#endif
+#ifndef TPUT_BRIDGE_UART_RX
+#define TPUT_BRIDGE_UART_RX             (CYBSP_D0)
+#endif
+/* Baud rate of the second UART */
+#ifndef TPUT_BRIDGE_BAUD_RATE
+#define TPUT_BRIDGE_BAUD_RATE           (3000000u)
+#endif
+
+/* Size of each of the two transmit buffers. One is sent by DMA while the
+ * other one is filled */
+#ifndef TPUT_BRIDGE_BUF_SIZE
+#define TPUT_BRIDGE_BUF_SIZE            (2048u)
+#endif
+
+/* Longest time tput_bridge_write() waits for a buffer to be free before the
+ * payload is dropped */
+#ifndef TPUT_BRIDGE_WAIT_MS
+#define TPUT_BRIDGE_WAIT_MS             (50u)
+#endif
+
+/* Task notification index tput_bridge_write() waits on. The calling task
+ * must not use it for anything else */
+#define TPUT_BRIDGE_NOTIFY_INDEX        (1u)
+
+#define TPUT_BRIDGE_UART_INTR_PRIORITY  (6u)
+
+/*******************************************************************************
+*        Structures and Enumerations
+*******************************************************************************/
+typedef struct
+{
+    uint32_t bytes;                 // bytes transmitted on the UART
+    uint32_t transfers;             // DMA transfers completed
+    uint32_t backpressure_events;   // times a payload waited for a free buffer
+    uint32_t dropped_bytes;         // bytes of the payloads dropped
+    uint32_t dropped_pkts;
+    uint32_t tx_errors;             // transfers completed with an error
+} tput_bridge_stats_t;
+
+/****************************************************************************
+ *                              FUNCTION DECLARATIONS
+ ***************************************************************************/
+cy_rslt_t tput_bridge_init(void);
+bool tput_bridge_start(void);
+void tput_bridge_stop(void);
+bool tput_bridge_is_running(void);
+bool tput_bridge_is_on_debug_uart(void);
+bool tput_bridge_write(const uint8_t *p_data, uint16_t len);
+void tput_bridge_flush(void);
+void tput_bridge_get_stats(tput_bridge_stats_t *p_stats);
+void tput_bridge_clear_stats(void);
+
+#endif      /*__TPUT_BRIDGE_H__ */
+/* [] END OF FILE */
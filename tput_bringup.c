@@ -0,0 +1,212 @@
+/*******************************************************************************
+ * File Name: tput_bringup.c
+ *
+ * Description: This file times the connection bring-up, from the connection to the
+ *              first payload byte sent or received.
+ *
+ * Related Document: See README.md
+ *
+ *
+ *******************************************************************************
+ * Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ ******************************************************************************/
+
+/******************************************************************************
+ *                                INCLUDES
+ ******************************************************************************/
+#include <stdio.h>
+#include <string.h>
+#include "ble_client.h"
+#include "tput_time.h"
+#include "tput_bringup.h"
+
+/*******************************************************************************
+*        Variable Definitions
+*******************************************************************************/
+static uint32_t connected_us = 0;
+static tput_bringup_result_t result = {0};
+
+/* Names printed for the steps after TPUT_BRINGUP_CONNECTED */
+static const char * const step_names[TPUT_BRINGUP_NUM_STEPS] =
+{
+    [TPUT_BRINGUP_MTU]         = "MTU",
+    [TPUT_BRINGUP_PHY]         = "PHY",
+    [TPUT_BRINGUP_DATA_LENGTH] = "data length",
+    [TPUT_BRINGUP_DISCOVERY]   = "discovery",
+    [TPUT_BRINGUP_MODE]        = "mode started",
+    [TPUT_BRINGUP_FIRST_BYTE]  = "first byte",
+};
+
+/******************************************************************************
+ * Function Definitions
+ ******************************************************************************/
+
+/*******************************************************************************
+* Function Name: tput_bringup_reset()
+********************************************************************************
+* Summary:
+*   Clears the times of the previous connection.
+*
+* Parameters:
+*   None
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void tput_bringup_reset(void)
+{
+    memset(&result, 0, sizeof(result));
+    connected_us = 0;
+}
+
+/*******************************************************************************
+* Function Name: tput_bringup_mark()
+********************************************************************************
+* Summary:
+*   Times a step of the bring-up, the first time it completes on the
+*   connection. Marking TPUT_BRINGUP_CONNECTED restarts the timing. The
+*   times are printed when the first payload byte is marked.
+*
+* Parameters:
+*   tput_bringup_step_t step : Step completed
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void tput_bringup_mark(tput_bringup_step_t step)
+{
+    uint32_t now_us = tput_time_us();
+
+    if (TPUT_BRINGUP_CONNECTED == step)
+    {
+        tput_bringup_reset();
+        connected_us = now_us;
+        result.done_mask = (uint8_t)(1u << TPUT_BRINGUP_CONNECTED);
+        return;
+    }
+    /* Not connected, or already timed */
+    if ((0u == (result.done_mask & (1u << TPUT_BRINGUP_CONNECTED))) ||
+        (0u != (result.done_mask & (1u << step))))
+    {
+        return;
+    }
+    result.step_us[step] = now_us - connected_us;
+    result.done_mask |= (uint8_t)(1u << step);
+    if (TPUT_BRINGUP_FIRST_BYTE == step)
+    {
+        tput_bringup_print();
+    }
+}
+
+/*******************************************************************************
+* Function Name: tput_bringup_is_complete()
+********************************************************************************
+* Summary:
+*   Tells if the first payload byte of the connection was timed. Lets the
+*   data path skip tput_bringup_mark() once the bring-up is over.
+*
+* Parameters:
+*   None
+*
+* Return:
+*   bool : true once the first byte was sent or received
+*
+*******************************************************************************/
+bool tput_bringup_is_complete(void)
+{
+    return (0u != (result.done_mask & (1u << TPUT_BRINGUP_FIRST_BYTE)));
+}
+
+/*******************************************************************************
+* Function Name: tput_bringup_get()
+********************************************************************************
+* Summary:
+*   Reads the times of the steps completed on the current connection.
+*
+* Parameters:
+*   tput_bringup_result_t *p_result : Times read
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void tput_bringup_get(tput_bringup_result_t *p_result)
+{
+    *p_result = result;
+}
+
+/*******************************************************************************
+* Function Name: tput_bringup_print()
+********************************************************************************
+* Summary:
+*   Prints the time of each step completed since the connection, in the
+*   order they are defined. Steps not completed are printed as "-".
+*
+* Parameters:
+*   None
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void tput_bringup_print(void)
+{
+    uint32_t step;
+
+    if (0u == (result.done_mask & (1u << TPUT_BRINGUP_CONNECTED)))
+    {
+        printf("Bring-up: not connected\n");
+        return;
+    }
+    printf("Bring-up (%s) since connection:",
+           TPUT_PIPELINED_BRINGUP ? "pipelined" : "sequential");
+    for (step = TPUT_BRINGUP_MTU; step < TPUT_BRINGUP_NUM_STEPS; step++)
+    {
+        if (0u != (result.done_mask & (1u << step)))
+        {
+            printf(" %s %lu.%lu ms%s", step_names[step],
+                   (unsigned long)(result.step_us[step] / 1000u),
+                   (unsigned long)((result.step_us[step] % 1000u) / 100u),
+                   (TPUT_BRINGUP_FIRST_BYTE == step) ? "" : ",");
+        }
+        else
+        {
+            printf(" %s -%s", step_names[step],
+                   (TPUT_BRINGUP_FIRST_BYTE == step) ? "" : ",");
+        }
+    }
+    printf("\n");
+}
+
+/* [] END OF FILE */
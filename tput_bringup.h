@@ -0,0 +1,84 @@
+/*******************************************************************************
+ * File Name: tput_bringup.h
+ *
+ * Description: This file contains the declarations of the connection bring-up timing.
+ *
+ * Related Document: See README.md
+ *
+ *
+ *******************************************************************************
+ * Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ ******************************************************************************/
+
+#ifndef __TPUT_BRINGUP_H__
+#define __TPUT_BRINGUP_H__
+
+/******************************************************************************
+ *                                INCLUDES
+ ******************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+
+/*******************************************************************************
+*        Structures and Enumerations
+*******************************************************************************/
+/* Steps from the connection to the first payload byte. Each step is timed
+ * once per connection, relative to TPUT_BRINGUP_CONNECTED */
+typedef enum
+{
+    TPUT_BRINGUP_CONNECTED,
+    TPUT_BRINGUP_MTU,           // MTU exchange completed
+    TPUT_BRINGUP_PHY,           // PHY update completed
+    TPUT_BRINGUP_DATA_LENGTH,   // data length update completed
+    TPUT_BRINGUP_DISCOVERY,     // throughput service discovered
+    TPUT_BRINGUP_MODE,          // CCCD written, data transfer mode started
+    TPUT_BRINGUP_FIRST_BYTE,    // first notification received or write sent
+    TPUT_BRINGUP_NUM_STEPS
+} tput_bringup_step_t;
+
+typedef struct
+{
+    uint32_t step_us[TPUT_BRINGUP_NUM_STEPS]; // time since the connection
+    uint8_t  done_mask;                       // bit per step timed
+} tput_bringup_result_t;
+
+/****************************************************************************
+ *                              FUNCTION DECLARATIONS
+ ***************************************************************************/
+void tput_bringup_reset(void);
+void tput_bringup_mark(tput_bringup_step_t step);
+bool tput_bringup_is_complete(void);
+void tput_bringup_get(tput_bringup_result_t *p_result);
+void tput_bringup_print(void);
+
+#endif      /*__TPUT_BRINGUP_H__ */
+/* [] END OF FILE */
@@ -0,0 +1,424 @@
+/*******************************************************************************
+ * File Name: tput_coalesce.c
+ *
+ * Description: This file implements a Nagle-style coalescing layer in front
+ *              of the GATT write path. Length-prefixed messages are packed
+ *              into packet sized buffers, which are sent when full or when
+ *              the oldest message reaches the configured deadline.
+ *
+ * Related Document: See README.md
+ *
+ *
+ *******************************************************************************
+ * Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ ******************************************************************************/
+
+/******************************************************************************
+ *                                INCLUDES
+ ******************************************************************************/
+#include <FreeRTOS.h>
+#include <task.h>
+#include <string.h>
+#include "ble_client.h"
+#include "tput_coalesce.h"
+
+/*******************************************************************************
+*        Structures and Enumerations
+*******************************************************************************/
+typedef enum
+{
+    SLOT_FREE,          /* Available for new messages */
+    SLOT_FILLING,       /* Accepting messages */
+    SLOT_READY,         /* Closed, waiting for the write window */
+    SLOT_IN_STACK       /* Handed to the stack, not yet transmitted */
+} slot_state_t;
+
+typedef struct
+{
+    uint8_t               data[GATT_WRITE_BYTES_MAX_LEN];
+    uint16_t              len;
+    volatile slot_state_t state;
+    TickType_t            first_msg_tick;   /* Submit time of the first message */
+    uint32_t              msg_offset_sum;   /* Sum of submit times relative to it */
+    uint16_t              msg_count;
+    uint16_t              msg_bytes;
+    bool                  by_deadline;
+    uint32_t              latency_sum_ms;   /* Added to the statistics when sent */
+} coalesce_slot_t;
+
+/*******************************************************************************
+*        Variable Definitions
+*******************************************************************************/
+static coalesce_slot_t slots[TPUT_COALESCE_NUM_SLOTS];
+/* Slots are filled, sent and transmitted in ring order */
+static uint8_t fill_idx = 0;
+static uint8_t send_idx = 0;
+static uint16_t coalesce_packet_len = 0;
+static uint16_t coalesce_deadline_ms = TPUT_COALESCE_DEADLINE_MS;
+static tput_coalesce_stats_t stats;
+
+/*******************************************************************************
+*        Function Prototypes
+*******************************************************************************/
+static void tput_coalesce_close_slot(bool by_deadline);
+
+/******************************************************************************
+ * Function Definitions
+ ******************************************************************************/
+
+/*******************************************************************************
+* Function Name: tput_coalesce_init()
+********************************************************************************
+* Summary:
+*   Resets the coalescing layer for a new packet size and deadline.
+*
+* Parameters:
+*   uint16_t packet_len  : Size of the packets to be filled
+*   uint16_t deadline_ms : Maximum time a message waits for the packet to fill
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void tput_coalesce_init(uint16_t packet_len, uint16_t deadline_ms)
+{
+    for (uint8_t index = 0; index < TPUT_COALESCE_NUM_SLOTS; index++)
+    {
+        /* Slots held by the stack are freed on transmission */
+        if (SLOT_IN_STACK != slots[index].state)
+        {
+            slots[index].state = SLOT_FREE;
+        }
+    }
+    fill_idx = 0;
+    send_idx = 0;
+    coalesce_packet_len = (packet_len > GATT_WRITE_BYTES_MAX_LEN) ?
+                            GATT_WRITE_BYTES_MAX_LEN : packet_len;
+    coalesce_deadline_ms = deadline_ms;
+    tput_coalesce_clear_stats();
+}
+
+/*******************************************************************************
+* Function Name: tput_coalesce_close_slot()
+********************************************************************************
+* Summary:
+*   Marks the slot being filled as ready to send and moves to the next one.
+*
+* Parameters:
+*   bool by_deadline : true if closed because the deadline expired
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+static void tput_coalesce_close_slot(bool by_deadline)
+{
+    slots[fill_idx].by_deadline = by_deadline;
+    slots[fill_idx].state = SLOT_READY;
+    fill_idx = (fill_idx + 1u) % TPUT_COALESCE_NUM_SLOTS;
+}
+
+/*******************************************************************************
+* Function Name: tput_coalesce_submit()
+********************************************************************************
+* Summary:
+*   Appends a message, preceded by its length, to the packet being filled.
+*   A packet that cannot take the message is closed first.
+*
+* Parameters:
+*   const uint8_t *p_msg : Message to be sent
+*   uint8_t len          : Length of the message
+*
+* Return:
+*   bool : false if no packet buffer is free. The caller should retry later.
+*
+*******************************************************************************/
+bool tput_coalesce_submit(const uint8_t *p_msg, uint8_t len)
+{
+    coalesce_slot_t *p_slot = &slots[fill_idx];
+    TickType_t now = xTaskGetTickCount();
+
+    if ((0u == len) ||
+        ((TPUT_COALESCE_LEN_PREFIX + len) > coalesce_packet_len))
+    {
+        return false;
+    }
+
+    if ((SLOT_FILLING == p_slot->state) &&
+        ((p_slot->len + TPUT_COALESCE_LEN_PREFIX + len) > coalesce_packet_len))
+    {
+        tput_coalesce_close_slot(false);
+        p_slot = &slots[fill_idx];
+    }
+
+    if (SLOT_FREE == p_slot->state)
+    {
+        p_slot->len = 0;
+        p_slot->msg_count = 0;
+        p_slot->msg_bytes = 0;
+        p_slot->msg_offset_sum = 0;
+        p_slot->first_msg_tick = now;
+        p_slot->state = SLOT_FILLING;
+    }
+    else if (SLOT_FILLING != p_slot->state)
+    {
+        stats.rejected++;
+        return false;
+    }
+
+    p_slot->data[p_slot->len] = len;
+    memcpy(&p_slot->data[p_slot->len + TPUT_COALESCE_LEN_PREFIX], p_msg, len);
+    p_slot->len += TPUT_COALESCE_LEN_PREFIX + len;
+    p_slot->msg_count++;
+    p_slot->msg_bytes += len;
+    p_slot->msg_offset_sum += (uint32_t)(now - p_slot->first_msg_tick);
+
+    /* Close the packet right away if not even a one byte message fits */
+    if ((p_slot->len + TPUT_COALESCE_LEN_PREFIX + 1u) > coalesce_packet_len)
+    {
+        tput_coalesce_close_slot(false);
+    }
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: tput_coalesce_tick()
+********************************************************************************
+* Summary:
+*   Closes the packet being filled if its oldest message has reached the
+*   deadline. Called from the write task every millisecond.
+*
+* Parameters:
+*   None
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void tput_coalesce_tick(void)
+{
+    coalesce_slot_t *p_slot = &slots[fill_idx];
+
+    if ((SLOT_FILLING == p_slot->state) &&
+        ((uint32_t)(xTaskGetTickCount() - p_slot->first_msg_tick) *
+                        portTICK_PERIOD_MS >= coalesce_deadline_ms))
+    {
+        tput_coalesce_close_slot(true);
+    }
+}
+
+/*******************************************************************************
+* Function Name: tput_coalesce_get_ready()
+********************************************************************************
+* Summary:
+*   Returns the oldest packet that is ready to be sent. The packet stays
+*   queued until tput_coalesce_on_sent() is called.
+*
+* Parameters:
+*   uint16_t *p_len : Length of the packet
+*
+* Return:
+*   uint8_t * : Packet data, NULL if no packet is ready
+*
+*******************************************************************************/
+uint8_t *tput_coalesce_get_ready(uint16_t *p_len)
+{
+    coalesce_slot_t *p_slot = &slots[send_idx];
+
+    if (SLOT_READY != p_slot->state)
+    {
+        return NULL;
+    }
+    *p_len = p_slot->len;
+    return p_slot->data;
+}
+
+/*******************************************************************************
+* Function Name: tput_coalesce_on_sent()
+********************************************************************************
+* Summary:
+*   Accounts for the packet returned by tput_coalesce_get_ready() being
+*   passed to the stack. Called before the stack is called, as the buffer
+*   may be transmitted and released before the call returns. The buffer is
+*   owned by the stack until tput_coalesce_release() is called on
+*   GATT_APP_BUFFER_TRANSMITTED_EVT. If the stack does not accept the
+*   packet, tput_coalesce_cancel_sent() queues it again.
+*
+* Parameters:
+*   None
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void tput_coalesce_on_sent(void)
+{
+    coalesce_slot_t *p_slot = &slots[send_idx];
+    uint32_t wait_ms = (uint32_t)(xTaskGetTickCount() - p_slot->first_msg_tick)
+                                                        * portTICK_PERIOD_MS;
+
+    stats.messages += p_slot->msg_count;
+    stats.message_bytes += p_slot->msg_bytes;
+    stats.packets++;
+    stats.packet_capacity += coalesce_packet_len;
+    if (p_slot->by_deadline)
+    {
+        stats.deadline_flushes++;
+    }
+    else
+    {
+        stats.fill_flushes++;
+    }
+    /* The first message waited the longest. The others waited less by their
+     * submit time relative to it */
+    p_slot->latency_sum_ms = (wait_ms * p_slot->msg_count) -
+                             (p_slot->msg_offset_sum * portTICK_PERIOD_MS);
+    stats.latency_sum_ms += p_slot->latency_sum_ms;
+    if (wait_ms > stats.latency_max_ms)
+    {
+        stats.latency_max_ms = wait_ms;
+    }
+
+    p_slot->state = SLOT_IN_STACK;
+    send_idx = (send_idx + 1u) % TPUT_COALESCE_NUM_SLOTS;
+}
+
+/*******************************************************************************
+* Function Name: tput_coalesce_cancel_sent()
+********************************************************************************
+* Summary:
+*   Queues again the packet passed last to tput_coalesce_on_sent(), when the
+*   stack did not accept it, and takes it out of the statistics. The
+*   longest latency is kept.
+*
+* Parameters:
+*   None
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void tput_coalesce_cancel_sent(void)
+{
+    uint8_t last_idx = (send_idx + TPUT_COALESCE_NUM_SLOTS - 1u) %
+                                                    TPUT_COALESCE_NUM_SLOTS;
+    coalesce_slot_t *p_slot = &slots[last_idx];
+
+    if (SLOT_IN_STACK != p_slot->state)
+    {
+        return;
+    }
+    /* Unless the statistics were cleared meanwhile */
+    if (0u != stats.packets)
+    {
+        stats.messages -= p_slot->msg_count;
+        stats.message_bytes -= p_slot->msg_bytes;
+        stats.packets--;
+        stats.packet_capacity -= coalesce_packet_len;
+        if (p_slot->by_deadline)
+        {
+            stats.deadline_flushes--;
+        }
+        else
+        {
+            stats.fill_flushes--;
+        }
+        stats.latency_sum_ms -= p_slot->latency_sum_ms;
+    }
+
+    p_slot->state = SLOT_READY;
+    send_idx = last_idx;
+}
+
+/*******************************************************************************
+* Function Name: tput_coalesce_release()
+********************************************************************************
+* Summary:
+*   Returns a packet buffer to the pool once the stack has transmitted it.
+*   Passed to the stack as the buffer context, see pfn_free_buffer_t.
+*
+* Parameters:
+*   uint8_t *p_buf : Packet data returned by tput_coalesce_get_ready()
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void tput_coalesce_release(uint8_t *p_buf)
+{
+    for (uint8_t index = 0; index < TPUT_COALESCE_NUM_SLOTS; index++)
+    {
+        if (slots[index].data == p_buf)
+        {
+            slots[index].state = SLOT_FREE;
+            break;
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: tput_coalesce_get_stats()
+********************************************************************************
+* Summary:
+*   Returns the packing and latency statistics.
+*
+* Parameters:
+*   tput_coalesce_stats_t *p_stats : Pointer to the structure to be filled
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void tput_coalesce_get_stats(tput_coalesce_stats_t *p_stats)
+{
+    *p_stats = stats;
+}
+
+/*******************************************************************************
+* Function Name: tput_coalesce_clear_stats()
+********************************************************************************
+* Summary:
+*   Clears the packing and latency statistics.
+*
+* Parameters:
+*   None
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void tput_coalesce_clear_stats(void)
+{
+    memset(&stats, 0, sizeof(stats));
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,97 @@
+/*******************************************************************************
+ * File Name: tput_coalesce.h
+ *
+ * Description: This file contains the declarations of the layer that packs
+ *              small messages into full GATT write packets.
+ *
+ * Related Document: See README.md
+ *
+ *
+ *******************************************************************************
+ * Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ ******************************************************************************/
+
+#ifndef __TPUT_COALESCE_H__
+#define __TPUT_COALESCE_H__
+
+/******************************************************************************
+ *                                INCLUDES
+ ******************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+
+/******************************************************************************
+ *                                Macros
+ ******************************************************************************/
+/* Number of packet buffers: one being filled, the rest waiting for the write
+ * window or held by the stack until transmitted */
+#define TPUT_COALESCE_NUM_SLOTS         (8u)
+/* A partially filled packet is sent once its oldest message is this old.
+ * Default of tput_coalesce_init(), changed with the console command
+ * "coalesce" */
+#ifndef TPUT_COALESCE_DEADLINE_MS
+#define TPUT_COALESCE_DEADLINE_MS       (5u)
+#endif
+/* Each message is preceded by a one byte length */
+#define TPUT_COALESCE_LEN_PREFIX        (1u)
+
+/*******************************************************************************
+*        Structures and Enumerations
+*******************************************************************************/
+typedef struct
+{
+    uint32_t messages;          // messages packed and sent
+    uint32_t message_bytes;     // message bytes sent, length prefixes excluded
+    uint32_t packets;           // packets sent
+    uint32_t packet_capacity;   // packets * packet size
+    uint32_t fill_flushes;      // packets sent because they were full
+    uint32_t deadline_flushes;  // packets sent because of the deadline
+    uint32_t rejected;          // messages refused because no buffer was free
+    uint32_t latency_sum_ms;    // sum of the time messages waited to be sent
+    uint32_t latency_max_ms;    // longest time a message waited to be sent
+} tput_coalesce_stats_t;
+
+/****************************************************************************
+ *                              FUNCTION DECLARATIONS
+ ***************************************************************************/
+void tput_coalesce_init(uint16_t packet_len, uint16_t deadline_ms);
+bool tput_coalesce_submit(const uint8_t *p_msg, uint8_t len);
+void tput_coalesce_tick(void);
+uint8_t *tput_coalesce_get_ready(uint16_t *p_len);
+void tput_coalesce_on_sent(void);
+void tput_coalesce_cancel_sent(void);
+void tput_coalesce_release(uint8_t *p_buf);
+void tput_coalesce_get_stats(tput_coalesce_stats_t *p_stats);
+void tput_coalesce_clear_stats(void);
+
+#endif      /*__TPUT_COALESCE_H__ */
+/* [] END OF FILE */
@@ -0,0 +1,246 @@
+/*******************************************************************************
+ * File Name: tput_conn_evt.c
+ *
+ * Description: This file contains a histogram of the number of packets sent and received
+ *              per connection event, used to find connection events that end early.
+ *
+ * Related Document: See README.md
+ *
+ *
+ *******************************************************************************
+ * Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ ******************************************************************************/
+
+/******************************************************************************
+ *                                INCLUDES
+ ******************************************************************************/
+#include <string.h>
+#include <FreeRTOS.h>
+#include <task.h>
+#include "tput_conn_evt.h"
+
+/*******************************************************************************
+*        Variable Definitions
+*******************************************************************************/
+static uint32_t interval_us = 0;
+static uint16_t packet_budget = 0;
+/* Connection event being counted */
+static bool event_open = false;
+static uint32_t event_start_us = 0;
+static uint32_t event_packets = 0;
+static tput_conn_evt_stats_t stats;
+
+/******************************************************************************
+ * Function Definitions
+ ******************************************************************************/
+
+/*******************************************************************************
+* Function Name: tput_conn_evt_close()
+********************************************************************************
+* Summary:
+*   Adds a finished connection event to the histogram.
+*
+* Parameters:
+*   uint32_t packets : Packets of the event
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+static void tput_conn_evt_close(uint32_t packets)
+{
+    stats.events++;
+    stats.packets += packets;
+    stats.hist[(packets < TPUT_CONN_EVT_HIST_BINS) ?
+               packets : (TPUT_CONN_EVT_HIST_BINS - 1u)]++;
+    if ((0u != packet_budget) && (packets >= packet_budget))
+    {
+        stats.events_at_budget++;
+    }
+}
+
+/*******************************************************************************
+* Function Name: tput_conn_evt_configure()
+********************************************************************************
+* Summary:
+*   Sets the connection interval used to group packets into connection
+*   events, and the number of packets an event can carry (see
+*   tput_model_compute()). A change of the interval restarts the grouping.
+*
+* Parameters:
+*   uint32_t conn_interval_us : Connection interval, 0 if not known
+*   uint16_t budget           : Packets per event, 0 if not known
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void tput_conn_evt_configure(uint32_t conn_interval_us, uint16_t budget)
+{
+    taskENTER_CRITICAL();
+    if (conn_interval_us != interval_us)
+    {
+        interval_us = conn_interval_us;
+        event_open = false;
+    }
+    packet_budget = budget;
+    taskEXIT_CRITICAL();
+}
+
+/*******************************************************************************
+* Function Name: tput_conn_evt_on_packet()
+********************************************************************************
+* Summary:
+*   Counts a notification received or a GATT write completed. The host sees
+*   packets some time after the controller exchanged them, so the event
+*   boundaries are not known exactly. An event is taken to start with the
+*   first packet seen after the previous event, and all packets within 3/4
+*   of a connection interval belong to it. Connection intervals without
+*   packets between two events are counted as empty events, unless the gap
+*   is long enough to be a pause of the traffic.
+*
+* Parameters:
+*   uint32_t timestamp_us : Time the packet was seen, from tput_time_us()
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void tput_conn_evt_on_packet(uint32_t timestamp_us)
+{
+    uint32_t elapsed_us;
+    uint32_t idle_events;
+
+    taskENTER_CRITICAL();
+    if (0u == interval_us)
+    {
+        taskEXIT_CRITICAL();
+        return;
+    }
+
+    elapsed_us = timestamp_us - event_start_us;
+    if (event_open && (elapsed_us < (interval_us * 3u) / 4u))
+    {
+        event_packets++;
+        taskEXIT_CRITICAL();
+        return;
+    }
+
+    if (event_open)
+    {
+        tput_conn_evt_close(event_packets);
+        /* Intervals skipped since the previous event, rounded to the
+         * nearest so that jitter does not add or lose an event */
+        idle_events = (elapsed_us + (interval_us / 2u)) /
+                      interval_us;
+        if (idle_events > 1u)
+        {
+            idle_events--;
+            if (idle_events <= TPUT_CONN_EVT_MAX_IDLE_EVENTS)
+            {
+                stats.events += idle_events;
+                stats.hist[0] += idle_events;
+            }
+        }
+    }
+    event_open = true;
+    event_start_us = timestamp_us;
+    event_packets = 1;
+    taskEXIT_CRITICAL();
+}
+
+/*******************************************************************************
+* Function Name: tput_conn_evt_reset()
+********************************************************************************
+* Summary:
+*   Forgets the connection interval and the open event, on disconnection.
+*
+* Parameters:
+*   None
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void tput_conn_evt_reset(void)
+{
+    taskENTER_CRITICAL();
+    interval_us = 0;
+    packet_budget = 0;
+    event_open = false;
+    memset(&stats, 0, sizeof(stats));
+    taskEXIT_CRITICAL();
+}
+
+/*******************************************************************************
+* Function Name: tput_conn_evt_get_stats()
+********************************************************************************
+* Summary:
+*   Returns the histogram of the events closed since the statistics were
+*   cleared.
+*
+* Parameters:
+*   tput_conn_evt_stats_t *p_stats : Statistics
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void tput_conn_evt_get_stats(tput_conn_evt_stats_t *p_stats)
+{
+    taskENTER_CRITICAL();
+    *p_stats = stats;
+    p_stats->budget = packet_budget;
+    taskEXIT_CRITICAL();
+}
+
+/*******************************************************************************
+* Function Name: tput_conn_evt_clear_stats()
+********************************************************************************
+* Summary:
+*   Clears the histogram. The open event is kept.
+*
+* Parameters:
+*   None
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void tput_conn_evt_clear_stats(void)
+{
+    taskENTER_CRITICAL();
+    memset(&stats, 0, sizeof(stats));
+    taskEXIT_CRITICAL();
+}
+
+/* [] END OF FILE */
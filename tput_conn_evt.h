@@ -0,0 +1,84 @@
+/*******************************************************************************
+ * File Name: tput_conn_evt.h
+ *
+ * Description: This file contains the declarations of the per connection event packet
+ *              histogram.
+ *
+ * Related Document: See README.md
+ *
+ *
+ *******************************************************************************
+ * Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ ******************************************************************************/
+
+#ifndef __TPUT_CONN_EVT_H__
+#define __TPUT_CONN_EVT_H__
+
+/******************************************************************************
+ *                                INCLUDES
+ ******************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+
+/******************************************************************************
+ *                                Macros
+ ******************************************************************************/
+/* Histogram bins for 0 to TPUT_CONN_EVT_HIST_BINS - 1 packets per event,
+ * the last bin also counts larger events */
+#define TPUT_CONN_EVT_HIST_BINS         (16u)
+/* A gap of more connection intervals than this ends a burst of traffic.
+ * Events without packets within a burst are counted in bin 0 */
+#define TPUT_CONN_EVT_MAX_IDLE_EVENTS   (8u)
+
+/*******************************************************************************
+*        Structures and Enumerations
+*******************************************************************************/
+typedef struct
+{
+    uint32_t events;            // connection events counted
+    uint32_t packets;           // packets in those events
+    uint32_t events_at_budget;  // events that carried the packet budget
+    uint16_t budget;            // packet budget per event, 0 if unknown
+    uint32_t hist[TPUT_CONN_EVT_HIST_BINS];
+} tput_conn_evt_stats_t;
+
+/****************************************************************************
+ *                              FUNCTION DECLARATIONS
+ ***************************************************************************/
+void tput_conn_evt_configure(uint32_t conn_interval_us, uint16_t budget);
+void tput_conn_evt_on_packet(uint32_t timestamp_us);
+void tput_conn_evt_reset(void);
+void tput_conn_evt_get_stats(tput_conn_evt_stats_t *p_stats);
+void tput_conn_evt_clear_stats(void);
+
+#endif      /*__TPUT_CONN_EVT_H__ */
+/* [] END OF FILE */
@@ -0,0 +1,1161 @@
+/*******************************************************************************
+ * File Name: tput_console.c
+ *
+ * Description: This file contains a line-oriented command console on the debug UART,
+ *              used to control the throughput client from a script.
+ *
+ * Related Document: See README.md
+ *
+ *
+ *******************************************************************************
+ * Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ ******************************************************************************/
+
+/******************************************************************************
+ *                                INCLUDES
+ ******************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "cyhal.h"
+#include "cy_retarget_io.h"
+#include "ble_client.h"
+#include "tput_result_log.h"
+#include "tput_load.h"
+#include "tput_bench.h"
+#include "tput_evrec.h"
+#include "tput_ubench.h"
+#include "tput_trace.h"
+#include "tput_mem.h"
+#include "tput_reconnect.h"
+#include "tput_phy.h"
+#include "tput_bridge.h"
+#include "tput_security.h"
+#include "tput_adapt.h"
+#include "tput_stream.h"
+#include "tput_console.h"
+
+/*******************************************************************************
+*        Structures and Enumerations
+*******************************************************************************/
+typedef struct
+{
+    const char *name;
+    const char *usage;
+    /* Returns false if the arguments are invalid or the command failed */
+    bool (*handler)(uint32_t argc, char *argv[]);
+} tput_console_cmd_t;
+
+/*******************************************************************************
+*        Function Prototypes
+*******************************************************************************/
+static bool tput_console_help        (uint32_t argc, char *argv[]);
+static bool tput_console_scan        (uint32_t argc, char *argv[]);
+static bool tput_console_connect     (uint32_t argc, char *argv[]);
+static bool tput_console_disconnect  (uint32_t argc, char *argv[]);
+static bool tput_console_mode        (uint32_t argc, char *argv[]);
+static bool tput_console_size        (uint32_t argc, char *argv[]);
+static bool tput_console_phy         (uint32_t argc, char *argv[]);
+static bool tput_console_interval    (uint32_t argc, char *argv[]);
+static bool tput_console_coalesce    (uint32_t argc, char *argv[]);
+static bool tput_console_clear       (uint32_t argc, char *argv[]);
+static bool tput_console_status      (uint32_t argc, char *argv[]);
+static bool tput_console_log         (uint32_t argc, char *argv[]);
+static bool tput_console_load        (uint32_t argc, char *argv[]);
+static bool tput_console_sweep       (uint32_t argc, char *argv[]);
+static bool tput_console_mem         (uint32_t argc, char *argv[]);
+static bool tput_console_relay       (uint32_t argc, char *argv[]);
+static bool tput_console_bench       (uint32_t argc, char *argv[]);
+static bool tput_console_reconnect   (uint32_t argc, char *argv[]);
+static bool tput_console_secure      (uint32_t argc, char *argv[]);
+static bool tput_console_adapt       (uint32_t argc, char *argv[]);
+#if TPUT_TRACE_ENABLE
+static bool tput_console_trace       (uint32_t argc, char *argv[]);
+#endif
+#if TPUT_EATT_ENABLE
+static bool tput_console_eatt        (uint32_t argc, char *argv[]);
+#endif
+#if TPUT_BRIDGE_ENABLE
+static bool tput_console_bridge      (uint32_t argc, char *argv[]);
+#endif
+#if TPUT_EVREC_ENABLE
+static bool tput_console_evrec       (uint32_t argc, char *argv[]);
+#endif
+#if TPUT_STREAM_ENABLE
+static bool tput_console_stream      (uint32_t argc, char *argv[]);
+#endif
+#if TPUT_UBENCH_BUILD
+static bool tput_console_ubench      (uint32_t argc, char *argv[]);
+#endif
+
+/*******************************************************************************
+*        Variable Definitions
+*******************************************************************************/
+static const tput_console_cmd_t console_cmds[] =
+{
+    {"help",       "",                              tput_console_help},
+#if TPUT_EXT_SCAN_ENABLE
+    {"scan",       "on [coded]|off",                tput_console_scan},
+#else
+    {"scan",       "on|off",                        tput_console_scan},
+#endif
+    {"connect",    "<xx:xx:xx:xx:xx:xx> [random]",  tput_console_connect},
+    {"disconnect", "",                              tput_console_disconnect},
+    {"mode",       "<1-5>",                         tput_console_mode},
+    {"size",       "<bytes>",                       tput_console_size},
+    {"phy",        "[1m|2m|coded|s2|s8]",           tput_console_phy},
+    {"interval",   "<min> [max] (1.25 ms units)",   tput_console_interval},
+    {"coalesce",   "<deadline ms>",                 tput_console_coalesce},
+    {"clear",      "",                              tput_console_clear},
+    {"status",     "",                              tput_console_status},
+    {"log",        "dump|erase",                    tput_console_log},
+    {"load",       "<cycles> [inline|deferred]",    tput_console_load},
+    {"sweep",      "<max cycles> <step> [seconds]", tput_console_sweep},
+    {"mem",        "",                              tput_console_mem},
+    {"relay",      "on [conn id]|off",              tput_console_relay},
+    {"bench",      "<1-5> [trials] [seconds]",      tput_console_bench},
+    {"reconnect",  "[on|off]",                      tput_console_reconnect},
+    {"secure",     "[on|off|forget]",               tput_console_secure},
+    {"adapt",      "[on|off]",                      tput_console_adapt},
+#if TPUT_TRACE_ENABLE
+    {"trace",      "start|stop|dump",               tput_console_trace},
+#endif
+#if TPUT_EATT_ENABLE
+    {"eatt",       "open|start|stop",               tput_console_eatt},
+#endif
+#if TPUT_BRIDGE_ENABLE
+    {"bridge",     "on|off",                        tput_console_bridge},
+#endif
+#if TPUT_EVREC_ENABLE
+    {"evrec",      "start|stop|dump|clear|replay|load <hex>", tput_console_evrec},
+#endif
+#if TPUT_STREAM_ENABLE
+    {"stream",     "[weight <latency> <bulk>|send control|latency <len>|"
+                   "periodic <ms> <len>]",          tput_console_stream},
+#endif
+#if TPUT_UBENCH_BUILD
+    {"ubench",     "[calls]",                       tput_console_ubench},
+#endif
+};
+
+/******************************************************************************
+ * Function Definitions
+ ******************************************************************************/
+
+/*******************************************************************************
+* Function Name: tput_console_parse_u16()
+********************************************************************************
+* Summary:
+*   Converts a decimal argument to a number.
+*
+* Parameters:
+*   const char *p_arg : Argument
+*   uint16_t *p_value : Converted value
+*
+* Return:
+*   bool : true if the argument is a number that fits in 16 bits
+*
+*******************************************************************************/
+static bool tput_console_parse_u16(const char *p_arg, uint16_t *p_value)
+{
+    char *p_end;
+    unsigned long value = strtoul(p_arg, &p_end, 10);
+
+    if (('\0' == *p_arg) || ('\0' != *p_end) || (value > UINT16_MAX))
+    {
+        return false;
+    }
+    *p_value = (uint16_t)value;
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: tput_console_parse_u32()
+********************************************************************************
+* Summary:
+*   Converts a decimal argument to a number.
+*
+* Parameters:
+*   const char *p_arg : Argument
+*   uint32_t *p_value : Converted value
+*
+* Return:
+*   bool : true if the argument is a number that fits in 32 bits
+*
+*******************************************************************************/
+static bool tput_console_parse_u32(const char *p_arg, uint32_t *p_value)
+{
+    char *p_end;
+    unsigned long long value = strtoull(p_arg, &p_end, 10);
+
+    if (('\0' == *p_arg) || ('\0' != *p_end) || (value > UINT32_MAX))
+    {
+        return false;
+    }
+    *p_value = (uint32_t)value;
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: tput_console_help()
+********************************************************************************
+* Summary:
+*   Lists the commands.
+*
+*******************************************************************************/
+static bool tput_console_help(uint32_t argc, char *argv[])
+{
+    for (uint32_t i = 0; i < sizeof(console_cmds) / sizeof(console_cmds[0]); i++)
+    {
+        printf("  %-10s %s\n", console_cmds[i].name, console_cmds[i].usage);
+    }
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: tput_console_scan()
+********************************************************************************
+* Summary:
+*   Starts or stops scanning for the server, on the LE Coded PHY only if
+*   requested.
+*
+*******************************************************************************/
+static bool tput_console_scan(uint32_t argc, char *argv[])
+{
+    wiced_result_t result;
+
+#if TPUT_EXT_SCAN_ENABLE
+    if ((3 == argc) && (0 == strcmp(argv[1], "on")) &&
+        (0 == strcmp(argv[2], "coded")))
+    {
+        tput_set_scan_phys(true);
+        result = tput_scan_start();
+        return ((WICED_BT_PENDING == result) || (WICED_BT_BUSY == result));
+    }
+#endif
+    if (2 != argc)
+    {
+        return false;
+    }
+    if (0 == strcmp(argv[1], "on"))
+    {
+#if TPUT_EXT_SCAN_ENABLE
+        tput_set_scan_phys(false);
+#endif
+        result = tput_scan_start();
+        return ((WICED_BT_PENDING == result) || (WICED_BT_BUSY == result));
+    }
+    if (0 == strcmp(argv[1], "off"))
+    {
+        result = tput_scan_stop();
+        return ((WICED_BT_SUCCESS == result) || (WICED_BT_PENDING == result));
+    }
+    return false;
+}
+
+/*******************************************************************************
+* Function Name: tput_console_connect()
+********************************************************************************
+* Summary:
+*   Connects to a server by address. The address is given in the order
+*   printed by print_bd_address().
+*
+*******************************************************************************/
+static bool tput_console_connect(uint32_t argc, char *argv[])
+{
+    wiced_bt_device_address_t bd_addr;
+    wiced_bt_ble_address_type_t addr_type = BLE_ADDR_PUBLIC;
+    const char *p_arg;
+    char *p_end;
+
+    if ((2 != argc) && (3 != argc))
+    {
+        return false;
+    }
+    if (3 == argc)
+    {
+        if (0 != strcmp(argv[2], "random"))
+        {
+            return false;
+        }
+        addr_type = BLE_ADDR_RANDOM;
+    }
+
+    p_arg = argv[1];
+    for (uint32_t i = 0; i < BD_ADDR_LEN; i++)
+    {
+        unsigned long byte = strtoul(p_arg, &p_end, 16);
+
+        if ((p_end == p_arg) || (byte > UINT8_MAX) ||
+            (*p_end != ((BD_ADDR_LEN - 1u == i) ? '\0' : ':')))
+        {
+            return false;
+        }
+        bd_addr[i] = (uint8_t)byte;
+        p_arg = p_end + 1;
+    }
+    return tput_connect(bd_addr, addr_type);
+}
+
+/*******************************************************************************
+* Function Name: tput_console_disconnect()
+********************************************************************************
+* Summary:
+*   Disconnects from the server.
+*
+*******************************************************************************/
+static bool tput_console_disconnect(uint32_t argc, char *argv[])
+{
+    return (WICED_BT_GATT_SUCCESS == tput_disconnect());
+}
+
+/*******************************************************************************
+* Function Name: tput_console_mode()
+********************************************************************************
+* Summary:
+*   Selects the data transfer mode, numbered as in the README.
+*
+*******************************************************************************/
+static bool tput_console_mode(uint32_t argc, char *argv[])
+{
+    uint16_t mode;
+
+    if ((2 != argc) || !tput_console_parse_u16(argv[1], &mode) ||
+        (mode < 1u) || (mode > TPUT_MODE_LAST + 1u))
+    {
+        return false;
+    }
+    return (WICED_BT_GATT_SUCCESS == tput_set_mode((tput_mode_t)(mode - 1u)));
+}
+
+/*******************************************************************************
+* Function Name: tput_console_size()
+********************************************************************************
+* Summary:
+*   Sets the GATT write packet size.
+*
+*******************************************************************************/
+static bool tput_console_size(uint32_t argc, char *argv[])
+{
+    uint16_t size;
+
+    if ((2 != argc) || !tput_console_parse_u16(argv[1], &size))
+    {
+        return false;
+    }
+    return tput_set_packet_size(size);
+}
+
+/*******************************************************************************
+* Function Name: tput_console_phy()
+********************************************************************************
+* Summary:
+*   Requests a PHY for both directions, with the coding of the Coded PHY,
+*   or prints the throughput measured on each PHY.
+*
+*******************************************************************************/
+static bool tput_console_phy(uint32_t argc, char *argv[])
+{
+    wiced_bt_ble_host_phy_preferences_t phys;
+    wiced_bt_ble_lecoded_phy_preferences_t phy_opts = BTM_BLE_PREFER_NO_LELR;
+
+    if (1 == argc)
+    {
+        tput_phy_print();
+        return true;
+    }
+    if (2 != argc)
+    {
+        return false;
+    }
+    if (0 == strcmp(argv[1], "1m"))
+    {
+        phys = BTM_BLE_PREFER_1M_PHY;
+    }
+    else if (0 == strcmp(argv[1], "2m"))
+    {
+        phys = BTM_BLE_PREFER_2M_PHY;
+    }
+    else if (0 == strcmp(argv[1], "coded"))
+    {
+        phys = BTM_BLE_PREFER_LELR_PHY;
+    }
+    else if (0 == strcmp(argv[1], "s2"))
+    {
+        phys = BTM_BLE_PREFER_LELR_PHY;
+        phy_opts = BTM_BLE_PREFER_LELR_512K;
+    }
+    else if (0 == strcmp(argv[1], "s8"))
+    {
+        phys = BTM_BLE_PREFER_LELR_PHY;
+        phy_opts = BTM_BLE_PREFER_LELR_125K;
+    }
+    else
+    {
+        return false;
+    }
+    return (WICED_BT_SUCCESS == tput_set_phy(phys, phy_opts));
+}
+
+/*******************************************************************************
+* Function Name: tput_console_interval()
+********************************************************************************
+* Summary:
+*   Requests a connection interval. If no maximum is given, the minimum is
+*   requested as a fixed interval.
+*
+*******************************************************************************/
+static bool tput_console_interval(uint32_t argc, char *argv[])
+{
+    uint16_t min_interval;
+    uint16_t max_interval;
+
+    if (((2 != argc) && (3 != argc)) ||
+        !tput_console_parse_u16(argv[1], &min_interval))
+    {
+        return false;
+    }
+    max_interval = min_interval;
+    if ((3 == argc) && !tput_console_parse_u16(argv[2], &max_interval))
+    {
+        return false;
+    }
+    return tput_set_conn_interval(min_interval, max_interval);
+}
+
+/*******************************************************************************
+* Function Name: tput_console_coalesce()
+********************************************************************************
+* Summary:
+*   Sets the deadline of the record packing of mode 5, used the next time
+*   the mode is selected.
+*
+*******************************************************************************/
+static bool tput_console_coalesce(uint32_t argc, char *argv[])
+{
+    uint16_t deadline_ms;
+
+    if ((2 != argc) || !tput_console_parse_u16(argv[1], &deadline_ms))
+    {
+        return false;
+    }
+    tput_set_coalesce_deadline(deadline_ms);
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: tput_console_clear()
+********************************************************************************
+* Summary:
+*   Clears the throughput statistics.
+*
+*******************************************************************************/
+static bool tput_console_clear(uint32_t argc, char *argv[])
+{
+    tput_clear_stats();
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: tput_console_status()
+********************************************************************************
+* Summary:
+*   Prints the connection state and link parameters.
+*
+*******************************************************************************/
+static bool tput_console_status(uint32_t argc, char *argv[])
+{
+    tput_print_status();
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: tput_console_log()
+********************************************************************************
+* Summary:
+*   Prints or erases the persistent result log.
+*
+*******************************************************************************/
+static bool tput_console_log(uint32_t argc, char *argv[])
+{
+    if (2 != argc)
+    {
+        return false;
+    }
+    if (0 == strcmp(argv[1], "dump"))
+    {
+        tput_result_log_dump();
+        return true;
+    }
+    if (0 == strcmp(argv[1], "erase"))
+    {
+        tput_result_log_erase();
+        return true;
+    }
+    return false;
+}
+
+/*******************************************************************************
+* Function Name: tput_console_load()
+********************************************************************************
+* Summary:
+*   Sets the synthetic processing load applied to every notification, run
+*   inline in the GATT callback (default) or deferred to rx_sink_task.
+*   0 cycles switches the load off.
+*
+*******************************************************************************/
+static bool tput_console_load(uint32_t argc, char *argv[])
+{
+    tput_load_place_t place = TPUT_LOAD_INLINE;
+    uint32_t cycles;
+
+    if ((argc < 2) || (argc > 3) || !tput_console_parse_u32(argv[1], &cycles))
+    {
+        return false;
+    }
+    if (3 == argc)
+    {
+        if (0 == strcmp(argv[2], "deferred"))
+        {
+            if (!TPUT_RX_SINK_ENABLE)
+            {
+                return false;
+            }
+            place = TPUT_LOAD_DEFERRED;
+        }
+        else if (0 != strcmp(argv[2], "inline"))
+        {
+            return false;
+        }
+    }
+    tput_load_set(place, cycles);
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: tput_console_sweep()
+********************************************************************************
+* Summary:
+*   Sweeps the synthetic load and prints the receive throughput of each
+*   step. Blocks the console until the sweep is done.
+*
+*******************************************************************************/
+static bool tput_console_sweep(uint32_t argc, char *argv[])
+{
+    uint32_t max_cycles;
+    uint32_t step_cycles;
+    uint32_t measure_s = TPUT_LOAD_DEFAULT_MEASURE_S;
+
+    if ((argc < 3) || (argc > 4) ||
+        !tput_console_parse_u32(argv[1], &max_cycles) ||
+        !tput_console_parse_u32(argv[2], &step_cycles) ||
+        ((4 == argc) && !tput_console_parse_u32(argv[3], &measure_s)))
+    {
+        return false;
+    }
+    return tput_load_sweep(max_cycles, step_cycles, measure_s);
+}
+
+/*******************************************************************************
+* Function Name: tput_console_relay()
+********************************************************************************
+* Summary:
+*   Starts relaying the notifications as GATT writes, on the same or on
+*   another connection, or stops it.
+*
+*******************************************************************************/
+static bool tput_console_relay(uint32_t argc, char *argv[])
+{
+    uint16_t conn_id = 0;
+
+    if ((2 == argc) && (0 == strcmp(argv[1], "off")))
+    {
+        return tput_set_relay(false, 0);
+    }
+    if ((argc < 2) || (argc > 3) || (0 != strcmp(argv[1], "on")) ||
+        ((3 == argc) && !tput_console_parse_u16(argv[2], &conn_id)))
+    {
+        return false;
+    }
+    return tput_set_relay(true, conn_id);
+}
+
+/*******************************************************************************
+* Function Name: tput_console_bench()
+********************************************************************************
+* Summary:
+*   Measures the throughput of a mode over repeated trials.
+*
+*******************************************************************************/
+static bool tput_console_bench(uint32_t argc, char *argv[])
+{
+    uint16_t mode;
+    uint32_t trials = TPUT_BENCH_DEFAULT_TRIALS;
+    uint32_t measure_s = TPUT_BENCH_DEFAULT_MEASURE_S;
+
+    if ((argc < 2) || (argc > 4) ||
+        !tput_console_parse_u16(argv[1], &mode) ||
+        (mode < 1u) || (mode > TPUT_MODE_LAST + 1u) ||
+        ((argc >= 3) && !tput_console_parse_u32(argv[2], &trials)) ||
+        ((4 == argc) && !tput_console_parse_u32(argv[3], &measure_s)))
+    {
+        return false;
+    }
+    return tput_bench_run((tput_mode_t)(mode - 1u), trials, measure_s);
+}
+
+/*******************************************************************************
+* Function Name: tput_console_reconnect()
+********************************************************************************
+* Summary:
+*   Enables or disables reconnecting after a link loss, or prints the
+*   recovery statistics.
+*
+*******************************************************************************/
+static bool tput_console_reconnect(uint32_t argc, char *argv[])
+{
+    tput_reconnect_stats_t stats;
+
+    if (1 == argc)
+    {
+        tput_reconnect_get_stats(&stats);
+        printf("Reconnect %s: %lu outages, %lu recovered, %lu given up, "
+               "%lu attempts\n", tput_reconnect_is_enabled() ? "on" : "off",
+               (unsigned long)stats.outages, (unsigned long)stats.recovered,
+               (unsigned long)stats.given_up, (unsigned long)stats.attempts);
+        printf("Recovery %lu ms (max %lu ms), lost %lu bytes (total %lu), "
+               "not transferred %lu bytes (total %lu)\n",
+               (unsigned long)stats.last_recovery_ms,
+               (unsigned long)stats.max_recovery_ms,
+               (unsigned long)stats.last_lost_bytes,
+               (unsigned long)stats.lost_bytes,
+               (unsigned long)stats.last_missed_bytes,
+               (unsigned long)stats.missed_bytes);
+        return true;
+    }
+    if ((2 == argc) && (0 == strcmp(argv[1], "on")))
+    {
+        tput_reconnect_enable(true);
+        return true;
+    }
+    if ((2 == argc) && (0 == strcmp(argv[1], "off")))
+    {
+        tput_reconnect_enable(false);
+        return true;
+    }
+    return false;
+}
+
+/*******************************************************************************
+* Function Name: tput_console_secure()
+********************************************************************************
+* Summary:
+*   Enables or disables the encrypted link mode, drops the cached bonds, or
+*   prints the plaintext and encrypted link statistics.
+*
+*******************************************************************************/
+static bool tput_console_secure(uint32_t argc, char *argv[])
+{
+    if (1 == argc)
+    {
+        tput_security_print();
+        return true;
+    }
+    if (2 != argc)
+    {
+        return false;
+    }
+    if (0 == strcmp(argv[1], "on"))
+    {
+        tput_security_enable(true);
+        return true;
+    }
+    if (0 == strcmp(argv[1], "off"))
+    {
+        tput_security_enable(false);
+        return true;
+    }
+    if (0 == strcmp(argv[1], "forget"))
+    {
+        tput_security_forget();
+        return true;
+    }
+    return false;
+}
+
+/*******************************************************************************
+* Function Name: tput_console_adapt()
+********************************************************************************
+* Summary:
+*   Enables or disables the adaptive PHY and packet size controller, or
+*   prints its last decisions.
+*
+*******************************************************************************/
+static bool tput_console_adapt(uint32_t argc, char *argv[])
+{
+    if (1 == argc)
+    {
+        tput_adapt_print();
+        return true;
+    }
+    if ((2 == argc) && (0 == strcmp(argv[1], "on")))
+    {
+        tput_adapt_enable(true);
+        return true;
+    }
+    if ((2 == argc) && (0 == strcmp(argv[1], "off")))
+    {
+        tput_adapt_enable(false);
+        return true;
+    }
+    return false;
+}
+
+/*******************************************************************************
+* Function Name: tput_console_mem()
+********************************************************************************
+* Summary:
+*   Prints the RAM usage report.
+*
+*******************************************************************************/
+static bool tput_console_mem(uint32_t argc, char *argv[])
+{
+    tput_mem_report();
+    return true;
+}
+
+#if TPUT_TRACE_ENABLE
+/*******************************************************************************
+* Function Name: tput_console_trace()
+********************************************************************************
+* Summary:
+*   Starts or stops the event trace, or prints the recorded events.
+*
+*******************************************************************************/
+static bool tput_console_trace(uint32_t argc, char *argv[])
+{
+    if (2 != argc)
+    {
+        return false;
+    }
+    if (0 == strcmp(argv[1], "start"))
+    {
+        tput_trace_start();
+        return true;
+    }
+    if (0 == strcmp(argv[1], "stop"))
+    {
+        tput_trace_stop();
+        return true;
+    }
+    if (0 == strcmp(argv[1], "dump"))
+    {
+        tput_trace_dump();
+        return true;
+    }
+    return false;
+}
+#endif
+
+#if TPUT_EATT_ENABLE
+/*******************************************************************************
+* Function Name: tput_console_eatt()
+********************************************************************************
+* Summary:
+*   Opens the EATT bearers, or starts or stops the write requests on them.
+*
+*******************************************************************************/
+static bool tput_console_eatt(uint32_t argc, char *argv[])
+{
+    if (2 != argc)
+    {
+        return false;
+    }
+    if (0 == strcmp(argv[1], "open"))
+    {
+        return WICED_BT_GATT_SUCCESS == tput_open_eatt_bearers();
+    }
+    if (0 == strcmp(argv[1], "start"))
+    {
+        return tput_set_eatt_writes(true);
+    }
+    if (0 == strcmp(argv[1], "stop"))
+    {
+        return tput_set_eatt_writes(false);
+    }
+    return false;
+}
+#endif
+
+#if TPUT_STREAM_ENABLE
+/*******************************************************************************
+* Function Name: tput_console_stream()
+********************************************************************************
+* Summary:
+*   Sets the weights of the latency and bulk streams, queues a message on
+*   the control or latency stream, or generates latency messages
+*   periodically. Without an argument, prints the streams.
+*
+*******************************************************************************/
+static bool tput_console_stream(uint32_t argc, char *argv[])
+{
+    uint16_t latency_weight;
+    uint16_t bulk_weight;
+    uint32_t period_ms;
+    uint16_t len;
+
+    if (1 == argc)
+    {
+        tput_stream_print();
+        return true;
+    }
+    if (4 != argc)
+    {
+        return false;
+    }
+    if (0 == strcmp(argv[1], "weight"))
+    {
+        if ((!tput_console_parse_u16(argv[2], &latency_weight)) ||
+            (!tput_console_parse_u16(argv[3], &bulk_weight)) ||
+            (latency_weight > UINT8_MAX) || (bulk_weight > UINT8_MAX))
+        {
+            return false;
+        }
+        tput_stream_set_weight(TPUT_STREAM_LATENCY, (uint8_t)latency_weight);
+        tput_stream_set_weight(TPUT_STREAM_BULK, (uint8_t)bulk_weight);
+        return true;
+    }
+    if (0 == strcmp(argv[1], "send"))
+    {
+        if (!tput_console_parse_u16(argv[3], &len))
+        {
+            return false;
+        }
+        if (0 == strcmp(argv[2], "control"))
+        {
+            return tput_stream_send(TPUT_STREAM_CONTROL, len);
+        }
+        if (0 == strcmp(argv[2], "latency"))
+        {
+            return tput_stream_send(TPUT_STREAM_LATENCY, len);
+        }
+        return false;
+    }
+    if (0 == strcmp(argv[1], "periodic"))
+    {
+        if ((!tput_console_parse_u32(argv[2], &period_ms)) ||
+            (!tput_console_parse_u16(argv[3], &len)) ||
+            (period_ms && ((len < TPUT_STREAM_MIN_MSG_LEN) ||
+                           (len > TPUT_STREAM_MAX_MSG_LEN))))
+        {
+            return false;
+        }
+        tput_stream_periodic(period_ms, len);
+        return true;
+    }
+    return false;
+}
+#endif
+
+#if TPUT_BRIDGE_ENABLE
+/*******************************************************************************
+* Function Name: tput_console_bridge()
+********************************************************************************
+* Summary:
+*   Starts or stops streaming the received payloads to the bridge UART.
+*
+*******************************************************************************/
+static bool tput_console_bridge(uint32_t argc, char *argv[])
+{
+    if ((2 == argc) && (0 == strcmp(argv[1], "on")))
+    {
+        return tput_set_bridge(true);
+    }
+    if ((2 == argc) && (0 == strcmp(argv[1], "off")))
+    {
+        return tput_set_bridge(false);
+    }
+    return false;
+}
+#endif
+
+#if TPUT_EVREC_ENABLE
+/*******************************************************************************
+* Function Name: tput_console_evrec()
+********************************************************************************
+* Summary:
+*   Records the GATT and management events, prints or loads the recording,
+*   or replays it.
+*
+*******************************************************************************/
+static bool tput_console_evrec(uint32_t argc, char *argv[])
+{
+    if ((3 == argc) && (0 == strcmp(argv[1], "load")))
+    {
+        return tput_evrec_load(argv[2]);
+    }
+    if (2 != argc)
+    {
+        return false;
+    }
+    if (0 == strcmp(argv[1], "start"))
+    {
+        return tput_record_events(true);
+    }
+    if (0 == strcmp(argv[1], "stop"))
+    {
+        return tput_record_events(false);
+    }
+    if (0 == strcmp(argv[1], "dump"))
+    {
+        tput_evrec_dump();
+        return true;
+    }
+    if (0 == strcmp(argv[1], "clear"))
+    {
+        tput_evrec_clear();
+        return true;
+    }
+    if (0 == strcmp(argv[1], "replay"))
+    {
+        return tput_replay_events();
+    }
+    return false;
+}
+#endif
+
+#if TPUT_UBENCH_BUILD
+/*******************************************************************************
+* Function Name: tput_console_ubench()
+********************************************************************************
+* Summary:
+*   Runs the microbenchmarks of the client hot paths.
+*
+*******************************************************************************/
+static bool tput_console_ubench(uint32_t argc, char *argv[])
+{
+    uint32_t calls = TPUT_UBENCH_DEFAULT_CALLS;
+
+    if ((argc > 2) ||
+        ((2 == argc) && !tput_console_parse_u32(argv[1], &calls)))
+    {
+        return false;
+    }
+    return tput_run_ubench(calls);
+}
+#endif
+
+/*******************************************************************************
+* Function Name: tput_console_is_quiet()
+********************************************************************************
+* Summary:
+*   Tells whether the console must not print, because the UART bridge
+*   streams payloads on the debug UART.
+*
+* Parameters:
+*   None
+*
+* Return:
+*   bool : true while the console is quiet
+*
+*******************************************************************************/
+static bool tput_console_is_quiet(void)
+{
+#if TPUT_BRIDGE_ENABLE
+    return tput_bridge_is_on_debug_uart();
+#else
+    return false;
+#endif
+}
+
+/*******************************************************************************
+* Function Name: tput_console_execute()
+********************************************************************************
+* Summary:
+*   Splits a command line into arguments and runs the command. Every command
+*   is answered with "OK" or "ERROR" so that a script can wait for it. While
+*   the console is quiet, only the bridge command runs and nothing is
+*   printed.
+*
+* Parameters:
+*   char *p_line : Command line, modified in place
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+static void tput_console_execute(char *p_line)
+{
+    bool quiet = tput_console_is_quiet();
+    char *argv[TPUT_CONSOLE_MAX_ARGS];
+    uint32_t argc = 0;
+    char *p_char = p_line;
+
+    while (true)
+    {
+        while (' ' == *p_char)
+        {
+            *p_char++ = '\0';
+        }
+        if (('\0' == *p_char) || (argc == TPUT_CONSOLE_MAX_ARGS))
+        {
+            break;
+        }
+        argv[argc++] = p_char;
+        while (('\0' != *p_char) && (' ' != *p_char))
+        {
+            p_char++;
+        }
+    }
+    if (0 == argc)
+    {
+        return;
+    }
+
+    for (uint32_t i = 0; i < sizeof(console_cmds) / sizeof(console_cmds[0]); i++)
+    {
+        if (0 == strcmp(argv[0], console_cmds[i].name))
+        {
+            bool ok;
+
+#if TPUT_BRIDGE_ENABLE
+            /* Only the bridge command runs while the bridge holds the UART */
+            if (quiet && (tput_console_bridge != console_cmds[i].handler))
+            {
+                return;
+            }
+#endif
+            /* Characters left over mean too many arguments */
+            ok = ('\0' == *p_char) && console_cmds[i].handler(argc, argv);
+            if (tput_console_is_quiet())
+            {
+                return;
+            }
+            if (ok)
+            {
+                printf("OK\n");
+            }
+            else
+            {
+                printf("ERROR usage: %s %s\n", console_cmds[i].name,
+                       console_cmds[i].usage);
+            }
+            return;
+        }
+    }
+    if (!quiet)
+    {
+        printf("ERROR unknown command, type help\n");
+    }
+}
+
+/*******************************************************************************
+* Function Name: console_task()
+********************************************************************************
+* Summary:
+*   Reads command lines from the debug UART and runs them. The UART is polled,
+*   so the task only runs when characters have arrived and never waits on the
+*   UART. It is meant to run at a lower priority than the data path tasks.
+*
+* Parameters:
+*   void *pvParam : The argument parameter is not used.
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void console_task(void *pvParam)
+{
+    char line[TPUT_CONSOLE_LINE_LEN + 1u];
+    uint32_t line_len = 0;
+    bool overflow = false;
+    uint8_t rx_char;
+
+    while (true)
+    {
+        vTaskDelay(pdMS_TO_TICKS(TPUT_CONSOLE_POLL_MS));
+
+        while (cyhal_uart_readable(&cy_retarget_io_uart_obj) &&
+               (CY_RSLT_SUCCESS ==
+                        cyhal_uart_getc(&cy_retarget_io_uart_obj, &rx_char, 0)))
+        {
+            if (('\r' == rx_char) || ('\n' == rx_char))
+            {
+                line[line_len] = '\0';
+                if (overflow)
+                {
+                    if (!tput_console_is_quiet())
+                    {
+                        printf("ERROR line too long\n");
+                    }
+                }
+                else if (0 != line_len)
+                {
+                    if (!tput_console_is_quiet())
+                    {
+                        printf("\n");
+                    }
+                    tput_console_execute(line);
+                }
+                line_len = 0;
+                overflow = false;
+            }
+            else if (('\b' == rx_char) || (0x7Fu == rx_char))
+            {
+                if (line_len)
+                {
+                    line_len--;
+                    if (!tput_console_is_quiet())
+                    {
+                        printf("\b \b");
+                        fflush(stdout);
+                    }
+                }
+            }
+            else if (line_len < TPUT_CONSOLE_LINE_LEN)
+            {
+                line[line_len++] = (char)rx_char;
+                if (!tput_console_is_quiet())
+                {
+                    putchar(rx_char);
+                    fflush(stdout);
+                }
+            }
+            else
+            {
+                overflow = true;
+            }
+        }
+    }
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,291 @@
+/*******************************************************************************
+ * File Name: tput_cwnd.c
+ *
+ * Description: This file implements an additive-increase/multiplicative-
+ *              decrease (AIMD) window that limits the number of GATT write
+ *              commands handed to the stack and not yet completed.
+ *
+ * Related Document: See README.md
+ *
+ *
+ *******************************************************************************
+ * Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ ******************************************************************************/
+
+/******************************************************************************
+ *                                INCLUDES
+ ******************************************************************************/
+#include <FreeRTOS.h>
+#include <task.h>
+#include "tput_cwnd.h"
+
+/*******************************************************************************
+*         Macros
+*******************************************************************************/
+/* The window is kept in Q8 fixed point so that the additive increase of
+ * 1/cwnd packet per completed write can be accumulated without floats */
+#define CWND_FRAC_BITS                  (8u)
+#define CWND_ONE                        (1u << CWND_FRAC_BITS)
+
+/*******************************************************************************
+*        Variable Definitions
+*******************************************************************************/
+/* Current window in Q8 packets */
+static uint32_t cwnd_q8 = TPUT_CWND_INITIAL_PKTS * CWND_ONE;
+/* Writes handed to the stack (updated by the write task only) and writes
+ * completed (updated by the GATT callback only). The difference is the number
+ * of packets in flight, so neither counter needs a lock. */
+static volatile uint32_t sent_count = 0;
+static volatile uint32_t completed_count = 0;
+/* Congestion bookkeeping */
+static volatile bool congested = false;
+static TickType_t congestion_start_tick = 0;
+static uint32_t congestion_episodes = 0;
+static uint32_t congested_time_ms = 0;
+
+/******************************************************************************
+ * Function Definitions
+ ******************************************************************************/
+
+/*******************************************************************************
+* Function Name: tput_cwnd_reset()
+********************************************************************************
+* Summary:
+*   Restores the initial window and clears the in-flight count and congestion
+*   statistics. Called when a connection goes down.
+*
+* Parameters:
+*   None
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void tput_cwnd_reset(void)
+{
+    taskENTER_CRITICAL();
+    cwnd_q8 = TPUT_CWND_INITIAL_PKTS * CWND_ONE;
+    sent_count = 0;
+    completed_count = 0;
+    congested = false;
+    congestion_episodes = 0;
+    congested_time_ms = 0;
+    taskEXIT_CRITICAL();
+}
+
+/*******************************************************************************
+* Function Name: tput_cwnd_can_send()
+********************************************************************************
+* Summary:
+*   Checks whether one more GATT write command fits in the current window.
+*
+* Parameters:
+*   None
+*
+* Return:
+*   bool : true if a write can be sent now
+*
+*******************************************************************************/
+bool tput_cwnd_can_send(void)
+{
+    uint32_t in_flight = sent_count - completed_count;
+
+    return ((!congested) && (in_flight < (cwnd_q8 >> CWND_FRAC_BITS)));
+}
+
+/*******************************************************************************
+* Function Name: tput_cwnd_on_sent()
+********************************************************************************
+* Summary:
+*   Accounts for a GATT write command about to be passed to the stack. The
+*   write is counted before the call, as its completion may be reported
+*   before the call returns. If the stack does not accept the write,
+*   tput_cwnd_cancel_sent() must be called.
+*
+* Parameters:
+*   None
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void tput_cwnd_on_sent(void)
+{
+    sent_count++;
+}
+
+/*******************************************************************************
+* Function Name: tput_cwnd_cancel_sent()
+********************************************************************************
+* Summary:
+*   Takes back the write counted last, when the stack did not accept it.
+*
+* Parameters:
+*   None
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void tput_cwnd_cancel_sent(void)
+{
+    taskENTER_CRITICAL();
+    /* Nothing to take back if the window was reset meanwhile */
+    if (sent_count != completed_count)
+    {
+        sent_count--;
+    }
+    taskEXIT_CRITICAL();
+}
+
+/*******************************************************************************
+* Function Name: tput_cwnd_on_complete()
+********************************************************************************
+* Summary:
+*   Accounts for a completed GATT write command and grows the window by
+*   1/cwnd packet, i.e. by one packet per window of successful writes.
+*
+* Parameters:
+*   None
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void tput_cwnd_on_complete(void)
+{
+    /* Ignore completions of writes sent before the last reset */
+    if (completed_count == sent_count)
+    {
+        return;
+    }
+    completed_count++;
+
+    if (!congested)
+    {
+        taskENTER_CRITICAL();
+        cwnd_q8 += (CWND_ONE * CWND_ONE) / cwnd_q8;
+        if (cwnd_q8 > (TPUT_CWND_MAX_PKTS * CWND_ONE))
+        {
+            cwnd_q8 = TPUT_CWND_MAX_PKTS * CWND_ONE;
+        }
+        taskEXIT_CRITICAL();
+    }
+}
+
+/*******************************************************************************
+* Function Name: tput_cwnd_on_congested()
+********************************************************************************
+* Summary:
+*   Halves the window when the stack rejects a write with
+*   WICED_BT_GATT_CONGESTED and starts a new congestion episode.
+*
+* Parameters:
+*   None
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void tput_cwnd_on_congested(void)
+{
+    taskENTER_CRITICAL();
+    cwnd_q8 >>= 1;
+    if (cwnd_q8 < (TPUT_CWND_MIN_PKTS * CWND_ONE))
+    {
+        cwnd_q8 = TPUT_CWND_MIN_PKTS * CWND_ONE;
+    }
+    if (!congested)
+    {
+        congested = true;
+        congestion_start_tick = xTaskGetTickCount();
+        congestion_episodes++;
+    }
+    taskEXIT_CRITICAL();
+}
+
+/*******************************************************************************
+* Function Name: tput_cwnd_on_uncongested()
+********************************************************************************
+* Summary:
+*   Ends the current congestion episode and accumulates its duration.
+*
+* Parameters:
+*   None
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void tput_cwnd_on_uncongested(void)
+{
+    taskENTER_CRITICAL();
+    if (congested)
+    {
+        congested = false;
+        congested_time_ms += (uint32_t)(xTaskGetTickCount() - congestion_start_tick)
+                                                        * portTICK_PERIOD_MS;
+    }
+    taskEXIT_CRITICAL();
+}
+
+/*******************************************************************************
+* Function Name: tput_cwnd_get_stats()
+********************************************************************************
+* Summary:
+*   Returns a snapshot of the window state and congestion statistics.
+*
+* Parameters:
+*   tput_cwnd_stats_t *p_stats : Pointer to the structure to be filled
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void tput_cwnd_get_stats(tput_cwnd_stats_t *p_stats)
+{
+    taskENTER_CRITICAL();
+    p_stats->cwnd = (uint16_t)(cwnd_q8 >> CWND_FRAC_BITS);
+    p_stats->in_flight = (uint16_t)(sent_count - completed_count);
+    p_stats->congestion_episodes = congestion_episodes;
+    p_stats->congested_time_ms = congested_time_ms;
+    p_stats->congested = congested;
+    if (congested)
+    {
+        /* Include the ongoing episode */
+        p_stats->congested_time_ms += (uint32_t)(xTaskGetTickCount() -
+                                    congestion_start_tick) * portTICK_PERIOD_MS;
+    }
+    taskEXIT_CRITICAL();
+}
+
+/* [] END OF FILE */
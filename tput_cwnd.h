@@ -0,0 +1,88 @@
+/*******************************************************************************
+ * File Name: tput_cwnd.h
+ *
+ * Description: This file contains the declarations of the AIMD in-flight
+ *              window used to pace GATT write commands.
+ *
+ * Related Document: See README.md
+ *
+ *
+ *******************************************************************************
+ * Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ ******************************************************************************/
+
+#ifndef __TPUT_CWND_H__
+#define __TPUT_CWND_H__
+
+/******************************************************************************
+ *                                INCLUDES
+ ******************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+
+/******************************************************************************
+ *                                Macros
+ ******************************************************************************/
+/* Window size (in GATT write packets) used after connection and reset */
+#define TPUT_CWND_INITIAL_PKTS          (4u)
+/* Lower bound of the window. One packet is always allowed in flight */
+#define TPUT_CWND_MIN_PKTS              (1u)
+/* Upper bound of the window. Keeps the stack buffer pool from being exhausted
+ * even when congestion is never reported */
+#define TPUT_CWND_MAX_PKTS              (24u)
+
+/*******************************************************************************
+*        Structures and Enumerations
+*******************************************************************************/
+typedef struct
+{
+    uint16_t cwnd;                  // current window, in packets
+    uint16_t in_flight;             // writes sent but not yet completed
+    uint32_t congestion_episodes;   // number of times the stack reported congestion
+    uint32_t congested_time_ms;     // total time spent in the congested state
+    bool     congested;             // stack currently reports congestion
+} tput_cwnd_stats_t;
+
+/****************************************************************************
+ *                              FUNCTION DECLARATIONS
+ ***************************************************************************/
+void tput_cwnd_reset(void);
+bool tput_cwnd_can_send(void);
+void tput_cwnd_on_sent(void);
+void tput_cwnd_cancel_sent(void);
+void tput_cwnd_on_complete(void);
+void tput_cwnd_on_congested(void);
+void tput_cwnd_on_uncongested(void);
+void tput_cwnd_get_stats(tput_cwnd_stats_t *p_stats);
+
+#endif      /*__TPUT_CWND_H__ */
+/* [] END OF FILE */
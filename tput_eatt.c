@@ -0,0 +1,575 @@
+/*******************************************************************************
+ * File Name: tput_eatt.c
+ *
+ * Description: This file contains the Enhanced ATT (EATT) multi-bearer write mode. Several
+ *              EATT bearers are opened on the connection and each keeps one GATT write
+ *              request outstanding, so that the requests run in parallel instead of being
+ *              serialized on the single ATT bearer. Throughput and request latency are
+ *              measured per bearer.
+ *
+ * Related Document: See README.md
+ *
+ *
+ *******************************************************************************
+ * Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ ******************************************************************************/
+
+/******************************************************************************
+ *                                INCLUDES
+ ******************************************************************************/
+#include <stdio.h>
+#include <string.h>
+#include <FreeRTOS.h>
+#include <task.h>
+#include "ble_client.h"
+#include "app_bt_utils.h"
+#include "tput_time.h"
+#include "tput_eatt.h"
+
+#if TPUT_EATT_ENABLE
+#include "wiced_bt_eatt.h"
+
+/*******************************************************************************
+*        Structures and Enumerations
+*******************************************************************************/
+typedef struct
+{
+    tput_eatt_bearer_stats_t stats;
+    bool     up;                // connection of the bearer completed
+    bool     in_flight;         // a write request is outstanding
+    uint32_t sent_us;           // time the outstanding request was sent
+} tput_eatt_bearer_t;
+
+/*******************************************************************************
+*        Function Prototypes
+*******************************************************************************/
+static void tput_eatt_connect_cmpl_cb(
+                            wiced_bt_eatt_connection_complete_event_t *p_cmpl);
+static void tput_eatt_reconfigure_cb(wiced_bt_eatt_reconfigure_event_t *p_reconf);
+static void tput_eatt_send(uint32_t bearer);
+static uint16_t tput_eatt_write_len(const tput_eatt_bearer_t *p_bearer);
+
+/*******************************************************************************
+*        Variable Definitions
+*******************************************************************************/
+/* Bearers are only opened by this client, incoming requests are not
+ * expected from the throughput server */
+static wiced_bt_eatt_callbacks_t eatt_callbacks =
+{
+    .p_eatt_connect_ind_cb = NULL,
+    .p_eatt_connect_cmpl_cb = tput_eatt_connect_cmpl_cb,
+    .p_eatt_reconfigure_cb = tput_eatt_reconfigure_cb
+};
+
+static tput_eatt_bearer_t bearers[TPUT_EATT_NUM_BEARERS];
+static uint32_t num_bearers = 0;
+static volatile bool running = false;
+static uint16_t write_handle = 0;
+static uint8_t *p_write_data = NULL;
+static uint16_t write_max_len = 0;
+
+/******************************************************************************
+ * Function Definitions
+ ******************************************************************************/
+
+/*******************************************************************************
+* Function Name: tput_eatt_init()
+********************************************************************************
+* Summary:
+*   Registers with the EATT layer of the stack. Called once the stack is
+*   enabled.
+*
+* Parameters:
+*   None
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void tput_eatt_init(void)
+{
+    wiced_bt_gatt_status_t status;
+
+    status = wiced_bt_eatt_register(&eatt_callbacks, TPUT_EATT_MTU,
+                                    TPUT_EATT_NUM_BEARERS,
+                                    TPUT_EATT_BUFFERS_PER_BEARER);
+    printf("EATT registration status: %s\n", get_bt_gatt_status_name(status));
+}
+
+/*******************************************************************************
+* Function Name: tput_eatt_find()
+********************************************************************************
+* Summary:
+*   Finds the bearer with a connection ID.
+*
+* Parameters:
+*   uint16_t conn_id : Connection ID
+*
+* Return:
+*   uint32_t : Index of the bearer, num_bearers if not found
+*
+*******************************************************************************/
+static uint32_t tput_eatt_find(uint16_t conn_id)
+{
+    uint32_t bearer;
+
+    for (bearer = 0; bearer < num_bearers; bearer++)
+    {
+        if (bearers[bearer].stats.conn_id == conn_id)
+        {
+            break;
+        }
+    }
+    return bearer;
+}
+
+/*******************************************************************************
+* Function Name: tput_eatt_open()
+********************************************************************************
+* Summary:
+*   Opens TPUT_EATT_NUM_BEARERS EATT bearers on the connection with a peer.
+*   The link must be encrypted and the peer must support EATT. Each bearer
+*   is reported by the connection complete callback.
+*
+* Parameters:
+*   wiced_bt_device_address_t bd_addr : Address of the peer
+*
+* Return:
+*   wiced_bt_gatt_status_t : Status of the request
+*
+*******************************************************************************/
+wiced_bt_gatt_status_t tput_eatt_open(wiced_bt_device_address_t bd_addr)
+{
+    wiced_bt_eatt_bearers_t conn_ids = {0};
+    wiced_bt_gatt_status_t status;
+
+    if (0u != num_bearers)
+    {
+        return WICED_BT_GATT_ILLEGAL_PARAMETER;
+    }
+    status = wiced_bt_eatt_connect(bd_addr, conn_ids);
+    if (WICED_BT_GATT_SUCCESS != status)
+    {
+        return status;
+    }
+
+    /* The connection IDs of the bearers requested are returned right away */
+    taskENTER_CRITICAL();
+    memset(bearers, 0, sizeof(bearers));
+    for (uint32_t idx = 0; idx < EATT_CHANNELS_PER_TRANSACTION; idx++)
+    {
+        if ((0u != conn_ids[idx]) && (num_bearers < TPUT_EATT_NUM_BEARERS))
+        {
+            bearers[num_bearers].stats.conn_id = conn_ids[idx];
+            bearers[num_bearers].stats.latency_min_us = UINT32_MAX;
+            num_bearers++;
+        }
+    }
+    taskEXIT_CRITICAL();
+    return status;
+}
+
+/*******************************************************************************
+* Function Name: tput_eatt_connect_cmpl_cb()
+********************************************************************************
+* Summary:
+*   EATT connection complete callback, called for each bearer.
+*
+* Parameters:
+*   wiced_bt_eatt_connection_complete_event_t *p_cmpl : Bearer connected
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+static void tput_eatt_connect_cmpl_cb(
+                            wiced_bt_eatt_connection_complete_event_t *p_cmpl)
+{
+    uint32_t bearer = tput_eatt_find(p_cmpl->conn_id);
+
+    if (bearer == num_bearers)
+    {
+        return;
+    }
+    if (WICED_BT_GATT_SUCCESS == p_cmpl->result)
+    {
+        bearers[bearer].up = true;
+        bearers[bearer].stats.mtu = p_cmpl->mtu;
+        printf("EATT bearer %lu up, connection ID %u, MTU %u\n",
+               (unsigned long)bearer, p_cmpl->conn_id, p_cmpl->mtu);
+    }
+    else
+    {
+        printf("EATT bearer %lu failed: %s\n", (unsigned long)bearer,
+               get_bt_gatt_status_name(p_cmpl->result));
+    }
+}
+
+/*******************************************************************************
+* Function Name: tput_eatt_reconfigure_cb()
+********************************************************************************
+* Summary:
+*   EATT reconfiguration callback, updates the MTU of a bearer.
+*
+* Parameters:
+*   wiced_bt_eatt_reconfigure_event_t *p_reconf : Bearer reconfigured
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+static void tput_eatt_reconfigure_cb(wiced_bt_eatt_reconfigure_event_t *p_reconf)
+{
+    uint32_t bearer = tput_eatt_find(p_reconf->conn_id);
+
+    if ((bearer < num_bearers) && (WICED_BT_GATT_SUCCESS == p_reconf->result))
+    {
+        bearers[bearer].stats.mtu = p_reconf->mtu;
+    }
+}
+
+/*******************************************************************************
+* Function Name: tput_eatt_start()
+********************************************************************************
+* Summary:
+*   Starts writing on all bearers that are up. Each bearer sends a write
+*   request of up to MTU - 3 bytes as soon as the previous one is answered.
+*
+* Parameters:
+*   uint16_t handle  : Attribute handle written
+*   uint8_t *p_data  : Data written, must stay valid until stopped
+*   uint16_t max_len : Size of the data
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void tput_eatt_start(uint16_t handle, uint8_t *p_data, uint16_t max_len)
+{
+    write_handle = handle;
+    p_write_data = p_data;
+    write_max_len = max_len;
+    running = true;
+}
+
+/*******************************************************************************
+* Function Name: tput_eatt_stop()
+********************************************************************************
+* Summary:
+*   Stops writing. Requests outstanding are still answered.
+*
+* Parameters:
+*   None
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void tput_eatt_stop(void)
+{
+    running = false;
+}
+
+/*******************************************************************************
+* Function Name: tput_eatt_is_running()
+********************************************************************************
+* Summary:
+*   Tells if writes are running on at least one bearer.
+*
+* Parameters:
+*   None
+*
+* Return:
+*   bool : true if running
+*
+*******************************************************************************/
+bool tput_eatt_is_running(void)
+{
+    return running && (0u != num_bearers);
+}
+
+/*******************************************************************************
+* Function Name: tput_eatt_write_len()
+********************************************************************************
+* Summary:
+*   Returns the length of the writes on a bearer: MTU - 3, at most the size
+*   of the data.
+*
+* Parameters:
+*   const tput_eatt_bearer_t *p_bearer : Bearer
+*
+* Return:
+*   uint16_t : Length of a write
+*
+*******************************************************************************/
+static uint16_t tput_eatt_write_len(const tput_eatt_bearer_t *p_bearer)
+{
+    uint16_t len = p_bearer->stats.mtu - 3u;
+
+    return (len < write_max_len) ? len : write_max_len;
+}
+
+/*******************************************************************************
+* Function Name: tput_eatt_send()
+********************************************************************************
+* Summary:
+*   Sends a write request on a bearer if it is up and idle.
+*
+* Parameters:
+*   uint32_t bearer : Index of the bearer
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+static void tput_eatt_send(uint32_t bearer)
+{
+    tput_eatt_bearer_t *p_bearer = &bearers[bearer];
+    wiced_bt_gatt_write_hdr_t write_req = {0};
+    wiced_bt_gatt_status_t status;
+    bool send;
+
+    taskENTER_CRITICAL();
+    send = running && p_bearer->up && !p_bearer->in_flight;
+    p_bearer->in_flight |= send;
+    taskEXIT_CRITICAL();
+    if (!send)
+    {
+        return;
+    }
+
+    write_req.auth_req = GATT_AUTH_REQ_NONE;
+    write_req.handle = write_handle;
+    write_req.offset = 0;
+    write_req.len = tput_eatt_write_len(p_bearer);
+    p_bearer->sent_us = tput_time_us();
+    /* The data is static, so no free function is passed as context */
+    status = wiced_bt_gatt_client_send_write(p_bearer->stats.conn_id,
+                                             GATT_REQ_WRITE, &write_req,
+                                             p_write_data, NULL);
+    if (WICED_BT_GATT_SUCCESS != status)
+    {
+        /* Retried on the next tick */
+        p_bearer->stats.failures++;
+        p_bearer->in_flight = false;
+    }
+}
+
+/*******************************************************************************
+* Function Name: tput_eatt_tick()
+********************************************************************************
+* Summary:
+*   Sends a write request on every idle bearer. Called every millisecond by
+*   send_gatt_write_task, it starts the bearers and restarts those whose
+*   last request could not be sent.
+*
+* Parameters:
+*   None
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void tput_eatt_tick(void)
+{
+    for (uint32_t bearer = 0; bearer < num_bearers; bearer++)
+    {
+        tput_eatt_send(bearer);
+    }
+}
+
+/*******************************************************************************
+* Function Name: tput_eatt_on_write_rsp()
+********************************************************************************
+* Summary:
+*   Accounts for a write response, and sends the next request on the same
+*   bearer right away. Called from the GATT callback for every completed
+*   write request.
+*
+* Parameters:
+*   uint16_t conn_id              : Connection ID of the response
+*   wiced_bt_gatt_status_t status : Status of the write
+*
+* Return:
+*   bool : false if the connection ID is not an EATT bearer
+*
+*******************************************************************************/
+bool tput_eatt_on_write_rsp(uint16_t conn_id, wiced_bt_gatt_status_t status)
+{
+    uint32_t bearer = tput_eatt_find(conn_id);
+    tput_eatt_bearer_t *p_bearer;
+    uint32_t latency_us;
+
+    if (bearer == num_bearers)
+    {
+        return false;
+    }
+    p_bearer = &bearers[bearer];
+    latency_us = tput_time_us() - p_bearer->sent_us;
+
+    taskENTER_CRITICAL();
+    if (WICED_BT_GATT_SUCCESS == status)
+    {
+        p_bearer->stats.writes++;
+        p_bearer->stats.bytes += tput_eatt_write_len(p_bearer);
+        p_bearer->stats.latency_sum_us += latency_us;
+        if (latency_us < p_bearer->stats.latency_min_us)
+        {
+            p_bearer->stats.latency_min_us = latency_us;
+        }
+        if (latency_us > p_bearer->stats.latency_max_us)
+        {
+            p_bearer->stats.latency_max_us = latency_us;
+        }
+    }
+    else
+    {
+        p_bearer->stats.failures++;
+    }
+    p_bearer->in_flight = false;
+    taskEXIT_CRITICAL();
+
+    tput_eatt_send(bearer);
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: tput_eatt_on_bearer_down()
+********************************************************************************
+* Summary:
+*   Stops using a bearer that was disconnected.
+*
+* Parameters:
+*   uint16_t conn_id : Connection ID of the bearer
+*
+* Return:
+*   bool : false if the connection ID is not an EATT bearer
+*
+*******************************************************************************/
+bool tput_eatt_on_bearer_down(uint16_t conn_id)
+{
+    uint32_t bearer = tput_eatt_find(conn_id);
+
+    if (bearer == num_bearers)
+    {
+        return false;
+    }
+    bearers[bearer].up = false;
+    bearers[bearer].in_flight = false;
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: tput_eatt_on_link_down()
+********************************************************************************
+* Summary:
+*   Forgets all bearers when the connection is lost.
+*
+* Parameters:
+*   None
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void tput_eatt_on_link_down(void)
+{
+    taskENTER_CRITICAL();
+    running = false;
+    num_bearers = 0;
+    memset(bearers, 0, sizeof(bearers));
+    taskEXIT_CRITICAL();
+}
+
+/*******************************************************************************
+* Function Name: tput_eatt_get_stats()
+********************************************************************************
+* Summary:
+*   Reads the statistics of every bearer since the last call of
+*   tput_eatt_clear_stats().
+*
+* Parameters:
+*   tput_eatt_bearer_stats_t *p_stats : Statistics read, one per bearer
+*   uint32_t max_bearers              : Size of p_stats
+*
+* Return:
+*   uint32_t : Number of bearers read
+*
+*******************************************************************************/
+uint32_t tput_eatt_get_stats(tput_eatt_bearer_stats_t *p_stats,
+                             uint32_t max_bearers)
+{
+    uint32_t count;
+
+    taskENTER_CRITICAL();
+    count = (num_bearers < max_bearers) ? num_bearers : max_bearers;
+    for (uint32_t bearer = 0; bearer < count; bearer++)
+    {
+        p_stats[bearer] = bearers[bearer].stats;
+    }
+    taskEXIT_CRITICAL();
+    return count;
+}
+
+/*******************************************************************************
+* Function Name: tput_eatt_clear_stats()
+********************************************************************************
+* Summary:
+*   Clears the throughput and latency statistics of every bearer.
+*
+* Parameters:
+*   None
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void tput_eatt_clear_stats(void)
+{
+    taskENTER_CRITICAL();
+    for (uint32_t bearer = 0; bearer < num_bearers; bearer++)
+    {
+        tput_eatt_bearer_stats_t *p_stats = &bearers[bearer].stats;
+
+        p_stats->bytes = 0;
+        p_stats->writes = 0;
+        p_stats->failures = 0;
+        p_stats->latency_sum_us = 0;
+        p_stats->latency_min_us = UINT32_MAX;
+        p_stats->latency_max_us = 0;
+    }
+    taskEXIT_CRITICAL();
+}
+
+#endif /* TPUT_EATT_ENABLE */
+
+/* [] END OF FILE */
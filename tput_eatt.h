@@ -0,0 +1,98 @@
+/*******************************************************************************
+ * File Name: tput_eatt.h
+ *
+ * Description: This file contains the declarations of the Enhanced ATT (EATT) multi-bearer
+ *              write mode.
+ *
+ * Related Document: See README.md
+ *
+ *
+ *******************************************************************************
+ * Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ ******************************************************************************/
+
+#ifndef __TPUT_EATT_H__
+#define __TPUT_EATT_H__
+
+/******************************************************************************
+ *                                INCLUDES
+ ******************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include "wiced_bt_gatt.h"
+
+/******************************************************************************
+ *                                Macros
+ ******************************************************************************/
+/* Bearers opened by tput_eatt_open(), at most 5. The L2CAP channels of the
+ * stack configuration (design.cybt) must allow as many */
+#ifndef TPUT_EATT_NUM_BEARERS
+#define TPUT_EATT_NUM_BEARERS           (4u)
+#endif
+/* MTU requested for each bearer, and stack buffers reserved per bearer */
+#define TPUT_EATT_MTU                   (512u)
+#define TPUT_EATT_BUFFERS_PER_BEARER    (2u)
+
+/*******************************************************************************
+*        Structures and Enumerations
+*******************************************************************************/
+typedef struct
+{
+    uint16_t conn_id;           // connection ID of the bearer
+    uint16_t mtu;               // MTU of the bearer
+    uint32_t bytes;             // bytes written and acknowledged
+    uint32_t writes;            // write requests acknowledged
+    uint32_t failures;          // write requests failed or rejected
+    uint32_t latency_sum_us;    // request to response time of the writes
+    uint32_t latency_min_us;
+    uint32_t latency_max_us;
+} tput_eatt_bearer_stats_t;
+
+/****************************************************************************
+ *                              FUNCTION DECLARATIONS
+ ***************************************************************************/
+void     tput_eatt_init(void);
+wiced_bt_gatt_status_t tput_eatt_open(wiced_bt_device_address_t bd_addr);
+void     tput_eatt_start(uint16_t handle, uint8_t *p_data, uint16_t max_len);
+void     tput_eatt_stop(void);
+bool     tput_eatt_is_running(void);
+void     tput_eatt_tick(void);
+bool     tput_eatt_on_write_rsp(uint16_t conn_id,
+                                wiced_bt_gatt_status_t status);
+bool     tput_eatt_on_bearer_down(uint16_t conn_id);
+void     tput_eatt_on_link_down(void);
+uint32_t tput_eatt_get_stats(tput_eatt_bearer_stats_t *p_stats,
+                             uint32_t max_bearers);
+void     tput_eatt_clear_stats(void);
+
+#endif      /*__TPUT_EATT_H__ */
+/* [] END OF FILE */
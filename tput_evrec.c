@@ -0,0 +1,854 @@
+/*******************************************************************************
+ * File Name: tput_evrec.c
+ *
+ * Description: This file contains the event recorder, which captures the events seen by
+ *              ble_app_gatt_event_handler() and app_bt_management_callback() into a
+ *              compact recording, and their replay, which feeds a recording back to the
+ *              handlers at full speed, checks the client counters, and measures the
+ *              handler cost per event type.
+ *
+ * Related Document: See README.md
+ *
+ *
+ *******************************************************************************
+ * Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ ******************************************************************************/
+
+/******************************************************************************
+ *                                INCLUDES
+ ******************************************************************************/
+#include <stdio.h>
+#include <string.h>
+#include <FreeRTOS.h>
+#include <task.h>
+#include "ble_client.h"
+#include "app_bt_utils.h"
+#include "tput_time.h"
+#include "tput_evrec.h"
+
+#if TPUT_EVREC_ENABLE
+
+/******************************************************************************
+ *                                Macros
+ ******************************************************************************/
+/* Recording bytes per line of tput_evrec_dump() */
+#define TPUT_EVREC_DUMP_LINE_BYTES      (32u)
+
+/*******************************************************************************
+*        Structures and Enumerations
+*******************************************************************************/
+/* Handler cost of one event type during replay */
+typedef struct
+{
+    uint8_t  src;
+    uint8_t  event;
+    uint32_t count;
+    uint32_t cycles_sum;
+    uint32_t cycles_max;
+} tput_evrec_cost_t;
+
+/*******************************************************************************
+*        Variable Definitions
+*******************************************************************************/
+static tput_evrec_gatt_cb_t p_gatt_cb = NULL;
+static tput_evrec_mgmt_cb_t p_mgmt_cb = NULL;
+
+static uint8_t rec_buf[TPUT_EVREC_BUF_SIZE];
+static uint32_t rec_len = 0;
+static volatile bool recording = false;
+static bool overflow = false;
+static uint32_t last_us = 0;
+
+/* Replay */
+static uint8_t replay_value[TPUT_EVREC_MAX_VALUE_LEN];
+static wiced_bt_device_address_t replay_bd_addr;
+static tput_evrec_cost_t costs[TPUT_EVREC_MAX_COSTS];
+static uint32_t num_costs = 0;
+
+/******************************************************************************
+ * Function Definitions
+ ******************************************************************************/
+
+/*******************************************************************************
+* Function Name: tput_evrec_init()
+********************************************************************************
+* Summary:
+*   Sets the handlers the events are replayed to.
+*
+* Parameters:
+*   tput_evrec_gatt_cb_t gatt_cb : GATT event handler
+*   tput_evrec_mgmt_cb_t mgmt_cb : Management event handler
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void tput_evrec_init(tput_evrec_gatt_cb_t gatt_cb, tput_evrec_mgmt_cb_t mgmt_cb)
+{
+    p_gatt_cb = gatt_cb;
+    p_mgmt_cb = mgmt_cb;
+}
+
+/*******************************************************************************
+* Function Name: tput_evrec_append()
+********************************************************************************
+* Summary:
+*   Appends a record, with its data in two parts. When the recording is
+*   full, recording stops.
+*
+* Parameters:
+*   tput_evrec_src_t src : Source of the event
+*   uint8_t event        : Event code
+*   const void *p_data1  : First part of the data
+*   uint16_t len1        : Its length
+*   const void *p_data2  : Second part of the data, or NULL
+*   uint16_t len2        : Its length
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+static void tput_evrec_append(tput_evrec_src_t src, uint8_t event,
+                              const void *p_data1, uint16_t len1,
+                              const void *p_data2, uint16_t len2)
+{
+    tput_evrec_rec_hdr_t rec;
+    uint32_t now_us = tput_time_us();
+
+    taskENTER_CRITICAL();
+    if (recording)
+    {
+        if ((rec_len + sizeof(rec) + len1 + len2) > sizeof(rec_buf))
+        {
+            recording = false;
+            overflow = true;
+        }
+        else
+        {
+            rec.src = (uint8_t)src;
+            rec.event = event;
+            rec.len = ((NULL != p_data1) ? len1 : 0u) +
+                      ((NULL != p_data2) ? len2 : 0u);
+            rec.delta_us = now_us - last_us;
+            last_us = now_us;
+            memcpy(&rec_buf[rec_len], &rec, sizeof(rec));
+            rec_len += sizeof(rec);
+            if (NULL != p_data1)
+            {
+                memcpy(&rec_buf[rec_len], p_data1, len1);
+                rec_len += len1;
+            }
+            if (NULL != p_data2)
+            {
+                memcpy(&rec_buf[rec_len], p_data2, len2);
+                rec_len += len2;
+            }
+        }
+    }
+    taskEXIT_CRITICAL();
+}
+
+/*******************************************************************************
+* Function Name: tput_evrec_append_check()
+********************************************************************************
+* Summary:
+*   Appends the client counters, if they can be read.
+*
+* Parameters:
+*   None
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+static void tput_evrec_append_check(void)
+{
+    tput_rx_totals_t totals;
+    tput_evrec_check_t check;
+
+    if (tput_get_rx_totals(&totals))
+    {
+        check.rx_bytes = totals.rx_bytes;
+        check.rx_pkts = totals.rx_pkts;
+        tput_evrec_append(TPUT_EVREC_SRC_CHECK, 0, &check, sizeof(check),
+                          NULL, 0);
+    }
+}
+
+/*******************************************************************************
+* Function Name: tput_evrec_start()
+********************************************************************************
+* Summary:
+*   Starts a new recording. It should be started while disconnected, so that
+*   it includes the connection.
+*
+* Parameters:
+*   None
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void tput_evrec_start(void)
+{
+    tput_evrec_file_hdr_t hdr =
+    {
+        .magic = {'T', 'E', 'V'},
+        .version = TPUT_EVREC_VERSION,
+        .gatt_data_size = sizeof(wiced_bt_gatt_event_data_t),
+        .mgmt_data_size = sizeof(wiced_bt_management_evt_data_t)
+    };
+
+    taskENTER_CRITICAL();
+    memcpy(rec_buf, &hdr, sizeof(hdr));
+    rec_len = sizeof(hdr);
+    overflow = false;
+    last_us = tput_time_us();
+    recording = true;
+    taskEXIT_CRITICAL();
+}
+
+/*******************************************************************************
+* Function Name: tput_evrec_stop()
+********************************************************************************
+* Summary:
+*   Stops recording, after appending the client counters if connected.
+*
+* Parameters:
+*   None
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void tput_evrec_stop(void)
+{
+    if (recording)
+    {
+        tput_evrec_append_check();
+    }
+    recording = false;
+    printf("Event recording: %lu bytes%s\n", (unsigned long)rec_len,
+           overflow ? ", stopped when full" : "");
+}
+
+/*******************************************************************************
+* Function Name: tput_evrec_is_recording()
+********************************************************************************
+* Summary:
+*   Tells whether events are being recorded.
+*
+* Parameters:
+*   None
+*
+* Return:
+*   bool : true while recording
+*
+*******************************************************************************/
+bool tput_evrec_is_recording(void)
+{
+    return recording;
+}
+
+/*******************************************************************************
+* Function Name: tput_evrec_on_gatt_event()
+********************************************************************************
+* Summary:
+*   Records a GATT event, called on entry of ble_app_gatt_event_handler().
+*   The structure of the event is kept, with the peer address of connection
+*   events and the leading bytes of notification payloads. Buffer events
+*   only mark their place, as the buffers belong to the live stack.
+*
+* Parameters:
+*   wiced_bt_gatt_evt_t event                      : GATT event
+*   const wiced_bt_gatt_event_data_t *p_event_data : Event data
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void tput_evrec_on_gatt_event(wiced_bt_gatt_evt_t event,
+                              const wiced_bt_gatt_event_data_t *p_event_data)
+{
+    const wiced_bt_gatt_operation_complete_t *p_op;
+    uint16_t payload_len;
+
+    if (!recording)
+    {
+        return;
+    }
+    switch (event)
+    {
+    case GATT_CONNECTION_STATUS_EVT:
+        /* Counters are cleared on disconnection, check them before */
+        if (!p_event_data->connection_status.connected)
+        {
+            tput_evrec_append_check();
+        }
+        tput_evrec_append(TPUT_EVREC_SRC_GATT, event,
+                          &p_event_data->connection_status,
+                          sizeof(p_event_data->connection_status),
+                          p_event_data->connection_status.bd_addr, BD_ADDR_LEN);
+        break;
+
+    case GATT_OPERATION_CPLT_EVT:
+        p_op = &p_event_data->operation_complete;
+        payload_len = 0;
+        if (GATTC_OPTYPE_NOTIFICATION == p_op->op)
+        {
+            payload_len = (p_op->response_data.att_value.len <
+                           TPUT_EVREC_PAYLOAD_BYTES) ?
+                          p_op->response_data.att_value.len :
+                          TPUT_EVREC_PAYLOAD_BYTES;
+        }
+        tput_evrec_append(TPUT_EVREC_SRC_GATT, event, p_op, sizeof(*p_op),
+                          payload_len ? p_op->response_data.att_value.p_data :
+                                        NULL,
+                          payload_len);
+        break;
+
+    case GATT_DISCOVERY_RESULT_EVT:
+        tput_evrec_append(TPUT_EVREC_SRC_GATT, event,
+                          &p_event_data->discovery_result,
+                          sizeof(p_event_data->discovery_result), NULL, 0);
+        break;
+
+    case GATT_DISCOVERY_CPLT_EVT:
+        tput_evrec_append(TPUT_EVREC_SRC_GATT, event,
+                          &p_event_data->discovery_complete,
+                          sizeof(p_event_data->discovery_complete), NULL, 0);
+        break;
+
+    case GATT_CONGESTION_EVT:
+        tput_evrec_append(TPUT_EVREC_SRC_GATT, event,
+                          &p_event_data->congestion,
+                          sizeof(p_event_data->congestion), NULL, 0);
+        break;
+
+    default:
+        tput_evrec_append(TPUT_EVREC_SRC_GATT, event, NULL, 0, NULL, 0);
+        break;
+    }
+}
+
+/*******************************************************************************
+* Function Name: tput_evrec_on_mgmt_event()
+********************************************************************************
+* Summary:
+*   Records a management event, called on entry of
+*   app_bt_management_callback(). The data of the link update and scan
+*   events is kept; other events only mark their place.
+*
+* Parameters:
+*   wiced_bt_management_evt_t event                    : Management event
+*   const wiced_bt_management_evt_data_t *p_event_data : Event data
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void tput_evrec_on_mgmt_event(wiced_bt_management_evt_t event,
+                              const wiced_bt_management_evt_data_t *p_event_data)
+{
+    if (!recording)
+    {
+        return;
+    }
+    switch (event)
+    {
+    case BTM_BLE_SCAN_STATE_CHANGED_EVT:
+        tput_evrec_append(TPUT_EVREC_SRC_MGMT, event,
+                          &p_event_data->ble_scan_state_changed,
+                          sizeof(p_event_data->ble_scan_state_changed), NULL, 0);
+        break;
+
+    case BTM_BLE_PHY_UPDATE_EVT:
+        tput_evrec_append(TPUT_EVREC_SRC_MGMT, event,
+                          &p_event_data->ble_phy_update_event,
+                          sizeof(p_event_data->ble_phy_update_event), NULL, 0);
+        break;
+
+    case BTM_BLE_DATA_LENGTH_UPDATE_EVENT:
+        tput_evrec_append(TPUT_EVREC_SRC_MGMT, event,
+                          &p_event_data->ble_data_length_update_event,
+                          sizeof(p_event_data->ble_data_length_update_event),
+                          NULL, 0);
+        break;
+
+    case BTM_BLE_CONNECTION_PARAM_UPDATE:
+        tput_evrec_append(TPUT_EVREC_SRC_MGMT, event,
+                          &p_event_data->ble_connection_param_update,
+                          sizeof(p_event_data->ble_connection_param_update),
+                          NULL, 0);
+        break;
+
+    default:
+        tput_evrec_append(TPUT_EVREC_SRC_MGMT, event, NULL, 0, NULL, 0);
+        break;
+    }
+}
+
+/*******************************************************************************
+* Function Name: tput_evrec_clear()
+********************************************************************************
+* Summary:
+*   Empties the recording, before one is loaded with tput_evrec_load().
+*
+* Parameters:
+*   None
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void tput_evrec_clear(void)
+{
+    taskENTER_CRITICAL();
+    recording = false;
+    overflow = false;
+    rec_len = 0;
+    taskEXIT_CRITICAL();
+}
+
+/*******************************************************************************
+* Function Name: tput_evrec_load()
+********************************************************************************
+* Summary:
+*   Appends hexadecimal bytes to the recording. scripts/tput_evrec.py
+*   converts a recording file to the console commands that load it.
+*
+* Parameters:
+*   const char *p_hex : Even number of hexadecimal digits
+*
+* Return:
+*   bool : false if the digits are invalid or the recording is full
+*
+*******************************************************************************/
+bool tput_evrec_load(const char *p_hex)
+{
+    uint32_t num_bytes = strlen(p_hex) / 2u;
+    uint8_t nibble[2];
+
+    if (recording || (0u != (strlen(p_hex) % 2u)) ||
+        ((rec_len + num_bytes) > sizeof(rec_buf)))
+    {
+        return false;
+    }
+    for (uint32_t idx = 0; idx < num_bytes; idx++)
+    {
+        for (uint32_t half = 0; half < 2u; half++)
+        {
+            char digit = p_hex[(idx * 2u) + half];
+
+            if ((digit >= '0') && (digit <= '9'))
+            {
+                nibble[half] = (uint8_t)(digit - '0');
+            }
+            else if ((digit >= 'a') && (digit <= 'f'))
+            {
+                nibble[half] = (uint8_t)(digit - 'a' + 10);
+            }
+            else if ((digit >= 'A') && (digit <= 'F'))
+            {
+                nibble[half] = (uint8_t)(digit - 'A' + 10);
+            }
+            else
+            {
+                return false;
+            }
+        }
+        rec_buf[rec_len++] = (uint8_t)((nibble[0] << 4) | nibble[1]);
+    }
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: tput_evrec_dump()
+********************************************************************************
+* Summary:
+*   Prints the recording as hexadecimal lines for scripts/tput_evrec.py:
+*     evrec_start,<bytes>
+*     evrec,<up to 32 bytes in hexadecimal>
+*     evrec_end
+*
+* Parameters:
+*   None
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void tput_evrec_dump(void)
+{
+    printf("evrec_start,%lu\n", (unsigned long)rec_len);
+    for (uint32_t offset = 0; offset < rec_len;
+         offset += TPUT_EVREC_DUMP_LINE_BYTES)
+    {
+        printf("evrec,");
+        for (uint32_t idx = offset;
+             (idx < rec_len) && (idx < (offset + TPUT_EVREC_DUMP_LINE_BYTES));
+             idx++)
+        {
+            printf("%02x", rec_buf[idx]);
+        }
+        printf("\n");
+    }
+    printf("evrec_end\n");
+}
+
+/*******************************************************************************
+* Function Name: tput_evrec_build_gatt()
+********************************************************************************
+* Summary:
+*   Rebuilds the data of a recorded GATT event, pointing its pointers to
+*   replay buffers.
+*
+* Parameters:
+*   const tput_evrec_rec_hdr_t *p_rec        : Record
+*   const uint8_t *p_data                    : Data of the record
+*   wiced_bt_gatt_event_data_t *p_event_data : Event data rebuilt
+*
+* Return:
+*   bool : false if the event is not replayed
+*
+*******************************************************************************/
+static bool tput_evrec_build_gatt(const tput_evrec_rec_hdr_t *p_rec,
+                                  const uint8_t *p_data,
+                                  wiced_bt_gatt_event_data_t *p_event_data)
+{
+    wiced_bt_gatt_operation_complete_t *p_op = &p_event_data->operation_complete;
+    uint16_t size;
+
+    memset(p_event_data, 0, sizeof(*p_event_data));
+    switch (p_rec->event)
+    {
+    case GATT_CONNECTION_STATUS_EVT:
+        size = sizeof(p_event_data->connection_status);
+        if (p_rec->len != (size + BD_ADDR_LEN))
+        {
+            return false;
+        }
+        memcpy(&p_event_data->connection_status, p_data, size);
+        memcpy(replay_bd_addr, &p_data[size], BD_ADDR_LEN);
+        p_event_data->connection_status.bd_addr = replay_bd_addr;
+        return true;
+
+    case GATT_OPERATION_CPLT_EVT:
+        size = sizeof(*p_op);
+        if (p_rec->len < size)
+        {
+            return false;
+        }
+        memcpy(p_op, p_data, size);
+        if (GATTC_OPTYPE_NOTIFICATION == p_op->op)
+        {
+            if ((p_op->response_data.att_value.len > TPUT_EVREC_MAX_VALUE_LEN) ||
+                ((p_rec->len - size) > p_op->response_data.att_value.len))
+            {
+                return false;
+            }
+            memset(replay_value, 0, p_op->response_data.att_value.len);
+            memcpy(replay_value, &p_data[size], p_rec->len - size);
+            p_op->response_data.att_value.p_data = replay_value;
+        }
+        return true;
+
+    case GATT_DISCOVERY_RESULT_EVT:
+        size = sizeof(p_event_data->discovery_result);
+        break;
+
+    case GATT_DISCOVERY_CPLT_EVT:
+        size = sizeof(p_event_data->discovery_complete);
+        break;
+
+    case GATT_CONGESTION_EVT:
+        size = sizeof(p_event_data->congestion);
+        break;
+
+    default:
+        return false;
+    }
+    if (p_rec->len != size)
+    {
+        return false;
+    }
+    /* The members of the union start at its beginning */
+    memcpy(p_event_data, p_data, size);
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: tput_evrec_build_mgmt()
+********************************************************************************
+* Summary:
+*   Rebuilds the data of a recorded management event.
+*
+* Parameters:
+*   const tput_evrec_rec_hdr_t *p_rec            : Record
+*   const uint8_t *p_data                        : Data of the record
+*   wiced_bt_management_evt_data_t *p_event_data : Event data rebuilt
+*
+* Return:
+*   bool : false if the event is not replayed
+*
+*******************************************************************************/
+static bool tput_evrec_build_mgmt(const tput_evrec_rec_hdr_t *p_rec,
+                                  const uint8_t *p_data,
+                                  wiced_bt_management_evt_data_t *p_event_data)
+{
+    uint16_t size;
+
+    memset(p_event_data, 0, sizeof(*p_event_data));
+    switch (p_rec->event)
+    {
+    case BTM_BLE_SCAN_STATE_CHANGED_EVT:
+        size = sizeof(p_event_data->ble_scan_state_changed);
+        break;
+
+    case BTM_BLE_PHY_UPDATE_EVT:
+        size = sizeof(p_event_data->ble_phy_update_event);
+        break;
+
+    case BTM_BLE_DATA_LENGTH_UPDATE_EVENT:
+        size = sizeof(p_event_data->ble_data_length_update_event);
+        break;
+
+    case BTM_BLE_CONNECTION_PARAM_UPDATE:
+        size = sizeof(p_event_data->ble_connection_param_update);
+        break;
+
+    default:
+        return false;
+    }
+    if (p_rec->len != size)
+    {
+        return false;
+    }
+    memcpy(p_event_data, p_data, size);
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: tput_evrec_add_cost()
+********************************************************************************
+* Summary:
+*   Accounts the handler cost of a replayed event.
+*
+* Parameters:
+*   const tput_evrec_rec_hdr_t *p_rec : Record replayed
+*   uint32_t cycles                   : CPU cycles spent in the handler
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+static void tput_evrec_add_cost(const tput_evrec_rec_hdr_t *p_rec,
+                                uint32_t cycles)
+{
+    uint32_t idx;
+
+    for (idx = 0; idx < num_costs; idx++)
+    {
+        if ((costs[idx].src == p_rec->src) && (costs[idx].event == p_rec->event))
+        {
+            break;
+        }
+    }
+    if (idx == num_costs)
+    {
+        if (num_costs == TPUT_EVREC_MAX_COSTS)
+        {
+            return;
+        }
+        memset(&costs[idx], 0, sizeof(costs[idx]));
+        costs[idx].src = p_rec->src;
+        costs[idx].event = p_rec->event;
+        num_costs++;
+    }
+    costs[idx].count++;
+    costs[idx].cycles_sum += cycles;
+    if (cycles > costs[idx].cycles_max)
+    {
+        costs[idx].cycles_max = cycles;
+    }
+}
+
+/*******************************************************************************
+* Function Name: tput_evrec_check()
+********************************************************************************
+* Summary:
+*   Compares the client counters with a recorded check.
+*
+* Parameters:
+*   const tput_evrec_rec_hdr_t *p_rec : Record
+*   const uint8_t *p_data             : Data of the record
+*
+* Return:
+*   bool : true if the counters match
+*
+*******************************************************************************/
+static bool tput_evrec_check(const tput_evrec_rec_hdr_t *p_rec,
+                             const uint8_t *p_data)
+{
+    tput_evrec_check_t expected;
+    tput_rx_totals_t totals;
+
+    if (p_rec->len != sizeof(expected))
+    {
+        return false;
+    }
+    memcpy(&expected, p_data, sizeof(expected));
+    if (!tput_get_rx_totals(&totals))
+    {
+        printf("evrec_check,FAIL,not connected\n");
+        return false;
+    }
+    if ((totals.rx_bytes != expected.rx_bytes) ||
+        (totals.rx_pkts != expected.rx_pkts))
+    {
+        printf("evrec_check,FAIL,rx bytes %lu expected %lu, rx pkts %lu "
+               "expected %lu\n", (unsigned long)totals.rx_bytes,
+               (unsigned long)expected.rx_bytes, (unsigned long)totals.rx_pkts,
+               (unsigned long)expected.rx_pkts);
+        return false;
+    }
+    printf("evrec_check,PASS,rx bytes %lu, rx pkts %lu\n",
+           (unsigned long)totals.rx_bytes, (unsigned long)totals.rx_pkts);
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: tput_evrec_replay()
+********************************************************************************
+* Summary:
+*   Feeds the recorded events to the handlers, one after the other without
+*   delay, and compares the client counters with the recorded checks. Must
+*   be called while neither connected nor scanning, so that no live event
+*   interleaves. The caller keeps the handlers from calling the stack. Prints
+*   a line per check and the handler cost per event type:
+*     evrec_cost,<gatt|mgmt>,<event>,<count>,<avg cycles>,<max cycles>
+*
+* Parameters:
+*   None
+*
+* Return:
+*   bool : true if the recording is valid and every check passed
+*
+*******************************************************************************/
+bool tput_evrec_replay(void)
+{
+    tput_evrec_file_hdr_t hdr;
+    tput_evrec_rec_hdr_t rec;
+    wiced_bt_gatt_event_data_t gatt_data;
+    wiced_bt_management_evt_data_t mgmt_data;
+    uint32_t offset = sizeof(hdr);
+    uint32_t replayed = 0;
+    uint32_t skipped = 0;
+    uint32_t checks = 0;
+    uint32_t failures = 0;
+    uint32_t start;
+    uint32_t elapsed_us = tput_time_us();
+
+    if (recording || (NULL == p_gatt_cb) || (NULL == p_mgmt_cb) ||
+        (rec_len < sizeof(hdr)))
+    {
+        return false;
+    }
+    memcpy(&hdr, rec_buf, sizeof(hdr));
+    if ((0 != memcmp(hdr.magic, "TEV", sizeof(hdr.magic))) ||
+        (TPUT_EVREC_VERSION != hdr.version) ||
+        (sizeof(wiced_bt_gatt_event_data_t) != hdr.gatt_data_size) ||
+        (sizeof(wiced_bt_management_evt_data_t) != hdr.mgmt_data_size))
+    {
+        printf("Event replay: recording made by another build\n");
+        return false;
+    }
+
+    num_costs = 0;
+    while ((offset + sizeof(rec)) <= rec_len)
+    {
+        memcpy(&rec, &rec_buf[offset], sizeof(rec));
+        offset += sizeof(rec);
+        if ((offset + rec.len) > rec_len)
+        {
+            printf("Event replay: truncated record at %lu\n",
+                   (unsigned long)offset);
+            return false;
+        }
+
+        if ((TPUT_EVREC_SRC_GATT == rec.src) &&
+            tput_evrec_build_gatt(&rec, &rec_buf[offset], &gatt_data))
+        {
+            start = tput_time_cycles();
+            p_gatt_cb((wiced_bt_gatt_evt_t)rec.event, &gatt_data);
+            tput_evrec_add_cost(&rec, tput_time_cycles() - start);
+            replayed++;
+        }
+        else if ((TPUT_EVREC_SRC_MGMT == rec.src) &&
+                 tput_evrec_build_mgmt(&rec, &rec_buf[offset], &mgmt_data))
+        {
+            start = tput_time_cycles();
+            p_mgmt_cb((wiced_bt_management_evt_t)rec.event, &mgmt_data);
+            tput_evrec_add_cost(&rec, tput_time_cycles() - start);
+            replayed++;
+        }
+        else if (TPUT_EVREC_SRC_CHECK == rec.src)
+        {
+            checks++;
+            failures += tput_evrec_check(&rec, &rec_buf[offset]) ? 0u : 1u;
+        }
+        else
+        {
+            skipped++;
+        }
+        offset += rec.len;
+    }
+    elapsed_us = tput_time_us() - elapsed_us;
+
+    for (uint32_t idx = 0; idx < num_costs; idx++)
+    {
+        printf("evrec_cost,%s,%u,%lu,%lu,%lu\n",
+               (TPUT_EVREC_SRC_GATT == costs[idx].src) ? "gatt" : "mgmt",
+               costs[idx].event, (unsigned long)costs[idx].count,
+               (unsigned long)(costs[idx].cycles_sum / costs[idx].count),
+               (unsigned long)costs[idx].cycles_max);
+    }
+    printf("Event replay: %lu events replayed, %lu skipped, in %lu us; "
+           "%lu checks, %lu failed\n", (unsigned long)replayed,
+           (unsigned long)skipped, (unsigned long)elapsed_us,
+           (unsigned long)checks, (unsigned long)failures);
+    return (0u == failures);
+}
+
+#endif /* TPUT_EVREC_ENABLE */
+
+/* [] END OF FILE */
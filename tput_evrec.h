@@ -0,0 +1,131 @@
+/*******************************************************************************
+ * File Name: tput_evrec.h
+ *
+ * Description: This file contains the declarations of the GATT and management event
+ *              recorder and its replay.
+ *
+ * Related Document: See README.md
+ *
+ *
+ *******************************************************************************
+ * Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ ******************************************************************************/
+
+#ifndef __TPUT_EVREC_H__
+#define __TPUT_EVREC_H__
+
+/******************************************************************************
+ *                                INCLUDES
+ ******************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include "wiced_bt_dev.h"
+#include "wiced_bt_gatt.h"
+
+/******************************************************************************
+ *                                Macros
+ ******************************************************************************/
+/* Size of the recording, including its header */
+#define TPUT_EVREC_BUF_SIZE             (8192u)
+/* Leading payload bytes kept per notification. The length is always kept,
+ * the rest of the payload is replayed as zeros */
+#define TPUT_EVREC_PAYLOAD_BYTES        (8u)
+/* Largest notification payload replayed (the ATT maximum) */
+#define TPUT_EVREC_MAX_VALUE_LEN        (512u)
+/* Event types whose handler cost is measured separately during replay */
+#define TPUT_EVREC_MAX_COSTS            (16u)
+
+/* Incremented when the recording format changes, checked by
+ * scripts/tput_evrec.py */
+#define TPUT_EVREC_VERSION              (1u)
+
+/*******************************************************************************
+*        Structures and Enumerations
+*******************************************************************************/
+/* Recording: a header followed by records, little endian. Event data is
+ * kept as the structures of the stack, so a recording can only be
+ * replayed by a build using the same stack headers */
+typedef struct __attribute__((packed))
+{
+    uint8_t  magic[3];              // "TEV"
+    uint8_t  version;               // TPUT_EVREC_VERSION
+    uint16_t gatt_data_size;        // sizeof(wiced_bt_gatt_event_data_t)
+    uint16_t mgmt_data_size;        // sizeof(wiced_bt_management_evt_data_t)
+} tput_evrec_file_hdr_t;
+
+typedef enum
+{
+    TPUT_EVREC_SRC_GATT,            // ble_app_gatt_event_handler()
+    TPUT_EVREC_SRC_MGMT,            // app_bt_management_callback()
+    TPUT_EVREC_SRC_CHECK            // client counters, checked on replay
+} tput_evrec_src_t;
+
+typedef struct __attribute__((packed))
+{
+    uint8_t  src;                   // tput_evrec_src_t
+    uint8_t  event;                 // wiced_bt_gatt_evt_t or
+                                    // wiced_bt_management_evt_t
+    uint16_t len;                   // length of the data that follows
+    uint32_t delta_us;              // time since the previous record
+} tput_evrec_rec_hdr_t;
+
+/* Data of a TPUT_EVREC_SRC_CHECK record, taken before a disconnection and
+ * when the recording stops */
+typedef struct __attribute__((packed))
+{
+    uint32_t rx_bytes;
+    uint32_t rx_pkts;
+} tput_evrec_check_t;
+
+typedef wiced_bt_gatt_status_t (*tput_evrec_gatt_cb_t)(wiced_bt_gatt_evt_t event,
+                                    wiced_bt_gatt_event_data_t *p_event_data);
+typedef wiced_result_t (*tput_evrec_mgmt_cb_t)(wiced_bt_management_evt_t event,
+                                wiced_bt_management_evt_data_t *p_event_data);
+
+/****************************************************************************
+ *                              FUNCTION DECLARATIONS
+ ***************************************************************************/
+void tput_evrec_init(tput_evrec_gatt_cb_t gatt_cb, tput_evrec_mgmt_cb_t mgmt_cb);
+void tput_evrec_start(void);
+void tput_evrec_stop(void);
+bool tput_evrec_is_recording(void);
+void tput_evrec_on_gatt_event(wiced_bt_gatt_evt_t event,
+                              const wiced_bt_gatt_event_data_t *p_event_data);
+void tput_evrec_on_mgmt_event(wiced_bt_management_evt_t event,
+                              const wiced_bt_management_evt_data_t *p_event_data);
+void tput_evrec_clear(void);
+bool tput_evrec_load(const char *p_hex);
+void tput_evrec_dump(void);
+bool tput_evrec_replay(void);
+
+#endif      /*__TPUT_EVREC_H__ */
+/* [] END OF FILE */
@@ -0,0 +1,186 @@
+/*******************************************************************************
+ * File Name: tput_load.c
+ *
+ * Description: This file contains a synthetic processing load applied to every received
+ *              notification, and a sweep measuring how the receive throughput falls as
+ *              the load grows.
+ *
+ * Related Document: See README.md
+ *
+ *
+ *******************************************************************************
+ * Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ ******************************************************************************/
+
+/******************************************************************************
+ *                                INCLUDES
+ ******************************************************************************/
+#include <stdio.h>
+#include <FreeRTOS.h>
+#include <task.h>
+#include "ble_client.h"
+#include "tput_time.h"
+#include "tput_load.h"
+
+/*******************************************************************************
+*        Variable Definitions
+*******************************************************************************/
+static volatile tput_load_place_t load_place = TPUT_LOAD_OFF;
+static volatile uint32_t load_cycles = 0;
+
+/******************************************************************************
+ * Function Definitions
+ ******************************************************************************/
+
+/*******************************************************************************
+* Function Name: tput_load_set()
+********************************************************************************
+* Summary:
+*   Selects where the load runs and how many CPU cycles it takes per
+*   notification.
+*
+* Parameters:
+*   tput_load_place_t place : Where the load runs, TPUT_LOAD_OFF to disable
+*   uint32_t cycles         : Cycles per notification
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void tput_load_set(tput_load_place_t place, uint32_t cycles)
+{
+    taskENTER_CRITICAL();
+    load_place = (0u != cycles) ? place : TPUT_LOAD_OFF;
+    load_cycles = cycles;
+    taskEXIT_CRITICAL();
+}
+
+/*******************************************************************************
+* Function Name: tput_load_run()
+********************************************************************************
+* Summary:
+*   Runs the load for one notification, if it is configured for the calling
+*   place.
+*
+* Parameters:
+*   tput_load_place_t place : Place of the caller
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void tput_load_run(tput_load_place_t place)
+{
+    if (place == load_place)
+    {
+        tput_time_spin_cycles(load_cycles);
+    }
+}
+
+/*******************************************************************************
+* Function Name: tput_load_sweep()
+********************************************************************************
+* Summary:
+*   Measures the receive throughput for loads from 0 to max_cycles, first
+*   run inline and then deferred. Each step runs for TPUT_LOAD_SETTLE_MS and
+*   is then measured for measure_s seconds. One CSV line is printed per
+*   step, prefixed with "sweep," so that it can be picked out of the
+*   console output (see scripts/tput_load_sweep.py). The load is switched
+*   off at the end. Notifications must be enabled.
+*
+* Parameters:
+*   uint32_t max_cycles  : Largest load, in cycles per notification
+*   uint32_t step_cycles : Load increment
+*   uint32_t measure_s   : Measurement time of each step
+*
+* Return:
+*   bool : false if no notifications are received
+*
+*******************************************************************************/
+bool tput_load_sweep(uint32_t max_cycles, uint32_t step_cycles,
+                     uint32_t measure_s)
+{
+    static const tput_load_place_t places[] =
+                                    {TPUT_LOAD_INLINE, TPUT_LOAD_DEFERRED};
+    static const char * const place_names[] = {"inline", "deferred"};
+    tput_rx_totals_t start;
+    tput_rx_totals_t end;
+    uint32_t measure_ms = measure_s * 1000u;
+    /* Deferred load runs in rx_sink_task, which only sees packets when the
+     * RX ring is enabled */
+    uint32_t num_places = TPUT_RX_SINK_ENABLE ? 2u : 1u;
+
+    if ((0u == step_cycles) || (0u == measure_s) ||
+        !tput_get_rx_totals(&start))
+    {
+        return false;
+    }
+
+    printf("sweep,placement,cycles,cost_us,rx_kbps,rx_pkts_per_s,"
+           "consumed_kbps,consumed_pkts_per_s\n");
+    for (uint32_t place = 0; place < num_places; place++)
+    {
+        for (uint32_t cycles = 0; cycles <= max_cycles; cycles += step_cycles)
+        {
+            tput_load_set(places[place], cycles);
+            vTaskDelay(pdMS_TO_TICKS(TPUT_LOAD_SETTLE_MS));
+            if (!tput_get_rx_totals(&start))
+            {
+                tput_load_set(TPUT_LOAD_OFF, 0);
+                return false;
+            }
+            vTaskDelay(pdMS_TO_TICKS(measure_ms));
+            if (!tput_get_rx_totals(&end))
+            {
+                tput_load_set(TPUT_LOAD_OFF, 0);
+                return false;
+            }
+
+            printf("sweep,%s,%lu,%lu.%02lu,%lu,%lu,%lu,%lu\n",
+                   place_names[place], (unsigned long)cycles,
+                   (unsigned long)(cycles / tput_time_cycles_per_us()),
+                   (unsigned long)(((cycles % tput_time_cycles_per_us()) *
+                                    100u) / tput_time_cycles_per_us()),
+                   (unsigned long)(((end.rx_bytes - start.rx_bytes) * 8u) /
+                                   measure_ms),
+                   (unsigned long)((end.rx_pkts - start.rx_pkts) / measure_s),
+                   (unsigned long)(((end.consumed_bytes -
+                                     start.consumed_bytes) * 8u) / measure_ms),
+                   (unsigned long)((end.consumed_pkts - start.consumed_pkts) /
+                                   measure_s));
+        }
+    }
+    tput_load_set(TPUT_LOAD_OFF, 0);
+    return true;
+}
+
+/* [] END OF FILE */
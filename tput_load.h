@@ -0,0 +1,79 @@
+/*******************************************************************************
+ * File Name: tput_load.h
+ *
+ * Description: This file contains the declarations of the synthetic per-packet processing
+ *              load.
+ *
+ * Related Document: See README.md
+ *
+ *
+ *******************************************************************************
+ * Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ ******************************************************************************/
+
+#ifndef __TPUT_LOAD_H__
+#define __TPUT_LOAD_H__
+
+/******************************************************************************
+ *                                INCLUDES
+ ******************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+
+/******************************************************************************
+ *                                Macros
+ ******************************************************************************/
+/* Time each sweep step runs before and while it is measured */
+#define TPUT_LOAD_SETTLE_MS             (1000u)
+#define TPUT_LOAD_DEFAULT_MEASURE_S     (3u)
+
+/*******************************************************************************
+*        Structures and Enumerations
+*******************************************************************************/
+/* Where the load runs for each notification */
+typedef enum
+{
+    TPUT_LOAD_OFF,
+    TPUT_LOAD_INLINE,       // in the GATT callback, in the stack task
+    TPUT_LOAD_DEFERRED      // in rx_sink_task, on the payload in the RX ring
+} tput_load_place_t;
+
+/****************************************************************************
+ *                              FUNCTION DECLARATIONS
+ ***************************************************************************/
+void tput_load_set(tput_load_place_t place, uint32_t cycles);
+void tput_load_run(tput_load_place_t place);
+bool tput_load_sweep(uint32_t max_cycles, uint32_t step_cycles,
+                     uint32_t measure_s);
+
+#endif      /*__TPUT_LOAD_H__ */
+/* [] END OF FILE */
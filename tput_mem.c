@@ -0,0 +1,338 @@
+/*******************************************************************************
+ * File Name: tput_mem.c
+ *
+ * Description: This file contains the zero-heap mode: a static buffer pool for the
+ *              buffers passed to the Bluetooth stack, a check that asserts on heap
+ *              allocations while connected, and a RAM usage report.
+ *
+ * Related Document: See README.md
+ *
+ *
+ *******************************************************************************
+ * Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ ******************************************************************************/
+
+/******************************************************************************
+ *                                INCLUDES
+ ******************************************************************************/
+#include <stdio.h>
+#if defined(__GNUC__) && !defined(__ARMCC_VERSION)
+#include <malloc.h>
+#endif
+#include <FreeRTOS.h>
+#include <task.h>
+#include "cyhal.h"
+#include "tput_mem.h"
+
+/******************************************************************************
+ *                                Macros
+ ******************************************************************************/
+/* Number of tasks listed by the report */
+#define TPUT_MEM_MAX_TASKS              (24u)
+
+/* The section boundaries are only known with the GCC linker scripts */
+#if defined(__GNUC__) && !defined(__ARMCC_VERSION)
+#define TPUT_MEM_GCC_SECTIONS           (1)
+#else
+#define TPUT_MEM_GCC_SECTIONS           (0)
+#endif
+
+/*******************************************************************************
+*        Variable Definitions
+*******************************************************************************/
+#if TPUT_MEM_GCC_SECTIONS
+extern uint8_t __data_start__[];
+extern uint8_t __data_end__[];
+extern uint8_t __bss_start__[];
+extern uint8_t __bss_end__[];
+extern uint8_t __HeapBase[];
+extern uint8_t __HeapLimit[];
+extern uint8_t __StackLimit[];
+extern uint8_t __StackTop[];
+#endif
+
+#if TPUT_STATIC_ALLOC
+/* Word aligned, as the stack may copy from them in words */
+static uint32_t pool_blocks[TPUT_MEM_POOL_BLOCKS]
+                           [TPUT_MEM_POOL_BLOCK_SIZE / sizeof(uint32_t)];
+static bool pool_block_used[TPUT_MEM_POOL_BLOCKS];
+#endif
+static tput_mem_pool_stats_t pool_stats;
+
+/* Set while connected, heap allocations then trip an assert */
+static volatile bool heap_locked = false;
+/* Allocations made while locked, and the size of the last one, for builds
+ * without asserts or for the debugger */
+static volatile uint32_t locked_heap_allocs = 0;
+static volatile size_t locked_heap_alloc_size = 0;
+
+static TaskStatus_t report_tasks[TPUT_MEM_MAX_TASKS];
+
+/******************************************************************************
+ * Function Definitions
+ ******************************************************************************/
+
+/*******************************************************************************
+* Function Name: tput_mem_alloc()
+********************************************************************************
+* Summary:
+*   Allocates a buffer to be passed to the Bluetooth stack. With
+*   TPUT_STATIC_ALLOC, it is a block of the static pool, otherwise it is
+*   allocated from the heap.
+*
+* Parameters:
+*   uint32_t len : Size of the buffer
+*
+* Return:
+*   void * : Buffer, NULL if none is available
+*
+*******************************************************************************/
+void *tput_mem_alloc(uint32_t len)
+{
+#if TPUT_STATIC_ALLOC
+    void *p_buf = NULL;
+
+    taskENTER_CRITICAL();
+    if (len <= TPUT_MEM_POOL_BLOCK_SIZE)
+    {
+        for (uint32_t block = 0; block < TPUT_MEM_POOL_BLOCKS; block++)
+        {
+            if (!pool_block_used[block])
+            {
+                pool_block_used[block] = true;
+                p_buf = pool_blocks[block];
+                break;
+            }
+        }
+    }
+    if (NULL != p_buf)
+    {
+        pool_stats.blocks_used++;
+        if (pool_stats.blocks_used > pool_stats.max_blocks_used)
+        {
+            pool_stats.max_blocks_used = pool_stats.blocks_used;
+        }
+    }
+    else
+    {
+        pool_stats.alloc_failures++;
+    }
+    taskEXIT_CRITICAL();
+    return p_buf;
+#else
+    void *p_buf = pvPortMalloc(len);
+
+    if (NULL == p_buf)
+    {
+        pool_stats.alloc_failures++;
+    }
+    return p_buf;
+#endif
+}
+
+/*******************************************************************************
+* Function Name: tput_mem_free()
+********************************************************************************
+* Summary:
+*   Frees a buffer allocated with tput_mem_alloc(). NULL is ignored. With
+*   TPUT_STATIC_ALLOC, a pointer that is not the start of a pool block is
+*   counted in the statistics and ignored.
+*
+* Parameters:
+*   void *p_buf : Buffer, or NULL
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void tput_mem_free(void *p_buf)
+{
+#if TPUT_STATIC_ALLOC
+    uintptr_t offset;
+    uint32_t block;
+
+    if (NULL == p_buf)
+    {
+        return;
+    }
+    /* Below the pool, the offset wraps around to a large value */
+    offset = (uintptr_t)p_buf - (uintptr_t)pool_blocks;
+    block = (uint32_t)(offset / TPUT_MEM_POOL_BLOCK_SIZE);
+    if ((offset >= sizeof(pool_blocks)) ||
+        (0u != (offset % TPUT_MEM_POOL_BLOCK_SIZE)))
+    {
+        CY_ASSERT(0);
+        taskENTER_CRITICAL();
+        pool_stats.invalid_frees++;
+        taskEXIT_CRITICAL();
+        return;
+    }
+    taskENTER_CRITICAL();
+    if (pool_block_used[block])
+    {
+        pool_block_used[block] = false;
+        pool_stats.blocks_used--;
+    }
+    taskEXIT_CRITICAL();
+#else
+    vPortFree(p_buf);
+#endif
+}
+
+/*******************************************************************************
+* Function Name: tput_mem_get_pool_stats()
+********************************************************************************
+* Summary:
+*   Reads the buffer pool statistics. Without TPUT_STATIC_ALLOC, only the
+*   allocation failures are counted.
+*
+* Parameters:
+*   tput_mem_pool_stats_t *p_stats : Statistics read
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void tput_mem_get_pool_stats(tput_mem_pool_stats_t *p_stats)
+{
+    taskENTER_CRITICAL();
+    *p_stats = pool_stats;
+    taskEXIT_CRITICAL();
+}
+
+/*******************************************************************************
+* Function Name: tput_mem_heap_lock()
+********************************************************************************
+* Summary:
+*   Forbids or allows heap allocations. Locked on connection and unlocked on
+*   disconnection, so that the data path is checked to run without the heap.
+*   Only has an effect with TPUT_STATIC_ALLOC.
+*
+* Parameters:
+*   bool lock : true to forbid heap allocations
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void tput_mem_heap_lock(bool lock)
+{
+    heap_locked = lock;
+}
+
+/*******************************************************************************
+* Function Name: tput_mem_on_heap_alloc()
+********************************************************************************
+* Summary:
+*   Called by the traceMALLOC() hook in FreeRTOSConfig.h for every
+*   pvPortMalloc(), with the scheduler suspended. Asserts if the heap is
+*   locked.
+*
+* Parameters:
+*   size_t size : Size requested
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void tput_mem_on_heap_alloc(size_t size)
+{
+    if (heap_locked)
+    {
+        locked_heap_allocs++;
+        locked_heap_alloc_size = size;
+        CY_ASSERT(0);
+    }
+}
+
+/*******************************************************************************
+* Function Name: tput_mem_report()
+********************************************************************************
+* Summary:
+*   Prints the RAM used by the image sections, the heap and the buffer pool,
+*   and the unused stack of every task.
+*
+* Parameters:
+*   None
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void tput_mem_report(void)
+{
+    tput_mem_pool_stats_t stats;
+    uint32_t num_tasks;
+
+#if TPUT_MEM_GCC_SECTIONS
+    printf("RAM: data %lu, bss %lu, heap region %lu, main stack %lu bytes\n",
+           (unsigned long)(__data_end__ - __data_start__),
+           (unsigned long)(__bss_end__ - __bss_start__),
+           (unsigned long)(__HeapLimit - __HeapBase),
+           (unsigned long)(__StackTop - __StackLimit));
+    {
+        struct mallinfo heap_info = mallinfo();
+
+        printf("Heap: %lu bytes in use, %lu bytes taken from the heap "
+               "region\n", (unsigned long)heap_info.uordblks,
+               (unsigned long)heap_info.arena);
+    }
+#endif
+
+    tput_mem_get_pool_stats(&stats);
+#if TPUT_STATIC_ALLOC
+    printf("Buffer pool: %lu blocks of %lu bytes, %lu in use, %lu max, "
+           "%lu failures, %lu invalid frees\n",
+           (unsigned long)TPUT_MEM_POOL_BLOCKS,
+           (unsigned long)TPUT_MEM_POOL_BLOCK_SIZE,
+           (unsigned long)stats.blocks_used,
+           (unsigned long)stats.max_blocks_used,
+           (unsigned long)stats.alloc_failures,
+           (unsigned long)stats.invalid_frees);
+    printf("Heap allocations while connected: %lu\n",
+           (unsigned long)locked_heap_allocs);
+#else
+    printf("Buffer pool: not used, %lu heap allocation failures\n",
+           (unsigned long)stats.alloc_failures);
+#endif
+
+    num_tasks = uxTaskGetSystemState(report_tasks, TPUT_MEM_MAX_TASKS, NULL);
+    for (uint32_t task = 0; task < num_tasks; task++)
+    {
+        printf("Task %-16s %lu bytes of stack never used\n",
+               report_tasks[task].pcTaskName,
+               (unsigned long)(report_tasks[task].usStackHighWaterMark *
+                               sizeof(StackType_t)));
+    }
+}
+
+/* [] END OF FILE */
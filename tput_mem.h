@@ -0,0 +1,97 @@
+/*******************************************************************************
+ * File Name: tput_mem.h
+ *
+ * Description: This file contains the declarations of the static buffer pool and of the
+ *              heap checks of the zero-heap mode.
+ *
+ * Related Document: See README.md
+ *
+ *
+ *******************************************************************************
+ * Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ ******************************************************************************/
+
+#ifndef __TPUT_MEM_H__
+#define __TPUT_MEM_H__
+
+/******************************************************************************
+ *                                INCLUDES
+ ******************************************************************************/
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "tput_cwnd.h"
+
+/******************************************************************************
+ *                                Macros
+ ******************************************************************************/
+/* Set to 1 to allocate the application tasks and the buffers passed to the
+ * Bluetooth stack statically, and to assert on any heap allocation while
+ * connected. The heap allocation hook in FreeRTOSConfig.h also checks this
+ * macro, so it must be set for the whole build, with
+ * DEFINES+=TPUT_STATIC_ALLOC=1 in the Makefile */
+#ifndef TPUT_STATIC_ALLOC
+#define TPUT_STATIC_ALLOC               (0)
+#endif
+
+/* Buffer pool used instead of the heap when TPUT_STATIC_ALLOC is set. A
+ * block holds the largest attribute value (CY_BT_MTU_SIZE in design.cybt).
+ * One block is needed per GATT write in flight, plus a few for the CCCD
+ * write and the response buffers */
+#define TPUT_MEM_POOL_BLOCK_SIZE        (512u)
+#define TPUT_MEM_POOL_BLOCKS            (TPUT_CWND_MAX_PKTS + 4u)
+
+/*******************************************************************************
+*        Structures and Enumerations
+*******************************************************************************/
+typedef struct
+{
+    uint32_t blocks_used;       // blocks currently allocated
+    uint32_t max_blocks_used;   // largest number allocated at the same time
+    uint32_t alloc_failures;    // requests that found no free block or were
+                                // larger than a block
+    uint32_t invalid_frees;     // frees of pointers that are not the start
+                                // of a pool block, ignored
+} tput_mem_pool_stats_t;
+
+/****************************************************************************
+ *                              FUNCTION DECLARATIONS
+ ***************************************************************************/
+void *tput_mem_alloc(uint32_t len);
+void  tput_mem_free(void *p_buf);
+void  tput_mem_get_pool_stats(tput_mem_pool_stats_t *p_stats);
+void  tput_mem_heap_lock(bool lock);
+void  tput_mem_on_heap_alloc(size_t size);
+void  tput_mem_report(void);
+
+#endif      /*__TPUT_MEM_H__ */
+/* [] END OF FILE */
@@ -0,0 +1,317 @@
+/*******************************************************************************
+ * File Name: tput_model.c
+ *
+ * Description: This file contains a model of the theoretical maximum GATT throughput of
+ *              a link, from its connection interval, PHY, data length, MTU and packet size.
+ *              It has no platform dependencies.
+ *
+ * Related Document: See README.md
+ *
+ *
+ *******************************************************************************
+ * Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ ******************************************************************************/
+
+/******************************************************************************
+ *                                INCLUDES
+ ******************************************************************************/
+#include <stddef.h>
+#include "tput_model.h"
+
+/******************************************************************************
+ *                                Macros
+ ******************************************************************************/
+/* Inter frame space between the PDUs of a connection event */
+#define T_IFS_US                        (150u)
+/* ATT opcode and handle of a write command or a notification */
+#define ATT_PDU_HDR_LEN                 (3u)
+/* L2CAP basic header: length and channel ID */
+#define L2CAP_HDR_LEN                   (4u)
+/* LL data PDU header, CRC and, on encrypted links, MIC */
+#define LL_HDR_LEN                      (2u)
+#define LL_CRC_LEN                      (3u)
+#define LL_MIC_LEN                      (4u)
+#define LL_ACCESS_ADDR_LEN              (4u)
+/* Coded PHY: 80 us preamble, then the access address, coding indicator and
+ * TERM1 (37 bits) always coded with S=8, then the PDU, CRC and TERM2 coded
+ * with S=2 or S=8 */
+#define CODED_PREAMBLE_US               (80u)
+#define CODED_FEC1_BITS                 (37u)
+#define CODED_TERM2_BITS                (3u)
+/* Shortest PDU time a controller may use on the Coded PHY, the time of a
+ * 27 byte payload with a MIC at S=8 */
+#define CODED_MIN_TIME_US               (2704u)
+
+/******************************************************************************
+ * Function Definitions
+ ******************************************************************************/
+
+/*******************************************************************************
+* Function Name: tput_model_pdu_time_us()
+********************************************************************************
+* Summary:
+*   Computes the air time of an LL data PDU.
+*
+* Parameters:
+*   tput_model_phy_t phy : PHY the PDU is sent on
+*   uint16_t payload_len : LL payload length, including the MIC if any.
+*                          0 for an empty PDU
+*
+* Return:
+*   uint32_t : Air time in microseconds
+*
+*******************************************************************************/
+uint32_t tput_model_pdu_time_us(tput_model_phy_t phy, uint16_t payload_len)
+{
+    uint32_t pdu_len = LL_HDR_LEN + payload_len + LL_CRC_LEN;
+
+    switch (phy)
+    {
+    case TPUT_MODEL_PHY_2M:
+        /* 2 byte preamble, 4 us per byte */
+        return (2u + LL_ACCESS_ADDR_LEN + pdu_len) * 4u;
+
+    case TPUT_MODEL_PHY_CODED_S8:
+        return CODED_PREAMBLE_US + (CODED_FEC1_BITS * 8u) +
+               (((pdu_len * 8u) + CODED_TERM2_BITS) * 8u);
+
+    case TPUT_MODEL_PHY_CODED_S2:
+        return CODED_PREAMBLE_US + (CODED_FEC1_BITS * 8u) +
+               (((pdu_len * 8u) + CODED_TERM2_BITS) * 2u);
+
+    case TPUT_MODEL_PHY_1M:
+    default:
+        /* 1 byte preamble, 8 us per byte */
+        return (1u + LL_ACCESS_ADDR_LEN + pdu_len) * 8u;
+    }
+}
+
+/*******************************************************************************
+* Function Name: tput_model_time_octets()
+********************************************************************************
+* Summary:
+*   Computes the largest LL payload whose PDU lasts at most the negotiated
+*   PDU time, the inverse of tput_model_pdu_time_us(). On the Coded PHY the
+*   controller uses at least CODED_MIN_TIME_US.
+*
+* Parameters:
+*   tput_model_phy_t phy : PHY the PDU is sent on
+*   uint16_t time_us     : Negotiated PDU time, 0 if not known yet
+*   uint32_t mic_len     : Length of the MIC, 0 on unencrypted links
+*
+* Return:
+*   uint32_t : Largest LL payload without the MIC, at least 1 byte
+*
+*******************************************************************************/
+static uint32_t tput_model_time_octets(tput_model_phy_t phy, uint16_t time_us,
+                                       uint32_t mic_len)
+{
+    uint32_t time = time_us ? time_us : TPUT_MODEL_DEFAULT_TIME_US;
+    uint32_t pdu_len;
+
+    switch (phy)
+    {
+    case TPUT_MODEL_PHY_2M:
+        pdu_len = time / 4u;
+        pdu_len = (pdu_len > 2u + LL_ACCESS_ADDR_LEN) ?
+                  (pdu_len - 2u - LL_ACCESS_ADDR_LEN) : 0u;
+        break;
+
+    case TPUT_MODEL_PHY_CODED_S8:
+    case TPUT_MODEL_PHY_CODED_S2:
+        time = (time > CODED_MIN_TIME_US) ? time : CODED_MIN_TIME_US;
+        time -= CODED_PREAMBLE_US + (CODED_FEC1_BITS * 8u);
+        time /= (TPUT_MODEL_PHY_CODED_S8 == phy) ? 8u : 2u;
+        pdu_len = (time - CODED_TERM2_BITS) / 8u;
+        break;
+
+    case TPUT_MODEL_PHY_1M:
+    default:
+        pdu_len = time / 8u;
+        pdu_len = (pdu_len > 1u + LL_ACCESS_ADDR_LEN) ?
+                  (pdu_len - 1u - LL_ACCESS_ADDR_LEN) : 0u;
+        break;
+    }
+
+    if (pdu_len <= LL_HDR_LEN + LL_CRC_LEN + mic_len)
+    {
+        return 1u;
+    }
+    return pdu_len - LL_HDR_LEN - LL_CRC_LEN - mic_len;
+}
+
+/*******************************************************************************
+* Function Name: tput_model_frags_time_us()
+********************************************************************************
+* Summary:
+*   Computes the air time of the LL PDUs carrying one L2CAP packet.
+*
+* Parameters:
+*   tput_model_phy_t phy  : PHY the PDUs are sent on
+*   uint32_t l2cap_len    : Length of the L2CAP packet, with its header
+*   uint16_t max_octets   : Largest LL payload
+*   uint32_t mic_len      : Length of the MIC, 0 on unencrypted links
+*   uint32_t *p_frags     : Number of LL PDUs
+*
+* Return:
+*   uint32_t : Air time in microseconds
+*
+*******************************************************************************/
+static uint32_t tput_model_frags_time_us(tput_model_phy_t phy,
+                                         uint32_t l2cap_len,
+                                         uint16_t max_octets,
+                                         uint32_t mic_len,
+                                         uint32_t *p_frags)
+{
+    uint32_t full_frags = l2cap_len / max_octets;
+    uint32_t last_len = l2cap_len % max_octets;
+    uint32_t time_us;
+
+    time_us = full_frags * tput_model_pdu_time_us(phy, max_octets + mic_len);
+    *p_frags = full_frags;
+    if (last_len)
+    {
+        time_us += tput_model_pdu_time_us(phy, last_len + mic_len);
+        (*p_frags)++;
+    }
+    return time_us;
+}
+
+/*******************************************************************************
+* Function Name: tput_model_compute()
+********************************************************************************
+* Summary:
+*   Computes the highest GATT throughput a link can carry. Each GATT packet
+*   is an ATT PDU in an L2CAP packet, split into LL PDUs of up to the
+*   negotiated data length and of the payload that fits the negotiated PDU
+*   time on the PHY. Every LL PDU is answered by the peer, with an
+*   empty PDU if it has no data, and PDUs are separated by T_IFS. A
+*   connection event is assumed to last for the full connection interval,
+*   so the result is an upper bound that controllers do not reach when
+*   they end events early.
+*
+*   In TPUT_MODEL_DIR_BOTH, each exchange carries data in both directions
+*   and the result applies to each direction.
+*
+* Parameters:
+*   const tput_model_link_t *p_link : Link parameters
+*   tput_model_dir_t dir            : Direction of the traffic
+*   tput_model_result_t *p_result   : Result, zeroed if the link parameters
+*                                     are not known yet
+*
+* Return:
+*   bool : false if the link parameters are incomplete or inconsistent
+*
+*******************************************************************************/
+bool tput_model_compute(const tput_model_link_t *p_link,
+                        tput_model_dir_t dir,
+                        tput_model_result_t *p_result)
+{
+    uint32_t l2cap_len = p_link->packet_size + ATT_PDU_HDR_LEN + L2CAP_HDR_LEN;
+    uint32_t mic_len = p_link->encrypted ? LL_MIC_LEN : 0u;
+    uint16_t max_tx_octets = p_link->max_tx_octets ? p_link->max_tx_octets :
+                                                     TPUT_MODEL_DEFAULT_OCTETS;
+    uint16_t max_rx_octets = p_link->max_rx_octets ? p_link->max_rx_octets :
+                                                     TPUT_MODEL_DEFAULT_OCTETS;
+    uint32_t time_octets;
+    uint32_t tx_frags = 0;
+    uint32_t rx_frags = 0;
+    uint32_t tx_time_us = 0;
+    uint32_t rx_time_us = 0;
+    uint32_t exchanges;
+    uint32_t exchanges_per_event;
+
+    p_result->frags_per_pkt = 0;
+    p_result->exchanges_per_event = 0;
+    p_result->pkts_per_event = 0;
+    p_result->pkt_time_us = 0;
+    p_result->ceiling_kbps = 0;
+
+    if ((0u == p_link->conn_interval_us) || (0u == p_link->packet_size) ||
+        (p_link->packet_size + ATT_PDU_HDR_LEN > p_link->mtu))
+    {
+        return false;
+    }
+
+    /* The controller also limits PDUs by time, which matters on the Coded
+     * PHY where 251 bytes take up to 17 ms */
+    time_octets = tput_model_time_octets(p_link->tx_phy,
+                                         p_link->max_tx_time_us, mic_len);
+    if (time_octets < max_tx_octets)
+    {
+        max_tx_octets = (uint16_t)time_octets;
+    }
+    time_octets = tput_model_time_octets(p_link->rx_phy,
+                                         p_link->max_rx_time_us, mic_len);
+    if (time_octets < max_rx_octets)
+    {
+        max_rx_octets = (uint16_t)time_octets;
+    }
+
+    if (TPUT_MODEL_DIR_RX != dir)
+    {
+        tx_time_us = tput_model_frags_time_us(p_link->tx_phy, l2cap_len,
+                                              max_tx_octets, mic_len,
+                                              &tx_frags);
+    }
+    if (TPUT_MODEL_DIR_TX != dir)
+    {
+        rx_time_us = tput_model_frags_time_us(p_link->rx_phy, l2cap_len,
+                                              max_rx_octets, mic_len,
+                                              &rx_frags);
+    }
+
+    /* Exchanges without data in one direction carry an empty PDU there */
+    exchanges = (tx_frags > rx_frags) ? tx_frags : rx_frags;
+    tx_time_us += (exchanges - tx_frags) *
+                  tput_model_pdu_time_us(p_link->tx_phy, 0);
+    rx_time_us += (exchanges - rx_frags) *
+                  tput_model_pdu_time_us(p_link->rx_phy, 0);
+
+    p_result->frags_per_pkt = (uint16_t)exchanges;
+    p_result->pkt_time_us = tx_time_us + rx_time_us + (exchanges * 2u * T_IFS_US);
+
+    /* Fragments of a packet may be sent in different connection events */
+    exchanges_per_event = (uint32_t)(((uint64_t)p_link->conn_interval_us *
+                                      exchanges) / p_result->pkt_time_us);
+    p_result->exchanges_per_event = (uint16_t)exchanges_per_event;
+    p_result->pkts_per_event = (uint16_t)(exchanges_per_event / exchanges);
+
+    /* bits per millisecond is kbps */
+    p_result->ceiling_kbps = (uint32_t)(((uint64_t)exchanges_per_event *
+                                         p_link->packet_size * 8u * 1000u) /
+                                        ((uint64_t)exchanges *
+                                         p_link->conn_interval_us));
+    return true;
+}
+
+/* [] END OF FILE */
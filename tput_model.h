@@ -0,0 +1,112 @@
+/*******************************************************************************
+ * File Name: tput_model.h
+ *
+ * Description: This file contains the declarations of the model of the theoretical
+ *              maximum GATT throughput of a link.
+ *
+ * Related Document: See README.md
+ *
+ *
+ *******************************************************************************
+ * Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ ******************************************************************************/
+
+#ifndef __TPUT_MODEL_H__
+#define __TPUT_MODEL_H__
+
+/******************************************************************************
+ *                                INCLUDES
+ ******************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+
+/******************************************************************************
+ *                                Macros
+ ******************************************************************************/
+/* LL payload length and PDU time without Data Length Extension */
+#define TPUT_MODEL_DEFAULT_OCTETS       (27u)
+#define TPUT_MODEL_DEFAULT_TIME_US      (328u)
+
+/*******************************************************************************
+*        Structures and Enumerations
+*******************************************************************************/
+/* PHYs, 1M, 2M and Coded use the values of the HCI LE PHY Update Complete
+ * event, which does not tell the coding of the Coded PHY */
+typedef enum
+{
+    TPUT_MODEL_PHY_1M = 1,
+    TPUT_MODEL_PHY_2M = 2,
+    TPUT_MODEL_PHY_CODED_S8 = 3,
+    TPUT_MODEL_PHY_CODED_S2 = 4
+} tput_model_phy_t;
+
+/* Direction of the GATT traffic */
+typedef enum
+{
+    TPUT_MODEL_DIR_TX,          // GATT write commands from the client
+    TPUT_MODEL_DIR_RX,          // notifications from the server
+    TPUT_MODEL_DIR_BOTH         // both at the same time
+} tput_model_dir_t;
+
+typedef struct
+{
+    uint32_t conn_interval_us;  // connection interval
+    tput_model_phy_t tx_phy;
+    tput_model_phy_t rx_phy;
+    uint16_t max_tx_octets;     // LL payload length negotiated with DLE
+    uint16_t max_rx_octets;
+    uint16_t max_tx_time_us;    // LL PDU air time negotiated with DLE
+    uint16_t max_rx_time_us;
+    uint16_t mtu;               // ATT MTU
+    uint16_t packet_size;       // ATT value length of writes and notifications
+    bool encrypted;             // adds a MIC to every non-empty LL PDU
+} tput_model_link_t;
+
+typedef struct
+{
+    uint16_t frags_per_pkt;     // LL PDUs per GATT packet
+    uint16_t exchanges_per_event; // LL PDU exchanges per connection event
+    uint16_t pkts_per_event;    // complete GATT packets per connection event
+    uint32_t pkt_time_us;       // air time of one GATT packet, with ACKs
+    uint32_t ceiling_kbps;      // GATT payload throughput per direction
+} tput_model_result_t;
+
+/****************************************************************************
+ *                              FUNCTION DECLARATIONS
+ ***************************************************************************/
+uint32_t tput_model_pdu_time_us(tput_model_phy_t phy, uint16_t payload_len);
+bool     tput_model_compute(const tput_model_link_t *p_link,
+                            tput_model_dir_t dir,
+                            tput_model_result_t *p_result);
+
+#endif      /*__TPUT_MODEL_H__ */
+/* [] END OF FILE */
@@ -0,0 +1,252 @@
+/*******************************************************************************
+ * File Name: tput_phy.c
+ *
+ * Description: This file accumulates the throughput measured every second separately
+ *              for each PHY, 1M, 2M, and Coded with S2 and S8 coding, to compare the
+ *              range and throughput trade-off of the PHYs.
+ *
+ * Related Document: See README.md
+ *
+ *
+ *******************************************************************************
+ * Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ ******************************************************************************/
+
+/******************************************************************************
+ *                                INCLUDES
+ ******************************************************************************/
+#include <stdio.h>
+#include <string.h>
+#include <FreeRTOS.h>
+#include <task.h>
+#include "tput_phy.h"
+
+/*******************************************************************************
+*        Macros
+*******************************************************************************/
+/* tput_model_phy_t values are 1 to TPUT_PHY_MAX */
+#define TPUT_PHY_MAX                    (TPUT_MODEL_PHY_CODED_S2)
+
+/*******************************************************************************
+*        Function Prototypes
+*******************************************************************************/
+static void tput_phy_dir_sample(tput_phy_dir_stats_t *p_dir, uint32_t kbps);
+
+/*******************************************************************************
+*        Variable Definitions
+*******************************************************************************/
+static tput_phy_stats_t stats[TPUT_PHY_MAX];
+
+static const char * const phy_names[TPUT_PHY_MAX] =
+{
+    [TPUT_MODEL_PHY_1M - 1]       = "1M",
+    [TPUT_MODEL_PHY_2M - 1]       = "2M",
+    [TPUT_MODEL_PHY_CODED_S8 - 1] = "Coded S8",
+    [TPUT_MODEL_PHY_CODED_S2 - 1] = "Coded S2",
+};
+
+/******************************************************************************
+ * Function Definitions
+ ******************************************************************************/
+
+/*******************************************************************************
+* Function Name: tput_phy_name()
+********************************************************************************
+* Summary:
+*   Gets the name of a PHY.
+*
+* Parameters:
+*   tput_model_phy_t phy : PHY
+*
+* Return:
+*   const char * : Name, "?" if the PHY is unknown
+*
+*******************************************************************************/
+const char *tput_phy_name(tput_model_phy_t phy)
+{
+    if ((phy < TPUT_MODEL_PHY_1M) || (phy > TPUT_PHY_MAX))
+    {
+        return "?";
+    }
+    return phy_names[phy - 1];
+}
+
+/*******************************************************************************
+* Function Name: tput_phy_sample()
+********************************************************************************
+* Summary:
+*   Adds the throughput of one second to the statistics of the PHY of each
+*   direction. Directions without data in that second are left out.
+*
+* Parameters:
+*   tput_model_phy_t rx_phy : PHY the server transmits on
+*   uint32_t rx_kbps        : Throughput received
+*   tput_model_phy_t tx_phy : PHY the client transmits on
+*   uint32_t tx_kbps        : Throughput written
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void tput_phy_sample(tput_model_phy_t rx_phy, uint32_t rx_kbps,
+                     tput_model_phy_t tx_phy, uint32_t tx_kbps)
+{
+    taskENTER_CRITICAL();
+    if (rx_kbps && (rx_phy >= TPUT_MODEL_PHY_1M) && (rx_phy <= TPUT_PHY_MAX))
+    {
+        tput_phy_dir_sample(&stats[rx_phy - 1].rx, rx_kbps);
+    }
+    if (tx_kbps && (tx_phy >= TPUT_MODEL_PHY_1M) && (tx_phy <= TPUT_PHY_MAX))
+    {
+        tput_phy_dir_sample(&stats[tx_phy - 1].tx, tx_kbps);
+    }
+    taskEXIT_CRITICAL();
+}
+
+/*******************************************************************************
+* Function Name: tput_phy_get_stats()
+********************************************************************************
+* Summary:
+*   Reads the statistics of a PHY.
+*
+* Parameters:
+*   tput_model_phy_t phy      : PHY
+*   tput_phy_stats_t *p_stats : Statistics read
+*
+* Return:
+*   bool : false if the PHY is unknown
+*
+*******************************************************************************/
+bool tput_phy_get_stats(tput_model_phy_t phy, tput_phy_stats_t *p_stats)
+{
+    if ((phy < TPUT_MODEL_PHY_1M) || (phy > TPUT_PHY_MAX))
+    {
+        return false;
+    }
+    taskENTER_CRITICAL();
+    *p_stats = stats[phy - 1];
+    taskEXIT_CRITICAL();
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: tput_phy_clear_stats()
+********************************************************************************
+* Summary:
+*   Clears the statistics of all PHYs.
+*
+* Parameters:
+*   None
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void tput_phy_clear_stats(void)
+{
+    taskENTER_CRITICAL();
+    memset(stats, 0, sizeof(stats));
+    taskEXIT_CRITICAL();
+}
+
+/*******************************************************************************
+* Function Name: tput_phy_print()
+********************************************************************************
+* Summary:
+*   Prints the average, minimum and maximum throughput of each direction on
+*   each PHY, over the seconds data flowed on it.
+*
+* Parameters:
+*   None
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void tput_phy_print(void)
+{
+    tput_phy_stats_t phy_stats;
+    const tput_phy_dir_stats_t *p_dir;
+    uint32_t phy;
+    uint32_t dir;
+
+    printf("PHY       Dir  Seconds  Avg kbps  Min kbps  Max kbps\n");
+    for (phy = TPUT_MODEL_PHY_1M; phy <= TPUT_PHY_MAX; phy++)
+    {
+        tput_phy_get_stats((tput_model_phy_t)phy, &phy_stats);
+        for (dir = 0; dir < 2u; dir++)
+        {
+            p_dir = (0u == dir) ? &phy_stats.rx : &phy_stats.tx;
+            if (0u == p_dir->seconds)
+            {
+                continue;
+            }
+            printf("%-9s %-4s %7lu  %8lu  %8lu  %8lu\n",
+                   tput_phy_name((tput_model_phy_t)phy),
+                   (0u == dir) ? "RX" : "TX",
+                   (unsigned long)p_dir->seconds,
+                   (unsigned long)(p_dir->kbps_sum / p_dir->seconds),
+                   (unsigned long)p_dir->kbps_min,
+                   (unsigned long)p_dir->kbps_max);
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: tput_phy_dir_sample()
+********************************************************************************
+* Summary:
+*   Adds the throughput of one second to the statistics of one direction.
+*
+* Parameters:
+*   tput_phy_dir_stats_t *p_dir : Statistics updated
+*   uint32_t kbps               : Throughput
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+static void tput_phy_dir_sample(tput_phy_dir_stats_t *p_dir, uint32_t kbps)
+{
+    if ((0u == p_dir->seconds) || (kbps < p_dir->kbps_min))
+    {
+        p_dir->kbps_min = kbps;
+    }
+    if (kbps > p_dir->kbps_max)
+    {
+        p_dir->kbps_max = kbps;
+    }
+    p_dir->kbps_sum += kbps;
+    p_dir->seconds++;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,82 @@
+/*******************************************************************************
+ * File Name: tput_phy.h
+ *
+ * Description: This file contains the declarations of the throughput statistics per PHY.
+ *
+ * Related Document: See README.md
+ *
+ *
+ *******************************************************************************
+ * Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ ******************************************************************************/
+
+#ifndef __TPUT_PHY_H__
+#define __TPUT_PHY_H__
+
+/******************************************************************************
+ *                                INCLUDES
+ ******************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include "tput_model.h"
+
+/*******************************************************************************
+*        Structures and Enumerations
+*******************************************************************************/
+/* Throughput of one direction on one PHY. Only the seconds in which data
+ * flowed are counted */
+typedef struct
+{
+    uint32_t seconds;
+    uint32_t kbps_sum;
+    uint32_t kbps_min;
+    uint32_t kbps_max;
+} tput_phy_dir_stats_t;
+
+typedef struct
+{
+    tput_phy_dir_stats_t rx;
+    tput_phy_dir_stats_t tx;
+} tput_phy_stats_t;
+
+/****************************************************************************
+ *                              FUNCTION DECLARATIONS
+ ***************************************************************************/
+const char *tput_phy_name(tput_model_phy_t phy);
+void tput_phy_sample(tput_model_phy_t rx_phy, uint32_t rx_kbps,
+                     tput_model_phy_t tx_phy, uint32_t tx_kbps);
+bool tput_phy_get_stats(tput_model_phy_t phy, tput_phy_stats_t *p_stats);
+void tput_phy_clear_stats(void);
+void tput_phy_print(void);
+
+#endif      /*__TPUT_PHY_H__ */
+/* [] END OF FILE */
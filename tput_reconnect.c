@@ -0,0 +1,508 @@
+/*******************************************************************************
+ * File Name: tput_reconnect.c
+ *
+ * Description: This file reconnects to the last server when the link is lost, with
+ *              exponential backoff, and resumes the data transfer mode.
+ *
+ * Related Document: See README.md
+ *
+ *
+ *******************************************************************************
+ * Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ ******************************************************************************/
+
+/******************************************************************************
+ *                                INCLUDES
+ ******************************************************************************/
+#include <stdio.h>
+#include <string.h>
+#include <FreeRTOS.h>
+#include <task.h>
+#include "wiced_bt_gatt.h"
+#include "ble_client.h"
+#include "tput_reconnect.h"
+
+/*******************************************************************************
+*        Structures and Enumerations
+*******************************************************************************/
+typedef enum
+{
+    TPUT_RECONNECT_IDLE,        // connected, or no link to recover
+    TPUT_RECONNECT_BACKOFF,     // waiting before the next attempt
+    TPUT_RECONNECT_CONNECTING,  // attempt in progress
+    TPUT_RECONNECT_RESUMING     // reconnected, waiting for the first byte
+} tput_reconnect_state_t;
+
+/*******************************************************************************
+*        Function Prototypes
+*******************************************************************************/
+static uint32_t tput_reconnect_elapsed_ms(TickType_t since);
+static void tput_reconnect_recovered(void);
+
+/*******************************************************************************
+*        Variable Definitions
+*******************************************************************************/
+static volatile bool enabled = true;
+static volatile tput_reconnect_state_t state = TPUT_RECONNECT_IDLE;
+/* Last server connected to */
+static wiced_bt_device_address_t peer_addr;
+static wiced_bt_ble_address_type_t peer_addr_type;
+static bool peer_valid = false;
+/* Data transfer mode running on the link, resumed after reconnecting */
+static tput_mode_t session_mode;
+static bool session_mode_valid = false;
+static bool resume_pending = false;
+/* Current outage */
+static TickType_t outage_start;
+static TickType_t state_start;
+static uint32_t backoff_ms = TPUT_RECONNECT_INITIAL_BACKOFF_MS;
+static uint32_t attempt = 0;
+static uint32_t outage_rate_bytes_per_s = 0;
+static tput_reconnect_stats_t stats = {0};
+
+/******************************************************************************
+ * Function Definitions
+ ******************************************************************************/
+
+/*******************************************************************************
+* Function Name: tput_reconnect_enable()
+********************************************************************************
+* Summary:
+*   Enables or disables reconnecting after a link loss. Disabling stops a
+*   recovery in progress.
+*
+* Parameters:
+*   bool on : true to reconnect automatically
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void tput_reconnect_enable(bool on)
+{
+    enabled = on;
+    if (!on)
+    {
+        bool attempting = (TPUT_RECONNECT_BACKOFF == state) ||
+                          (TPUT_RECONNECT_CONNECTING == state);
+
+        tput_reconnect_cancel();
+        if (attempting)
+        {
+            printf("Press user button on your kit to start scanning.....\n");
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: tput_reconnect_is_enabled()
+********************************************************************************
+* Summary:
+*   Tells if the link is recovered automatically.
+*
+* Parameters:
+*   None
+*
+* Return:
+*   bool : true if enabled
+*
+*******************************************************************************/
+bool tput_reconnect_is_enabled(void)
+{
+    return enabled;
+}
+
+/*******************************************************************************
+* Function Name: tput_reconnect_on_connected()
+********************************************************************************
+* Summary:
+*   Called from the GATT callback on connection. Remembers the server for a
+*   later recovery. If the connection ends an outage, the data transfer
+*   mode of the lost link is resumed once the service is discovered, see
+*   tput_reconnect_get_resume_mode().
+*
+* Parameters:
+*   const uint8_t *p_bd_addr : Address of the server
+*   uint8_t addr_type        : Address type of the server
+*
+* Return:
+*   bool : true if the connection recovers a lost link
+*
+*******************************************************************************/
+bool tput_reconnect_on_connected(const uint8_t *p_bd_addr, uint8_t addr_type)
+{
+    bool recovering;
+
+    taskENTER_CRITICAL();
+    recovering = (TPUT_RECONNECT_IDLE != state) &&
+                 (0 == memcmp(peer_addr, p_bd_addr, BD_ADDR_LEN));
+    if (!recovering)
+    {
+        /* New session, possibly with another server */
+        state = TPUT_RECONNECT_IDLE;
+        session_mode_valid = false;
+    }
+    memcpy(peer_addr, p_bd_addr, BD_ADDR_LEN);
+    peer_addr_type = (wiced_bt_ble_address_type_t)addr_type;
+    peer_valid = true;
+    resume_pending = recovering && session_mode_valid;
+    taskEXIT_CRITICAL();
+
+    if (recovering)
+    {
+        stats.outages++;
+        printf("Reconnected after %lu ms, %lu attempts\n",
+               (unsigned long)tput_reconnect_elapsed_ms(outage_start),
+               (unsigned long)attempt);
+        if (resume_pending)
+        {
+            state = TPUT_RECONNECT_RESUMING;
+        }
+        else
+        {
+            /* No data transfer mode to resume */
+            tput_reconnect_recovered();
+        }
+    }
+    return recovering;
+}
+
+/*******************************************************************************
+* Function Name: tput_reconnect_on_disconnected()
+********************************************************************************
+* Summary:
+*   Called from the GATT callback on disconnection, and when a connection
+*   attempt fails. Starts a recovery unless the link was closed locally, or
+*   continues the recovery in progress. The caller then wakes the task
+*   calling tput_reconnect_poll().
+*
+* Parameters:
+*   uint8_t reason            : Disconnection reason
+*   uint32_t lost_bytes       : Bytes written but not transmitted
+*   uint32_t rate_bytes_per_s : Throughput before the loss, both directions
+*
+* Return:
+*   bool : true if reconnecting
+*
+*******************************************************************************/
+bool tput_reconnect_on_disconnected(uint8_t reason, uint32_t lost_bytes,
+                                    uint32_t rate_bytes_per_s)
+{
+    if (!enabled || !peer_valid ||
+        (GATT_CONN_TERMINATE_LOCAL_HOST == reason))
+    {
+        tput_reconnect_cancel();
+        return false;
+    }
+
+    taskENTER_CRITICAL();
+    if (TPUT_RECONNECT_IDLE == state)
+    {
+        /* New outage */
+        outage_start = xTaskGetTickCount();
+        backoff_ms = TPUT_RECONNECT_INITIAL_BACKOFF_MS;
+        attempt = 0;
+        outage_rate_bytes_per_s = rate_bytes_per_s;
+        stats.last_lost_bytes = 0;
+    }
+    stats.last_lost_bytes += lost_bytes;
+    /* An attempt that failed, or a link lost again before resuming, backs
+     * off as a failed attempt does */
+    state = TPUT_RECONNECT_BACKOFF;
+    state_start = xTaskGetTickCount();
+    taskEXIT_CRITICAL();
+
+    if (0u == attempt)
+    {
+        printf("Link lost, reconnecting\n");
+    }
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: tput_reconnect_save_mode()
+********************************************************************************
+* Summary:
+*   Remembers the data transfer mode started on the link, to resume it after
+*   a link loss.
+*
+* Parameters:
+*   tput_mode_t mode : Data transfer mode
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void tput_reconnect_save_mode(tput_mode_t mode)
+{
+    session_mode = mode;
+    session_mode_valid = true;
+}
+
+/*******************************************************************************
+* Function Name: tput_reconnect_get_resume_mode()
+********************************************************************************
+* Summary:
+*   Reads the data transfer mode to resume, once per recovery. Called when
+*   the service is discovered.
+*
+* Parameters:
+*   tput_mode_t *p_mode : Mode to resume
+*
+* Return:
+*   bool : true if a mode is to be resumed
+*
+*******************************************************************************/
+bool tput_reconnect_get_resume_mode(tput_mode_t *p_mode)
+{
+    if (!resume_pending)
+    {
+        return false;
+    }
+    resume_pending = false;
+    *p_mode = session_mode;
+    printf("Resuming data transfer mode %u\n", session_mode + 1u);
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: tput_reconnect_on_first_byte()
+********************************************************************************
+* Summary:
+*   Called when the first payload byte is sent or received on a connection.
+*   Ends the recovery in progress.
+*
+* Parameters:
+*   None
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void tput_reconnect_on_first_byte(void)
+{
+    if (TPUT_RECONNECT_RESUMING == state)
+    {
+        tput_reconnect_recovered();
+    }
+}
+
+/*******************************************************************************
+* Function Name: tput_reconnect_poll()
+********************************************************************************
+* Summary:
+*   Runs the reconnection attempts. Each attempt connects directly to the
+*   last server and is cancelled after TPUT_RECONNECT_ATTEMPT_MS. After
+*   TPUT_RECONNECT_MAX_ATTEMPTS attempts, the recovery is given up.
+*
+* Parameters:
+*   None
+*
+* Return:
+*   uint32_t : Time in ms until the next call, 0 if nothing is pending
+*
+*******************************************************************************/
+uint32_t tput_reconnect_poll(void)
+{
+    uint32_t elapsed_ms = tput_reconnect_elapsed_ms(state_start);
+
+    switch (state)
+    {
+    case TPUT_RECONNECT_BACKOFF:
+        if (elapsed_ms < backoff_ms)
+        {
+            return backoff_ms - elapsed_ms;
+        }
+        if (attempt >= TPUT_RECONNECT_MAX_ATTEMPTS)
+        {
+            printf("Reconnection given up after %lu attempts\n",
+                   (unsigned long)attempt);
+            stats.given_up++;
+            tput_reconnect_cancel();
+            printf("Press user button on your kit to start scanning.....\n");
+            return 0u;
+        }
+        attempt++;
+        stats.attempts++;
+        backoff_ms = (backoff_ms * 2u < TPUT_RECONNECT_MAX_BACKOFF_MS) ?
+                     backoff_ms * 2u : TPUT_RECONNECT_MAX_BACKOFF_MS;
+        state_start = xTaskGetTickCount();
+        state = TPUT_RECONNECT_CONNECTING;
+        if (!tput_connect(peer_addr, peer_addr_type))
+        {
+            state = TPUT_RECONNECT_BACKOFF;
+            return backoff_ms;
+        }
+        return TPUT_RECONNECT_ATTEMPT_MS;
+
+    case TPUT_RECONNECT_CONNECTING:
+        if (elapsed_ms < TPUT_RECONNECT_ATTEMPT_MS)
+        {
+            return TPUT_RECONNECT_ATTEMPT_MS - elapsed_ms;
+        }
+        /* The server did not advertise in time */
+        wiced_bt_gatt_cancel_connect(peer_addr, WICED_TRUE);
+        state_start = xTaskGetTickCount();
+        state = TPUT_RECONNECT_BACKOFF;
+        return backoff_ms;
+
+    default:
+        return 0u;
+    }
+}
+
+/*******************************************************************************
+* Function Name: tput_reconnect_cancel()
+********************************************************************************
+* Summary:
+*   Stops the recovery in progress, if any. Scanning is allowed again.
+*
+* Parameters:
+*   None
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void tput_reconnect_cancel(void)
+{
+    if (TPUT_RECONNECT_CONNECTING == state)
+    {
+        wiced_bt_gatt_cancel_connect(peer_addr, WICED_TRUE);
+    }
+    if ((TPUT_RECONNECT_BACKOFF == state) ||
+        (TPUT_RECONNECT_CONNECTING == state))
+    {
+        /* The attempts held off scanning, let the user button scan again */
+        tput_connect_abandon();
+    }
+    state = TPUT_RECONNECT_IDLE;
+    resume_pending = false;
+}
+
+/*******************************************************************************
+* Function Name: tput_reconnect_get_stats()
+********************************************************************************
+* Summary:
+*   Reads the recovery statistics.
+*
+* Parameters:
+*   tput_reconnect_stats_t *p_stats : Statistics read
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void tput_reconnect_get_stats(tput_reconnect_stats_t *p_stats)
+{
+    taskENTER_CRITICAL();
+    *p_stats = stats;
+    taskEXIT_CRITICAL();
+}
+
+/*******************************************************************************
+* Function Name: tput_reconnect_clear_stats()
+********************************************************************************
+* Summary:
+*   Clears the recovery statistics.
+*
+* Parameters:
+*   None
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void tput_reconnect_clear_stats(void)
+{
+    taskENTER_CRITICAL();
+    memset(&stats, 0, sizeof(stats));
+    taskEXIT_CRITICAL();
+}
+
+/*******************************************************************************
+* Function Name: tput_reconnect_elapsed_ms()
+********************************************************************************
+* Summary:
+*   Computes the time elapsed since a tick count.
+*
+* Parameters:
+*   TickType_t since : Tick count
+*
+* Return:
+*   uint32_t : Elapsed time in ms
+*
+*******************************************************************************/
+static uint32_t tput_reconnect_elapsed_ms(TickType_t since)
+{
+    return (uint32_t)((xTaskGetTickCount() - since) * portTICK_PERIOD_MS);
+}
+
+/*******************************************************************************
+* Function Name: tput_reconnect_recovered()
+********************************************************************************
+* Summary:
+*   Ends the recovery and reports the outage. The bytes missed are estimated
+*   from the throughput before the loss and the recovery time.
+*
+* Parameters:
+*   None
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+static void tput_reconnect_recovered(void)
+{
+    uint32_t recovery_ms = tput_reconnect_elapsed_ms(outage_start);
+
+    taskENTER_CRITICAL();
+    state = TPUT_RECONNECT_IDLE;
+    stats.recovered++;
+    stats.last_recovery_ms = recovery_ms;
+    if (recovery_ms > stats.max_recovery_ms)
+    {
+        stats.max_recovery_ms = recovery_ms;
+    }
+    stats.last_missed_bytes = (uint32_t)(((uint64_t)outage_rate_bytes_per_s *
+                                          recovery_ms) / 1000u);
+    stats.lost_bytes += stats.last_lost_bytes;
+    stats.missed_bytes += stats.last_missed_bytes;
+    taskEXIT_CRITICAL();
+
+    printf("Link recovered in %lu ms: %lu bytes in flight lost, about %lu "
+           "bytes not transferred\n", (unsigned long)recovery_ms,
+           (unsigned long)stats.last_lost_bytes,
+           (unsigned long)stats.last_missed_bytes);
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,98 @@
+/*******************************************************************************
+ * File Name: tput_reconnect.h
+ *
+ * Description: This file contains the declarations of the link loss recovery.
+ *
+ * Related Document: See README.md
+ *
+ *
+ *******************************************************************************
+ * Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ ******************************************************************************/
+
+#ifndef __TPUT_RECONNECT_H__
+#define __TPUT_RECONNECT_H__
+
+/******************************************************************************
+ *                                INCLUDES
+ ******************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include "ble_client.h"
+
+/*******************************************************************************
+*        Macros
+*******************************************************************************/
+/* Wait before the first reconnection attempt. The wait doubles after every
+ * failed attempt, up to TPUT_RECONNECT_MAX_BACKOFF_MS */
+#define TPUT_RECONNECT_INITIAL_BACKOFF_MS   (250u)
+#define TPUT_RECONNECT_MAX_BACKOFF_MS       (8000u)
+/* Time an attempt waits for the peer to advertise before it is cancelled */
+#define TPUT_RECONNECT_ATTEMPT_MS           (3000u)
+/* Attempts before giving up and waiting for the user button */
+#define TPUT_RECONNECT_MAX_ATTEMPTS         (10u)
+
+/*******************************************************************************
+*        Structures and Enumerations
+*******************************************************************************/
+typedef struct
+{
+    uint32_t outages;           // links lost and reconnected to
+    uint32_t recovered;         // outages after which data flowed again
+    uint32_t given_up;          // outages that ran out of attempts
+    uint32_t attempts;          // connection attempts, all outages
+    uint32_t last_recovery_ms;  // link lost to first byte (or reconnected)
+    uint32_t max_recovery_ms;
+    uint32_t last_lost_bytes;   // writes in flight when the link was lost
+    uint32_t last_missed_bytes; // estimated from the rate before the loss
+    uint32_t lost_bytes;        // all outages
+    uint32_t missed_bytes;
+} tput_reconnect_stats_t;
+
+/****************************************************************************
+ *                              FUNCTION DECLARATIONS
+ ***************************************************************************/
+void tput_reconnect_enable(bool on);
+bool tput_reconnect_is_enabled(void);
+bool tput_reconnect_on_connected(const uint8_t *p_bd_addr, uint8_t addr_type);
+bool tput_reconnect_on_disconnected(uint8_t reason, uint32_t lost_bytes,
+                                    uint32_t rate_bytes_per_s);
+void tput_reconnect_save_mode(tput_mode_t mode);
+bool tput_reconnect_get_resume_mode(tput_mode_t *p_mode);
+void tput_reconnect_on_first_byte(void);
+uint32_t tput_reconnect_poll(void);
+void tput_reconnect_cancel(void);
+void tput_reconnect_get_stats(tput_reconnect_stats_t *p_stats);
+void tput_reconnect_clear_stats(void);
+
+#endif      /*__TPUT_RECONNECT_H__ */
+/* [] END OF FILE */
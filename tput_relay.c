@@ -0,0 +1,393 @@
+/*******************************************************************************
+ * File Name: tput_relay.c
+ *
+ * Description: This file contains the notification-to-write relay. Every notification
+ *              payload copied into the RX ring is sent from its ring slot as a GATT write
+ *              command, without further copies, and the slot is released once the stack
+ *              has transmitted it.
+ *
+ * Related Document: See README.md
+ *
+ *
+ *******************************************************************************
+ * Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ ******************************************************************************/
+
+/******************************************************************************
+ *                                INCLUDES
+ ******************************************************************************/
+#include <FreeRTOS.h>
+#include <task.h>
+#include "wiced_bt_gatt.h"
+#include "ble_client.h"
+#include "tput_time.h"
+#include "tput_rx_ring.h"
+#include "tput_relay.h"
+
+/*******************************************************************************
+*        Structures and Enumerations
+*******************************************************************************/
+/* A payload acquired from the RX ring. Slots are released in the order they
+ * were acquired, so each entry is only released once all older ones are */
+typedef struct
+{
+    const uint8_t *p_data;
+    uint32_t       rx_us;
+    uint16_t       len;
+    bool           done;        // transmitted, or dropped
+} tput_relay_entry_t;
+
+/*******************************************************************************
+*        Function Prototypes
+*******************************************************************************/
+static void tput_relay_on_transmitted(uint8_t *p_buf);
+
+/*******************************************************************************
+*        Variable Definitions
+*******************************************************************************/
+static tput_relay_entry_t entries[TPUT_RX_RING_NUM_SLOTS];
+/* Free running counters of the entries acquired and released */
+static volatile uint32_t head = 0;
+static volatile uint32_t tail = 0;
+/* Acquired payload that could not be sent yet because of congestion */
+static const tput_rx_pkt_t *p_pending = NULL;
+static volatile bool running = false;
+static uint16_t relay_conn_id = 0;
+static uint16_t relay_handle = 0;
+static tput_relay_stats_t stats = {.latency_min_us = UINT32_MAX};
+
+/******************************************************************************
+ * Function Definitions
+ ******************************************************************************/
+
+/*******************************************************************************
+* Function Name: tput_relay_start()
+********************************************************************************
+* Summary:
+*   Starts relaying the notifications received as GATT write commands.
+*
+* Parameters:
+*   uint16_t conn_id : Connection the writes are sent on
+*   uint16_t handle  : Attribute handle written
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void tput_relay_start(uint16_t conn_id, uint16_t handle)
+{
+    relay_conn_id = conn_id;
+    relay_handle = handle;
+    running = true;
+}
+
+/*******************************************************************************
+* Function Name: tput_relay_stop()
+********************************************************************************
+* Summary:
+*   Stops relaying. Writes in flight still release their slots when they
+*   are transmitted.
+*
+* Parameters:
+*   None
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void tput_relay_stop(void)
+{
+    running = false;
+}
+
+/*******************************************************************************
+* Function Name: tput_relay_is_running()
+********************************************************************************
+* Summary:
+*   Tells if notifications are relayed.
+*
+* Parameters:
+*   None
+*
+* Return:
+*   bool : true if relaying
+*
+*******************************************************************************/
+bool tput_relay_is_running(void)
+{
+    return running;
+}
+
+/*******************************************************************************
+* Function Name: tput_relay_is_busy()
+********************************************************************************
+* Summary:
+*   Tells if the relay holds RX ring slots. Until it does not, no other
+*   consumer may acquire or release slots.
+*
+* Parameters:
+*   None
+*
+* Return:
+*   bool : true if relaying or slots are still held
+*
+*******************************************************************************/
+bool tput_relay_is_busy(void)
+{
+    return running || (head != tail);
+}
+
+/*******************************************************************************
+* Function Name: tput_relay_release_done()
+********************************************************************************
+* Summary:
+*   Releases the oldest entries that are done to the RX ring.
+*
+* Parameters:
+*   None
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+static void tput_relay_release_done(void)
+{
+    while ((tail != head) && entries[tail % TPUT_RX_RING_NUM_SLOTS].done)
+    {
+        tail++;
+        tput_rx_ring_release();
+    }
+}
+
+/*******************************************************************************
+* Function Name: tput_relay_forward()
+********************************************************************************
+* Summary:
+*   Sends every payload waiting in the RX ring as a GATT write command
+*   pointing at its ring slot. Stops when the stack reports congestion; the
+*   payload is sent again on the next call. Called by rx_sink_task.
+*
+* Parameters:
+*   None
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void tput_relay_forward(void)
+{
+    wiced_bt_gatt_write_hdr_t write_cmd = {0};
+    wiced_bt_gatt_status_t status;
+    tput_relay_entry_t *p_entry;
+
+    while (running)
+    {
+        if (NULL == p_pending)
+        {
+            p_pending = tput_rx_ring_acquire();
+            if (NULL == p_pending)
+            {
+                break;
+            }
+            taskENTER_CRITICAL();
+            p_entry = &entries[head % TPUT_RX_RING_NUM_SLOTS];
+            p_entry->p_data = p_pending->p_data;
+            p_entry->rx_us = p_pending->rx_us;
+            p_entry->len = p_pending->len;
+            p_entry->done = false;
+            head++;
+            taskEXIT_CRITICAL();
+        }
+        p_entry = &entries[(head - 1u) % TPUT_RX_RING_NUM_SLOTS];
+
+        write_cmd.auth_req = GATT_AUTH_REQ_NONE;
+        write_cmd.handle = relay_handle;
+        write_cmd.len = p_pending->len;
+        write_cmd.offset = 0;
+        /* The slot is released by the free function passed as context */
+        status = wiced_bt_gatt_client_send_write(relay_conn_id, GATT_CMD_WRITE,
+                                                 &write_cmd, p_pending->p_data,
+                                                 (void *)tput_relay_on_transmitted);
+        if (WICED_BT_GATT_CONGESTED == status)
+        {
+            stats.congested++;
+            break;
+        }
+
+        taskENTER_CRITICAL();
+        if (WICED_BT_GATT_SUCCESS == status)
+        {
+            stats.in_flight++;
+            if (stats.in_flight > stats.max_in_flight)
+            {
+                stats.max_in_flight = stats.in_flight;
+            }
+        }
+        else
+        {
+            stats.failures++;
+            p_entry->done = true;
+            tput_relay_release_done();
+        }
+        taskEXIT_CRITICAL();
+        p_pending = NULL;
+    }
+}
+
+/*******************************************************************************
+* Function Name: tput_relay_on_transmitted()
+********************************************************************************
+* Summary:
+*   Called by the GATT callback on GATT_APP_BUFFER_TRANSMITTED_EVT for a
+*   relayed payload. Accounts for it and releases its slot, together with
+*   any newer slots already done.
+*
+* Parameters:
+*   uint8_t *p_buf : Payload transmitted
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+static void tput_relay_on_transmitted(uint8_t *p_buf)
+{
+    uint32_t now_us = tput_time_us();
+
+    taskENTER_CRITICAL();
+    for (uint32_t idx = tail; idx != head; idx++)
+    {
+        tput_relay_entry_t *p_entry = &entries[idx % TPUT_RX_RING_NUM_SLOTS];
+
+        if ((p_entry->p_data == p_buf) && !p_entry->done)
+        {
+            uint32_t latency_us = now_us - p_entry->rx_us;
+
+            p_entry->done = true;
+            stats.pkts++;
+            stats.bytes += p_entry->len;
+            stats.latency_sum_us += latency_us;
+            if (latency_us < stats.latency_min_us)
+            {
+                stats.latency_min_us = latency_us;
+            }
+            if (latency_us > stats.latency_max_us)
+            {
+                stats.latency_max_us = latency_us;
+            }
+            if (stats.in_flight)
+            {
+                stats.in_flight--;
+            }
+            break;
+        }
+    }
+    tput_relay_release_done();
+    taskEXIT_CRITICAL();
+}
+
+/*******************************************************************************
+* Function Name: tput_relay_on_link_down()
+********************************************************************************
+* Summary:
+*   Stops relaying and releases all slots when the connection is lost, as
+*   the writes in flight are dropped with it.
+*
+* Parameters:
+*   None
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void tput_relay_on_link_down(void)
+{
+    taskENTER_CRITICAL();
+    running = false;
+    for (uint32_t idx = tail; idx != head; idx++)
+    {
+        entries[idx % TPUT_RX_RING_NUM_SLOTS].done = true;
+    }
+    tput_relay_release_done();
+    p_pending = NULL;
+    stats.in_flight = 0;
+    taskEXIT_CRITICAL();
+}
+
+/*******************************************************************************
+* Function Name: tput_relay_get_stats()
+********************************************************************************
+* Summary:
+*   Reads the relay statistics since the last call of
+*   tput_relay_clear_stats().
+*
+* Parameters:
+*   tput_relay_stats_t *p_stats : Statistics read
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void tput_relay_get_stats(tput_relay_stats_t *p_stats)
+{
+    taskENTER_CRITICAL();
+    *p_stats = stats;
+    taskEXIT_CRITICAL();
+}
+
+/*******************************************************************************
+* Function Name: tput_relay_clear_stats()
+********************************************************************************
+* Summary:
+*   Clears the relay statistics, except the writes in flight.
+*
+* Parameters:
+*   None
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void tput_relay_clear_stats(void)
+{
+    taskENTER_CRITICAL();
+    stats.pkts = 0;
+    stats.bytes = 0;
+    stats.failures = 0;
+    stats.congested = 0;
+    stats.latency_sum_us = 0;
+    stats.latency_min_us = UINT32_MAX;
+    stats.latency_max_us = 0;
+    stats.max_in_flight = stats.in_flight;
+    taskEXIT_CRITICAL();
+}
+
+/* [] END OF FILE */
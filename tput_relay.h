@@ -0,0 +1,80 @@
+/*******************************************************************************
+ * File Name: tput_relay.h
+ *
+ * Description: This file contains the declarations of the notification-to-write relay.
+ *
+ * Related Document: See README.md
+ *
+ *
+ *******************************************************************************
+ * Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ ******************************************************************************/
+
+#ifndef __TPUT_RELAY_H__
+#define __TPUT_RELAY_H__
+
+/******************************************************************************
+ *                                INCLUDES
+ ******************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+
+/*******************************************************************************
+*        Structures and Enumerations
+*******************************************************************************/
+typedef struct
+{
+    uint32_t pkts;              // payloads relayed and transmitted
+    uint32_t bytes;
+    uint32_t failures;          // payloads the stack did not accept
+    uint32_t congested;         // times relaying waited for congestion to end
+    uint32_t latency_sum_us;    // notification received to write transmitted
+    uint32_t latency_min_us;
+    uint32_t latency_max_us;
+    uint16_t in_flight;         // writes handed to the stack, not transmitted
+    uint16_t max_in_flight;
+} tput_relay_stats_t;
+
+/****************************************************************************
+ *                              FUNCTION DECLARATIONS
+ ***************************************************************************/
+void tput_relay_start(uint16_t conn_id, uint16_t handle);
+void tput_relay_stop(void);
+bool tput_relay_is_running(void);
+bool tput_relay_is_busy(void);
+void tput_relay_forward(void);
+void tput_relay_on_link_down(void);
+void tput_relay_get_stats(tput_relay_stats_t *p_stats);
+void tput_relay_clear_stats(void);
+
+#endif      /*__TPUT_RELAY_H__ */
+/* [] END OF FILE */
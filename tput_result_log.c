@@ -0,0 +1,464 @@
+/*******************************************************************************
+ * File Name: tput_result_log.c
+ *
+ * Description: This file contains a ring of throughput results kept in flash, so that
+ *              the results of a benchmark survive a reset or a power cycle.
+ *
+ * Related Document: See README.md
+ *
+ *
+ *******************************************************************************
+ * Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ ******************************************************************************/
+
+/******************************************************************************
+ *                                INCLUDES
+ ******************************************************************************/
+#include <stdio.h>
+#include <string.h>
+#include <stddef.h>
+#include <FreeRTOS.h>
+#include <semphr.h>
+#include "cyhal.h"
+#include "cy_utils.h"
+#include "app_bt_utils.h"
+#include "tput_result_log.h"
+
+/******************************************************************************
+ *                                Macros
+ ******************************************************************************/
+#define TPUT_RESULT_LOG_MAGIC           (0x544C4F47u)   /* "TLOG" */
+#define TPUT_RESULT_LOG_HDR_SIZE        (sizeof(tput_result_log_row_hdr_t))
+#define TPUT_RESULT_LOG_RECS_PER_ROW    ((TPUT_RESULT_LOG_ROW_SIZE - \
+                                          TPUT_RESULT_LOG_HDR_SIZE) / \
+                                          sizeof(tput_result_record_t))
+#define TPUT_RESULT_LOG_CHECK_LEN       (offsetof(tput_result_record_t, check))
+
+/* The PSoC 6 devices have a flash region reserved for emulated EEPROM.
+ * On other targets the log is kept in RAM and only survives a soft reset
+ * of the application, not a power cycle. */
+#if defined(COMPONENT_CAT1A)
+#define TPUT_RESULT_LOG_IN_FLASH        (1)
+#else
+#define TPUT_RESULT_LOG_IN_FLASH        (0)
+#endif
+
+/*******************************************************************************
+*        Structures and Enumerations
+*******************************************************************************/
+typedef struct
+{
+    uint32_t magic;
+    uint32_t seq;               // row write sequence number, never wraps
+    uint32_t erase_count;       // number of times this row was written
+    uint16_t boot_id;           // boot the row was written in
+    uint16_t record_count;      // number of valid records in the row
+} tput_result_log_row_hdr_t;
+
+typedef union
+{
+    struct
+    {
+        tput_result_log_row_hdr_t hdr;
+        tput_result_record_t records[TPUT_RESULT_LOG_RECS_PER_ROW];
+    } row;
+    uint32_t words[TPUT_RESULT_LOG_ROW_SIZE / sizeof(uint32_t)];
+} tput_result_log_row_t;
+
+_Static_assert(sizeof(tput_result_record_t) == 32u,
+               "Result record size changed");
+_Static_assert(sizeof(tput_result_log_row_t) == TPUT_RESULT_LOG_ROW_SIZE,
+               "Result log row does not match the flash row size");
+
+/*******************************************************************************
+*        Variable Definitions
+*******************************************************************************/
+#if TPUT_RESULT_LOG_IN_FLASH
+CY_SECTION(".cy_em_eeprom") CY_ALIGN(TPUT_RESULT_LOG_ROW_SIZE)
+static const tput_result_log_row_t log_rows[TPUT_RESULT_LOG_NUM_ROWS] = {0};
+static cyhal_flash_t log_flash;
+#else
+static tput_result_log_row_t log_rows[TPUT_RESULT_LOG_NUM_ROWS];
+#endif
+
+/* Row being filled, written to log_rows[write_row] once full */
+static tput_result_log_row_t row_image;
+static uint32_t write_row = 0;
+static uint32_t next_seq = 0;
+static uint16_t boot_id = 0;
+static SemaphoreHandle_t log_mutex = NULL;
+static StaticSemaphore_t log_mutex_buf;
+
+/******************************************************************************
+ * Function Definitions
+ ******************************************************************************/
+
+/*******************************************************************************
+* Function Name: tput_result_log_row()
+********************************************************************************
+* Summary:
+*   Returns a stored row. Flash is read through a volatile pointer since the
+*   compiler would otherwise assume the const array still holds zeros.
+*
+* Parameters:
+*   uint32_t row : Row index
+*
+* Return:
+*   const volatile tput_result_log_row_t * : Stored row
+*
+*******************************************************************************/
+static const volatile tput_result_log_row_t *tput_result_log_row(uint32_t row)
+{
+    return (const volatile tput_result_log_row_t *)&log_rows[row];
+}
+
+/*******************************************************************************
+* Function Name: tput_result_log_row_valid()
+********************************************************************************
+* Summary:
+*   Checks whether a stored row has been written by this module.
+*
+* Parameters:
+*   const volatile tput_result_log_row_t *p_row : Stored row
+*
+* Return:
+*   bool : true if the row holds records
+*
+*******************************************************************************/
+static bool tput_result_log_row_valid(const volatile tput_result_log_row_t *p_row)
+{
+    return ((TPUT_RESULT_LOG_MAGIC == p_row->row.hdr.magic) &&
+            (p_row->row.hdr.record_count <= TPUT_RESULT_LOG_RECS_PER_ROW));
+}
+
+/*******************************************************************************
+* Function Name: tput_result_log_write_row()
+********************************************************************************
+* Summary:
+*   Writes the RAM row image to the current row and moves on to the next row.
+*
+* Parameters:
+*   None
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+static void tput_result_log_write_row(void)
+{
+    const volatile tput_result_log_row_t *p_row = tput_result_log_row(write_row);
+
+    row_image.row.hdr.magic = TPUT_RESULT_LOG_MAGIC;
+    row_image.row.hdr.seq = next_seq++;
+    row_image.row.hdr.boot_id = boot_id;
+    row_image.row.hdr.erase_count = tput_result_log_row_valid(p_row) ?
+                                    (p_row->row.hdr.erase_count + 1u) : 1u;
+
+#if TPUT_RESULT_LOG_IN_FLASH
+    cy_rslt_t result = cyhal_flash_write(&log_flash,
+                                         (uint32_t)&log_rows[write_row],
+                                         row_image.words);
+    if (CY_RSLT_SUCCESS != result)
+    {
+        printf("Result log: flash write of row %lu failed, 0x%lX\r\n",
+               (unsigned long)write_row, (unsigned long)result);
+    }
+#else
+    memcpy(&log_rows[write_row], &row_image, sizeof(row_image));
+#endif
+
+    write_row = (write_row + 1u) % TPUT_RESULT_LOG_NUM_ROWS;
+    memset(&row_image, 0, sizeof(row_image));
+}
+
+/*******************************************************************************
+* Function Name: tput_result_log_init()
+********************************************************************************
+* Summary:
+*   Scans the stored rows for the most recently written one, so that logging
+*   continues after it, and assigns the boot ID of this boot.
+*
+* Parameters:
+*   None
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void tput_result_log_init(void)
+{
+    bool found = false;
+    uint32_t last_seq = 0;
+    uint32_t last_row = 0;
+    uint16_t last_boot_id = 0;
+
+#if TPUT_RESULT_LOG_IN_FLASH
+    cy_rslt_t result = cyhal_flash_init(&log_flash);
+    if (CY_RSLT_SUCCESS != result)
+    {
+        printf("Result log: flash init failed, 0x%lX\r\n",
+               (unsigned long)result);
+        CY_ASSERT(0);
+    }
+#endif
+
+    log_mutex = xSemaphoreCreateMutexStatic(&log_mutex_buf);
+    CY_ASSERT(NULL != log_mutex);
+
+    for (uint32_t row = 0; row < TPUT_RESULT_LOG_NUM_ROWS; row++)
+    {
+        const volatile tput_result_log_row_t *p_row = tput_result_log_row(row);
+
+        if (!tput_result_log_row_valid(p_row))
+        {
+            continue;
+        }
+        /* Sequence numbers are compared as a signed difference so that the
+         * scan keeps working once they wrap */
+        if (!found || ((int32_t)(p_row->row.hdr.seq - last_seq) > 0))
+        {
+            last_seq = p_row->row.hdr.seq;
+            last_row = row;
+            last_boot_id = p_row->row.hdr.boot_id;
+            found = true;
+        }
+    }
+
+    memset(&row_image, 0, sizeof(row_image));
+    if (found)
+    {
+        next_seq = last_seq + 1u;
+        write_row = (last_row + 1u) % TPUT_RESULT_LOG_NUM_ROWS;
+        boot_id = last_boot_id + 1u;
+    }
+    else
+    {
+        next_seq = 0;
+        write_row = 0;
+        boot_id = 0;
+    }
+
+    printf("Result log: boot ID %u, %u records per row, %u rows\r\n",
+           boot_id, (unsigned)TPUT_RESULT_LOG_RECS_PER_ROW,
+           (unsigned)TPUT_RESULT_LOG_NUM_ROWS);
+}
+
+/*******************************************************************************
+* Function Name: tput_result_log_append()
+********************************************************************************
+* Summary:
+*   Adds a record to the log. The boot ID and the check field are filled in
+*   here. The record is buffered in RAM and reaches flash when its row is full.
+*
+* Parameters:
+*   tput_result_record_t *p_record : Record to be added
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void tput_result_log_append(tput_result_record_t *p_record)
+{
+    p_record->boot_id = boot_id;
+    p_record->check = (uint16_t)crc32_update(0, (const uint8_t *)p_record,
+                                             TPUT_RESULT_LOG_CHECK_LEN);
+
+    xSemaphoreTake(log_mutex, portMAX_DELAY);
+    row_image.row.records[row_image.row.hdr.record_count++] = *p_record;
+    if (TPUT_RESULT_LOG_RECS_PER_ROW == row_image.row.hdr.record_count)
+    {
+        tput_result_log_write_row();
+    }
+    xSemaphoreGive(log_mutex);
+}
+
+/*******************************************************************************
+* Function Name: tput_result_log_flush()
+********************************************************************************
+* Summary:
+*   Writes buffered records to flash even if their row is not full. The
+*   remainder of the row is left unused.
+*
+* Parameters:
+*   None
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void tput_result_log_flush(void)
+{
+    xSemaphoreTake(log_mutex, portMAX_DELAY);
+    if (0 != row_image.row.hdr.record_count)
+    {
+        tput_result_log_write_row();
+    }
+    xSemaphoreGive(log_mutex);
+}
+
+/*******************************************************************************
+* Function Name: tput_result_log_print_record()
+********************************************************************************
+* Summary:
+*   Prints a record as one CSV line.
+*
+* Parameters:
+*   const volatile tput_result_record_t *p_stored : Record in flash or RAM
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+static void tput_result_log_print_record(const volatile tput_result_record_t *p_stored)
+{
+    tput_result_record_t rec;
+    uint16_t check;
+
+    memcpy(&rec, (const void *)p_stored, sizeof(rec));
+    check = (uint16_t)crc32_update(0, (const uint8_t *)&rec,
+                                   TPUT_RESULT_LOG_CHECK_LEN);
+
+    printf("%u,%lu,%u,%u,%u,%u,%u,%u,%u,%u,%u,%lu,%u,%u,%u,%s\r\n",
+           rec.boot_id, (unsigned long)rec.timestamp_ms, rec.mode,
+           rec.phy >> 4, rec.phy & 0x0Fu, rec.mtu,
+           (unsigned)(rec.conn_interval * 5u / 4u), rec.packet_size,
+           rec.rx_kbps, rec.tx_kbps, rec.cwnd,
+           (unsigned long)rec.congestion_episodes, rec.congested_ms,
+           rec.rx_overruns, rec.tx_failures,
+           (check == rec.check) ? "ok" : "bad");
+}
+
+/*******************************************************************************
+* Function Name: tput_result_log_dump()
+********************************************************************************
+* Summary:
+*   Prints all stored records, oldest first, as CSV followed by the records
+*   that are still buffered in RAM.
+*
+* Parameters:
+*   None
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void tput_result_log_dump(void)
+{
+    uint32_t total = 0;
+
+    xSemaphoreTake(log_mutex, portMAX_DELAY);
+
+    printf("boot_id,timestamp_ms,mode,tx_phy,rx_phy,mtu,conn_interval_ms,"
+           "packet_size,rx_kbps,tx_kbps,cwnd,congestion_episodes,"
+           "congested_ms,rx_overruns,tx_failures,check\r\n");
+
+    /* write_row is the oldest row once the ring has wrapped */
+    for (uint32_t i = 0; i < TPUT_RESULT_LOG_NUM_ROWS; i++)
+    {
+        uint32_t row = (write_row + i) % TPUT_RESULT_LOG_NUM_ROWS;
+        const volatile tput_result_log_row_t *p_row = tput_result_log_row(row);
+
+        if (!tput_result_log_row_valid(p_row))
+        {
+            continue;
+        }
+        for (uint32_t rec = 0; rec < p_row->row.hdr.record_count; rec++)
+        {
+            tput_result_log_print_record(&p_row->row.records[rec]);
+            total++;
+        }
+    }
+    for (uint32_t rec = 0; rec < row_image.row.hdr.record_count; rec++)
+    {
+        tput_result_log_print_record(&row_image.row.records[rec]);
+        total++;
+    }
+
+    printf("Result log: %lu records\r\n", (unsigned long)total);
+
+    xSemaphoreGive(log_mutex);
+}
+
+/*******************************************************************************
+* Function Name: tput_result_log_erase()
+********************************************************************************
+* Summary:
+*   Discards all stored and buffered records. The boot ID is kept.
+*
+* Parameters:
+*   None
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void tput_result_log_erase(void)
+{
+    xSemaphoreTake(log_mutex, portMAX_DELAY);
+
+    for (uint32_t row = 0; row < TPUT_RESULT_LOG_NUM_ROWS; row++)
+    {
+#if TPUT_RESULT_LOG_IN_FLASH
+        /* Rows that were never written need no erase cycle */
+        if (tput_result_log_row_valid(tput_result_log_row(row)))
+        {
+            cyhal_flash_erase(&log_flash, (uint32_t)&log_rows[row]);
+        }
+#else
+        memset(&log_rows[row], 0, sizeof(log_rows[row]));
+#endif
+    }
+    memset(&row_image, 0, sizeof(row_image));
+    write_row = 0;
+
+    xSemaphoreGive(log_mutex);
+}
+
+/*******************************************************************************
+* Function Name: tput_result_log_get_boot_id()
+********************************************************************************
+* Summary:
+*   Returns the boot ID assigned by tput_result_log_init().
+*
+* Parameters:
+*   None
+*
+* Return:
+*   uint16_t : Boot ID
+*
+*******************************************************************************/
+uint16_t tput_result_log_get_boot_id(void)
+{
+    return boot_id;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,96 @@
+/*******************************************************************************
+ * File Name: tput_result_log.h
+ *
+ * Description: This file contains the declarations of the persistent log of
+ *              throughput results.
+ *
+ * Related Document: See README.md
+ *
+ *
+ *******************************************************************************
+ * Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ ******************************************************************************/
+
+#ifndef __TPUT_RESULT_LOG_H__
+#define __TPUT_RESULT_LOG_H__
+
+/******************************************************************************
+ *                                INCLUDES
+ ******************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+
+/******************************************************************************
+ *                                Macros
+ ******************************************************************************/
+/* The log is a ring of flash rows. A row is written when it is full or when
+ * tput_result_log_flush() is called, and rows are reused oldest first so
+ * that they wear evenly */
+#define TPUT_RESULT_LOG_ROW_SIZE        (512u)
+#define TPUT_RESULT_LOG_NUM_ROWS        (32u)
+
+/*******************************************************************************
+*        Structures and Enumerations
+*******************************************************************************/
+/* One throughput sample, 32 bytes. PHYs are the
+ * wiced_bt_ble_host_phy_preferences_t values, TX in the upper nibble */
+typedef struct __attribute__((packed))
+{
+    uint32_t timestamp_ms;          // time since boot
+    uint16_t boot_id;               // incremented on every boot
+    uint8_t  mode;                  // tput_mode_t
+    uint8_t  phy;                   // (tx_phy << 4) | rx_phy
+    uint16_t mtu;
+    uint16_t conn_interval;         // in units of 1.25 ms
+    uint16_t packet_size;
+    uint16_t rx_kbps;
+    uint16_t tx_kbps;
+    uint16_t cwnd;                  // write window at the end of the sample
+    uint32_t congestion_episodes;   // since connection
+    uint16_t congested_ms;          // during the sample
+    uint16_t rx_overruns;           // notifications dropped by the RX ring
+    uint16_t tx_failures;           // write commands completed with an error
+    uint16_t check;                 // lower half of the CRC-32 of the above
+} tput_result_record_t;
+
+/****************************************************************************
+ *                              FUNCTION DECLARATIONS
+ ***************************************************************************/
+void     tput_result_log_init(void);
+void     tput_result_log_append(tput_result_record_t *p_record);
+void     tput_result_log_flush(void);
+void     tput_result_log_dump(void);
+void     tput_result_log_erase(void);
+uint16_t tput_result_log_get_boot_id(void);
+
+#endif      /*__TPUT_RESULT_LOG_H__ */
+/* [] END OF FILE */
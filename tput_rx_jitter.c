@@ -0,0 +1,381 @@
+/*******************************************************************************
+ * File Name: tput_rx_jitter.c
+ *
+ * Description: This file contains statistics of the time between notifications and a
+ *              log of the gaps in the notification stream, with the link state at the
+ *              time of each gap.
+ *
+ * Related Document: See README.md
+ *
+ *
+ *******************************************************************************
+ * Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ ******************************************************************************/
+
+/******************************************************************************
+ *                                INCLUDES
+ ******************************************************************************/
+#include <string.h>
+#include <FreeRTOS.h>
+#include <task.h>
+#include "tput_rx_jitter.h"
+
+/******************************************************************************
+ *                                Macros
+ ******************************************************************************/
+#define TPUT_RX_LINK_STATE_BITS         (4u)
+/* Weight of a new sample in the jitter estimate, as in RFC 3550 */
+#define JITTER_GAIN_SHIFT               (4u)
+
+/*******************************************************************************
+*        Variable Definitions
+*******************************************************************************/
+static uint32_t interval_us = 0;
+static bool have_last = false;
+static uint32_t last_rx_us = 0;
+static uint32_t last_delta_us = 0;
+/* Link procedures requested by the client and not completed yet */
+static uint8_t pending_state = 0;
+/* Completion time of the last procedure of each TPUT_RX_LINK_* bit */
+static uint32_t event_us[TPUT_RX_LINK_STATE_BITS];
+static uint8_t event_valid = 0;
+static tput_rx_gap_t gap_log[TPUT_RX_JITTER_GAP_LOG_LEN];
+static uint32_t gap_put = 0;
+static uint32_t gap_get = 0;
+static tput_rx_jitter_stats_t stats;
+
+/******************************************************************************
+ * Function Definitions
+ ******************************************************************************/
+
+/*******************************************************************************
+* Function Name: tput_rx_jitter_bin()
+********************************************************************************
+* Summary:
+*   Returns the histogram bin of an inter-arrival time.
+*
+* Parameters:
+*   uint32_t delta_us : Inter-arrival time
+*
+* Return:
+*   uint32_t : Bin index
+*
+*******************************************************************************/
+static uint32_t tput_rx_jitter_bin(uint32_t delta_us)
+{
+    uint32_t bin = 0;
+
+    delta_us /= (TPUT_RX_JITTER_BIN0_US * 2u);
+    while ((0u != delta_us) && (bin < TPUT_RX_JITTER_HIST_BINS - 1u))
+    {
+        delta_us >>= 1;
+        bin++;
+    }
+    return bin;
+}
+
+/*******************************************************************************
+* Function Name: tput_rx_jitter_log_gap()
+********************************************************************************
+* Summary:
+*   Logs a gap with the link procedures that were in progress or completed
+*   while it lasted.
+*
+* Parameters:
+*   uint32_t start_us : Arrival of the notification before the gap
+*   uint32_t gap_us   : Length of the gap
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+static void tput_rx_jitter_log_gap(uint32_t start_us, uint32_t gap_us)
+{
+    tput_rx_gap_t *p_gap;
+    uint8_t link_state = pending_state;
+
+    for (uint32_t bit = 0; bit < TPUT_RX_LINK_STATE_BITS; bit++)
+    {
+        if ((event_valid & (1u << bit)) &&
+            ((event_us[bit] - start_us) <= gap_us))
+        {
+            link_state |= (uint8_t)(1u << bit);
+        }
+    }
+
+    stats.gaps++;
+    if ((gap_put - gap_get) >= TPUT_RX_JITTER_GAP_LOG_LEN)
+    {
+        stats.gaps_dropped++;
+        return;
+    }
+    p_gap = &gap_log[gap_put % TPUT_RX_JITTER_GAP_LOG_LEN];
+    p_gap->start_us = start_us;
+    p_gap->gap_us = gap_us;
+    p_gap->conn_interval_us = interval_us;
+    p_gap->link_state = link_state;
+    gap_put++;
+}
+
+/*******************************************************************************
+* Function Name: tput_rx_jitter_configure()
+********************************************************************************
+* Summary:
+*   Sets the connection interval gaps are measured against.
+*
+* Parameters:
+*   uint32_t conn_interval_us : Connection interval, 0 if not known
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void tput_rx_jitter_configure(uint32_t conn_interval_us)
+{
+    taskENTER_CRITICAL();
+    interval_us = conn_interval_us;
+    taskEXIT_CRITICAL();
+}
+
+/*******************************************************************************
+* Function Name: tput_rx_jitter_on_notification()
+********************************************************************************
+* Summary:
+*   Adds the time since the previous notification to the statistics, and
+*   logs it if it is a gap.
+*
+* Parameters:
+*   uint32_t timestamp_us : Arrival time, from tput_time_us()
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void tput_rx_jitter_on_notification(uint32_t timestamp_us)
+{
+    uint32_t delta_us;
+    uint32_t variation_us;
+
+    taskENTER_CRITICAL();
+    if (have_last)
+    {
+        delta_us = timestamp_us - last_rx_us;
+
+        if ((0u == stats.count) || (delta_us < stats.min_us))
+        {
+            stats.min_us = delta_us;
+        }
+        if (delta_us > stats.max_us)
+        {
+            stats.max_us = delta_us;
+        }
+        stats.count++;
+        stats.sum_us += delta_us;
+        stats.hist[tput_rx_jitter_bin(delta_us)]++;
+
+        variation_us = (delta_us > last_delta_us) ? (delta_us - last_delta_us) :
+                                                    (last_delta_us - delta_us);
+        stats.jitter_us = stats.jitter_us +
+                          (variation_us >> JITTER_GAIN_SHIFT) -
+                          (stats.jitter_us >> JITTER_GAIN_SHIFT);
+        last_delta_us = delta_us;
+
+        if ((0u != interval_us) &&
+            (delta_us > interval_us * TPUT_RX_JITTER_GAP_INTERVALS))
+        {
+            tput_rx_jitter_log_gap(last_rx_us, delta_us);
+        }
+    }
+    have_last = true;
+    last_rx_us = timestamp_us;
+    taskEXIT_CRITICAL();
+}
+
+/*******************************************************************************
+* Function Name: tput_rx_jitter_link_pending()
+********************************************************************************
+* Summary:
+*   Marks a link procedure requested by the client as in progress, or as no
+*   longer in progress.
+*
+* Parameters:
+*   uint8_t link_state : TPUT_RX_LINK_* bit of the procedure
+*   bool pending       : true when requested, false when completed
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void tput_rx_jitter_link_pending(uint8_t link_state, bool pending)
+{
+    taskENTER_CRITICAL();
+    if (pending)
+    {
+        pending_state |= link_state;
+    }
+    else
+    {
+        pending_state &= (uint8_t)~link_state;
+    }
+    taskEXIT_CRITICAL();
+}
+
+/*******************************************************************************
+* Function Name: tput_rx_jitter_link_event()
+********************************************************************************
+* Summary:
+*   Records the completion of a link procedure, including procedures started
+*   by the peer, so that a gap around it is attributed to it.
+*
+* Parameters:
+*   uint8_t link_state    : TPUT_RX_LINK_* bit of the procedure
+*   uint32_t timestamp_us : Completion time, from tput_time_us()
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void tput_rx_jitter_link_event(uint8_t link_state, uint32_t timestamp_us)
+{
+    taskENTER_CRITICAL();
+    for (uint32_t bit = 0; bit < TPUT_RX_LINK_STATE_BITS; bit++)
+    {
+        if (link_state & (1u << bit))
+        {
+            event_us[bit] = timestamp_us;
+            event_valid |= (uint8_t)(1u << bit);
+        }
+    }
+    pending_state &= (uint8_t)~link_state;
+    taskEXIT_CRITICAL();
+}
+
+/*******************************************************************************
+* Function Name: tput_rx_jitter_reset()
+********************************************************************************
+* Summary:
+*   Clears all state, on disconnection.
+*
+* Parameters:
+*   None
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void tput_rx_jitter_reset(void)
+{
+    taskENTER_CRITICAL();
+    interval_us = 0;
+    have_last = false;
+    last_delta_us = 0;
+    pending_state = 0;
+    event_valid = 0;
+    gap_get = gap_put;
+    memset(&stats, 0, sizeof(stats));
+    taskEXIT_CRITICAL();
+}
+
+/*******************************************************************************
+* Function Name: tput_rx_jitter_get_gap()
+********************************************************************************
+* Summary:
+*   Takes the oldest gap from the gap log.
+*
+* Parameters:
+*   tput_rx_gap_t *p_gap : Gap
+*
+* Return:
+*   bool : false if no gap was logged
+*
+*******************************************************************************/
+bool tput_rx_jitter_get_gap(tput_rx_gap_t *p_gap)
+{
+    bool found = false;
+
+    taskENTER_CRITICAL();
+    if (gap_get != gap_put)
+    {
+        *p_gap = gap_log[gap_get % TPUT_RX_JITTER_GAP_LOG_LEN];
+        gap_get++;
+        found = true;
+    }
+    taskEXIT_CRITICAL();
+    return found;
+}
+
+/*******************************************************************************
+* Function Name: tput_rx_jitter_get_stats()
+********************************************************************************
+* Summary:
+*   Returns the inter-arrival statistics.
+*
+* Parameters:
+*   tput_rx_jitter_stats_t *p_stats : Statistics
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void tput_rx_jitter_get_stats(tput_rx_jitter_stats_t *p_stats)
+{
+    taskENTER_CRITICAL();
+    *p_stats = stats;
+    taskEXIT_CRITICAL();
+}
+
+/*******************************************************************************
+* Function Name: tput_rx_jitter_clear_stats()
+********************************************************************************
+* Summary:
+*   Clears the inter-arrival statistics. The jitter estimate is kept, as it
+*   is a running average.
+*
+* Parameters:
+*   None
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void tput_rx_jitter_clear_stats(void)
+{
+    uint32_t jitter_us;
+
+    taskENTER_CRITICAL();
+    jitter_us = stats.jitter_us;
+    memset(&stats, 0, sizeof(stats));
+    stats.jitter_us = jitter_us;
+    taskEXIT_CRITICAL();
+}
+
+/* [] END OF FILE */
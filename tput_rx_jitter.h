@@ -0,0 +1,110 @@
+/*******************************************************************************
+ * File Name: tput_rx_jitter.h
+ *
+ * Description: This file contains the declarations of the notification inter-arrival
+ *              time statistics and gap log.
+ *
+ * Related Document: See README.md
+ *
+ *
+ *******************************************************************************
+ * Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ ******************************************************************************/
+
+#ifndef __TPUT_RX_JITTER_H__
+#define __TPUT_RX_JITTER_H__
+
+/******************************************************************************
+ *                                INCLUDES
+ ******************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+
+/******************************************************************************
+ *                                Macros
+ ******************************************************************************/
+/* Inter-arrival histogram. Bin 0 counts times below
+ * TPUT_RX_JITTER_BIN0_US * 2, each further bin doubles the range, and the
+ * last bin also counts longer times */
+#define TPUT_RX_JITTER_HIST_BINS        (16u)
+#define TPUT_RX_JITTER_BIN0_US          (128u)
+/* An inter-arrival time longer than this many connection intervals is a
+ * gap and is logged */
+#ifndef TPUT_RX_JITTER_GAP_INTERVALS
+#define TPUT_RX_JITTER_GAP_INTERVALS    (4u)
+#endif
+/* Gaps kept until they are read with tput_rx_jitter_get_gap() */
+#define TPUT_RX_JITTER_GAP_LOG_LEN      (8u)
+
+/* Link state bits of tput_rx_gap_t.link_state */
+#define TPUT_RX_LINK_PHY_UPDATE         (0x01u)
+#define TPUT_RX_LINK_CONN_PARAM_UPDATE  (0x02u)
+#define TPUT_RX_LINK_DATA_LENGTH_UPDATE (0x04u)
+#define TPUT_RX_LINK_TX_CONGESTED       (0x08u)
+
+/*******************************************************************************
+*        Structures and Enumerations
+*******************************************************************************/
+typedef struct
+{
+    uint32_t count;             // inter-arrival times measured
+    uint32_t sum_us;
+    uint32_t min_us;
+    uint32_t max_us;
+    uint32_t jitter_us;         // smoothed variation of consecutive times
+    uint32_t gaps;              // gaps detected
+    uint32_t gaps_dropped;      // gaps not kept, the log was full
+    uint32_t hist[TPUT_RX_JITTER_HIST_BINS];
+} tput_rx_jitter_stats_t;
+
+typedef struct
+{
+    uint32_t start_us;          // arrival of the notification before the gap
+    uint32_t gap_us;            // length of the gap
+    uint32_t conn_interval_us;
+    uint8_t  link_state;        // TPUT_RX_LINK_* in progress during the gap
+} tput_rx_gap_t;
+
+/****************************************************************************
+ *                              FUNCTION DECLARATIONS
+ ***************************************************************************/
+void tput_rx_jitter_configure(uint32_t conn_interval_us);
+void tput_rx_jitter_on_notification(uint32_t timestamp_us);
+void tput_rx_jitter_link_pending(uint8_t link_state, bool pending);
+void tput_rx_jitter_link_event(uint8_t link_state, uint32_t timestamp_us);
+void tput_rx_jitter_reset(void);
+bool tput_rx_jitter_get_gap(tput_rx_gap_t *p_gap);
+void tput_rx_jitter_get_stats(tput_rx_jitter_stats_t *p_stats);
+void tput_rx_jitter_clear_stats(void);
+
+#endif      /*__TPUT_RX_JITTER_H__ */
+/* [] END OF FILE */
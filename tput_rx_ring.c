@@ -0,0 +1,304 @@
+/*******************************************************************************
+ * File Name: tput_rx_ring.c
+ *
+ * Description: This file implements the RX ring. GATT notification payloads
+ *              are copied once, out of the stack buffer, into a preallocated
+ *              slot and handed to the registered sink by reference. The sink
+ *              releases slots explicitly, in the order it acquired them.
+ *
+ * Related Document: See README.md
+ *
+ *
+ *******************************************************************************
+ * Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ ******************************************************************************/
+
+/******************************************************************************
+ *                                INCLUDES
+ ******************************************************************************/
+#include <string.h>
+#include "tput_time.h"
+#include "tput_rx_ring.h"
+
+/*******************************************************************************
+*        Variable Definitions
+*******************************************************************************/
+static uint8_t ring_data[TPUT_RX_RING_NUM_SLOTS][TPUT_RX_RING_SLOT_SIZE];
+static tput_rx_pkt_t ring_pkts[TPUT_RX_RING_NUM_SLOTS];
+/* Free running counters, the slot index is the counter modulo the ring size.
+ * put_count is advanced by the GATT callback only, acquire_count and
+ * release_count by the sink only. */
+static volatile uint32_t put_count = 0;
+static volatile uint32_t acquire_count = 0;
+static volatile uint32_t release_count = 0;
+static tput_rx_sink_t rx_sink = {0};
+static volatile bool backpressure = false;
+static uint32_t rx_seq_num = 0;
+static tput_rx_ring_stats_t stats;
+
+/******************************************************************************
+ * Function Definitions
+ ******************************************************************************/
+
+/*******************************************************************************
+* Function Name: tput_rx_ring_register_sink()
+********************************************************************************
+* Summary:
+*   Registers the consumer of notification payloads. Until a sink is
+*   registered, payloads are not copied into the ring.
+*
+* Parameters:
+*   const tput_rx_sink_t *p_sink : Sink callbacks, NULL to unregister
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void tput_rx_ring_register_sink(const tput_rx_sink_t *p_sink)
+{
+    taskENTER_CRITICAL();
+    if (NULL != p_sink)
+    {
+        rx_sink = *p_sink;
+    }
+    else
+    {
+        memset(&rx_sink, 0, sizeof(rx_sink));
+    }
+    taskEXIT_CRITICAL();
+}
+
+/*******************************************************************************
+* Function Name: tput_rx_ring_has_sink()
+********************************************************************************
+* Summary:
+*   Checks whether a sink is registered.
+*
+* Parameters:
+*   None
+*
+* Return:
+*   bool : true if a sink is registered
+*
+*******************************************************************************/
+bool tput_rx_ring_has_sink(void)
+{
+    return (NULL != rx_sink.on_data);
+}
+
+/*******************************************************************************
+* Function Name: tput_rx_ring_put()
+********************************************************************************
+* Summary:
+*   Copies a notification payload into the next free slot and notifies the
+*   sink. Called from the GATT callback, as the stack buffer is only valid
+*   for the duration of the GATTC_OPTYPE_NOTIFICATION event.
+*
+* Parameters:
+*   uint16_t conn_id       : Connection the notification was received on
+*   const uint8_t *p_data  : Payload
+*   uint16_t len           : Length of the payload
+*
+* Return:
+*   bool : false if the payload was dropped
+*
+*******************************************************************************/
+bool tput_rx_ring_put(uint16_t conn_id, const uint8_t *p_data, uint16_t len)
+{
+    tput_rx_pkt_t *p_pkt;
+    uint32_t lag;
+    bool assert_backpressure = false;
+
+    if (len > TPUT_RX_RING_SLOT_SIZE)
+    {
+        stats.oversize++;
+        return false;
+    }
+
+    lag = put_count - release_count;
+    if (lag >= TPUT_RX_RING_NUM_SLOTS)
+    {
+        stats.overruns++;
+        return false;
+    }
+
+    p_pkt = &ring_pkts[put_count % TPUT_RX_RING_NUM_SLOTS];
+    p_pkt->p_data = ring_data[put_count % TPUT_RX_RING_NUM_SLOTS];
+    memcpy(p_pkt->p_data, p_data, len);
+    p_pkt->len = len;
+    p_pkt->conn_id = conn_id;
+    p_pkt->rx_tick = xTaskGetTickCount();
+    p_pkt->rx_us = tput_time_us();
+    p_pkt->seq_num = rx_seq_num++;
+    stats.received++;
+    put_count++;
+
+    lag++;
+    if (lag > stats.max_lag)
+    {
+        stats.max_lag = (uint16_t)lag;
+    }
+
+    taskENTER_CRITICAL();
+    if ((!backpressure) && (lag >= TPUT_RX_RING_HIGH_WATERMARK))
+    {
+        backpressure = true;
+        assert_backpressure = true;
+        stats.backpressure_events++;
+    }
+    taskEXIT_CRITICAL();
+
+    if (assert_backpressure && (NULL != rx_sink.on_backpressure))
+    {
+        rx_sink.on_backpressure(true, rx_sink.p_ctx);
+    }
+    if (NULL != rx_sink.on_data)
+    {
+        rx_sink.on_data(rx_sink.p_ctx);
+    }
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: tput_rx_ring_acquire()
+********************************************************************************
+* Summary:
+*   Hands the next payload to the sink without copying it. Several payloads
+*   may be acquired before any is released.
+*
+* Parameters:
+*   None
+*
+* Return:
+*   const tput_rx_pkt_t * : Next payload, NULL if none is pending
+*
+*******************************************************************************/
+const tput_rx_pkt_t *tput_rx_ring_acquire(void)
+{
+    const tput_rx_pkt_t *p_pkt;
+
+    if (acquire_count == put_count)
+    {
+        return NULL;
+    }
+    p_pkt = &ring_pkts[acquire_count % TPUT_RX_RING_NUM_SLOTS];
+    acquire_count++;
+    return p_pkt;
+}
+
+/*******************************************************************************
+* Function Name: tput_rx_ring_release()
+********************************************************************************
+* Summary:
+*   Returns the oldest acquired payload to the ring. Its data must not be
+*   accessed afterwards.
+*
+* Parameters:
+*   None
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void tput_rx_ring_release(void)
+{
+    bool release_backpressure = false;
+
+    if (release_count == acquire_count)
+    {
+        return;
+    }
+    release_count++;
+    stats.released++;
+
+    taskENTER_CRITICAL();
+    if (backpressure &&
+        ((put_count - release_count) <= TPUT_RX_RING_LOW_WATERMARK))
+    {
+        backpressure = false;
+        release_backpressure = true;
+    }
+    taskEXIT_CRITICAL();
+
+    if (release_backpressure && (NULL != rx_sink.on_backpressure))
+    {
+        rx_sink.on_backpressure(false, rx_sink.p_ctx);
+    }
+}
+
+/*******************************************************************************
+* Function Name: tput_rx_ring_get_stats()
+********************************************************************************
+* Summary:
+*   Returns the ring statistics, including the current consumer lag.
+*
+* Parameters:
+*   tput_rx_ring_stats_t *p_stats : Pointer to the structure to be filled
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void tput_rx_ring_get_stats(tput_rx_ring_stats_t *p_stats)
+{
+    uint32_t oldest = release_count;
+
+    *p_stats = stats;
+    p_stats->lag = (uint16_t)(put_count - oldest);
+    p_stats->oldest_age_ms = 0;
+    if (0u != p_stats->lag)
+    {
+        p_stats->oldest_age_ms = (uint32_t)(xTaskGetTickCount() -
+                        ring_pkts[oldest % TPUT_RX_RING_NUM_SLOTS].rx_tick) *
+                                                        portTICK_PERIOD_MS;
+    }
+}
+
+/*******************************************************************************
+* Function Name: tput_rx_ring_clear_stats()
+********************************************************************************
+* Summary:
+*   Clears the ring statistics. Payloads held by the sink are not affected.
+*
+* Parameters:
+*   None
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void tput_rx_ring_clear_stats(void)
+{
+    memset(&stats, 0, sizeof(stats));
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,119 @@
+/*******************************************************************************
+ * File Name: tput_rx_ring.h
+ *
+ * Description: This file contains the declarations of the RX ring that
+ *              hands GATT notification payloads to a registered sink.
+ *
+ * Related Document: See README.md
+ *
+ *
+ *******************************************************************************
+ * Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ ******************************************************************************/
+
+#ifndef __TPUT_RX_RING_H__
+#define __TPUT_RX_RING_H__
+
+/******************************************************************************
+ *                                INCLUDES
+ ******************************************************************************/
+#include <FreeRTOS.h>
+#include <task.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "ble_client.h"
+
+/******************************************************************************
+ *                                Macros
+ ******************************************************************************/
+/* Number of notification payloads the ring can hold */
+#define TPUT_RX_RING_NUM_SLOTS          (16u)
+/* Largest payload a slot can hold. Longer notifications are dropped */
+#define TPUT_RX_RING_SLOT_SIZE          (GATT_WRITE_BYTES_MAX_LEN)
+/* Backpressure is asserted when the ring holds this many payloads ... */
+#define TPUT_RX_RING_HIGH_WATERMARK     (12u)
+/* ... and released when it has drained down to this many */
+#define TPUT_RX_RING_LOW_WATERMARK      (4u)
+
+/*******************************************************************************
+*        Structures and Enumerations
+*******************************************************************************/
+/* Notification payload held in the ring. p_data stays valid until the
+ * packet is released */
+typedef struct
+{
+    uint8_t    *p_data;
+    uint16_t    len;
+    uint16_t    conn_id;
+    TickType_t  rx_tick;            // time the notification was received
+    uint32_t    rx_us;              // same, from tput_time_us()
+    uint32_t    seq_num;            // running count of received notifications
+} tput_rx_pkt_t;
+
+/* Called from the GATT callback when a payload has been added to the ring */
+typedef void (*tput_rx_data_cb_t)(void *p_ctx);
+/* Called when the ring crosses the high (asserted = true) or the low
+ * (asserted = false) watermark */
+typedef void (*tput_rx_backpressure_cb_t)(bool asserted, void *p_ctx);
+
+typedef struct
+{
+    tput_rx_data_cb_t           on_data;
+    tput_rx_backpressure_cb_t   on_backpressure;
+    void                       *p_ctx;
+} tput_rx_sink_t;
+
+typedef struct
+{
+    uint32_t received;              // payloads added to the ring
+    uint32_t released;              // payloads released by the sink
+    uint32_t overruns;              // payloads dropped because the ring was full
+    uint32_t oversize;              // payloads dropped because they did not fit a slot
+    uint32_t backpressure_events;   // times the high watermark was crossed
+    uint16_t lag;                   // payloads not yet released
+    uint16_t max_lag;               // largest lag seen
+    uint32_t oldest_age_ms;         // age of the oldest payload not yet released
+} tput_rx_ring_stats_t;
+
+/****************************************************************************
+ *                              FUNCTION DECLARATIONS
+ ***************************************************************************/
+void tput_rx_ring_register_sink(const tput_rx_sink_t *p_sink);
+bool tput_rx_ring_has_sink(void);
+bool tput_rx_ring_put(uint16_t conn_id, const uint8_t *p_data, uint16_t len);
+const tput_rx_pkt_t *tput_rx_ring_acquire(void);
+void tput_rx_ring_release(void);
+void tput_rx_ring_get_stats(tput_rx_ring_stats_t *p_stats);
+void tput_rx_ring_clear_stats(void);
+
+#endif      /*__TPUT_RX_RING_H__ */
+/* [] END OF FILE */
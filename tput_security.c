@@ -0,0 +1,669 @@
+/*******************************************************************************
+ * File Name: tput_security.c
+ *
+ * Description: This file implements the encrypted link mode. The client pairs with LE
+ *              Secure Connections and bonds, keeps the keys of the bonded servers for
+ *              re-encryption on the next connections, and compares the throughput and
+ *              notification timing of encrypted and plaintext links.
+ *
+ * Related Document: See README.md
+ *
+ *
+ *******************************************************************************
+ * Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ ******************************************************************************/
+
+/******************************************************************************
+ *                                INCLUDES
+ ******************************************************************************/
+#include <stdio.h>
+#include <string.h>
+#include <FreeRTOS.h>
+#include <task.h>
+#include "wiced_bt_dev.h"
+#include "wiced_bt_ble.h"
+#include "tput_time.h"
+#include "tput_security.h"
+
+/*******************************************************************************
+*        Macros
+*******************************************************************************/
+/* Keys distributed by each side when pairing */
+#define TPUT_SECURITY_KEYS              (BTM_LE_KEY_PENC | BTM_LE_KEY_PID)
+#define TPUT_SECURITY_MAX_KEY_SIZE      (16u)
+
+/*******************************************************************************
+*        Structures and Enumerations
+*******************************************************************************/
+typedef enum
+{
+    TPUT_SECURITY_IDLE,         // not connected, or plaintext link
+    TPUT_SECURITY_PAIRING,      // pairing, then encrypting with the new keys
+    TPUT_SECURITY_ENCRYPTING,   // encrypting with the keys of a bond
+    TPUT_SECURITY_ENCRYPTED
+} tput_security_state_t;
+
+/*******************************************************************************
+*        Function Prototypes
+*******************************************************************************/
+static int32_t tput_security_find_bond(const uint8_t *p_bd_addr);
+static void tput_security_pair(void);
+static void tput_security_link_sample(tput_security_link_stats_t *p_link,
+                                      uint32_t rx_kbps, uint32_t tx_kbps,
+                                      uint32_t interarrival_us,
+                                      uint32_t jitter_us);
+static void tput_security_link_print(const char *p_name,
+                                     const tput_security_link_stats_t *p_link);
+
+/*******************************************************************************
+*        Variable Definitions
+*******************************************************************************/
+static bool enabled = false;
+static volatile tput_security_state_t state = TPUT_SECURITY_IDLE;
+static wiced_bt_device_address_t link_addr;
+static uint8_t link_addr_type;
+static uint32_t start_us = 0;
+/* Keys of the bonded servers, kept in RAM */
+static wiced_bt_device_link_keys_t bonds[TPUT_SECURITY_MAX_BONDS];
+static bool bond_valid[TPUT_SECURITY_MAX_BONDS];
+static uint32_t next_bond = 0;
+static wiced_bt_local_identity_keys_t identity_keys;
+static bool identity_keys_valid = false;
+static tput_security_stats_t stats = {0};
+
+/******************************************************************************
+ * Function Definitions
+ ******************************************************************************/
+
+/*******************************************************************************
+* Function Name: tput_security_init()
+********************************************************************************
+* Summary:
+*   Sets the pairable mode of the stack. Pairing is only allowed in the
+*   encrypted link mode. Called once the stack is enabled.
+*
+* Parameters:
+*   None
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void tput_security_init(void)
+{
+    wiced_bt_set_pairable_mode(enabled ? WICED_TRUE : WICED_FALSE, 0);
+}
+
+/*******************************************************************************
+* Function Name: tput_security_enable()
+********************************************************************************
+* Summary:
+*   Enables or disables the encrypted link mode. Takes effect on the next
+*   connection; the current link stays as it is.
+*
+* Parameters:
+*   bool on : true to pair with, or re-encrypt, every server connected to
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void tput_security_enable(bool on)
+{
+    enabled = on;
+    tput_security_init();
+}
+
+/*******************************************************************************
+* Function Name: tput_security_is_enabled()
+********************************************************************************
+* Summary:
+*   Tells if the encrypted link mode is enabled.
+*
+* Parameters:
+*   None
+*
+* Return:
+*   bool : true if enabled
+*
+*******************************************************************************/
+bool tput_security_is_enabled(void)
+{
+    return enabled;
+}
+
+/*******************************************************************************
+* Function Name: tput_security_is_encrypted()
+********************************************************************************
+* Summary:
+*   Tells if the current link is encrypted.
+*
+* Parameters:
+*   None
+*
+* Return:
+*   bool : true if encrypted
+*
+*******************************************************************************/
+bool tput_security_is_encrypted(void)
+{
+    return (TPUT_SECURITY_ENCRYPTED == state);
+}
+
+/*******************************************************************************
+* Function Name: tput_security_on_connected()
+********************************************************************************
+* Summary:
+*   Called from the GATT callback on connection. In the encrypted link mode,
+*   encrypts the link with the keys of the server if it is bonded, and pairs
+*   with it otherwise. Runs alongside the MTU exchange and the discovery.
+*
+* Parameters:
+*   const uint8_t *p_bd_addr : Address of the server
+*   uint8_t addr_type        : Address type of the server
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void tput_security_on_connected(const uint8_t *p_bd_addr, uint8_t addr_type)
+{
+    wiced_result_t result;
+
+    state = TPUT_SECURITY_IDLE;
+    if (!enabled)
+    {
+        return;
+    }
+    memcpy(link_addr, p_bd_addr, BD_ADDR_LEN);
+    link_addr_type = addr_type;
+    start_us = tput_time_us();
+
+    if (tput_security_find_bond(p_bd_addr) < 0)
+    {
+        tput_security_pair();
+        return;
+    }
+    state = TPUT_SECURITY_ENCRYPTING;
+    result = wiced_bt_dev_set_encryption(link_addr, BT_TRANSPORT_LE, NULL);
+    if ((WICED_BT_SUCCESS != result) && (WICED_BT_PENDING != result))
+    {
+        printf("Re-encryption failed to start: %d, pairing\n", (int)result);
+        stats.reencryption_failures++;
+        tput_security_pair();
+    }
+}
+
+/*******************************************************************************
+* Function Name: tput_security_on_disconnected()
+********************************************************************************
+* Summary:
+*   Called from the GATT callback on disconnection.
+*
+* Parameters:
+*   None
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void tput_security_on_disconnected(void)
+{
+    state = TPUT_SECURITY_IDLE;
+}
+
+/*******************************************************************************
+* Function Name: tput_security_on_mgmt_event()
+********************************************************************************
+* Summary:
+*   Handles the pairing, encryption and key storage events of the stack.
+*   Pairing uses LE Secure Connections with bonding, Just Works, as the
+*   client has no input or output.
+*
+* Parameters:
+*   wiced_bt_management_evt_t event              : Event
+*   wiced_bt_management_evt_data_t *p_event_data : Event data
+*   wiced_result_t *p_result                     : Result returned to the stack
+*
+* Return:
+*   bool : false if the event is not a security event handled here
+*
+*******************************************************************************/
+bool tput_security_on_mgmt_event(wiced_bt_management_evt_t event,
+                                 wiced_bt_management_evt_data_t *p_event_data,
+                                 wiced_result_t *p_result)
+{
+    wiced_bt_dev_ble_io_caps_req_t *p_io_caps;
+    wiced_bt_device_link_keys_t *p_keys;
+    uint32_t elapsed_ms;
+    int32_t bond;
+
+    *p_result = WICED_BT_SUCCESS;
+    switch (event)
+    {
+    case BTM_PAIRING_IO_CAPABILITIES_BLE_REQUEST_EVT:
+        p_io_caps = &p_event_data->pairing_io_capabilities_ble_request;
+        p_io_caps->local_io_cap = BTM_IO_CAPABILITIES_NONE;
+        p_io_caps->oob_data = BTM_OOB_NONE;
+        p_io_caps->auth_req = BTM_LE_AUTH_REQ_SC_BOND;
+        p_io_caps->max_key_size = TPUT_SECURITY_MAX_KEY_SIZE;
+        p_io_caps->init_keys = TPUT_SECURITY_KEYS;
+        p_io_caps->resp_keys = TPUT_SECURITY_KEYS;
+        return true;
+
+    case BTM_USER_CONFIRMATION_REQUEST_EVT:
+        wiced_bt_dev_confirm_req_reply(WICED_BT_SUCCESS,
+                            p_event_data->user_confirmation_request.bd_addr);
+        return true;
+
+    case BTM_SECURITY_REQUEST_EVT:
+        if (!enabled)
+        {
+            return false;
+        }
+        wiced_bt_ble_security_grant(p_event_data->security_request.bd_addr,
+                                    WICED_BT_SUCCESS);
+        return true;
+
+    case BTM_PAIRING_COMPLETE_EVT:
+        if (WICED_BT_SUCCESS !=
+            p_event_data->pairing_complete.pairing_complete_info.ble.status)
+        {
+            printf("Pairing failed: %d\n",
+               (int)p_event_data->pairing_complete.pairing_complete_info.ble.status);
+            stats.pairing_failures++;
+            state = TPUT_SECURITY_IDLE;
+        }
+        /* Otherwise, the link is encrypted with the new keys next */
+        return true;
+
+    case BTM_ENCRYPTION_STATUS_EVT:
+        elapsed_ms = (tput_time_us() - start_us) / 1000u;
+        if (WICED_BT_SUCCESS == p_event_data->encryption_status.result)
+        {
+            taskENTER_CRITICAL();
+            if (TPUT_SECURITY_PAIRING == state)
+            {
+                stats.pairings++;
+                stats.pairing_ms_last = elapsed_ms;
+                if (elapsed_ms > stats.pairing_ms_max)
+                {
+                    stats.pairing_ms_max = elapsed_ms;
+                }
+            }
+            else if (TPUT_SECURITY_ENCRYPTING == state)
+            {
+                stats.reencryptions++;
+                stats.reencryption_ms_last = elapsed_ms;
+                if (elapsed_ms > stats.reencryption_ms_max)
+                {
+                    stats.reencryption_ms_max = elapsed_ms;
+                }
+            }
+            taskEXIT_CRITICAL();
+            printf("Link encrypted after %lu ms (%s)\n",
+                   (unsigned long)elapsed_ms,
+                   (TPUT_SECURITY_ENCRYPTING == state) ? "re-encryption" :
+                   (TPUT_SECURITY_PAIRING == state) ? "pairing" : "server");
+            state = TPUT_SECURITY_ENCRYPTED;
+        }
+        else if (TPUT_SECURITY_ENCRYPTING == state)
+        {
+            /* The server lost the bond */
+            printf("Re-encryption failed: %d, pairing again\n",
+                   (int)p_event_data->encryption_status.result);
+            stats.reencryption_failures++;
+            bond = tput_security_find_bond(link_addr);
+            if (bond >= 0)
+            {
+                bond_valid[bond] = false;
+            }
+            tput_security_pair();
+        }
+        else
+        {
+            state = TPUT_SECURITY_IDLE;
+        }
+        return true;
+
+    case BTM_PAIRED_DEVICE_LINK_KEYS_UPDATE_EVT:
+        p_keys = &p_event_data->paired_device_link_keys_update;
+        bond = tput_security_find_bond(p_keys->bd_addr);
+        if (bond < 0)
+        {
+            bond = (int32_t)next_bond;
+            next_bond = (next_bond + 1u) % TPUT_SECURITY_MAX_BONDS;
+        }
+        bonds[bond] = *p_keys;
+        bond_valid[bond] = true;
+        wiced_bt_dev_add_device_to_address_resolution_db(p_keys);
+        return true;
+
+    case BTM_PAIRED_DEVICE_LINK_KEYS_REQUEST_EVT:
+        p_keys = &p_event_data->paired_device_link_keys_request;
+        bond = tput_security_find_bond(p_keys->bd_addr);
+        if (bond < 0)
+        {
+            *p_result = WICED_BT_ERROR;
+        }
+        else
+        {
+            *p_keys = bonds[bond];
+        }
+        return true;
+
+    case BTM_LOCAL_IDENTITY_KEYS_UPDATE_EVT:
+        identity_keys = p_event_data->local_identity_keys_update;
+        identity_keys_valid = true;
+        return true;
+
+    case BTM_LOCAL_IDENTITY_KEYS_REQUEST_EVT:
+        if (identity_keys_valid)
+        {
+            p_event_data->local_identity_keys_request = identity_keys;
+        }
+        else
+        {
+            /* The stack generates new keys */
+            *p_result = WICED_BT_ERROR;
+        }
+        return true;
+
+    default:
+        return false;
+    }
+}
+
+/*******************************************************************************
+* Function Name: tput_security_forget()
+********************************************************************************
+* Summary:
+*   Deletes the bonds, so that the next connection to each server pairs
+*   again.
+*
+* Parameters:
+*   None
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void tput_security_forget(void)
+{
+    uint32_t bond;
+
+    for (bond = 0; bond < TPUT_SECURITY_MAX_BONDS; bond++)
+    {
+        if (bond_valid[bond])
+        {
+            wiced_bt_dev_remove_device_from_address_resolution_db(&bonds[bond]);
+            wiced_bt_dev_delete_bonded_device(bonds[bond].bd_addr);
+            bond_valid[bond] = false;
+        }
+    }
+    next_bond = 0;
+}
+
+/*******************************************************************************
+* Function Name: tput_security_sample()
+********************************************************************************
+* Summary:
+*   Adds the measurements of one second to the statistics of encrypted or
+*   plaintext links, by the state of the link at the end of the second.
+*
+* Parameters:
+*   uint32_t rx_kbps         : Throughput received, 0 if none
+*   uint32_t tx_kbps         : Throughput written, 0 if none
+*   uint32_t interarrival_us : Average notification inter-arrival time, 0 if
+*                              none
+*   uint32_t jitter_us       : Notification jitter
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void tput_security_sample(uint32_t rx_kbps, uint32_t tx_kbps,
+                          uint32_t interarrival_us, uint32_t jitter_us)
+{
+    taskENTER_CRITICAL();
+    tput_security_link_sample(tput_security_is_encrypted() ? &stats.encrypted :
+                                                             &stats.plain,
+                              rx_kbps, tx_kbps, interarrival_us, jitter_us);
+    taskEXIT_CRITICAL();
+}
+
+/*******************************************************************************
+* Function Name: tput_security_get_stats()
+********************************************************************************
+* Summary:
+*   Reads the statistics of the encrypted link mode.
+*
+* Parameters:
+*   tput_security_stats_t *p_stats : Statistics read
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void tput_security_get_stats(tput_security_stats_t *p_stats)
+{
+    taskENTER_CRITICAL();
+    *p_stats = stats;
+    taskEXIT_CRITICAL();
+}
+
+/*******************************************************************************
+* Function Name: tput_security_clear_stats()
+********************************************************************************
+* Summary:
+*   Clears the statistics of the encrypted link mode.
+*
+* Parameters:
+*   None
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void tput_security_clear_stats(void)
+{
+    taskENTER_CRITICAL();
+    memset(&stats, 0, sizeof(stats));
+    taskEXIT_CRITICAL();
+}
+
+/*******************************************************************************
+* Function Name: tput_security_print()
+********************************************************************************
+* Summary:
+*   Prints the throughput and notification timing of plaintext and
+*   encrypted links side by side, and the pairing and re-encryption times.
+*
+* Parameters:
+*   None
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void tput_security_print(void)
+{
+    tput_security_stats_t sec_stats;
+
+    tput_security_get_stats(&sec_stats);
+    printf("Encrypted link mode %s, link %s\n", enabled ? "on" : "off",
+           tput_security_is_encrypted() ? "encrypted" : "plaintext");
+    printf("Link       RX kbps  TX kbps  Interval us  Jitter us  Seconds\n");
+    tput_security_link_print("Plaintext", &sec_stats.plain);
+    tput_security_link_print("Encrypted", &sec_stats.encrypted);
+    printf("Pairing: %lu, last %lu ms, max %lu ms, failed %lu\n",
+           (unsigned long)sec_stats.pairings,
+           (unsigned long)sec_stats.pairing_ms_last,
+           (unsigned long)sec_stats.pairing_ms_max,
+           (unsigned long)sec_stats.pairing_failures);
+    printf("Re-encryption: %lu, last %lu ms, max %lu ms, failed %lu\n",
+           (unsigned long)sec_stats.reencryptions,
+           (unsigned long)sec_stats.reencryption_ms_last,
+           (unsigned long)sec_stats.reencryption_ms_max,
+           (unsigned long)sec_stats.reencryption_failures);
+}
+
+/*******************************************************************************
+* Function Name: tput_security_find_bond()
+********************************************************************************
+* Summary:
+*   Finds the bond of a server.
+*
+* Parameters:
+*   const uint8_t *p_bd_addr : Address of the server
+*
+* Return:
+*   int32_t : Index of the bond, -1 if not bonded
+*
+*******************************************************************************/
+static int32_t tput_security_find_bond(const uint8_t *p_bd_addr)
+{
+    uint32_t bond;
+
+    for (bond = 0; bond < TPUT_SECURITY_MAX_BONDS; bond++)
+    {
+        if (bond_valid[bond] &&
+            (0 == memcmp(bonds[bond].bd_addr, p_bd_addr, BD_ADDR_LEN)))
+        {
+            return (int32_t)bond;
+        }
+    }
+    return -1;
+}
+
+/*******************************************************************************
+* Function Name: tput_security_pair()
+********************************************************************************
+* Summary:
+*   Starts pairing and bonding with the server of the current link.
+*
+* Parameters:
+*   None
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+static void tput_security_pair(void)
+{
+    wiced_result_t result;
+
+    state = TPUT_SECURITY_PAIRING;
+    result = wiced_bt_dev_sec_bond(link_addr, link_addr_type, BT_TRANSPORT_LE,
+                                   0, NULL);
+    if ((WICED_BT_SUCCESS != result) && (WICED_BT_PENDING != result))
+    {
+        printf("Pairing failed to start: %d\n", (int)result);
+        stats.pairing_failures++;
+        state = TPUT_SECURITY_IDLE;
+    }
+}
+
+/*******************************************************************************
+* Function Name: tput_security_link_sample()
+********************************************************************************
+* Summary:
+*   Adds the measurements of one second to the statistics of one security
+*   state. Directions without data in that second are left out.
+*
+* Parameters:
+*   tput_security_link_stats_t *p_link : Statistics updated
+*   uint32_t rx_kbps                   : Throughput received
+*   uint32_t tx_kbps                   : Throughput written
+*   uint32_t interarrival_us           : Notification inter-arrival time
+*   uint32_t jitter_us                 : Notification jitter
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+static void tput_security_link_sample(tput_security_link_stats_t *p_link,
+                                      uint32_t rx_kbps, uint32_t tx_kbps,
+                                      uint32_t interarrival_us,
+                                      uint32_t jitter_us)
+{
+    if (rx_kbps)
+    {
+        p_link->rx_seconds++;
+        p_link->rx_kbps_sum += rx_kbps;
+    }
+    if (tx_kbps)
+    {
+        p_link->tx_seconds++;
+        p_link->tx_kbps_sum += tx_kbps;
+    }
+    if (interarrival_us)
+    {
+        p_link->timing_seconds++;
+        p_link->interarrival_sum_us += interarrival_us;
+        p_link->jitter_sum_us += jitter_us;
+    }
+}
+
+/*******************************************************************************
+* Function Name: tput_security_link_print()
+********************************************************************************
+* Summary:
+*   Prints the averages of one security state.
+*
+* Parameters:
+*   const char *p_name                       : Name of the state
+*   const tput_security_link_stats_t *p_link : Statistics
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+static void tput_security_link_print(const char *p_name,
+                                     const tput_security_link_stats_t *p_link)
+{
+    uint32_t seconds = (p_link->rx_seconds > p_link->tx_seconds) ?
+                       p_link->rx_seconds : p_link->tx_seconds;
+
+    printf("%-9s  %7lu  %7lu  %11lu  %9lu  %7lu\n", p_name,
+           (unsigned long)(p_link->rx_seconds ?
+                           p_link->rx_kbps_sum / p_link->rx_seconds : 0u),
+           (unsigned long)(p_link->tx_seconds ?
+                           p_link->tx_kbps_sum / p_link->tx_seconds : 0u),
+           (unsigned long)(p_link->timing_seconds ?
+                    p_link->interarrival_sum_us / p_link->timing_seconds : 0u),
+           (unsigned long)(p_link->timing_seconds ?
+                    p_link->jitter_sum_us / p_link->timing_seconds : 0u),
+           (unsigned long)seconds);
+}
+
+/* [] END OF FILE */
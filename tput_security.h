@@ -0,0 +1,109 @@
+/*******************************************************************************
+ * File Name: tput_security.h
+ *
+ * Description: This file contains the declarations of the encrypted link mode.
+ *
+ * Related Document: See README.md
+ *
+ *
+ *******************************************************************************
+ * Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ ******************************************************************************/
+
+#ifndef __TPUT_SECURITY_H__
+#define __TPUT_SECURITY_H__
+
+/******************************************************************************
+ *                                INCLUDES
+ ******************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include "wiced_bt_dev.h"
+
+/*******************************************************************************
+*        Macros
+*******************************************************************************/
+/* Servers whose keys are kept for re-encryption. The oldest bond is
+ * replaced when a new server is paired */
+#define TPUT_SECURITY_MAX_BONDS         (4u)
+
+/*******************************************************************************
+*        Structures and Enumerations
+*******************************************************************************/
+/* Throughput and notification timing, accumulated over the seconds data
+ * flowed on links in one security state */
+typedef struct
+{
+    uint32_t rx_seconds;
+    uint32_t rx_kbps_sum;
+    uint32_t tx_seconds;
+    uint32_t tx_kbps_sum;
+    uint32_t timing_seconds;    // seconds with notification inter-arrivals
+    uint32_t interarrival_sum_us;
+    uint32_t jitter_sum_us;
+} tput_security_link_stats_t;
+
+typedef struct
+{
+    tput_security_link_stats_t plain;
+    tput_security_link_stats_t encrypted;
+    uint32_t pairings;          // completed with bonding
+    uint32_t pairing_failures;
+    uint32_t pairing_ms_last;   // pairing started to link encrypted
+    uint32_t pairing_ms_max;
+    uint32_t reencryptions;     // with the keys of a bond
+    uint32_t reencryption_failures;
+    uint32_t reencryption_ms_last;
+    uint32_t reencryption_ms_max;
+} tput_security_stats_t;
+
+/****************************************************************************
+ *                              FUNCTION DECLARATIONS
+ ***************************************************************************/
+void tput_security_init(void);
+void tput_security_enable(bool on);
+bool tput_security_is_enabled(void);
+bool tput_security_is_encrypted(void);
+void tput_security_on_connected(const uint8_t *p_bd_addr, uint8_t addr_type);
+void tput_security_on_disconnected(void);
+bool tput_security_on_mgmt_event(wiced_bt_management_evt_t event,
+                                 wiced_bt_management_evt_data_t *p_event_data,
+                                 wiced_result_t *p_result);
+void tput_security_forget(void);
+void tput_security_sample(uint32_t rx_kbps, uint32_t tx_kbps,
+                          uint32_t interarrival_us, uint32_t jitter_us);
+void tput_security_get_stats(tput_security_stats_t *p_stats);
+void tput_security_clear_stats(void);
+void tput_security_print(void);
+
+#endif      /*__TPUT_SECURITY_H__ */
+/* [] END OF FILE */
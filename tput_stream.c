@@ -0,0 +1,732 @@
+/*******************************************************************************
+ * File Name: tput_stream.c
+ *
+ * Description: This file implements the prioritized TX arbiter. Control
+ *              and latency sensitive messages are queued per stream and sent
+ *              ahead of, or interleaved with, the writes of the data transfer
+ *              mode, by strict priority or deficit round robin.
+ *
+ * Related Document: See README.md
+ *
+ *
+ *******************************************************************************
+ * Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ ******************************************************************************/
+
+/******************************************************************************
+ *                                INCLUDES
+ ******************************************************************************/
+#include <stdio.h>
+#include <string.h>
+#include <FreeRTOS.h>
+#include <task.h>
+#include "tput_time.h"
+#include "tput_cwnd.h"
+#include "tput_stream.h"
+
+#if TPUT_STREAM_ENABLE
+
+/*******************************************************************************
+*        Macros
+*******************************************************************************/
+/* Write commands in flight, at most one window */
+#define TPUT_STREAM_IN_FLIGHT_LEN       (TPUT_CWND_MAX_PKTS)
+/* Streams visited by one deficit round robin selection, enough for the
+ * largest packet at the smallest weight */
+#define TPUT_STREAM_DRR_VISITS          (4u * TPUT_STREAM_COUNT)
+
+/*******************************************************************************
+*        Structures and Enumerations
+*******************************************************************************/
+typedef struct
+{
+    tput_stream_msg_t msgs[TPUT_STREAM_QUEUE_LEN];
+    uint32_t head;
+    uint32_t count;
+} tput_stream_queue_t;
+
+typedef struct
+{
+    uint8_t  stream;
+    uint16_t len;
+} tput_stream_in_flight_t;
+
+/*******************************************************************************
+*        Function Prototypes
+*******************************************************************************/
+static bool tput_stream_is_queued(tput_stream_id_t stream);
+
+/*******************************************************************************
+*        Variable Definitions
+*******************************************************************************/
+static const char *stream_names[TPUT_STREAM_COUNT] =
+{
+    "control",
+    "latency",
+    "bulk"
+};
+static const uint16_t stream_handles[TPUT_STREAM_COUNT] =
+{
+    TPUT_STREAM_CONTROL_HANDLE,
+    TPUT_STREAM_LATENCY_HANDLE,
+    GATT_WRITE_HANDLE
+};
+static tput_stream_wake_cb_t wake_cb = NULL;
+static uint16_t service_handle = 0;
+/* Only the control and latency streams are queued */
+static tput_stream_queue_t queues[TPUT_STREAM_BULK];
+static uint8_t weights[TPUT_STREAM_COUNT] =
+{
+    0u,
+    TPUT_STREAM_LATENCY_WEIGHT,
+    TPUT_STREAM_BULK_WEIGHT
+};
+/* Deficit round robin state of the weighted streams */
+static uint32_t deficits[TPUT_STREAM_COUNT];
+static uint32_t drr_current = 0;
+/* Streams of the write commands in flight, completed in order */
+static tput_stream_in_flight_t in_flight[TPUT_STREAM_IN_FLIGHT_LEN];
+static uint32_t in_flight_head = 0;
+static uint32_t in_flight_count = 0;
+/* The write recorded last was added to in_flight */
+static bool in_flight_pushed = false;
+/* Messages generated on the latency stream */
+static uint32_t periodic_ms = 0;
+static uint16_t periodic_len = 0;
+static uint32_t periodic_last_us = 0;
+static uint32_t seq = 0;
+static tput_stream_stats_t stats[TPUT_STREAM_COUNT];
+
+/******************************************************************************
+ * Function Definitions
+ ******************************************************************************/
+
+/*******************************************************************************
+* Function Name: tput_stream_init()
+********************************************************************************
+* Summary:
+*   Registers the function that wakes up the task sending the writes.
+*
+* Parameters:
+*   tput_stream_wake_cb_t wake : Called when a message is queued
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void tput_stream_init(tput_stream_wake_cb_t wake)
+{
+    wake_cb = wake;
+}
+
+/*******************************************************************************
+* Function Name: tput_stream_reset()
+********************************************************************************
+* Summary:
+*   Drops the queued messages and forgets the writes in flight. Called on
+*   connection, with 0, and once the service is discovered, with its
+*   handle. The weights and the generated messages are kept.
+*
+* Parameters:
+*   uint16_t handle : Handle of the throughput service, 0 if unknown
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void tput_stream_reset(uint16_t handle)
+{
+    taskENTER_CRITICAL();
+    service_handle = handle;
+    memset(queues, 0, sizeof(queues));
+    memset(deficits, 0, sizeof(deficits));
+    drr_current = 0;
+    in_flight_head = 0;
+    in_flight_count = 0;
+    in_flight_pushed = false;
+    taskEXIT_CRITICAL();
+}
+
+/*******************************************************************************
+* Function Name: tput_stream_name()
+********************************************************************************
+* Summary:
+*   Returns the name of a stream.
+*
+* Parameters:
+*   tput_stream_id_t stream : Stream
+*
+* Return:
+*   const char * : Name, "none" if invalid
+*
+*******************************************************************************/
+const char *tput_stream_name(tput_stream_id_t stream)
+{
+    return (stream < TPUT_STREAM_COUNT) ? stream_names[stream] : "none";
+}
+
+/*******************************************************************************
+* Function Name: tput_stream_set_weight()
+********************************************************************************
+* Summary:
+*   Sets the weight of the latency or bulk stream.
+*
+* Parameters:
+*   tput_stream_id_t stream : TPUT_STREAM_LATENCY or TPUT_STREAM_BULK
+*   uint8_t weight          : 0 for strict priority, else its share
+*
+* Return:
+*   bool : false for the control stream, which is always strict
+*
+*******************************************************************************/
+bool tput_stream_set_weight(tput_stream_id_t stream, uint8_t weight)
+{
+    if ((TPUT_STREAM_CONTROL == stream) || (stream >= TPUT_STREAM_COUNT))
+    {
+        return false;
+    }
+    taskENTER_CRITICAL();
+    weights[stream] = weight;
+    deficits[stream] = 0;
+    taskEXIT_CRITICAL();
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: tput_stream_get_weight()
+********************************************************************************
+* Summary:
+*   Returns the weight of a stream.
+*
+* Parameters:
+*   tput_stream_id_t stream : Stream
+*
+* Return:
+*   uint8_t : 0 for strict priority, else its share
+*
+*******************************************************************************/
+uint8_t tput_stream_get_weight(tput_stream_id_t stream)
+{
+    return (stream < TPUT_STREAM_COUNT) ? weights[stream] : 0u;
+}
+
+/*******************************************************************************
+* Function Name: tput_stream_enqueue()
+********************************************************************************
+* Summary:
+*   Queues a message on the control or latency stream, and wakes up the
+*   task sending the writes. May be called from any task or from the GATT
+*   callback.
+*
+* Parameters:
+*   tput_stream_id_t stream : TPUT_STREAM_CONTROL or TPUT_STREAM_LATENCY
+*   uint16_t handle         : Attribute written, 0 for the characteristic of
+*                             the stream
+*   bool request            : true for a write request, else a write command
+*   const uint8_t *p_data   : Message
+*   uint16_t len            : Length, at most TPUT_STREAM_MAX_MSG_LEN
+*
+* Return:
+*   bool : false if not connected, or if the queue is full
+*
+*******************************************************************************/
+bool tput_stream_enqueue(tput_stream_id_t stream, uint16_t handle,
+                         bool request, const uint8_t *p_data, uint16_t len)
+{
+    tput_stream_queue_t *p_queue;
+    tput_stream_msg_t *p_msg;
+    uint32_t now_us = tput_time_us();
+
+    if ((!tput_stream_is_queued(stream)) || (0 == service_handle) ||
+        (0 == len) || (len > TPUT_STREAM_MAX_MSG_LEN))
+    {
+        return false;
+    }
+    p_queue = &queues[stream];
+
+    taskENTER_CRITICAL();
+    if (TPUT_STREAM_QUEUE_LEN == p_queue->count)
+    {
+        stats[stream].dropped++;
+        taskEXIT_CRITICAL();
+        return false;
+    }
+    /* Only the sending task removes messages, from the head */
+    p_msg = &p_queue->msgs[(p_queue->head + p_queue->count) %
+                           TPUT_STREAM_QUEUE_LEN];
+    p_msg->handle = handle ? handle : service_handle + stream_handles[stream];
+    p_msg->request = request;
+    p_msg->len = len;
+    memcpy(p_msg->data, p_data, len);
+    p_msg->enqueue_us = now_us;
+    p_queue->count++;
+    if (p_queue->count > stats[stream].max_depth)
+    {
+        stats[stream].max_depth = (uint16_t)p_queue->count;
+    }
+    taskEXIT_CRITICAL();
+
+    if (NULL != wake_cb)
+    {
+        wake_cb();
+    }
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: tput_stream_send()
+********************************************************************************
+* Summary:
+*   Queues a generated write command on the control or latency stream. The
+*   message starts with its sequence number and queuing time in
+*   microseconds, little endian, and is padded with zeros.
+*
+* Parameters:
+*   tput_stream_id_t stream : TPUT_STREAM_CONTROL or TPUT_STREAM_LATENCY
+*   uint16_t len            : Length, 8 to TPUT_STREAM_MAX_MSG_LEN
+*
+* Return:
+*   bool : false if the message was not queued
+*
+*******************************************************************************/
+bool tput_stream_send(tput_stream_id_t stream, uint16_t len)
+{
+    uint8_t msg[TPUT_STREAM_MAX_MSG_LEN] = {0};
+    uint32_t now_us = tput_time_us();
+
+    if ((len < TPUT_STREAM_MIN_MSG_LEN) || (len > TPUT_STREAM_MAX_MSG_LEN))
+    {
+        return false;
+    }
+    memcpy(&msg[0], &seq, sizeof(seq));
+    memcpy(&msg[4], &now_us, sizeof(now_us));
+    seq++;
+    return tput_stream_enqueue(stream, 0u, false, msg, len);
+}
+
+/*******************************************************************************
+* Function Name: tput_stream_periodic()
+********************************************************************************
+* Summary:
+*   Starts or stops generating messages on the latency stream. They are
+*   generated on the ticks of the task sending the writes, so only in the
+*   data transfer modes with GATT writes.
+*
+* Parameters:
+*   uint32_t period_ms : Period, 0 to stop
+*   uint16_t len       : Length of each message
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void tput_stream_periodic(uint32_t period_ms, uint16_t len)
+{
+    periodic_len = len;
+    periodic_last_us = tput_time_us();
+    periodic_ms = period_ms;
+}
+
+/*******************************************************************************
+* Function Name: tput_stream_tick()
+********************************************************************************
+* Summary:
+*   Generates the periodic latency messages that are due. Called every
+*   tick by the task sending the writes.
+*
+* Parameters:
+*   None
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void tput_stream_tick(void)
+{
+    uint32_t now_us;
+
+    if (0 == periodic_ms)
+    {
+        return;
+    }
+    now_us = tput_time_us();
+    if ((now_us - periodic_last_us) >= (periodic_ms * 1000u))
+    {
+        periodic_last_us = now_us;
+        tput_stream_send(TPUT_STREAM_LATENCY, periodic_len);
+    }
+}
+
+/*******************************************************************************
+* Function Name: tput_stream_select()
+********************************************************************************
+* Summary:
+*   Selects the stream of the next write. Backlogged strict priority
+*   streams are served first, from the control stream down. The weighted
+*   streams then share the writes by deficit round robin, in bytes. Called
+*   by the task sending the writes.
+*
+* Parameters:
+*   bool bulk_ready   : true if the data transfer mode has a write to send
+*   uint16_t bulk_len : Length of the writes of the data transfer mode
+*
+* Return:
+*   tput_stream_id_t : Stream to send from, TPUT_STREAM_COUNT if none
+*
+*******************************************************************************/
+tput_stream_id_t tput_stream_select(bool bulk_ready, uint16_t bulk_len)
+{
+    uint32_t costs[TPUT_STREAM_COUNT];
+    bool ready[TPUT_STREAM_COUNT];
+    uint32_t stream;
+    uint32_t visit;
+
+    for (stream = 0; stream < TPUT_STREAM_BULK; stream++)
+    {
+        ready[stream] = (0u != queues[stream].count);
+        costs[stream] = ready[stream] ?
+                        queues[stream].msgs[queues[stream].head].len : 0u;
+    }
+    ready[TPUT_STREAM_BULK] = bulk_ready;
+    costs[TPUT_STREAM_BULK] = bulk_len;
+
+    for (stream = 0; stream < TPUT_STREAM_COUNT; stream++)
+    {
+        if (ready[stream] && (0u == weights[stream]))
+        {
+            return (tput_stream_id_t)stream;
+        }
+    }
+
+    for (visit = 0; visit < TPUT_STREAM_DRR_VISITS; visit++)
+    {
+        stream = drr_current;
+        if (ready[stream] && weights[stream])
+        {
+            if (deficits[stream] >= costs[stream])
+            {
+                return (tput_stream_id_t)stream;
+            }
+        }
+        else
+        {
+            /* Idle streams keep no credit */
+            deficits[stream] = 0;
+        }
+        drr_current = (drr_current + 1u) % TPUT_STREAM_COUNT;
+        if (ready[drr_current])
+        {
+            deficits[drr_current] += (uint32_t)weights[drr_current] *
+                                     TPUT_STREAM_QUANTUM;
+        }
+    }
+    return TPUT_STREAM_COUNT;
+}
+
+/*******************************************************************************
+* Function Name: tput_stream_peek()
+********************************************************************************
+* Summary:
+*   Returns the next message of the control or latency stream. It stays
+*   queued until tput_stream_on_sent().
+*
+* Parameters:
+*   tput_stream_id_t stream : TPUT_STREAM_CONTROL or TPUT_STREAM_LATENCY
+*
+* Return:
+*   const tput_stream_msg_t * : Message, NULL if none
+*
+*******************************************************************************/
+const tput_stream_msg_t *tput_stream_peek(tput_stream_id_t stream)
+{
+    if ((!tput_stream_is_queued(stream)) || (0u == queues[stream].count))
+    {
+        return NULL;
+    }
+    return &queues[stream].msgs[queues[stream].head];
+}
+
+/*******************************************************************************
+* Function Name: tput_stream_on_sent()
+********************************************************************************
+* Summary:
+*   Called once the stack accepted a write of a stream. Charges its length
+*   to the stream, removes a queued message and records its queuing delay.
+*
+* Parameters:
+*   tput_stream_id_t stream : Stream selected
+*   uint16_t len            : Length of a write of the data transfer mode,
+*                             unused for the queued streams
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void tput_stream_on_sent(tput_stream_id_t stream, uint16_t len)
+{
+    tput_stream_queue_t *p_queue;
+    tput_stream_msg_t *p_msg;
+    uint32_t delay_us;
+
+    if (stream >= TPUT_STREAM_COUNT)
+    {
+        return;
+    }
+    if (tput_stream_is_queued(stream))
+    {
+        p_queue = &queues[stream];
+        p_msg = &p_queue->msgs[p_queue->head];
+        len = p_msg->len;
+        delay_us = tput_time_us() - p_msg->enqueue_us;
+
+        taskENTER_CRITICAL();
+        p_queue->head = (p_queue->head + 1u) % TPUT_STREAM_QUEUE_LEN;
+        p_queue->count--;
+        stats[stream].msgs++;
+        stats[stream].delay_sum_us += delay_us;
+        if (delay_us > stats[stream].delay_max_us)
+        {
+            stats[stream].delay_max_us = delay_us;
+        }
+        /* Write requests complete with their response, not in order */
+        if (p_msg->request)
+        {
+            stats[stream].bytes += len;
+        }
+        taskEXIT_CRITICAL();
+    }
+    deficits[stream] = (deficits[stream] > len) ? deficits[stream] - len : 0u;
+}
+
+/*******************************************************************************
+* Function Name: tput_stream_on_sending()
+********************************************************************************
+* Summary:
+*   Records a write command of a stream to match its completion. Called
+*   before the write is passed to the stack, as the completion may be
+*   reported before the call returns. If the stack does not accept the
+*   write, tput_stream_cancel_sending() must be called.
+*
+* Parameters:
+*   tput_stream_id_t stream : Stream selected
+*   uint16_t len            : Length of the write
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void tput_stream_on_sending(tput_stream_id_t stream, uint16_t len)
+{
+    tput_stream_in_flight_t *p_write;
+
+    taskENTER_CRITICAL();
+    in_flight_pushed = (stream < TPUT_STREAM_COUNT) &&
+                       (in_flight_count < TPUT_STREAM_IN_FLIGHT_LEN);
+    if (in_flight_pushed)
+    {
+        p_write = &in_flight[(in_flight_head + in_flight_count) %
+                             TPUT_STREAM_IN_FLIGHT_LEN];
+        p_write->stream = (uint8_t)stream;
+        p_write->len = len;
+        in_flight_count++;
+    }
+    taskEXIT_CRITICAL();
+}
+
+/*******************************************************************************
+* Function Name: tput_stream_cancel_sending()
+********************************************************************************
+* Summary:
+*   Takes back the write recorded last, when the stack did not accept it.
+*
+* Parameters:
+*   None
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void tput_stream_cancel_sending(void)
+{
+    taskENTER_CRITICAL();
+    /* Nothing to take back if the streams were reset meanwhile */
+    if (in_flight_pushed && (0u != in_flight_count))
+    {
+        in_flight_count--;
+    }
+    in_flight_pushed = false;
+    taskEXIT_CRITICAL();
+}
+
+/*******************************************************************************
+* Function Name: tput_stream_on_complete()
+********************************************************************************
+* Summary:
+*   Matches a completed write command with the stream it was sent from, as
+*   write commands complete in order, and counts its bytes. Called from the
+*   GATT callback.
+*
+* Parameters:
+*   bool success : false if the write completed with an error
+*
+* Return:
+*   tput_stream_id_t : Stream of the write, TPUT_STREAM_BULK if unknown
+*
+*******************************************************************************/
+tput_stream_id_t tput_stream_on_complete(bool success)
+{
+    tput_stream_in_flight_t write;
+
+    taskENTER_CRITICAL();
+    if (0u == in_flight_count)
+    {
+        taskEXIT_CRITICAL();
+        return TPUT_STREAM_BULK;
+    }
+    write = in_flight[in_flight_head];
+    in_flight_head = (in_flight_head + 1u) % TPUT_STREAM_IN_FLIGHT_LEN;
+    in_flight_count--;
+    if (success && (TPUT_STREAM_BULK != write.stream))
+    {
+        stats[write.stream].bytes += write.len;
+    }
+    taskEXIT_CRITICAL();
+    return (tput_stream_id_t)write.stream;
+}
+
+/*******************************************************************************
+* Function Name: tput_stream_get_stats()
+********************************************************************************
+* Summary:
+*   Returns the statistics of a queued stream since they were cleared.
+*
+* Parameters:
+*   tput_stream_id_t stream      : TPUT_STREAM_CONTROL or TPUT_STREAM_LATENCY
+*   tput_stream_stats_t *p_stats : Returns the statistics
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void tput_stream_get_stats(tput_stream_id_t stream,
+                           tput_stream_stats_t *p_stats)
+{
+    if (stream >= TPUT_STREAM_COUNT)
+    {
+        memset(p_stats, 0, sizeof(*p_stats));
+        return;
+    }
+    taskENTER_CRITICAL();
+    *p_stats = stats[stream];
+    taskEXIT_CRITICAL();
+}
+
+/*******************************************************************************
+* Function Name: tput_stream_clear_stats()
+********************************************************************************
+* Summary:
+*   Clears the statistics of every stream.
+*
+* Parameters:
+*   None
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void tput_stream_clear_stats(void)
+{
+    taskENTER_CRITICAL();
+    memset(stats, 0, sizeof(stats));
+    taskEXIT_CRITICAL();
+}
+
+/*******************************************************************************
+* Function Name: tput_stream_print()
+********************************************************************************
+* Summary:
+*   Prints the weight, queued messages and characteristic of each stream,
+*   and the generated messages.
+*
+* Parameters:
+*   None
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void tput_stream_print(void)
+{
+    uint32_t stream;
+
+    for (stream = 0; stream < TPUT_STREAM_COUNT; stream++)
+    {
+        printf("Stream %-8s: %s", stream_names[stream],
+               weights[stream] ? "weight " : "strict priority");
+        if (weights[stream])
+        {
+            printf("%u", weights[stream]);
+        }
+        if (tput_stream_is_queued((tput_stream_id_t)stream))
+        {
+            printf(", %lu queued", (unsigned long)queues[stream].count);
+        }
+        printf(", handle offset %u\n", stream_handles[stream]);
+    }
+    if (periodic_ms)
+    {
+        printf("Latency messages of %u bytes every %lu ms\n", periodic_len,
+               (unsigned long)periodic_ms);
+    }
+}
+
+/*******************************************************************************
+* Function Name: tput_stream_is_queued()
+********************************************************************************
+* Summary:
+*   Tells if a stream has a message queue.
+*
+* Parameters:
+*   tput_stream_id_t stream : Stream
+*
+* Return:
+*   bool : true for the control and latency streams
+*
+*******************************************************************************/
+static bool tput_stream_is_queued(tput_stream_id_t stream)
+{
+    return (stream < TPUT_STREAM_BULK);
+}
+
+#endif /* TPUT_STREAM_ENABLE */
+
+/* [] END OF FILE */
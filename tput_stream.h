@@ -0,0 +1,133 @@
+/*******************************************************************************
+ * File Name: tput_stream.h
+ *
+ * Description: This file contains the declarations of the prioritized TX
+ *              arbiter of the logical write streams.
+ *
+ * Related Document: See README.md
+ *
+ *
+ *******************************************************************************
+ * Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ ******************************************************************************/
+
+#ifndef __TPUT_STREAM_H__
+#define __TPUT_STREAM_H__
+
+/******************************************************************************
+ *                                INCLUDES
+ ******************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include "ble_client.h"
+
+/*******************************************************************************
+*        Macros
+*******************************************************************************/
+/* Messages queued per stream, and largest message */
+#define TPUT_STREAM_QUEUE_LEN           (8u)
+#define TPUT_STREAM_MAX_MSG_LEN         (64u)
+/* A generated message holds its sequence number and queuing time */
+#define TPUT_STREAM_MIN_MSG_LEN         (8u)
+/* Characteristic written by each queued stream, as an offset from the
+ * service handle. The throughput server has one writable characteristic,
+ * which all streams share; point these at the characteristics of a server
+ * that has one per stream */
+#define TPUT_STREAM_CONTROL_HANDLE      (GATT_WRITE_HANDLE)
+#define TPUT_STREAM_LATENCY_HANDLE      (GATT_WRITE_HANDLE)
+/* Weights after connection. 0 is strict priority, over every weighted
+ * stream; otherwise a stream gets weight * TPUT_STREAM_QUANTUM bytes per
+ * round when several are backlogged. The control stream is always strict */
+#define TPUT_STREAM_LATENCY_WEIGHT      (0u)
+#define TPUT_STREAM_BULK_WEIGHT         (1u)
+#define TPUT_STREAM_QUANTUM             (DATA_PACKET_SIZE_1)
+
+/*******************************************************************************
+*        Structures and Enumerations
+*******************************************************************************/
+/* Logical streams, from the highest priority */
+typedef enum
+{
+    TPUT_STREAM_CONTROL,        // control writes, such as the CCCD update
+    TPUT_STREAM_LATENCY,        // short latency sensitive messages
+    TPUT_STREAM_BULK,           // writes of the data transfer mode
+    TPUT_STREAM_COUNT           // none
+} tput_stream_id_t;
+
+typedef struct
+{
+    uint16_t handle;            // attribute written
+    bool     request;           // write request, else write command
+    uint16_t len;
+    uint32_t enqueue_us;
+    uint8_t  data[TPUT_STREAM_MAX_MSG_LEN];
+} tput_stream_msg_t;
+
+typedef struct
+{
+    uint32_t msgs;              // messages sent
+    uint32_t bytes;             // bytes of the messages completed
+    uint32_t dropped;           // messages not queued, the queue was full
+    uint32_t delay_sum_us;      // queued to handed to the stack
+    uint32_t delay_max_us;
+    uint16_t max_depth;         // largest number of messages queued
+} tput_stream_stats_t;
+
+/* Called when a message is queued, to wake up the task sending the writes */
+typedef void (*tput_stream_wake_cb_t)(void);
+
+/****************************************************************************
+ *                              FUNCTION DECLARATIONS
+ ***************************************************************************/
+void tput_stream_init(tput_stream_wake_cb_t wake);
+void tput_stream_reset(uint16_t service_handle);
+const char *tput_stream_name(tput_stream_id_t stream);
+bool tput_stream_set_weight(tput_stream_id_t stream, uint8_t weight);
+uint8_t tput_stream_get_weight(tput_stream_id_t stream);
+bool tput_stream_enqueue(tput_stream_id_t stream, uint16_t handle,
+                         bool request, const uint8_t *p_data, uint16_t len);
+bool tput_stream_send(tput_stream_id_t stream, uint16_t len);
+void tput_stream_periodic(uint32_t period_ms, uint16_t len);
+void tput_stream_tick(void);
+tput_stream_id_t tput_stream_select(bool bulk_ready, uint16_t bulk_len);
+const tput_stream_msg_t *tput_stream_peek(tput_stream_id_t stream);
+void tput_stream_on_sent(tput_stream_id_t stream, uint16_t len);
+void tput_stream_on_sending(tput_stream_id_t stream, uint16_t len);
+void tput_stream_cancel_sending(void);
+tput_stream_id_t tput_stream_on_complete(bool success);
+void tput_stream_get_stats(tput_stream_id_t stream,
+                           tput_stream_stats_t *p_stats);
+void tput_stream_clear_stats(void);
+void tput_stream_print(void);
+
+#endif      /*__TPUT_STREAM_H__ */
+/* [] END OF FILE */
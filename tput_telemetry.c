@@ -0,0 +1,150 @@
+/*******************************************************************************
+ * File Name: tput_telemetry.c
+ *
+ * Description: This file contains the encoding of telemetry samples into COBS frames
+ *              written to the debug UART.
+ *
+ * Related Document: See README.md
+ *
+ *
+ *******************************************************************************
+ * Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ ******************************************************************************/
+
+/******************************************************************************
+ *                                INCLUDES
+ ******************************************************************************/
+#include <string.h>
+#include "cyhal.h"
+#include "cy_retarget_io.h"
+#include "app_bt_utils.h"
+#include "tput_telemetry.h"
+
+/******************************************************************************
+ *                                Macros
+ ******************************************************************************/
+#define TPUT_TELEMETRY_CRC_LEN          (4u)
+#define TPUT_TELEMETRY_RAW_LEN          (sizeof(tput_telemetry_sample_t) + \
+                                         TPUT_TELEMETRY_CRC_LEN)
+/* COBS adds one byte per 254 bytes of data, plus the 0x00 delimiter */
+#define TPUT_TELEMETRY_FRAME_LEN        (TPUT_TELEMETRY_RAW_LEN + \
+                                         (TPUT_TELEMETRY_RAW_LEN / 254u) + 2u)
+
+/******************************************************************************
+ * Function Definitions
+ ******************************************************************************/
+
+/*******************************************************************************
+* Function Name: tput_telemetry_cobs_encode()
+********************************************************************************
+* Summary:
+*   Encodes data with Consistent Overhead Byte Stuffing, which removes all
+*   0x00 bytes so that 0x00 can delimit frames. A receiver that starts in the
+*   middle of the stream synchronizes on the next 0x00.
+*
+* Parameters:
+*   const uint8_t *p_in : Data to be encoded
+*   uint32_t in_len     : Length of the data
+*   uint8_t *p_out      : Encoded data, at least in_len + in_len / 254 + 1
+*                         bytes
+*
+* Return:
+*   uint32_t : Length of the encoded data, without delimiter
+*
+*******************************************************************************/
+static uint32_t tput_telemetry_cobs_encode(const uint8_t *p_in, uint32_t in_len,
+                                           uint8_t *p_out)
+{
+    uint32_t code_idx = 0;
+    uint32_t out_idx = 1;
+    uint8_t code = 1;
+
+    for (uint32_t in_idx = 0; in_idx < in_len; in_idx++)
+    {
+        if (0u != p_in[in_idx])
+        {
+            p_out[out_idx++] = p_in[in_idx];
+            code++;
+        }
+        if ((0u == p_in[in_idx]) || (0xFFu == code))
+        {
+            /* Close the block: its code byte holds the offset to the next
+             * zero, or 0xFF for a full block of 254 non-zero bytes */
+            p_out[code_idx] = code;
+            code_idx = out_idx++;
+            code = 1;
+        }
+    }
+    p_out[code_idx] = code;
+    return out_idx;
+}
+
+/*******************************************************************************
+* Function Name: tput_telemetry_send()
+********************************************************************************
+* Summary:
+*   Writes a sample to the debug UART as a frame: the sample followed by its
+*   CRC-32, COBS encoded and terminated by 0x00. The version field is filled
+*   in here. Text printed by other tasks may corrupt a frame, which the
+*   decoder then discards.
+*
+* Parameters:
+*   tput_telemetry_sample_t *p_sample : Sample to be sent
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void tput_telemetry_send(tput_telemetry_sample_t *p_sample)
+{
+    uint8_t raw[TPUT_TELEMETRY_RAW_LEN];
+    uint8_t frame[TPUT_TELEMETRY_FRAME_LEN];
+    size_t frame_len;
+    uint32_t crc;
+
+    p_sample->version = TPUT_TELEMETRY_VERSION;
+    memcpy(raw, p_sample, sizeof(*p_sample));
+    crc = crc32_update(0, raw, sizeof(*p_sample));
+    raw[sizeof(*p_sample)]      = (uint8_t)(crc);
+    raw[sizeof(*p_sample) + 1u] = (uint8_t)(crc >> 8);
+    raw[sizeof(*p_sample) + 2u] = (uint8_t)(crc >> 16);
+    raw[sizeof(*p_sample) + 3u] = (uint8_t)(crc >> 24);
+
+    frame_len = tput_telemetry_cobs_encode(raw, sizeof(raw), frame);
+    frame[frame_len++] = 0u;
+
+    /* The frame is shorter than the UART FIFO, so this normally returns
+     * without waiting for the transmission */
+    cyhal_uart_write(&cy_retarget_io_uart_obj, frame, &frame_len);
+}
+
+/* [] END OF FILE */
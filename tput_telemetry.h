@@ -0,0 +1,105 @@
+/*******************************************************************************
+ * File Name: tput_telemetry.h
+ *
+ * Description: This file contains the declarations of the binary telemetry stream.
+ *
+ * Related Document: See README.md
+ *
+ *
+ *******************************************************************************
+ * Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ ******************************************************************************/
+
+#ifndef __TPUT_TELEMETRY_H__
+#define __TPUT_TELEMETRY_H__
+
+/******************************************************************************
+ *                                INCLUDES
+ ******************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+
+/******************************************************************************
+ *                                Macros
+ ******************************************************************************/
+/* Sample period. 50 ms gives 20 samples per second; periods from 20 ms to
+ * 100 ms (10 Hz to 50 Hz) fit in the bandwidth of the debug UART */
+#ifndef TPUT_TELEMETRY_PERIOD_MS
+#define TPUT_TELEMETRY_PERIOD_MS        (50u)
+#endif
+
+/* Incremented when the layout of tput_telemetry_sample_t changes, checked by
+ * scripts/tput_telemetry.py */
+#define TPUT_TELEMETRY_VERSION          (2u)
+
+/* Bits of tput_telemetry_sample_t.flags */
+#define TPUT_TELEMETRY_FLAG_CONNECTED   (0x01u)
+#define TPUT_TELEMETRY_FLAG_CONGESTED   (0x02u)
+#define TPUT_TELEMETRY_FLAG_NOTIFY      (0x04u)
+#define TPUT_TELEMETRY_FLAG_WRITE       (0x08u)
+
+/*******************************************************************************
+*        Structures and Enumerations
+*******************************************************************************/
+/* One sample, little endian. Byte counters are cumulative since connection,
+ * so that a lost frame only lowers the time resolution of the rates
+ * computed by the decoder */
+typedef struct __attribute__((packed))
+{
+    uint8_t  version;               // TPUT_TELEMETRY_VERSION
+    uint8_t  flags;                 // TPUT_TELEMETRY_FLAG_*
+    uint16_t seq;                   // sample sequence number
+    uint32_t timestamp_ms;          // time since boot
+    uint32_t rx_bytes;              // notification bytes received
+    uint32_t tx_bytes;              // GATT write bytes sent
+    uint16_t cwnd;                  // write window
+    uint16_t in_flight;             // writes not yet completed
+    uint32_t congestion_episodes;
+    uint32_t congested_ms;          // total time congested
+    uint16_t tx_failures;           // write commands completed with an error
+    uint16_t rx_lag;                // notifications not yet consumed
+    uint8_t  mode;                  // tput_mode_t
+    uint8_t  phy;                   // (tx_phy << 4) | rx_phy
+    uint16_t mtu;
+    uint16_t conn_interval;         // in units of 1.25 ms
+    uint16_t packet_size;
+    uint16_t rx_ceiling_kbps;       // theoretical maximum (tput_model.h)
+    uint16_t tx_ceiling_kbps;
+} tput_telemetry_sample_t;
+
+/****************************************************************************
+ *                              FUNCTION DECLARATIONS
+ ***************************************************************************/
+void tput_telemetry_send(tput_telemetry_sample_t *p_sample);
+
+#endif      /*__TPUT_TELEMETRY_H__ */
+/* [] END OF FILE */
@@ -0,0 +1,215 @@
+/*******************************************************************************
+ * File Name: tput_time.c
+ *
+ * Description: This file contains a microsecond clock based on the cycle counter of the
+ *              Cortex-M DWT unit.
+ *
+ * Related Document: See README.md
+ *
+ *
+ *******************************************************************************
+ * Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ ******************************************************************************/
+
+/******************************************************************************
+ *                                INCLUDES
+ ******************************************************************************/
+#include <FreeRTOS.h>
+#include <task.h>
+#include "cybsp.h"
+#include "tput_time.h"
+
+/******************************************************************************
+ *                                Macros
+ ******************************************************************************/
+/* Cortex-M0+ cores have no cycle counter, they fall back to the RTOS tick */
+#if defined(DWT_CTRL_CYCCNTENA_Msk)
+#define TPUT_TIME_USE_DWT               (1)
+#else
+#define TPUT_TIME_USE_DWT               (0)
+#endif
+
+/*******************************************************************************
+*        Variable Definitions
+*******************************************************************************/
+static uint32_t cycles_per_us = 1;
+#if TPUT_TIME_USE_DWT
+/* The 32-bit cycle counter wraps within a minute. It is extended to
+ * microseconds on every read, so intervals are only measured correctly if
+ * it is read at least once per wrap period (42 s at 100 MHz) */
+static uint32_t last_cycles = 0;
+static uint32_t rem_cycles = 0;
+static uint32_t now_us = 0;
+#endif
+
+/******************************************************************************
+ * Function Definitions
+ ******************************************************************************/
+
+/*******************************************************************************
+* Function Name: tput_time_init()
+********************************************************************************
+* Summary:
+*   Starts the cycle counter. Must be called after the system clocks are
+*   configured.
+*
+* Parameters:
+*   None
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void tput_time_init(void)
+{
+    cycles_per_us = SystemCoreClock / 1000000u;
+    if (0u == cycles_per_us)
+    {
+        cycles_per_us = 1;
+    }
+#if TPUT_TIME_USE_DWT
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    last_cycles = 0;
+    rem_cycles = 0;
+    now_us = 0;
+#endif
+}
+
+/*******************************************************************************
+* Function Name: tput_time_us()
+********************************************************************************
+* Summary:
+*   Returns the time since tput_time_init() in microseconds. The value wraps
+*   after 71 minutes, so only differences of two values are meaningful.
+*
+* Parameters:
+*   None
+*
+* Return:
+*   uint32_t : Time in microseconds
+*
+*******************************************************************************/
+uint32_t tput_time_us(void)
+{
+#if TPUT_TIME_USE_DWT
+    uint32_t result;
+
+    taskENTER_CRITICAL();
+    {
+        uint32_t cycles = DWT->CYCCNT;
+
+        rem_cycles += cycles - last_cycles;
+        last_cycles = cycles;
+        now_us += rem_cycles / cycles_per_us;
+        rem_cycles %= cycles_per_us;
+        result = now_us;
+    }
+    taskEXIT_CRITICAL();
+    return result;
+#else
+    return (uint32_t)(xTaskGetTickCount() * portTICK_PERIOD_MS * 1000u);
+#endif
+}
+
+/*******************************************************************************
+* Function Name: tput_time_cycles()
+********************************************************************************
+* Summary:
+*   Returns the raw cycle counter. Unlike tput_time_us(), it can be called
+*   from interrupts and from inside the scheduler. The value wraps within a
+*   minute; without a cycle counter it is derived from the RTOS tick.
+*
+* Parameters:
+*   None
+*
+* Return:
+*   uint32_t : CPU cycles
+*
+*******************************************************************************/
+uint32_t tput_time_cycles(void)
+{
+#if TPUT_TIME_USE_DWT
+    return DWT->CYCCNT;
+#else
+    return (uint32_t)(xTaskGetTickCountFromISR() * portTICK_PERIOD_MS *
+                      1000u * cycles_per_us);
+#endif
+}
+
+/*******************************************************************************
+* Function Name: tput_time_cycles_per_us()
+********************************************************************************
+* Summary:
+*   Returns the number of CPU cycles per microsecond.
+*
+* Parameters:
+*   None
+*
+* Return:
+*   uint32_t : Cycles per microsecond
+*
+*******************************************************************************/
+uint32_t tput_time_cycles_per_us(void)
+{
+    return cycles_per_us;
+}
+
+/*******************************************************************************
+* Function Name: tput_time_spin_cycles()
+********************************************************************************
+* Summary:
+*   Keeps the CPU busy for a number of cycles, measured with the cycle
+*   counter. Interrupts taken meanwhile are included in the count.
+*
+* Parameters:
+*   uint32_t cycles : Number of cycles
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void tput_time_spin_cycles(uint32_t cycles)
+{
+#if TPUT_TIME_USE_DWT
+    uint32_t start = DWT->CYCCNT;
+
+    while ((DWT->CYCCNT - start) < cycles)
+    {
+    }
+#else
+    Cy_SysLib_DelayCycles(cycles);
+#endif
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,251 @@
+/*******************************************************************************
+ * File Name: tput_trace.c
+ *
+ * Description: This file contains a low-overhead trace recorder that logs timestamped
+ *              events of the data path and the RTOS context switches into a RAM ring, and
+ *              prints them for scripts/tput_trace.py.
+ *
+ * Related Document: See README.md
+ *
+ *
+ *******************************************************************************
+ * Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ ******************************************************************************/
+
+/******************************************************************************
+ *                                INCLUDES
+ ******************************************************************************/
+#include <stdio.h>
+#include <FreeRTOS.h>
+#include <task.h>
+#include "tput_time.h"
+#include "tput_trace.h"
+
+#if TPUT_TRACE_ENABLE
+
+/*******************************************************************************
+*        Structures and Enumerations
+*******************************************************************************/
+typedef struct
+{
+    uint32_t cycles;    // tput_time_cycles()
+    uint16_t arg;
+    uint8_t  type;      // tput_trace_type_t
+    uint8_t  id;        // tput_trace_id_t
+} tput_trace_evt_t;
+
+/*******************************************************************************
+*        Variable Definitions
+*******************************************************************************/
+static tput_trace_evt_t trace_buf[TPUT_TRACE_DEPTH];
+/* Number of events recorded since tput_trace_start() */
+static uint32_t trace_count = 0;
+static volatile bool trace_running = false;
+static TaskStatus_t trace_tasks[TPUT_TRACE_MAX_TASKS];
+
+/* Indexed by tput_trace_id_t */
+static const struct
+{
+    const char *name;
+    bool isr;
+} trace_ids[TPUT_TRACE_ID_COUNT] =
+{
+    [TPUT_TRACE_MGMT_CB]         = {"mgmt_cb",          false},
+    [TPUT_TRACE_GATT_CB]         = {"gatt_cb",          false},
+    [TPUT_TRACE_THROUGHPUT_ISR]  = {"throughput_timer", true},
+    [TPUT_TRACE_MILLISEC_ISR]    = {"millisec_timer",   true},
+    [TPUT_TRACE_STATS]           = {"stats",            false},
+    [TPUT_TRACE_WRITE_BURST]     = {"write_burst",      false},
+    [TPUT_TRACE_WRITE_CONGESTED] = {"write_congested",  false},
+    [TPUT_TRACE_RX_SINK]         = {"rx_sink",          false},
+};
+
+static const char trace_type_chars[] = {'B', 'E', 'I', 'S'};
+
+/******************************************************************************
+ * Function Definitions
+ ******************************************************************************/
+
+/*******************************************************************************
+* Function Name: tput_trace_start()
+********************************************************************************
+* Summary:
+*   Discards the recorded events and starts recording.
+*
+* Parameters:
+*   None
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void tput_trace_start(void)
+{
+    taskENTER_CRITICAL();
+    trace_count = 0;
+    trace_running = true;
+    taskEXIT_CRITICAL();
+}
+
+/*******************************************************************************
+* Function Name: tput_trace_stop()
+********************************************************************************
+* Summary:
+*   Stops recording. The recorded events are kept for tput_trace_dump().
+*
+* Parameters:
+*   None
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void tput_trace_stop(void)
+{
+    trace_running = false;
+}
+
+/*******************************************************************************
+* Function Name: tput_trace_record()
+********************************************************************************
+* Summary:
+*   Records one event. Can be called from tasks, from interrupts and from
+*   the scheduler, and takes a few dozen cycles. Use the TPUT_TRACE_BEGIN,
+*   TPUT_TRACE_END and TPUT_TRACE_INSTANT macros, which compile to nothing
+*   when tracing is disabled.
+*
+* Parameters:
+*   tput_trace_type_t type : Event type
+*   tput_trace_id_t id     : Traced event
+*   uint16_t arg           : Event argument
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void tput_trace_record(tput_trace_type_t type, tput_trace_id_t id,
+                       uint16_t arg)
+{
+    UBaseType_t int_mask;
+    tput_trace_evt_t *p_evt;
+
+    if (!trace_running)
+    {
+        return;
+    }
+    int_mask = portSET_INTERRUPT_MASK_FROM_ISR();
+    p_evt = &trace_buf[trace_count % TPUT_TRACE_DEPTH];
+    p_evt->cycles = tput_time_cycles();
+    p_evt->arg = arg;
+    p_evt->type = (uint8_t)type;
+    p_evt->id = (uint8_t)id;
+    trace_count++;
+    portCLEAR_INTERRUPT_MASK_FROM_ISR(int_mask);
+}
+
+/*******************************************************************************
+* Function Name: tput_trace_task_switched_in()
+********************************************************************************
+* Summary:
+*   Records a context switch. Called by the traceTASK_SWITCHED_IN() hook in
+*   FreeRTOSConfig.h, from inside the scheduler.
+*
+* Parameters:
+*   uint32_t task_number : Number of the task switched in, as reported by
+*                          uxTaskGetSystemState()
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void tput_trace_task_switched_in(uint32_t task_number)
+{
+    tput_trace_record(TPUT_TRACE_TYPE_SWITCH, TPUT_TRACE_ID_COUNT,
+                      (uint16_t)task_number);
+}
+
+/*******************************************************************************
+* Function Name: tput_trace_dump()
+********************************************************************************
+* Summary:
+*   Stops recording and prints the recorded events, oldest first, as CSV
+*   lines for scripts/tput_trace.py:
+*     trace_start,<cycles per us>,<events>,<events overwritten>
+*     trace_id,<id>,<name>,isr|task     for each traced event
+*     trace_task,<number>,<name>        for each task
+*     trace,<cycles>,B|E|I|S,<id>,<arg> for each event
+*     trace_end
+*
+* Parameters:
+*   None
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void tput_trace_dump(void)
+{
+    uint32_t first;
+    uint32_t num_tasks;
+
+    tput_trace_stop();
+    first = (trace_count > TPUT_TRACE_DEPTH) ?
+            (trace_count - TPUT_TRACE_DEPTH) : 0u;
+
+    printf("trace_start,%lu,%lu,%lu\n",
+           (unsigned long)tput_time_cycles_per_us(),
+           (unsigned long)(trace_count - first), (unsigned long)first);
+    for (uint32_t id = 0; id < TPUT_TRACE_ID_COUNT; id++)
+    {
+        printf("trace_id,%lu,%s,%s\n", (unsigned long)id, trace_ids[id].name,
+               trace_ids[id].isr ? "isr" : "task");
+    }
+    num_tasks = uxTaskGetSystemState(trace_tasks, TPUT_TRACE_MAX_TASKS, NULL);
+    for (uint32_t task = 0; task < num_tasks; task++)
+    {
+        printf("trace_task,%lu,%s\n",
+               (unsigned long)trace_tasks[task].xTaskNumber,
+               trace_tasks[task].pcTaskName);
+    }
+    for (uint32_t idx = first; idx < trace_count; idx++)
+    {
+        const tput_trace_evt_t *p_evt = &trace_buf[idx % TPUT_TRACE_DEPTH];
+
+        printf("trace,%lu,%c,%u,%u\n", (unsigned long)p_evt->cycles,
+               trace_type_chars[p_evt->type], p_evt->id, p_evt->arg);
+    }
+    printf("trace_end\n");
+}
+
+#endif /* TPUT_TRACE_ENABLE */
+
+/* [] END OF FILE */
@@ -0,0 +1,118 @@
+/*******************************************************************************
+ * File Name: tput_trace.h
+ *
+ * Description: This file contains the declarations of the event trace recorder.
+ *
+ * Related Document: See README.md
+ *
+ *
+ *******************************************************************************
+ * Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ ******************************************************************************/
+
+#ifndef __TPUT_TRACE_H__
+#define __TPUT_TRACE_H__
+
+/******************************************************************************
+ *                                INCLUDES
+ ******************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+
+/******************************************************************************
+ *                                Macros
+ ******************************************************************************/
+/* Set to 1 to record the data path events and the RTOS context switches in
+ * a RAM ring. The context switch hook in FreeRTOSConfig.h also checks this
+ * macro, so it must be set for the whole build, with
+ * DEFINES+=TPUT_TRACE_ENABLE=1 in the Makefile */
+#ifndef TPUT_TRACE_ENABLE
+#define TPUT_TRACE_ENABLE               (0)
+#endif
+
+/* Number of events kept, 8 bytes each. The oldest event is overwritten */
+#define TPUT_TRACE_DEPTH                (1024u)
+/* Number of tasks whose names are listed in the dump */
+#define TPUT_TRACE_MAX_TASKS            (24u)
+
+#if TPUT_TRACE_ENABLE
+#define TPUT_TRACE_BEGIN(id, arg)   tput_trace_record(TPUT_TRACE_TYPE_BEGIN, \
+                                                      (id), (arg))
+#define TPUT_TRACE_END(id)          tput_trace_record(TPUT_TRACE_TYPE_END, \
+                                                      (id), 0)
+#define TPUT_TRACE_INSTANT(id, arg) tput_trace_record(TPUT_TRACE_TYPE_INSTANT, \
+                                                      (id), (arg))
+#else
+#define TPUT_TRACE_BEGIN(id, arg)
+#define TPUT_TRACE_END(id)
+#define TPUT_TRACE_INSTANT(id, arg)
+#endif
+
+/*******************************************************************************
+*        Structures and Enumerations
+*******************************************************************************/
+typedef enum
+{
+    TPUT_TRACE_TYPE_BEGIN,
+    TPUT_TRACE_TYPE_END,
+    TPUT_TRACE_TYPE_INSTANT,
+    TPUT_TRACE_TYPE_SWITCH      // a task was switched in, arg is its number
+} tput_trace_type_t;
+
+/* Traced events. Keep in sync with the names in tput_trace.c */
+typedef enum
+{
+    TPUT_TRACE_MGMT_CB,         // Bluetooth management callback
+    TPUT_TRACE_GATT_CB,         // GATT event callback, arg is the event
+    TPUT_TRACE_THROUGHPUT_ISR,  // 1-second timer interrupt
+    TPUT_TRACE_MILLISEC_ISR,    // 1-millisecond timer interrupt
+    TPUT_TRACE_STATS,           // get_throughput_task printing statistics
+    TPUT_TRACE_WRITE_BURST,     // send_gatt_write_task sending writes
+    TPUT_TRACE_WRITE_CONGESTED, // a write was rejected as congested
+    TPUT_TRACE_RX_SINK,         // rx_sink_task draining the RX ring
+    TPUT_TRACE_ID_COUNT
+} tput_trace_id_t;
+
+/****************************************************************************
+ *                              FUNCTION DECLARATIONS
+ ***************************************************************************/
+#if TPUT_TRACE_ENABLE
+void tput_trace_start(void);
+void tput_trace_stop(void);
+void tput_trace_dump(void);
+void tput_trace_record(tput_trace_type_t type, tput_trace_id_t id,
+                       uint16_t arg);
+void tput_trace_task_switched_in(uint32_t task_number);
+#endif
+
+#endif      /*__TPUT_TRACE_H__ */
+/* [] END OF FILE */
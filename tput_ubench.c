@@ -0,0 +1,218 @@
+/*******************************************************************************
+ * File Name: tput_ubench.c
+ *
+ * Description: This file contains the microbenchmark harness, which times each call of a
+ *              hot path with the DWT cycle counter and reports cycles per call.
+ *
+ * Related Document: See README.md
+ *
+ *
+ *******************************************************************************
+ * Copyright 2025, Cypress Semiconductor Corporation (an Infineon company) or
+ * an affiliate of Cypress Semiconductor Corporation.  All rights reserved.
+ *
+ * This software, including source code, documentation and related
+ * materials ("Software") is owned by Cypress Semiconductor Corporation
+ * or one of its affiliates ("Cypress") and is protected by and subject to
+ * worldwide patent protection (United States and foreign),
+ * United States copyright laws and international treaty provisions.
+ * Therefore, you may use this Software only as provided in the license
+ * agreement accompanying the software package from which you
+ * obtained this Software ("EULA").
+ * If no EULA applies, Cypress hereby grants you a personal, non-exclusive,
+ * non-transferable license to copy, modify, and compile the Software
+ * source code solely for use in connection with Cypress's
+ * integrated circuit products.  Any reproduction, modification, translation,
+ * compilation, or representation of this Software except as specified
+ * above is prohibited without the express written permission of Cypress.
+ *
+ * Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE. Cypress
+ * reserves the right to make changes to the Software without notice. Cypress
+ * does not assume any liability arising out of the application or use of the
+ * Software or any product or circuit described in the Software. Cypress does
+ * not authorize its products for use in any products where a malfunction or
+ * failure of the Cypress product may reasonably be expected to result in
+ * significant property damage, injury or death ("High Risk Product"). By
+ * including Cypress's product in a High Risk Product, the manufacturer
+ * of such system or application assumes all risk of such use and in doing
+ * so agrees to indemnify Cypress against all liability.
+ ******************************************************************************/
+
+/******************************************************************************
+ *                                INCLUDES
+ ******************************************************************************/
+#include <stdio.h>
+#include <FreeRTOS.h>
+#include <task.h>
+#include "ble_client.h"
+#include "tput_time.h"
+#include "tput_ubench.h"
+
+#if TPUT_UBENCH_BUILD
+
+/*******************************************************************************
+*        Variable Definitions
+*******************************************************************************/
+static uint32_t samples[TPUT_UBENCH_MAX_CALLS];
+
+/******************************************************************************
+ * Function Definitions
+ ******************************************************************************/
+
+/*******************************************************************************
+* Function Name: tput_ubench_empty()
+********************************************************************************
+* Summary:
+*   Empty benchmark, timed to measure the overhead of the timing itself.
+*
+* Parameters:
+*   None
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+static void tput_ubench_empty(void)
+{
+}
+
+/*******************************************************************************
+* Function Name: tput_ubench_time_call()
+********************************************************************************
+* Summary:
+*   Times one call of a benchmark. Interrupts up to the FreeRTOS syscall
+*   priority are masked while timing, so that neither a task switch nor
+*   the application interrupts are counted.
+*
+* Parameters:
+*   const tput_ubench_case_t *p_case : Benchmark
+*
+* Return:
+*   uint32_t : Cycles spent, including the timing overhead
+*
+*******************************************************************************/
+static uint32_t tput_ubench_time_call(const tput_ubench_case_t *p_case)
+{
+    uint32_t start;
+    uint32_t cycles;
+
+    if (NULL != p_case->prepare)
+    {
+        p_case->prepare();
+    }
+    taskENTER_CRITICAL();
+    start = tput_time_cycles();
+    p_case->run();
+    cycles = tput_time_cycles() - start;
+    taskEXIT_CRITICAL();
+    return cycles;
+}
+
+/*******************************************************************************
+* Function Name: tput_ubench_measure()
+********************************************************************************
+* Summary:
+*   Runs the warm-up calls and then the measured calls of a benchmark, and
+*   sorts the measured cycles.
+*
+* Parameters:
+*   const tput_ubench_case_t *p_case : Benchmark
+*   uint32_t calls                   : Calls measured
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+static void tput_ubench_measure(const tput_ubench_case_t *p_case, uint32_t calls)
+{
+    uint32_t value;
+    uint32_t pos;
+
+    for (uint32_t call = 0; call < TPUT_UBENCH_WARMUP_CALLS; call++)
+    {
+        (void)tput_ubench_time_call(p_case);
+    }
+    for (uint32_t call = 0; call < calls; call++)
+    {
+        /* Insertion sort, the sample arrives in order of the calls */
+        value = tput_ubench_time_call(p_case);
+        for (pos = call; (pos > 0u) && (samples[pos - 1u] > value); pos--)
+        {
+            samples[pos] = samples[pos - 1u];
+        }
+        samples[pos] = value;
+    }
+}
+
+/*******************************************************************************
+* Function Name: tput_ubench_run_cases()
+********************************************************************************
+* Summary:
+*   Runs benchmarks and prints one CSV line per benchmark with the cycles
+*   per call, less the timing overhead:
+*     ubench_overhead,<timing overhead cycles>,<cycles per us>
+*     ubench,<name>,<calls>,<min>,<median>,<mean>,<p90>,<max>,<median ns>
+*   The median is the figure to compare; the minimum is the cost with warm
+*   caches, the maximum includes cache and flash wait states.
+*
+* Parameters:
+*   const tput_ubench_case_t *p_cases : Benchmarks
+*   uint32_t num_cases                : Number of benchmarks
+*   uint32_t calls                    : Calls measured per benchmark, up to
+*                                       TPUT_UBENCH_MAX_CALLS
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void tput_ubench_run_cases(const tput_ubench_case_t *p_cases,
+                           uint32_t num_cases, uint32_t calls)
+{
+    static const tput_ubench_case_t empty_case =
+    {
+        .name = "empty",
+        .run = tput_ubench_empty,
+        .prepare = NULL
+    };
+    uint32_t overhead;
+    uint64_t sum;
+    uint32_t median;
+
+    calls = (calls > TPUT_UBENCH_MAX_CALLS) ? TPUT_UBENCH_MAX_CALLS : calls;
+    if (0u == calls)
+    {
+        return;
+    }
+
+    tput_ubench_measure(&empty_case, calls);
+    overhead = samples[0];
+    printf("ubench,name,calls,min_cycles,median_cycles,mean_cycles,"
+           "p90_cycles,max_cycles,median_ns\n");
+    printf("ubench_overhead,%lu,%lu\n", (unsigned long)overhead,
+           (unsigned long)tput_time_cycles_per_us());
+
+    for (uint32_t idx = 0; idx < num_cases; idx++)
+    {
+        tput_ubench_measure(&p_cases[idx], calls);
+        sum = 0;
+        for (uint32_t call = 0; call < calls; call++)
+        {
+            samples[call] = (samples[call] > overhead) ?
+                            (samples[call] - overhead) : 0u;
+            sum += samples[call];
+        }
+        median = samples[calls / 2u];
+        printf("ubench,%s,%lu,%lu,%lu,%lu,%lu,%lu,%lu\n", p_cases[idx].name,
+               (unsigned long)calls, (unsigned long)samples[0],
+               (unsigned long)median, (unsigned long)(sum / calls),
+               (unsigned long)samples[(calls * 9u) / 10u],
+               (unsigned long)samples[calls - 1u],
+               (unsigned long)((median * 1000u) / tput_time_cycles_per_us()));
+    }
+}
+
+#endif /* TPUT_UBENCH_BUILD */
+
+/* [] END OF FILE */